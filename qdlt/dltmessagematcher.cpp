@@ -25,7 +25,7 @@ bool DltMessageMatcher::match(const QDltMsg &msg, const Pattern& pattern) const
         if (m_messageIdFormat)
             header += ' ' + QString::asprintf(m_messageIdFormat->toUtf8(), msg.getMessageId());
         if (std::holds_alternative<QRegularExpression>(pattern)) {
-            matchFound = header.contains(std::get<QRegularExpression>(pattern));
+            matchFound = matchRegExp(header, std::get<QRegularExpression>(pattern));
         } else {
             const auto& searchText = std::get<QString>(pattern);
             matchFound = searchText.isEmpty() || header.contains(searchText, m_caseSensitivity);
@@ -36,9 +36,12 @@ bool DltMessageMatcher::match(const QDltMsg &msg, const Pattern& pattern) const
         return true;
 
     if (m_payloadSearchEnabled) {
-        const auto payload = msg.toStringPayload();
+        // the payload text is rendered into one buffer per thread, which keeps its capacity
+        thread_local QString payload;
+        payload.truncate(0);
+        msg.appendToStringPayload(payload);
         if (std::holds_alternative<QRegularExpression>(pattern)) {
-            matchFound = payload.contains(std::get<QRegularExpression>(pattern));
+            matchFound = matchRegExp(payload, std::get<QRegularExpression>(pattern));
         } else {
             const auto& searchText = std::get<QString>(pattern);
             matchFound = payload.contains(searchText, m_caseSensitivity);
@@ -48,6 +51,15 @@ bool DltMessageMatcher::match(const QDltMsg &msg, const Pattern& pattern) const
     return matchFound;
 }
 
+bool DltMessageMatcher::matchRegExp(const QString& text, const QRegularExpression& regExp) const
+{
+    // a copy of the same regular expression shares its data, so the comparison is cheap
+    if (regExp == m_prefilterRegExp && !m_prefilter.mayMatch(text))
+        return false;
+
+    return text.contains(regExp);
+}
+
 bool DltMessageMatcher::matchAppId(const QString& appId) const
 {
     return m_appId.isEmpty() || appId.compare(m_appId, m_caseSensitivity) == 0;
@@ -2,6 +2,7 @@
 #define DLTMESSAGEMATCHER_H
 
 #include "export_rules.h"
+#include "qdltregexprefilter.h"
 
 #include <QString>
 #include <QRegularExpression>
@@ -51,8 +52,21 @@ public:
         m_messageIdFormat = msgIdFormat;
     }
 
+    // the literals of the regular expression are searched before it is matched,
+    // if the same regular expression is passed to match()
+    void setRegexPrefilter(const QRegularExpression& regExp) {
+        m_prefilterRegExp = regExp;
+        m_prefilter.setRegularExpression(regExp);
+    }
+
+    // number of texts not matched by the regular expression because a literal is missing
+    quint64 getRegexPrefilterRejectedCount() const {
+        return m_prefilter.getRejectedCount();
+    }
+
     bool match(const QDltMsg& message, const Pattern& pattern) const;
 private:
+    bool matchRegExp(const QString& text, const QRegularExpression& regExp) const;
     bool matchAppId(const QString& appId) const;
     bool matchCtxId(const QString& ctxId) const;
     bool matchTimestampRange(unsigned int ts) const;
@@ -79,6 +93,9 @@ private:
     bool m_payloadSearchEnabled{true};
 
     std::optional<QString> m_messageIdFormat;
+
+    QRegularExpression m_prefilterRegExp;
+    QDltRegexPrefilter m_prefilter;
 };
 
 #endif // DLTMESSAGEMATCHER_H
@@ -0,0 +1,212 @@
+#include "dltsearchengine.h"
+
+#include <qdltfile.h>
+#include <qdltmsg.h>
+#include <qdltpluginmanager.h>
+
+#include <QThread>
+
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// rows checked by a worker at once, small enough to find a near match early
+const int defaultChunkSize = 4096;
+
+// the calling thread reports progress and delivers results in this interval
+const std::chrono::milliseconds pollInterval(50);
+
+} // namespace
+
+DltSearchEngine::DltSearchEngine(const QDltFile& file, const DltMessageMatcher& matcher, DltMessageMatcher::Pattern pattern)
+    : m_file(file), m_matcher(matcher), m_pattern(std::move(pattern)), m_chunkSize(defaultChunkSize)
+{
+}
+
+quint64 DltSearchEngine::getRegexPrefilterRejectedCount() const
+{
+    quint64 count = 0;
+    for (const DltMessageMatcher& matcher : m_matchers)
+        count += matcher.getRegexPrefilterRejectedCount();
+    return count;
+}
+
+bool DltSearchEngine::matchRow(const DltMessageMatcher& matcher, QDltMsg& msg, int row)
+{
+    const int msgIndex = m_file.getMsgFilterPos(row);
+    if (m_candidate && !m_candidate(msgIndex)) {
+        m_skippedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    msg.setMsg(m_file.getMsgFilter(row));
+    msg.setIndex(msgIndex);
+
+    // the plugin manager decodes one message at a time
+    if (m_pluginManager)
+        m_pluginManager->decodeMsg(msg, m_silentMode);
+
+    return matcher.match(msg, m_pattern);
+}
+
+void DltSearchEngine::runWorkers(int chunkCount, const ChunkFunction& processChunk, const std::function<void()>& poll)
+{
+    const int threadCount = m_threadCount > 0 ? m_threadCount : QThread::idealThreadCount();
+    const int workerCount = qBound(1, threadCount, chunkCount);
+    std::atomic<int> nextChunk(0);
+    std::mutex mutex;
+    std::condition_variable workerDone;
+    int runningWorkers = workerCount;
+    std::vector<std::thread> workers;
+
+    // each worker has its own matcher
+    m_matchers = QVector<DltMessageMatcher>(workerCount, m_matcher);
+
+    for (int num = 0; num < workerCount; num++) {
+        workers.emplace_back([&, num]() {
+            QDltMsg msg;
+            int chunk;
+
+            while (!m_cancelled && (chunk = nextChunk++) < chunkCount && chunk <= m_chunkLimit)
+                processChunk(chunk, m_matchers[num], msg);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            runningWorkers--;
+            workerDone.notify_one();
+        });
+    }
+
+    // poll until all workers are finished, the poll function may cancel the search
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!workerDone.wait_for(lock, pollInterval, [&]() { return runningWorkers == 0; })) {
+        lock.unlock();
+        poll();
+        lock.lock();
+    }
+    lock.unlock();
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    poll();
+}
+
+bool DltSearchEngine::findAll(int begin, int end, const ResultFunction& results, const ProgressFunction& progress)
+{
+    begin = qMax(0, begin);
+    end = qMin(end, m_file.sizeFilter());
+    if (begin >= end)
+        return true;
+
+    const int chunkCount = (end - begin + m_chunkSize - 1) / m_chunkSize;
+    std::vector<QVector<int>> chunkRows(chunkCount);
+    std::vector<bool> chunkDone(chunkCount, false);
+    std::mutex resultMutex;
+    int nextResult = 0;
+
+    m_cancelled = false;
+    m_chunkLimit = INT_MAX;
+    m_checkedRows = 0;
+    m_skippedCount = 0;
+
+    auto processChunk = [&](int chunk, const DltMessageMatcher& matcher, QDltMsg& msg) {
+        const int chunkBegin = begin + chunk * m_chunkSize;
+        const int chunkEnd = qMin(end, chunkBegin + m_chunkSize);
+        QVector<int>& rows = chunkRows[chunk];
+
+        for (int row = chunkBegin; row < chunkEnd; row++) {
+            if (m_cancelled)
+                return;
+            if (matchRow(matcher, msg, row))
+                rows.append(row);
+        }
+        m_checkedRows += chunkEnd - chunkBegin;
+
+        std::lock_guard<std::mutex> lock(resultMutex);
+        chunkDone[chunk] = true;
+    };
+
+    // the results of the finished chunks are delivered in the order of the chunks
+    auto poll = [&]() {
+        QVector<int> rows;
+        {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            while (nextResult < chunkCount && chunkDone[nextResult]) {
+                rows += chunkRows[nextResult];
+                chunkRows[nextResult].clear();
+                nextResult++;
+            }
+        }
+        if (!rows.isEmpty() && !m_cancelled)
+            results(rows);
+        if (progress)
+            progress(m_checkedRows);
+    };
+
+    runWorkers(chunkCount, processChunk, poll);
+
+    return !m_cancelled;
+}
+
+int DltSearchEngine::findNearest(int startRow, bool forward, const ProgressFunction& progress)
+{
+    const int rowCount = m_file.sizeFilter();
+    if (rowCount == 0)
+        return -1;
+
+    // positions count the rows in the order of the search, starting at the first row to be checked
+    int first;
+    if (forward)
+        first = (startRow < 0) ? 0 : (startRow + 1) % rowCount;
+    else
+        first = (startRow < 0 || startRow >= rowCount) ? rowCount - 1 : (startRow - 1 + rowCount) % rowCount;
+    auto rowAt = [&](int position) {
+        return forward ? (first + position) % rowCount : (first - position + rowCount) % rowCount;
+    };
+
+    const int chunkCount = (rowCount + m_chunkSize - 1) / m_chunkSize;
+    std::mutex resultMutex;
+    int foundPosition = -1;
+
+    m_cancelled = false;
+    m_chunkLimit = INT_MAX;
+    m_checkedRows = 0;
+    m_skippedCount = 0;
+
+    // chunks are taken in the order of the search, a match stops all workers in later chunks
+    auto processChunk = [&](int chunk, const DltMessageMatcher& matcher, QDltMsg& msg) {
+        const int chunkBegin = chunk * m_chunkSize;
+        const int chunkEnd = qMin(rowCount, chunkBegin + m_chunkSize);
+
+        for (int position = chunkBegin; position < chunkEnd; position++) {
+            if (m_cancelled || chunk > m_chunkLimit)
+                return;
+            if (matchRow(matcher, msg, rowAt(position))) {
+                std::lock_guard<std::mutex> lock(resultMutex);
+                if (foundPosition < 0 || position < foundPosition) {
+                    foundPosition = position;
+                    m_chunkLimit = chunk;
+                }
+                return;
+            }
+            m_checkedRows++;
+        }
+    };
+
+    auto poll = [&]() {
+        if (progress)
+            progress(m_checkedRows);
+    };
+
+    runWorkers(chunkCount, processChunk, poll);
+
+    if (m_cancelled || foundPosition < 0)
+        return -1;
+
+    return rowAt(foundPosition);
+}
@@ -0,0 +1,104 @@
+#ifndef DLTSEARCHENGINE_H
+#define DLTSEARCHENGINE_H
+
+#include "export_rules.h"
+#include "dltmessagematcher.h"
+
+#include <QVector>
+
+#include <atomic>
+#include <functional>
+
+class QDltFile;
+class QDltMsg;
+class QDltPluginManager;
+
+// Searches the filtered messages of a DLT file with several threads.
+// The rows of the filtered index are split into chunks, each worker thread takes the next chunk
+// and checks its messages with its own copy of the matcher. The calling thread waits for the
+// workers, gets the results in the order of the rows and can stop the search with cancel().
+class QDLT_EXPORT DltSearchEngine
+{
+public:
+    // called on the calling thread while waiting, with the number of rows checked so far
+    using ProgressFunction = std::function<void(int checkedRows)>;
+
+    // called on the calling thread with the next matching rows, in ascending order
+    using ResultFunction = std::function<void(const QVector<int>& rows)>;
+
+    // called by the worker threads before a message is read, returns false if it cannot match
+    using CandidateFunction = std::function<bool(int msgIndex)>;
+
+    DltSearchEngine(const QDltFile& file, const DltMessageMatcher& matcher, DltMessageMatcher::Pattern pattern);
+
+    // decode the messages with the decoder plugins before they are matched
+    void setPluginManager(QDltPluginManager* pluginManager, bool silentMode) {
+        m_pluginManager = pluginManager;
+        m_silentMode = silentMode;
+    }
+
+    void setCandidateFunction(CandidateFunction candidate) {
+        m_candidate = std::move(candidate);
+    }
+
+    // number of worker threads, 0 for the ideal thread count
+    void setThreadCount(int threadCount) {
+        m_threadCount = threadCount;
+    }
+
+    void setChunkSize(int chunkSize) {
+        m_chunkSize = qMax(1, chunkSize);
+    }
+
+    // find all matching rows in [begin, end), returns false if the search was cancelled
+    bool findAll(int begin, int end, const ResultFunction& results, const ProgressFunction& progress = {});
+
+    // find the nearest matching row after (forward) or before the start row, wrapping around
+    // at the end, the start row is checked last, -1 starts at the first or last row
+    // returns -1 if no row matches or the search was cancelled
+    int findNearest(int startRow, bool forward, const ProgressFunction& progress = {});
+
+    // stop the running search, can be called from any thread
+    void cancel() {
+        m_cancelled = true;
+    }
+
+    bool isCancelled() const {
+        return m_cancelled;
+    }
+
+    // number of messages not read, because the candidate function rejected them
+    quint64 getSkippedCount() const {
+        return m_skippedCount;
+    }
+
+    quint64 getRegexPrefilterRejectedCount() const;
+
+private:
+    using ChunkFunction = std::function<void(int chunk, const DltMessageMatcher& matcher, QDltMsg& msg)>;
+
+    bool matchRow(const DltMessageMatcher& matcher, QDltMsg& msg, int row);
+    void runWorkers(int chunkCount, const ChunkFunction& processChunk, const std::function<void()>& poll);
+
+    const QDltFile& m_file;
+    DltMessageMatcher m_matcher;
+    DltMessageMatcher::Pattern m_pattern;
+    CandidateFunction m_candidate;
+
+    QDltPluginManager* m_pluginManager{nullptr};
+    bool m_silentMode{true};
+
+    int m_threadCount{0};
+    int m_chunkSize;
+
+    // the matchers of the worker threads of the last search
+    QVector<DltMessageMatcher> m_matchers;
+
+    // workers do not take chunks after this one
+    std::atomic<int> m_chunkLimit{0};
+    std::atomic<int> m_checkedRows{0};
+    std::atomic<quint64> m_skippedCount{0};
+    std::atomic<bool> m_cancelled{false};
+};
+
+#endif // DLTSEARCHENGINE_H
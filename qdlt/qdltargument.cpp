@@ -75,7 +75,7 @@ QString QDltArgument::getTypeInfoString() const
     return qDltTypeInfo[typeInfo];
 }
 
-bool QDltArgument::setArgument(QByteArray &payload,unsigned int &offset, QDlt::DltEndiannessDef _endianess)
+bool QDltArgument::setArgument(const QByteArray &payload,unsigned int &offset, QDlt::DltEndiannessDef _endianess)
 {
     unsigned short length=0,length2=0,length3=0;
 
@@ -379,15 +379,22 @@ void QDltArgument::clear()
 QString QDltArgument::toString(bool binary) const
 {
     QString text;
-    text.reserve(1024);
 
+    appendToString(text, binary);
+
+    return text;
+}
+
+void QDltArgument::appendToString(QString &text, bool binary) const
+{
     if(binary) {
-        return QDlt::toAscii(data);
+        QDlt::appendHex(text, data.constData(), data.size());
+        return;
     }
 
     switch(getTypeInfo()) {
     case DltTypeInfoUnknown:
-        text += QString("?");
+        text += QLatin1Char('?');
         break;
     // for legacy reasons dlt-viewer does not make a difference between formally ASCII-only and UTF8 strings
     // both are handled as UTF8-encoded
@@ -395,45 +402,57 @@ QString QDltArgument::toString(bool binary) const
     case DltTypeInfoStrg:
     case DltTypeInfoUtf8:
         if(data.size()) {
-            text += QString::fromUtf8(data);
+            // same length as QString::fromUtf8(data), ASCII strings are appended without conversion
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+            const int length = data.size();
+#else
+            const int length = static_cast<int>(qstrnlen(data.constData(), data.size()));
+#endif
+            bool ascii = true;
+            for(int num = 0; ascii && num < length; num++)
+                ascii = (static_cast<uchar>(data.constData()[num]) < 0x80);
+            if(ascii)
+                text += QLatin1String(data.constData(), length);
+            else
+                text += QString::fromUtf8(data.constData(), length);
         }
         break;
     case DltTypeInfoBool:
         if(data.size()) {
             if(data.constData()[0])
-                text += QString("true");
+                text += QLatin1String("true");
             else
-                text += QString("false");
+                text += QLatin1String("false");
         }
         else
-            text += QString("?");
+            text += QLatin1Char('?');
         break;
     case DltTypeInfoSInt:
         switch(data.size())
         {
         case 1:
-            text += QString("%1").arg((short)(*(char*)(data.constData())));
+            QDlt::appendNumber(text, (qlonglong)(*(char*)(data.constData())));
             break;
         case 2:
             if(endianness == QDlt::DltEndiannessLittleEndian)
-                text += QString("%1").arg((short)(*(short*)(data.constData())));
+                QDlt::appendNumber(text, (qlonglong)(*(short*)(data.constData())));
             else
-                text += QString("%1").arg((short)DLT_SWAP_16((short)(*(short*)(data.constData()))));
+                QDlt::appendNumber(text, (qlonglong)(short)DLT_SWAP_16((short)(*(short*)(data.constData()))));
             break;
         case 4:
             if(endianness == QDlt::DltEndiannessLittleEndian)
-                text += QString("%1").arg((int)(*(int*)(data.constData())));
+                QDlt::appendNumber(text, (qlonglong)(*(int*)(data.constData())));
             else
-                text += QString("%1").arg((int)DLT_SWAP_32((int)(*(int*)(data.constData()))));
+                QDlt::appendNumber(text, (qlonglong)(int)DLT_SWAP_32((int)(*(int*)(data.constData()))));
             break;
         case 8:
             if(endianness == QDlt::DltEndiannessLittleEndian)
-                text += QString("%1").arg((long long)(*(long long*)(data.constData())));
+                QDlt::appendNumber(text, (qlonglong)(*(long long*)(data.constData())));
             else
-                text += QString("%1").arg((long long)DLT_SWAP_64((long long)(*(long long*)(data.constData()))));
+                QDlt::appendNumber(text, (qlonglong)DLT_SWAP_64((long long)(*(long long*)(data.constData()))));
             break;
         default:
-            text += QString("?");
+            text += QLatin1Char('?');
         }
 
         break;
@@ -461,28 +480,28 @@ QString QDltArgument::toString(bool binary) const
             switch(data.size())
             {
             case 1:
-                text += QString("%1").arg((unsigned short)(*(unsigned char*)(data.constData())));
+                QDlt::appendNumber(text, (qulonglong)(*(unsigned char*)(data.constData())));
                 break;
             case 2:
                 if(endianness == QDlt::DltEndiannessLittleEndian)
-                    text += QString("%1").arg((unsigned short)(*(unsigned short*)(data.constData())));
+                    QDlt::appendNumber(text, (qulonglong)(*(unsigned short*)(data.constData())));
                 else
-                    text += QString("%1").arg((unsigned short)DLT_SWAP_16((unsigned short)(*(unsigned short*)(data.constData()))));
+                    QDlt::appendNumber(text, (qulonglong)(unsigned short)DLT_SWAP_16((unsigned short)(*(unsigned short*)(data.constData()))));
                 break;
             case 4:
                 if(endianness == QDlt::DltEndiannessLittleEndian)
-                    text += QString("%1").arg((unsigned int)(*(unsigned int*)(data.constData())));
+                    QDlt::appendNumber(text, (qulonglong)(*(unsigned int*)(data.constData())));
                 else
-                    text += QString("%1").arg((unsigned int)DLT_SWAP_32((unsigned int)(*(unsigned int*)(data.constData()))));
+                    QDlt::appendNumber(text, (qulonglong)(unsigned int)DLT_SWAP_32((unsigned int)(*(unsigned int*)(data.constData()))));
                 break;
             case 8:
                 if(endianness == QDlt::DltEndiannessLittleEndian)
-                    text += QString("%1").arg((unsigned long long)(*(unsigned long long*)(data.constData())));
+                    QDlt::appendNumber(text, (qulonglong)(*(unsigned long long*)(data.constData())));
                 else
-                    text += QString("%1").arg((unsigned long long)DLT_SWAP_64((unsigned long long)(*(unsigned long long*)(data.constData()))));
+                    QDlt::appendNumber(text, (qulonglong)DLT_SWAP_64((unsigned long long)(*(unsigned long long*)(data.constData()))));
                 break;
             default:
-                text += QString("?");
+                text += QLatin1Char('?');
             }
         }
         break;
@@ -491,38 +510,36 @@ QString QDltArgument::toString(bool binary) const
         {
         case 4:
             if(endianness == QDlt::DltEndiannessLittleEndian)
-                text += QString("%1").arg((double)(*(float*)(data.constData())), 0, 'f', 8);
+                QDlt::appendFixed(text, (double)(*(float*)(data.constData())), 8);
             else
             {
                 const auto tmp = DLT_SWAP_32((unsigned int)(*(unsigned int*)(data.constData())));
                 void *buf = (void *) &tmp;
-                text += QString("%1").arg((double)(*((float*)buf)), 0, 'f', 8);
+                QDlt::appendFixed(text, (double)(*((float*)buf)), 8);
             }
             break;
         case 8:
             if(endianness == QDlt::DltEndiannessLittleEndian)
-                text += QString("%1").arg((double)(*(double*)(data.constData())), 0, 'f', 8);
+                QDlt::appendFixed(text, (double)(*(double*)(data.constData())), 8);
             else {
                 const auto tmp = DLT_SWAP_64((unsigned long long)(*(unsigned long long*)(data.constData())));
                 void *buf = (void *) &tmp;
-                text += QString("%1").arg((double)(*((double*)buf)), 0, 'f', 8);
+                QDlt::appendFixed(text, (double)(*((double*)buf)), 8);
             }
             break;
         default:
-            text += QString("?");
+            text += QLatin1Char('?');
         }
         break;
     case DltTypeInfoRawd:
-        text += QDlt::toAscii(data,0); // show raw format (no leading 0x)
+        QDlt::appendHex(text, data.constData(), data.size()); // show raw format (no leading 0x)
         break;
     case DltTypeInfoTrai:
-        text += QString("?");
+        text += QLatin1Char('?');
         break;
     default:
-        text += QString("?");
+        text += QLatin1Char('?');
     }
-
-    return text;
 }
 
 QVariant QDltArgument::getValue() const
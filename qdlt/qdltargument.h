@@ -153,7 +153,7 @@ public:
       \param _endianess The new endianness of the argument
       \return The name of the unit of the variable.
     */
-    bool setArgument(QByteArray &payload,unsigned int &offset, QDlt::DltEndiannessDef _endianess);
+    bool setArgument(const QByteArray &payload,unsigned int &offset, QDlt::DltEndiannessDef _endianess);
 
     //! Get argument as byte array and appends it to data.
     /*!
@@ -170,6 +170,15 @@ public:
     */
     QString toString(bool binary = false) const;
 
+    //! Append argument content to a string.
+    /*!
+      Same text as toString(), but written into a string provided by the caller, which can be
+      reused for many arguments without allocating memory again.
+      \param text string the argument text is appended to
+      \param binary if true write parameter as  Hex, if false translate into text
+    */
+    void appendToString(QString &text, bool binary = false) const;
+
     //! Clears all variables of the class.
     void clear();
 
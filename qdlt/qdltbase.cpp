@@ -21,7 +21,8 @@
 
 #include "qdltbase.h"
 
-#include <vector>
+#include <charconv>
+#include <cmath>
 
 QString QDlt::toAsciiTable(const QByteArray &bytes, bool withLineNumber, bool withBinary, bool withAscii, int blocksize, int linesize, bool toHtml)
 {
@@ -174,30 +175,77 @@ QString QDlt::toAscii(const QByteArray &bytes, int type,int size_bytes)
 
         if (0xff == size_bytes)
         {
-            std::vector<char> str( size*3, ' ' );
-
-            char* strData = &str[0];
-            const char* byteData = bytes.data();
-            static const char hexmap[16] = {'0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f'};
-            for(int num=0;num<size;++num)
-            {
-                *strData = hexmap[ (*byteData & 0xF0) >> 4 ];
-                ++strData;
-                *strData = hexmap[ *byteData & 0x0F ];
-                if((((num+1)%1)==0) && (num!=size-1))
-                    strData += 2;
-                else
-                    strData += 1;
-                ++byteData;
-            }
-            // add termination
-            if (size>0)
-            {
-                *(strData) = 0;
-            }
-            return QString( &str[0] );
+            QString text;
+            appendHex(text, bytes.constData(), size);
+            return text;
         }
     }
     return QString("");
 }
 
+void QDlt::appendHex(QString &text, const char *bytes, int size)
+{
+    static const char hexmap[16] = {'0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f'};
+
+    if(size <= 0)
+        return;
+
+    const int start = text.size();
+    text.resize(start + size * 3 - 1);
+    QChar *out = text.data() + start;
+    for(int num = 0; num < size; num++)
+    {
+        const uchar byte = static_cast<uchar>(bytes[num]);
+        if(num != 0)
+            *out++ = QLatin1Char(' ');
+        *out++ = QLatin1Char(hexmap[byte >> 4]);
+        *out++ = QLatin1Char(hexmap[byte & 0x0f]);
+    }
+}
+
+void QDlt::appendPrintable(QString &text, const char *bytes, int size)
+{
+    if(size <= 0)
+        return;
+
+    const int start = text.size();
+    text.resize(start + size);
+    QChar *out = text.data() + start;
+    for(int num = 0; num < size; num++)
+    {
+        const char ch = bytes[num];
+        *out++ = QLatin1Char(((ch >= ' ') && (ch <= '~')) ? ch : '-');
+    }
+}
+
+void QDlt::appendNumber(QString &text, qlonglong value)
+{
+    char buffer[24];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    text.append(QLatin1String(buffer, static_cast<int>(result.ptr - buffer)));
+}
+
+void QDlt::appendNumber(QString &text, qulonglong value)
+{
+    char buffer[24];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    text.append(QLatin1String(buffer, static_cast<int>(result.ptr - buffer)));
+}
+
+void QDlt::appendFixed(QString &text, double value, int precision)
+{
+#if defined(__cpp_lib_to_chars)
+    // both are exact for usual values, very large values and nan are left to Qt to keep its notation
+    if(std::isfinite(value) && std::fabs(value) < 1e15 && precision >= 0 && precision <= 17)
+    {
+        char buffer[48];
+        const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, precision);
+        if(result.ec == std::errc())
+        {
+            text.append(QLatin1String(buffer, static_cast<int>(result.ptr - buffer)));
+            return;
+        }
+    }
+#endif
+    text += QString("%1").arg(value, 0, 'f', precision);
+}
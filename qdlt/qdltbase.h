@@ -57,6 +57,41 @@ public:
     */
     static QString toAscii(const QByteArray &bytes, int type = false, int size_bytes = 0xff);
 
+    //! Append bytes in hex format separated by spaces to a string.
+    /*!
+      Same output as toAscii() in hex format for raw data, but without temporary strings.
+      \param text The string the output is appended to
+      \param bytes The data to be converted
+      \param size The number of bytes
+    */
+    static void appendHex(QString &text, const char *bytes, int size);
+
+    //! Append bytes as printable ASCII characters to a string.
+    /*!
+      Other characters are written as '-', like in the ASCII output of toAsciiTable().
+      \param text The string the output is appended to
+      \param bytes The data to be converted
+      \param size The number of bytes
+    */
+    static void appendPrintable(QString &text, const char *bytes, int size);
+
+    //! Append a number in decimal format to a string, without temporary strings.
+    /*!
+      \param text The string the output is appended to
+      \param value The number to be converted
+    */
+    static void appendNumber(QString &text, qlonglong value);
+    static void appendNumber(QString &text, qulonglong value);
+
+    //! Append a floating point number in fixed format to a string.
+    /*!
+      Same output as QString::arg() with format 'f', but without temporary strings for usual values.
+      \param text The string the output is appended to
+      \param value The number to be converted
+      \param precision The number of digits after the decimal point
+    */
+    static void appendFixed(QString &text, double value, int precision);
+
     //! The endianness of the message.
     enum DltEndiannessDef { DltEndiannessUnknown = -2, DltEndiannessLittleEndian = 0, DltEndiannessBigEndian = 1 };
 };
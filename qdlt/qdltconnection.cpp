@@ -21,6 +21,8 @@
 
 #include <QtDebug>
 
+#include <cstring>
+
 #include "qdltconnection.h"
 
 extern "C"
@@ -28,7 +30,120 @@ extern "C"
 #include "dlt_common.h"
 }
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(_M_AMD64)
+#define QDLT_CONNECTION_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+
+/* initial capacity of the receive buffer, data is received in blocks much smaller than this */
+const int receiveBufferCapacity = 1024 * 1024;
+
+const char serialHeader[4] = { 'D', 'L', 'S', 0x01 };
+
+int findSerialHeaderScalar(const char *data, int size)
+{
+    int num = 0;
+
+    while(num + 3 < size)
+    {
+        const char *found = static_cast<const char *>(memchr(data + num, 'D', size - 3 - num));
+        if(!found)
+            return -1;
+        num = found - data;
+        if(data[num + 1] == 'L' && data[num + 2] == 'S' && data[num + 3] == 0x01)
+            return num;
+        num++;
+    }
+
+    return -1;
+}
+
+/* find the serial header "DLS\x01", the same way as QDltStorageHeaderScanner finds storage headers */
+int findSerialHeader(const char *data, int size)
+{
+    int num = 0;
+
+#if defined(QDLT_CONNECTION_SSE2)
+    const __m128i patternD = _mm_set1_epi8('D');
+    const __m128i patternL = _mm_set1_epi8('L');
+    const __m128i patternS = _mm_set1_epi8('S');
+    const __m128i version1 = _mm_set1_epi8(0x01);
+
+    // compare 16 candidate positions at once, the remaining pattern bytes are only loaded if a 'D' was found
+    for(; num + 16 + 3 <= size; num += 16)
+    {
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + num));
+        const __m128i matchD = _mm_cmpeq_epi8(d, patternD);
+        if(!_mm_movemask_epi8(matchD))
+            continue;
+        const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + num + 1));
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + num + 2));
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + num + 3));
+        const __m128i match = _mm_and_si128(
+            _mm_and_si128(matchD, _mm_cmpeq_epi8(l, patternL)),
+            _mm_and_si128(_mm_cmpeq_epi8(s, patternS), _mm_cmpeq_epi8(v, version1)));
+        const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(match));
+        if(mask)
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return num + static_cast<int>(index);
+#else
+            return num + __builtin_ctz(mask);
+#endif
+        }
+    }
+#endif
+
+    const int found = findSerialHeaderScalar(data + num, size - num);
+    return (found < 0) ? -1 : num + found;
+}
+
+/* number of bytes at the end of the data, which can be the start of a serial header */
+int serialHeaderPrefix(const char *data, int size)
+{
+    for(int length = qMin(3, size); length > 0; length--)
+    {
+        if(memcmp(data + size - length, serialHeader, length) == 0)
+            return length;
+    }
+    return 0;
+}
+
+/* length of a DLT message from its standard header, -1 if the header is not complete, 0 if it is invalid */
+int messageLength(const char *data, int size, bool supportDLTv2)
+{
+    if(size < 1)
+        return -1;
+
+    const int versionNumber = (static_cast<unsigned char>(data[0]) & 0xe0) >> 5;
+    if(!supportDLTv2 || versionNumber == 1)
+    {
+        if(size < static_cast<int>(sizeof(DltStandardHeader)))
+            return -1;
+        const int length = (static_cast<unsigned char>(data[2]) << 8) | static_cast<unsigned char>(data[3]);
+        return (length < static_cast<int>(sizeof(DltStandardHeader))) ? 0 : length;
+    }
+    if(versionNumber == 2)
+    {
+        /* header type 4 bytes, message counter 1 byte, length 2 bytes */
+        if(size < 7)
+            return -1;
+        const int length = (static_cast<unsigned char>(data[5]) << 8) | static_cast<unsigned char>(data[6]);
+        return (length < 7) ? 0 : length;
+    }
+    return 0;
+}
+
+}
+
 QDltConnection::QDltConnection()
+    : tail(0),
+      dataView(nullptr, 0)
 {
     sendSerialHeader = false;
     syncSerialHeader = false;
@@ -63,8 +178,9 @@ bool QDltConnection::getSyncSerialHeader() const
 
 void QDltConnection::clear()
 {
-    data.clear();
-    dataView.align(data);
+    /* the capacity of the buffer is kept */
+    tail = 0;
+    dataView = QDltDataView(buffer.constData(), 0);
     bytesReceived = 0;
     bytesError = 0;
     syncFound = 0;
@@ -73,127 +189,144 @@ void QDltConnection::clear()
 
 void QDltConnection::add(const QByteArray &bytes)
 {
-    bytesReceived += bytes.size();
+    memcpy(reserve(bytes.size()), bytes.constData(), bytes.size());
+    commit(bytes.size());
+}
 
-    QByteArray dataViewArray = dataView;
-    data = dataViewArray + bytes;
+char *QDltConnection::reserve(int size)
+{
+    if(buffer.size() - tail < size)
+    {
+        const int pending = dataView.size();
+        if(pending + size > buffer.size())
+        {
+            QByteArray larger(qMax(qMax(buffer.size() * 2, pending + size), receiveBufferCapacity), Qt::Uninitialized);
+            if(pending > 0)
+                memcpy(larger.data(), dataView.constData(), pending);
+            buffer.swap(larger);
+        }
+        else if(pending > 0)
+        {
+            memmove(buffer.data(), dataView.constData(), pending);
+        }
+        tail = pending;
+        dataView = QDltDataView(buffer.constData(), tail);
+    }
 
-    dataView.align(data);
+    return buffer.data() + tail;
 }
 
-bool QDltConnection::parseDlt(QDltMsg &msg , bool supportDLTv2)
+void QDltConnection::commit(int size)
 {
-    /* if sync to serial header search for header */
-    int found = 0;
-    int firstPos = 0;
-    int secondPos = 0;
+    bytesReceived += size;
 
-    char lastFound = 0;
+    tail += size;
+    dataView = QDltDataView(dataView.constData(), dataView.size() + size);
+}
 
-    /* Use primitive buffer for faster access */
-    int cbuf_sz = dataView.size();
-    const char *cbuf = dataView.constData();
+bool QDltConnection::parseDlt(QDltMsg &msg , bool supportDLTv2)
+{
+    for(;;)
+    {
+        int firstPos = 0;
 
-    /* find marker in buffer */
-    for(int num=0;num<cbuf_sz;num++) {
-        if(cbuf[num] == 'D')
+        if(syncSerialHeader)
         {
-            lastFound = 'D';
-        }
-        else if(lastFound == 'D' && cbuf[num] == 'L')
-        {
-            lastFound = 'L';
+            /* skip everything before the next serial header */
+            const int pos = findSerialHeader(dataView.constData(), dataView.size());
+            if(pos < 0)
+            {
+                /* complete sync header not found, only keep a possible start of it */
+                const int skip = dataView.size() - serialHeaderPrefix(dataView.constData(), dataView.size());
+                bytesError += skip;
+                dataView.advance(skip);
+                return false;
+            }
+            bytesError += pos;
+            dataView.advance(pos);
+            firstPos = 4;
         }
-        else if(lastFound == 'L' && cbuf[num] == 'S')
+        else if(dataView.size() >= 4 && memcmp(dataView.constData(), serialHeader, 4) == 0)
         {
-            lastFound = 'S';
+            firstPos = 4;
         }
-        else if(lastFound == 'S' && cbuf[num] == 0x01)
+
+        const char *cbuf = dataView.constData();
+        const int size = dataView.size();
+
+        /* the length is taken from the header, while in sync the next message starts directly behind */
+        const int length = messageLength(cbuf + firstPos, size - firstPos, supportDLTv2);
+        if(length < 0 || (length > 0 && firstPos + length > size))
         {
-            /* header found */
-            found++;
-            if(found==1)
+            /* message not completely received */
+            if(syncSerialHeader)
             {
-                firstPos = num+1;
-                syncFound++;
+                /* a message interrupted by the next serial header is dropped */
+                const int next = findSerialHeader(cbuf + firstPos, size - firstPos);
+                if(next >= 0)
+                {
+                    syncFound++;
+                    bytesError += firstPos + next;
+                    dataView.advance(firstPos + next);
+                    continue;
+                }
             }
-            if(found==2)
+            else if(size > DLT_MAX_MESSAGE_LEN)
             {
-                secondPos = num+1;
-                break;
+                /* size exceeds max DLT message size */
+                bytesError += size;
+                dataView.clear();
             }
-            lastFound = 0;
+            return false;
         }
-        else
+
+        if(syncSerialHeader && length > 0)
         {
-            lastFound = 0;
+            /* in sync the next serial header follows directly, otherwise the message may be interrupted by it */
+            const int behind = qMin(4, size - firstPos - length);
+            if(memcmp(cbuf + firstPos + length, serialHeader, behind) != 0)
+            {
+                const int next = findSerialHeader(cbuf + firstPos, qMin(size - firstPos, length + 3));
+                if(next >= 0)
+                {
+                    syncFound++;
+                    bytesError += firstPos + next;
+                    dataView.advance(firstPos + next);
+                    continue;
+                }
+            }
         }
-        if((!syncSerialHeader) && num==3)
-            break;
-    }
 
-    if(syncSerialHeader && !found)
-    {
-        /* complete sync header not found */
-        if(!lastFound)
+        if(length > 0 && msg.setMsg(dataView.mid(firstPos, length), false, supportDLTv2))
         {
-            /* clear buffer if even not start of sync header found */
-            bytesError += dataView.size();
-            dataView.clear();
+            /* msg read successful */
+            if(firstPos > 0)
+                syncFound++;
+            dataView.advance(firstPos + length);
+            return true;
         }
-        return false;
-    }
-
-    //qDebug() << "found " << found << " firstPos " << firstPos << " secondPos " << secondPos;
 
-    if(found==2)
-    {
-        /* two sync headers found */
-        /* try to read msg */
-        if(!msg.setMsg(dataView.mid(firstPos,secondPos-firstPos-4),false,supportDLTv2))
+        /* invalid message */
+        if(syncSerialHeader)
         {
-            /* no valid msg found, perhaps to short */
-            dataView.advance(secondPos-4);
-            /* errors found */
-            bytesError += secondPos-4;
-            return false;
+            /* search the next serial header */
+            syncFound++;
+            bytesError += firstPos;
+            dataView.advance(firstPos);
         }
-        else
+        else if(length > 0)
         {
-            /* msg read successful */
-            dataView.advance(secondPos-4);
-            if(firstPos>4)
-                /* errors found */
-                bytesError += firstPos-4;
-            return true;
+            bytesError += firstPos + length;
+            dataView.advance(firstPos + length);
         }
-
-    }
-
-    if(firstPos>4)
-        /* errors found */
-        bytesError += firstPos-4;
-
-    /* try to read msg */
-    if(!msg.setMsg(dataView.mid(firstPos),false,supportDLTv2))
-    {
-        /* no complete msg found */
-        /* perhaps not completely received */
-        /* check valid size */
-        if(dataView.size()>DLT_MAX_MESSAGE_LEN)
+        else
         {
-            /* size exceeds max DLT message size */
-            /* clear buffer */
-            /* errors found */
-            bytesError += dataView.size();
+            /* the start of the next message cannot be found without serial header */
+            bytesError += size;
             dataView.clear();
+            return false;
         }
-        return false;
     }
-
-    /* msg read successful */
-    dataView.advance(firstPos+msg.getHeaderSize()+msg.getPayloadSize());
-    return true;
 }
 
 bool QDltConnection::parseAscii(QDltMsg &msg)
@@ -73,7 +73,7 @@ public:
 
     const char* data() { return m_data + m_position; }
     const char* constData() { return m_data + m_position; }
-    int size() { return m_size - m_position; }
+    int size() const { return m_size - m_position; }
     void clear() { m_position = m_size; }
 
 private:
@@ -104,8 +104,24 @@ public:
     void clear();
     void add(const QByteArray &bytes);
 
-    QByteArray data;
-    QDltDataView dataView = {data};
+    //! Get space at the end of the receive buffer to receive data directly into it.
+    /*!
+      The data not parsed yet is moved to the start of the buffer, when the space
+      behind it is too small. The buffer only grows, when the data not parsed yet
+      and the requested space do not fit into it.
+      \param size Number of bytes to be received.
+      eturn Pointer to the space, valid until the next call of reserve(), add() or clear().
+    */
+    char *reserve(int size);
+
+    //! Add the data received into the space returned by reserve().
+    /*!
+      \param size Number of bytes received.
+    */
+    void commit(int size);
+
+    //! Get the number of received bytes not parsed yet.
+    int available() const { return dataView.size(); }
 
     unsigned long bytesReceived;
     unsigned long bytesError;
@@ -120,6 +136,15 @@ private:
 
     unsigned char messageCounter;
 
+    //! Receive buffer, its size is the capacity.
+    QByteArray buffer;
+
+    //! End of the received data in the buffer.
+    int tail;
+
+    //! The received data not parsed yet, it always ends at tail.
+    QDltDataView dataView;
+
 };
 
 #endif // QDLT_CONNECTION_H
@@ -22,13 +22,75 @@
 #include <QFile>
 #include <QtDebug>
 
+#include <algorithm>
+
+#ifndef Q_OS_WIN
+#include <errno.h>
+#include <unistd.h>
+#endif
+
 #include "qdltfile.h"
+#include "qdltstorageheaderscanner.h"
 
 extern "C"
 {
 #include "dlt_common.h"
 }
 
+//! The index of the DLT log files as seen by the readers.
+struct QDltFileSnapshot
+{
+    struct File
+    {
+        QDltFileItem *item;
+        QDltFileIndex index;
+        qint64 size;
+        QVector<QDltFileMapping> mappings;
+    };
+
+    QVector<File> files;
+    int size;
+};
+
+void QDltFileIndex::append(qint64 pos)
+{
+    /* the chunks are only read with at(), so a vector shared with a snapshot is not detached */
+    if((count & (ChunkSize - 1)) == 0 && (count >> ChunkBits) == chunks.size())
+        chunks.append(std::shared_ptr<qint64>(new qint64[ChunkSize], std::default_delete<qint64[]>()));
+    chunks.at(count >> ChunkBits).get()[count & (ChunkSize - 1)] = pos;
+    count++;
+}
+
+void QDltFileIndex::append(const QVector<qint64> &positions)
+{
+    for(qint64 pos : positions)
+        append(pos);
+}
+
+void QDltFileIndex::clear()
+{
+    /* snapshots still using the chunks keep them */
+    chunks.clear();
+    count = 0;
+}
+
+int QDltFileIndex::lowerBound(qint64 pos) const
+{
+    int first = 0;
+    int last = count;
+
+    while(first < last)
+    {
+        const int middle = first + (last - first) / 2;
+        if(at(middle) < pos)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    return first;
+}
+
 QDltFile::QDltFile()
 {
     filterFlag = false;
@@ -37,6 +99,12 @@ QDltFile::QDltFile()
 
     cache.setMaxCost(1000);
     cacheEnable = true;
+
+    memoryMappingEnabled = true;
+    dltv2Support = false;
+
+    snapshot = nullptr;
+    snapshotReaders = 0;
 }
 
 QDltFile::~QDltFile()
@@ -68,18 +136,109 @@ bool QDltFile::getDLTv2Support() const
     return dltv2Support;
 }
 
+void QDltFile::setMemoryMappingEnabled(bool enable)
+{
+    memoryMappingEnabled = enable;
+}
+
+bool QDltFile::getMemoryMappingEnabled() const
+{
+    return memoryMappingEnabled;
+}
+
 void QDltFile::clear()
 {
+    /* cached messages may point into the mapped files */
+    cache.clear();
+    deleteSnapshots();
+
     for(int num=0;num<files.size();num++)
     {
+        for(const QDltFileMapping &mapping : files[num]->mappings + files[num]->truncatedMappings)
+            files[num]->infile.unmap(const_cast<uchar*>(mapping.data));
+        files[num]->mappings.clear();
+        files[num]->truncatedMappings.clear();
+
+        qDeleteAll(files[num]->readHandles);
+        files[num]->readHandles.clear();
+
         if(files[num]->infile.isOpen()) {
              files[num]->infile.close();
         }
         delete(files[num]);
     }
     files.clear();
+}
 
-    cache.clear();
+void QDltFile::mapFile(QDltFileItem *item)
+{
+    /* Map the grown part of the file only when it is large enough, to limit the number of mapped parts */
+    static const qint64 MAP_MIN_GROWTH = 1024 * 1024;
+
+    if(!memoryMappingEnabled || item->mappingFailed || !item->infile.isOpen())
+        return;
+
+    const qint64 mappedEnd = item->mappings.isEmpty() ? 0 : item->mappings.last().offset + item->mappings.last().size;
+    if(item->size <= mappedEnd || (mappedEnd > 0 && item->size - mappedEnd < qMax(mappedEnd / 32, MAP_MIN_GROWTH)))
+        return;
+
+    /* the message continued behind the mapped parts is mapped again with the new part */
+    qint64 offset = mappedEnd;
+    const int next = item->indexAll.lowerBound(mappedEnd);
+    if(next > 0 && (next == item->indexAll.size() || item->indexAll.at(next) > mappedEnd))
+        offset = item->indexAll.at(next - 1);
+
+    uchar *data = item->infile.map(offset, item->size - offset);
+    if(!data)
+    {
+        /* continue with seek and read */
+        qDebug() << "Memory mapping of file" << item->infile.fileName() << "failed:" << item->infile.errorString();
+        item->mappingFailed = true;
+        return;
+    }
+
+    item->mappings.append({data, offset, item->size - offset});
+}
+
+void QDltFile::publishSnapshot()
+{
+    QDltFileSnapshot *newSnapshot = new QDltFileSnapshot;
+    newSnapshot->size = 0;
+    for(QDltFileItem *item : files)
+    {
+        /* the file is mapped here and not by the readers */
+        mapFile(item);
+        newSnapshot->files.append({item, item->indexAll, item->size, item->mappings});
+        newSnapshot->size += item->indexAll.size();
+    }
+
+    /* a reader registers before it loads the snapshot, if there is none now, no reader can use a replaced one */
+    const QDltFileSnapshot *oldSnapshot = snapshot.exchange(newSnapshot);
+    if(oldSnapshot)
+        retiredSnapshots.append(oldSnapshot);
+    if(snapshotReaders.load() == 0)
+    {
+        qDeleteAll(retiredSnapshots);
+        retiredSnapshots.clear();
+    }
+}
+
+const QDltFileSnapshot *QDltFile::acquireSnapshot() const
+{
+    snapshotReaders++;
+    return snapshot.load();
+}
+
+void QDltFile::releaseSnapshot() const
+{
+    snapshotReaders--;
+}
+
+void QDltFile::deleteSnapshots()
+{
+    delete snapshot.exchange(nullptr);
+    qDeleteAll(retiredSnapshots);
+    retiredSnapshots.clear();
 }
 
 int QDltFile::getNumberOfFiles() const
@@ -94,18 +253,152 @@ void QDltFile::setDltIndex(QVector<qint64> &_indexAll, int num)
         return;
     }
 
-    files[num]->indexAll = _indexAll;
+    mutexQDlt.lock();
+    files[num]->indexAll.clear();
+    files[num]->indexAll.append(_indexAll);
+    files[num]->size = files[num]->infile.size();
+    publishSnapshot();
+    mutexQDlt.unlock();
 }
 
-int QDltFile::size() const
+void QDltFile::setMetadataIndex(const QDltMetadataIndex &metadata, int num)
 {
-    int size=0;
-    for(int num=0;num<files.size();num++)
+    if(num<0 || num>=files.size())
     {
-      if (nullptr!=files[num])
-         size += files[num]->indexAll.size();
+        return;
+    }
+
+    files[num]->metadata = metadata;
+}
+
+const QDltMetadataIndex &QDltFile::getMetadataIndex(int num) const
+{
+    static const QDltMetadataIndex empty;
+
+    if(num<0 || num>=files.size())
+    {
+        return empty;
+    }
+
+    return files[num]->metadata;
+}
+
+bool QDltFile::hasMetadataIndex() const
+{
+    for(const QDltFileItem *item : files)
+    {
+        if(!item->metadata.isValid() || item->metadata.size() != item->indexAll.size())
+            return false;
+    }
+
+    return !files.isEmpty();
+}
+
+void QDltFile::setTextBlockIndex(const QDltTextBlockIndex &textBlocks, int num)
+{
+    if(num<0 || num>=files.size())
+    {
+        return;
+    }
+
+    files[num]->textBlocks = textBlocks;
+}
+
+const QDltTextBlockIndex &QDltFile::getTextBlockIndex(int num) const
+{
+    static const QDltTextBlockIndex empty;
+
+    if(num<0 || num>=files.size())
+    {
+        return empty;
+    }
+
+    return files[num]->textBlocks;
+}
+
+bool QDltFile::hasTextBlockIndex(const QByteArray &renderKey) const
+{
+    for(const QDltFileItem *item : files)
+    {
+        if(item->textBlocks.size() != item->indexAll.size() || item->textBlocks.getRenderKey() != renderKey)
+            return false;
+    }
+
+    return !files.isEmpty();
+}
+
+bool QDltFile::mayContainText(int index, const QDltTextBlockIndex::Query &query) const
+{
+    for(const QDltFileItem *item : files)
+    {
+        if(index < item->indexAll.size())
+            return item->textBlocks.mayContain(index, query);
+        index -= item->indexAll.size();
+    }
+
+    return true;
+}
+
+void QDltFile::setFullTextIndex(const QDltFullTextIndex &fullText, int num)
+{
+    if(num<0 || num>=files.size())
+    {
+        return;
+    }
+
+    files[num]->fullText = fullText;
+}
+
+const QDltFullTextIndex &QDltFile::getFullTextIndex(int num) const
+{
+    static const QDltFullTextIndex empty;
+
+    if(num<0 || num>=files.size())
+    {
+        return empty;
     }
 
+    return files[num]->fullText;
+}
+
+bool QDltFile::hasFullTextIndex(const QByteArray &renderKey) const
+{
+    for(const QDltFileItem *item : files)
+    {
+        if(item->fullText.size() != item->indexAll.size() || item->fullText.getRenderKey() != renderKey)
+            return false;
+    }
+
+    return !files.isEmpty();
+}
+
+bool QDltFile::findFullText(const QStringList &texts, QBitArray &candidates) const
+{
+    QVector<int> found;
+    int offset = 0;
+
+    candidates.fill(false, size());
+    for(const QDltFileItem *item : files)
+    {
+        if(!item->fullText.findAll(texts, found))
+        {
+            candidates.clear();
+            return false;
+        }
+        for(int num : found)
+            candidates.setBit(offset + num);
+        offset += item->indexAll.size();
+    }
+
+    return true;
+}
+
+int QDltFile::size() const
+{
+    const QDltFileSnapshot *current = acquireSnapshot();
+    const int size = current ? current->size : 0;
+    releaseSnapshot();
+
     return size;
 }
 
@@ -153,15 +446,26 @@ bool QDltFile::open(QString _filename, bool append)
         return false;
     }
 
+    mutexQDlt.lock();
+    item->size = item->infile.size();
+    publishSnapshot();
+    mutexQDlt.unlock();
+
     return true;
 }
 
 void QDltFile::clearIndex()
 {
+    mutexQDlt.lock();
     for(int num=0;num<files.size();num++)
     {
         files[num]->indexAll.clear();
+        files[num]->metadata.clear();
+        files[num]->textBlocks.clear();
+        files[num]->fullText.clear();
     }
+    publishSnapshot();
+    mutexQDlt.unlock();
 }
 
 bool QDltFile::createIndex()
@@ -203,13 +507,25 @@ bool QDltFile::updateIndex()
             return false;
         }
 
+        /* the messages behind the end of a truncated file are gone, index the file again */
+        qint64 file_size = files[numFile]->infile.size();
+        if(file_size < files[numFile]->size)
+        {
+            qDebug() << "updateIndex: File was truncated" << files[numFile]->infile.fileName();
+            while(!files[numFile]->mappings.isEmpty() &&
+                  files[numFile]->mappings.last().offset + files[numFile]->mappings.last().size > file_size)
+                files[numFile]->truncatedMappings.append(files[numFile]->mappings.takeLast());
+            files[numFile]->indexAll.clear();
+            files[numFile]->metadata.clear();
+            files[numFile]->textBlocks.clear();
+            files[numFile]->fullText.clear();
+        }
 
         /* start at last found position */
         if(files[numFile]->indexAll.size())
         {
             /* move behind last found position */
-            const QVector<qint64>* const_indexAll = &(files[numFile]->indexAll);
-            pos = (*const_indexAll)[files[numFile]->indexAll.size()-1];
+            pos = files[numFile]->indexAll.last();
 
             // first move to beginnng of last found message
             files[numFile]->infile.seek(pos);
@@ -242,11 +558,10 @@ bool QDltFile::updateIndex()
 
             // move just behind the next expected message
             pos += (last_message_length - 1);
-            files[numFile]->infile.seek(pos);
         }
         else {
             /* the file was empty the last call */
-            files[numFile]->infile.seek(0);
+            pos = 0;
         }
 
         /* Align kbytes, 1MB read at a time */
@@ -254,16 +569,11 @@ bool QDltFile::updateIndex()
 
         /* walk through the whole file and find all DLT0x01 markers */
         /* store the found positions in the indexAll */
-        char lastFound = 0;
-        qint64 current_message_pos = 0;
-        qint64 next_message_pos = 0;
-        int counter_header = 0;
-        quint16 message_length = 0;
-        qint64 file_size = files[numFile]->infile.size();
-        qint64 errors_in_file  = 0;
+        QDltStorageHeaderScanner scanner(file_size);
+        QVector<qint64> found;
 
         quint8 progressNextCmdOutput=10;
-        while(true)
+        while(!scanner.isFinished())
         {
             if( (file_size>0) && ((pos*100/file_size)>=progressNextCmdOutput))
             {
@@ -272,153 +582,67 @@ bool QDltFile::updateIndex()
             }
 
             /* read buffer from file */
+            files[numFile]->infile.seek(pos);
             buf = files[numFile]->infile.read(READ_BUF_SZ);
             if(buf.isEmpty())
                 break; // EOF
 
-            /* Use primitive buffer for faster access */
-            int cbuf_sz = buf.size();
-            const char *cbuf = buf.constData();
-
-            /* find marker in buffer */
-            for(int num=0;num<cbuf_sz;num++) {
-                // search length of DLT message
-                if(counter_header>0)
-                {
-                    counter_header++;
-                    if(storageLength==13 && counter_header==13)
-                    {
-                        storageLength += ((unsigned char)cbuf[num]) + 1;
-                    }
-                    else if (counter_header==storageLength)
-                    {
-                        // Read DLT protocol version
-                        version = (((unsigned char)cbuf[num])&0xe0)>>5;
-                        if(version==1)
-                        {
-                            lengthOffset = 2;
-                        }
-                        else if(version==2)
-                        {
-                            lengthOffset = 5;
-                        }
-                        else
-                        {
-                            lengthOffset = 2;  // default
-                        }
-                    }
-                    else if (counter_header==(storageLength+lengthOffset)) // was 16
-                    {
-                        // Read low byte of message length
-                        message_length = (unsigned char)cbuf[num];
-                    }
-                    else if (counter_header==(storageLength+1+lengthOffset)) // was 17
-                    {
-                        // Read high byte of message length
-                        counter_header = 0;
-                        message_length = (message_length<<8 | ((unsigned char)cbuf[num])) + storageLength;
-                        next_message_pos = current_message_pos + message_length;
-                        if(next_message_pos==file_size)
-                        {
-                            // last message found in file
-                            files[numFile]->indexAll.append(current_message_pos);
-                            break;
-                        }
-                        // speed up move directly to next message, if inside current buffer
-                        if((message_length > storageLength+2+lengthOffset)) // was 20
-                        {
-                            if((num+message_length-(storageLength+2+lengthOffset)<cbuf_sz))  // was 20
-                            {
-                                num+=message_length-(storageLength+2+lengthOffset);  // was 20
-                            }
-                        }
-                    }
-                }
-                else if(cbuf[num] == 'D')
-                {
-                    lastFound = 'D';
-                }
-                else if(lastFound == 'D' && cbuf[num] == 'L')
-                {
-                    lastFound = 'L';
-                }
-                else if(lastFound == 'L' && cbuf[num] == 'T')
-                {
-                    lastFound = 'T';
-                }
-                else if(lastFound == 'T' && (cbuf[num] == 0x01 || cbuf[num] == 0x02))
-                {
-                    if(next_message_pos == 0)
-                    {
-                        // first message detected or first message after error
-                        current_message_pos = pos+num-3;
-                        counter_header = 3;
-                        if(cbuf[num] == 0x01)
-                            storageLength = 16;
-                        else
-                            storageLength = 13;
-                        if(current_message_pos!=0)
-                        {
-                            // first messages not at beginning or error occurred before
-                            errors_in_file++;
-                        }
-                        // speed up move directly to message length, if inside current buffer
-                        if(num+9<cbuf_sz)
-                        {
-                            num+=9;
-                            counter_header+=9;
-                        }
-                    }
-                    else if( next_message_pos == (pos+num-3) )
-                    {
-                        // Add message only when it is in the correct position in relationship to the last message
-                        files[numFile]->indexAll.append(current_message_pos);
-                        current_message_pos = pos+num-3;
-                        counter_header = 3;
-                        if(cbuf[num] == 0x01)
-                            storageLength = 16;
-                        else
-                            storageLength = 13;
-                        // speed up move directly to message length, if inside current buffer
-                        if(num+9<cbuf_sz)
-                        {
-                            num+=9;
-                            counter_header+=9;
-                        }
-                    }
-                    else if(next_message_pos > (pos+num-3))
-                    {
-                        // Header detected before end of message
-                    }
-                    else
-                    {
-                        // Header detected after end of message
-                        // start search for new message back after last header found
-                        files[numFile]->infile.seek(current_message_pos+4);
-                        pos = current_message_pos+4;
-                        buf = files[numFile]->infile.read(READ_BUF_SZ);
-                        cbuf_sz = buf.size();
-                        cbuf = buf.constData();
-                        num=0;
-                        next_message_pos = 0;
-                    }
-                    lastFound = 0;
-                }
-                else
-                {
-                    lastFound = 0;
-                }
-            }
-            pos += cbuf_sz;
+            /* find messages in buffer, the scanner returns where to continue */
+            pos = scanner.scanBlock(buf.constData(), buf.size(), pos, found);
         }
+        files[numFile]->indexAll.append(found);
+        files[numFile]->size = file_size;
     }
 
+    publishSnapshot();
     mutexQDlt.unlock();
 
     /* success */
     return true;
 }
 
+bool QDltFile::appendIndex(qint64 pos, const QDltMsg *msg)
+{
+    mutexQDlt.lock();
+
+    if(files.isEmpty())
+    {
+        mutexQDlt.unlock();
+        return false;
+    }
+
+    QDltFileItem *item = files.last();
+    if(!item->indexAll.isEmpty() && pos <= item->indexAll.last())
+    {
+        mutexQDlt.unlock();
+        return false;
+    }
+
+    /* keep a complete metadata index complete, so filters can still use it */
+    if(item->metadata.size() == item->indexAll.size())
+    {
+        if(msg)
+            item->metadata.append(*msg);
+        else
+            item->metadata.appendInvalid();
+    }
+    item->indexAll.append(pos);
+    item->size = qMax(item->size, item->infile.size());
+    publishSnapshot();
+
+    mutexQDlt.unlock();
+
+    return true;
+}
+
+qint64 QDltFile::getLastIndexPos() const
+{
+    if(files.isEmpty() || files.last()->indexAll.isEmpty())
+        return -1;
+
+    return files.last()->indexAll.last();
+}
+
 
 bool QDltFile::createIndexFilter()
 {
@@ -546,6 +770,60 @@ void QDltFile::close()
     clear();
 }
 
+qint64 QDltFile::readAt(QDltFileItem *item, char *data, qint64 size, qint64 pos) const
+{
+    qint64 length = 0;
+
+#ifndef Q_OS_WIN
+    /* positional read on the shared file descriptor */
+    int fd = item->infile.handle();
+    if(fd != -1)
+    {
+        while(length < size)
+        {
+            ssize_t result = pread(fd, data + length, static_cast<size_t>(size - length), static_cast<off_t>(pos + length));
+            if(result < 0 && errno == EINTR)
+                continue;
+            if(result < 0)
+                return -1;
+            if(result == 0)
+                break; // EOF
+            length += result;
+        }
+        return length;
+    }
+#endif
+
+    /* take a file handle, which is not used by any other reader */
+    QFile *handle = nullptr;
+    item->readHandlesMutex.lock();
+    if(!item->readHandles.isEmpty())
+        handle = item->readHandles.takeLast();
+    item->readHandlesMutex.unlock();
+
+    if(!handle)
+    {
+        handle = new QFile(item->infile.fileName());
+        if(!handle->open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+        {
+            qDebug() << "open of file" << handle->fileName() << "failed" << __FILE__ << __LINE__;
+            delete handle;
+            return -1;
+        }
+    }
+
+    if(handle->seek(pos))
+        length = handle->read(data, size);
+    else
+        length = -1;
+
+    item->readHandlesMutex.lock();
+    item->readHandles.append(handle);
+    item->readHandlesMutex.unlock();
+
+    return length;
+}
+
 QByteArray QDltFile::getMsg(int index) const
 {
     QByteArray buf;
@@ -561,112 +839,116 @@ QByteArray QDltFile::getMsg(int index) const
         return QByteArray();
     }
 
-    for( num=0; num < files.size(); num++ )
+    /* the snapshot is replaced, but not changed by updateIndex() and appendIndex() */
+    const QDltFileSnapshot *current = acquireSnapshot();
+    struct SnapshotRelease
     {
-        if(index < files[num]->indexAll.size())
+        const QDltFile *file;
+        ~SnapshotRelease() { file->releaseSnapshot(); }
+    } snapshotRelease{this};
+
+    if(!current)
+    {
+        qDebug() << "getMsg: No file opened in" << __FILE__ << "line" << __LINE__;
+        /* return empty data buffer */
+        return QByteArray();
+    }
+
+    for( num=0; num < current->files.size(); num++ )
+    {
+        if(index < current->files[num].index.size())
             break;
         else
-            index -= files[num]->indexAll.size();
+            index -= current->files[num].index.size();
     }
 
-    if(num >= files.size())
+    if(num >= current->files.size())
     {
      qDebug() << "getMsg: Index is out of range in" << __FILE__ << "line" << __LINE__;
      /* return empty data buffer */
      return QByteArray();
     }
 
+    const QDltFileSnapshot::File &snapshotFile = current->files[num];
+    QDltFileItem* file = snapshotFile.item;
+
     /* check if file is already opened */
-    if(false == files[num]->infile.isOpen())
+    if(false == file->infile.isOpen())
     {
         /* return empty buffer */
-        qDebug() << "getMsg: Infile is not open" << files[num]->infile.fileName() << __FILE__ << "line" << __LINE__;
+        qDebug() << "getMsg: Infile is not open" << file->infile.fileName() << __FILE__ << "line" << __LINE__;
 
         /* return empty data buffer */
         return QByteArray();
     }
 
-    mutexQDlt.lock();
+    const qint64 positionForIndex = snapshotFile.index.at(index);
+    const bool lastMessage = (index == (snapshotFile.index.size()-1));
 
-    QDltFileItem* file = files[num];
-    const QDltFileItem* const_file = file;
-    qint64 positionForIndex = const_file->indexAll[index];
+    /* get the end of the message, the last message ends at the end of the file when it was indexed */
+    const qint64 positionNext = lastMessage ? snapshotFile.size : snapshotFile.index.at(index+1);
 
-    /* move to file position selected by index */
-    if ( false == file->infile.seek(positionForIndex) )
-    {
-        qDebug() << "Seek error on " << positionForIndex << file->infile.fileName() << __FILE__ << __LINE__;
-        mutexQDlt.unlock();
-        buf.clear();
-        return buf;
-    }
+    /* return a view on the memory mapped file, no copy needed */
+    /* the mapped parts stay valid until the file is closed, the message is in the last part starting in front of it */
+    const QVector<QDltFileMapping> &mappings = snapshotFile.mappings;
+    const auto mapping = std::upper_bound(mappings.cbegin(), mappings.cend(), positionForIndex,
+        [](qint64 pos, const QDltFileMapping &part) { return pos < part.offset; });
+    if(memoryMappingEnabled && mapping != mappings.cbegin() && positionNext > positionForIndex &&
+       positionNext <= (mapping - 1)->offset + (mapping - 1)->size)
+        return QByteArray::fromRawData(reinterpret_cast<const char*>((mapping - 1)->data + (positionForIndex - (mapping - 1)->offset)),
+                                       static_cast<int>(positionNext - positionForIndex));
 
     /* read DLT message from file */
-    if(index == (file->indexAll.size()-1))
+    long int cal_index = positionNext - positionForIndex;
+    if ( cal_index < 0 )
     {
-        /* last message in file */
-        long int cal_index = file->infile.size() - positionForIndex;
-
-        if ( cal_index < 0 )
-            qDebug() << "Negativ index " << cal_index << index << "in" << file->infile.fileName() << __LINE__ << "of" << __FILE__;
-        else
-         buf = file->infile.read(file->infile.size() - positionForIndex);
+        qDebug() << "Negativ index " << cal_index << index << "in" << file->infile.fileName() << __LINE__ << "of" << __FILE__;
+        return buf;
     }
-    else
+
+    buf.resize(static_cast<int>(cal_index));
+    qint64 length = readAt(file, buf.data(), cal_index, positionForIndex);
+    if ( length < 0 )
     {
-        /* any other file position */
-        long int cal_index = const_file->indexAll[index+1] - positionForIndex;
-        if ( cal_index < 0 )
-            qDebug() << "Negativ index " << cal_index << index << "in" << __LINE__ << "of" << __FILE__;
-        else
-         buf = file->infile.read(cal_index);
+        qDebug() << "Read error on " << positionForIndex << file->infile.fileName() << __FILE__ << __LINE__;
+        buf.clear();
+        return buf;
     }
-
-    mutexQDlt.unlock();
+    buf.resize(static_cast<int>(length));
 
     /* return DLT message buffer */
     return buf;
 }
 
-bool QDltFile::getMsg(int index,QDltMsg &msg)
+bool QDltFile::getMsg(int index,QDltMsg &msg,bool lazyArguments)
 {
     bool result;
     QDltMsg *cacheMsg;
 
     // check if msg is already in cache
-    if(cacheEnable)
+    if(cacheEnable && cache.get(index, msg))
     {
-        mutexQDlt.lock();
-        cacheMsg = cache[index];
-        if(cacheMsg)
-        {
-            // load from cache
-            msg = *cacheMsg;
-            mutexQDlt.unlock();
-            return true;
-        }
-        mutexQDlt.unlock();
+        // loaded from cache
+        return true;
     }
 
     // load message from DLT file
     QByteArray data = getMsg(index);
     if(data.isEmpty())
         return false;
-    result = msg.setMsg(data,true,dltv2Support);
+    result = msg.setMsg(data,true,dltv2Support,lazyArguments);
     msg.setIndex(index);
 
-    // store msg in cache
-    if(cacheEnable && result)
+    // store msg in cache, a message with lazily parsed arguments could still turn out to be invalid
+    if(cacheEnable && result && !lazyArguments)
     {
         cacheMsg = new QDltMsg();
         *cacheMsg = msg;
-        mutexQDlt.lock();
         if(!cache.insert(index,cacheMsg))
         {
             // object deleted already by insert function
             // delete cacheMsg;
         }
-        mutexQDlt.unlock();
     }
 
     return result;
@@ -25,19 +25,84 @@
 #include "export_rules.h"
 #include "qdltfilter.h"
 #include "qdltfilterlist.h"
+#include "qdltmetadataindex.h"
+#include "qdlttextblockindex.h"
+#include "qdltfulltextindex.h"
 #include "qdltmsg.h"
+#include "qdltshardedcache.hpp"
 
+#include <QBitArray>
 #include <QObject>
 #include <QString>
 #include <QFile>
 #include <QDateTime>
 #include <QMutex>
 #include <time.h>
-#include <QCache>
+
+#include <atomic>
+#include <memory>
+
+//! A memory mapped part of a DLT log file.
+struct QDltFileMapping
+{
+    const uchar *data;
+    qint64 offset;
+    qint64 size;
+};
+
+//! Positions of the DLT messages in a DLT log file.
+/*!
+  The positions are stored in chunks of fixed size, which are shared by the
+  copies of the index. Appending to the index neither moves nor changes the
+  positions seen by a copy, so a copy can be read by other threads while
+  positions are appended to the original.
+*/
+class QDLT_EXPORT QDltFileIndex
+{
+public:
+    QDltFileIndex() : count(0) {}
+
+    //! Get the number of positions.
+    int size() const { return count; }
+
+    //! Check if the index contains no position.
+    bool isEmpty() const { return count == 0; }
+
+    //! Get the position of a message, the number must be smaller than size().
+    qint64 at(int num) const { return chunks.at(num >> ChunkBits).get()[num & (ChunkSize - 1)]; }
+
+    //! Get the position of the last message, the index must not be empty.
+    qint64 last() const { return at(count - 1); }
+
+    //! Append the position of a message.
+    void append(qint64 pos);
+
+    //! Append the positions of several messages.
+    void append(const QVector<qint64> &positions);
+
+    //! Remove all positions, copies of the index keep their positions.
+    void clear();
+
+    //! Get the number of the first message at or behind a position.
+    /*!
+      \param pos The position in the file.
+      \return The number of the message, size() if all messages are in front of the position.
+    */
+    int lowerBound(qint64 pos) const;
+
+private:
+    static const int ChunkBits = 16;
+    static const int ChunkSize = 1 << ChunkBits;
+
+    QVector<std::shared_ptr<qint64>> chunks;
+    int count;
+};
 
 class QDLT_EXPORT QDltFileItem
 {
 public:
+    QDltFileItem() : size(0), mappingFailed(false) {}
+
     //! DLT log file.
     QFile infile;
 
@@ -45,14 +110,66 @@ public:
     /*!
       Index contains positions of beginning of DLT messages in DLT log file.
     */
-    QVector<qint64> indexAll;
+    QDltFileIndex indexAll;
+
+    //! Size of the DLT log file when the index was updated, the end of the last message.
+    qint64 size;
+
+    //! Header fields of the DLT messages in indexAll.
+    /*!
+      Only complete if it has the same size as indexAll.
+    */
+    QDltMetadataIndex metadata;
+
+    //! Trigram Bloom filters of the text of blocks of the DLT messages in indexAll.
+    /*!
+      Only complete if it has the same size as indexAll.
+    */
+    QDltTextBlockIndex textBlocks;
+
+    //! Inverted index of the words of the text of the DLT messages in indexAll.
+    /*!
+      Only complete if it has the same size as indexAll.
+    */
+    QDltFullTextIndex fullText;
+
+    //! Memory mapped parts of the DLT log file, sorted by their offset.
+    /*!
+      When the file grows, only the part behind the mapped parts is mapped,
+      beginning with the message continued in it. So each message lies
+      completely in one part and no part is ever replaced.
+    */
+    QVector<QDltFileMapping> mappings;
+
+    //! Mapped parts behind the end of the file after it was truncated.
+    /*!
+      Messages read before may still point into them, so they are only
+      released when the file is closed.
+    */
+    QVector<QDltFileMapping> truncatedMappings;
 
+    //! Mapping the file failed, e.g. because of missing address space.
+    std::atomic<bool> mappingFailed;
+
+    //! Additional handles of the DLT log file for concurrent positional reads.
+    /*!
+      Only used on platforms without pread(), each reader takes a handle from
+      the list while reading, so no two readers share a file position.
+    */
+    QList<QFile*> readHandles;
+
+    //! Mutex to lock the list of read handles.
+    QMutex readHandlesMutex;
 };
 
+struct QDltFileSnapshot;
+
 //! Access to a DLT log file.
 /*!
   This class provide access to DLT log file.
-  This class is currently not thread safe.
+  Reading messages with getMsg() is thread safe and does not block other readers.
+  Readers use a snapshot of the index, which is replaced when the index is updated.
+  Opening files, indexing and changing filters is not thread safe.
 */
 class QDLT_EXPORT QDltFile : public QDlt
 {
@@ -109,6 +226,86 @@ public:
     */
     void setDltIndex(QVector<qint64> &_indexAll, int num = 0);
 
+    //! Sets the metadata index of all DLT messages.
+    /*!
+      \param metadata Header fields of the messages in the index of all DLT messages
+      \param num The number of the file
+    */
+    void setMetadataIndex(const QDltMetadataIndex &metadata, int num = 0);
+
+    //! Get the metadata index of all DLT messages.
+    /*!
+      \param num The number of the file
+      \return The metadata index, empty if not created for this file
+    */
+    const QDltMetadataIndex &getMetadataIndex(int num = 0) const;
+
+    //! Check if the metadata index of all files is complete.
+    /*!
+      \return true if the metadata index of each file has a row for every message
+    */
+    bool hasMetadataIndex() const;
+
+    //! Sets the text block index of all DLT messages.
+    /*!
+      \param textBlocks Trigram Bloom filters of the text of the messages in the index of all DLT messages
+      \param num The number of the file
+    */
+    void setTextBlockIndex(const QDltTextBlockIndex &textBlocks, int num = 0);
+
+    //! Get the text block index of all DLT messages.
+    /*!
+      \param num The number of the file
+      \return The text block index, empty if not created for this file
+    */
+    const QDltTextBlockIndex &getTextBlockIndex(int num = 0) const;
+
+    //! Check if the text block index of all files is complete and was created with the same text rendering.
+    /*!
+      \param renderKey The key of the current text rendering of the messages
+      \return true if the text block index of each file has an entry for every message
+    */
+    bool hasTextBlockIndex(const QByteArray &renderKey) const;
+
+    //! Check if the text of a message may contain the literals of a query.
+    /*!
+      Call only if hasTextBlockIndex() returned true for the same rendering.
+      \param index The index of the message in the index of all DLT messages
+      \param query The query of the literals
+      \return false if the text block index proves, that the message does not contain all literals
+    */
+    bool mayContainText(int index, const QDltTextBlockIndex::Query &query) const;
+
+    //! Sets the full text index of all DLT messages.
+    /*!
+      \param fullText Inverted index of the words of the text of the messages in the index of all DLT messages
+      \param num The number of the file
+    */
+    void setFullTextIndex(const QDltFullTextIndex &fullText, int num = 0);
+
+    //! Get the full text index of all DLT messages.
+    /*!
+      \param num The number of the file
+      \return The full text index, empty if not created for this file
+    */
+    const QDltFullTextIndex &getFullTextIndex(int num = 0) const;
+
+    //! Check if the full text index of all files is complete and was created with the same text rendering.
+    /*!
+      \param renderKey The key of the current text rendering of the messages
+      \return true if the full text index of each file has an entry for every message
+    */
+    bool hasFullTextIndex(const QByteArray &renderKey) const;
+
+    //! Find the messages which may contain all texts with the full text index.
+    /*!
+      Call only if hasFullTextIndex() returned true for the same rendering.
+      \param texts The search texts
+      \param candidates Set for each message of the index of all DLT messages, which may contain all texts
+      \return false if no text can be searched with the full text index
+    */
+    bool findFullText(const QStringList &texts, QBitArray &candidates) const;
+
     //! Clears the internal index of all DLT messages.
     /*!
     */
@@ -122,10 +319,30 @@ public:
 
     //! Update the index of the currently opened DLT log file by checking if new DLT messages were added to the file.
     /*!
+      A file, which was truncated, is indexed again. Messages of a truncated file
+      must not be read before its index was updated.
       \return true if the operation was successful, false if an error occurred.
     */
     bool updateIndex();
 
+    //! Append a message written to the end of the last file to the index.
+    /*!
+      Used for live logging instead of updateIndex(), when the position of the
+      written message is known, so the file does not need to be read again.
+      The message must directly follow the last message in the index.
+      A complete metadata index stays complete.
+      \param pos The position of the message in the file.
+      \param msg The parsed message for the metadata index, nullptr if it could not be parsed.
+      \return false if no file is open or the position is not behind the last message.
+    */
+    bool appendIndex(qint64 pos, const QDltMsg *msg);
+
+    //! Get the position of the last message in the index of the last file.
+    /*!
+      \return The position in the file, -1 if the index is empty.
+    */
+    qint64 getLastIndexPos() const;
+
     //! Create an internal index of all filtered DLT messages of the currently opened DLT log file.
     /*!
       \return true if the operation was successful, false if an error occurred.
@@ -143,12 +360,16 @@ public:
       This function retrieves on DLT message of the log file
       \param index The number of the DLT message in the DLT file starting from zero.
       \param msg The message which contains the DLT message after the function returns.
+      \param lazyArguments Parse the arguments when they are needed, see QDltMsg::setMsg().
+      Such messages are not stored in the message cache.
       \return true if the message is valid, false if an error occurred.
     */
-    bool getMsg(int index,QDltMsg &msg);
+    bool getMsg(int index,QDltMsg &msg,bool lazyArguments = false);
 
     //! Get one DLT message of the DLT log file selected by index
     /*!
+      If memory mapping is enabled, the returned byte array is a view on the mapped file,
+      which is only valid until the file is closed.
       \param index position of the DLT message in the log file up to the number DLT messages in the file
       \return Byte array containing the complete DLT message.
     */
@@ -293,6 +514,19 @@ public:
      **/
     void setDLTv2Support(bool dltv2Support);
 
+    //! Enable or disable reading the DLT log files through memory mapping
+    /*!
+     * Reading from the mapping needs no lock and no copy of the data.
+     * \param enable true to use memory mapping, false to read with seek and read
+     **/
+    void setMemoryMappingEnabled(bool enable);
+
+    //! Get the memory mapping setting
+    /*!
+     * \return true if memory mapping is used
+     **/
+    bool getMemoryMappingEnabled() const;
+
     //! Gets DLTv2 support setting
     /*!
      * \return DLTv2 Support
@@ -312,9 +546,51 @@ public:
 protected:
 
 private:
-    //! Mutex to lock critical path for infile
+    //! Map the DLT log file into memory or map the part it has grown by.
+    /*!
+      Must be called with mutexQDlt locked or before the file is accessed by other threads.
+      \param item The file to be mapped.
+    */
+    void mapFile(QDltFileItem *item);
+
+    //! Publish the current index and mappings of all files to the readers.
+    /*!
+      Must be called with mutexQDlt locked after the index was changed.
+      Replaced snapshots are deleted as soon as no reader uses a snapshot.
+    */
+    void publishSnapshot();
+
+    //! Get the latest snapshot, releaseSnapshot() must be called when it is no longer used.
+    const QDltFileSnapshot *acquireSnapshot() const;
+
+    //! Release a snapshot got by acquireSnapshot().
+    void releaseSnapshot() const;
+
+    //! Delete all snapshots, no reader may use them.
+    void deleteSnapshots();
+
+    //! Read from a DLT log file at a position without changing the file position.
+    /*!
+      \param item The file to be read.
+      \param data The buffer to be filled.
+      \param size Number of bytes to read.
+      \param pos Position in the file.
+      \return Number of bytes read, -1 if an error occurred.
+    */
+    qint64 readAt(QDltFileItem *item, char *data, qint64 size, qint64 pos) const;
+
+    //! Mutex to lock critical path for infile, taken by the writers of the index
     mutable QMutex mutexQDlt;
 
+    //! Latest snapshot of the index, read by getMsg() without lock.
+    std::atomic<const QDltFileSnapshot*> snapshot;
+
+    //! Number of readers currently using a snapshot.
+    mutable std::atomic<int> snapshotReaders;
+
+    //! Replaced snapshots, which may still be used by readers.
+    QList<const QDltFileSnapshot*> retiredSnapshots;
+
     //!all files including indexes
     QList<QDltFileItem*> files;
 
@@ -348,9 +624,12 @@ private:
     */
     bool sortByTimestampFlag;
 
-    QCache<int,QDltMsg> cache;
+    QDltShardedCache<int,QDltMsg> cache;
     bool cacheEnable;
 
+    //! Read the DLT log files through memory mapping.
+    bool memoryMappingEnabled;
+
     //! DLTv2 Support.
     /*!
       true dltv2 support is enabled.
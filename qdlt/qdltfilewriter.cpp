@@ -0,0 +1,426 @@
+#include "qdltfilewriter.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+// default flush policies, a busy ECU fills the buffer within a few milliseconds
+const qint64 defaultFlushBytes = 1024 * 1024;
+const int defaultFlushMessages = 10000;
+const int defaultFlushMilliseconds = 100;
+
+// the writer of the messages waits, when the file system cannot keep up
+const qint64 minBufferLimit = 4 * 1024 * 1024;
+
+// write the data of the file to the storage device, the file size is synced too
+bool syncFile(QFileDevice *file)
+{
+    const int fd = file->handle();
+    if(fd == -1)
+        return false;
+
+#if defined(Q_OS_WIN)
+    return FlushFileBuffers(reinterpret_cast<HANDLE>(_get_osfhandle(fd)));
+#elif defined(Q_OS_LINUX)
+    return fdatasync(fd) == 0;
+#else
+    return fsync(fd) == 0;
+#endif
+}
+
+}
+
+QDltFileWriter::QDltFileWriter()
+    : device(nullptr)
+    , flushBytes(defaultFlushBytes)
+    , flushMessages(defaultFlushMessages)
+    , flushMilliseconds(defaultFlushMilliseconds)
+    , bufferedMessages(0)
+    , keepWritten(false)
+    , startSize(0)
+    , appendedBytes(0)
+    , writtenBytes(0)
+    , flushTarget(0)
+    , syncedBytes(0)
+    , writeCount(0)
+    , stopRequested(false)
+    , failed(false)
+{
+}
+
+QDltFileWriter::~QDltFileWriter()
+{
+    close();
+}
+
+void QDltFileWriter::setFlushPolicy(qint64 bytes, int messages, int milliseconds)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    flushBytes = bytes;
+    flushMessages = messages;
+    flushMilliseconds = milliseconds;
+    wake.notify_one();
+}
+
+void QDltFileWriter::setWrittenCallback(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    writtenCallback = std::move(callback);
+}
+
+void QDltFileWriter::setKeepWrittenMessages(bool keep)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    keepWritten = keep;
+    if(!keep)
+    {
+        keptData.clear();
+        keptMessages.clear();
+    }
+}
+
+void QDltFileWriter::takeWrittenMessages(std::vector<char> &data, std::vector<WrittenMessage> &messages)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const qint64 end = startSize + static_cast<qint64>(writtenBytes);
+
+    // the messages are kept in the order of the file, the last ones may still be buffered
+    size_t count = 0;
+    size_t bytes = 0;
+    while(count < keptMessages.size() && keptMessages[count].pos + keptMessages[count].size <= end)
+    {
+        bytes += static_cast<size_t>(keptMessages[count].size);
+        count++;
+    }
+    if(count == 0)
+        return;
+
+    data.insert(data.end(), keptData.begin(), keptData.begin() + bytes);
+    messages.insert(messages.end(), keptMessages.begin(), keptMessages.begin() + count);
+    keptData.erase(keptData.begin(), keptData.begin() + bytes);
+    keptMessages.erase(keptMessages.begin(), keptMessages.begin() + count);
+}
+
+bool QDltFileWriter::open(const QString &fileName)
+{
+    close();
+
+    file.setFileName(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        qDebug() << "Failed opening WriteOnly" << fileName << file.errorString();
+        return false;
+    }
+
+    start(&file);
+    return true;
+}
+
+void QDltFileWriter::setDevice(QIODevice *device)
+{
+    close();
+
+    if(device)
+        start(device);
+}
+
+void QDltFileWriter::close()
+{
+    if(!device)
+        return;
+
+    flush();
+    stop();
+
+    if(device == &file)
+        file.close();
+    device = nullptr;
+}
+
+QString QDltFileWriter::getFileName() const
+{
+    return device == &file ? file.fileName() : QString();
+}
+
+qint64 QDltFileWriter::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return startSize + static_cast<qint64>(appendedBytes);
+}
+
+void QDltFileWriter::writeMessage(const DltStorageHeader &storageHeader, const QByteArray &header, std::string_view payload)
+{
+    if(!device)
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    const bool wasEmpty = buffer.empty();
+    const size_t size = buffer.size();
+
+    appendBytes(reinterpret_cast<const char*>(&storageHeader), sizeof(DltStorageHeader));
+    appendBytes(header.constData(), static_cast<size_t>(header.size()));
+    appendBytes(payload.data(), payload.size());
+
+    if(keepWritten)
+        keepMessage(size);
+    appendedBytes += buffer.size() - size;
+    bufferedMessages++;
+    added(lock, wasEmpty);
+}
+
+void QDltFileWriter::writeMessageV2(const DltStorageHeader &storageHeader, const QByteArray &ecuId, const QByteArray &header, std::string_view payload)
+{
+    if(!device)
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    const bool wasEmpty = buffer.empty();
+    const size_t size = buffer.size();
+
+    // version 2 storage header, the time values are not in big endian format
+    const quint8 version = 2;
+    const quint32 nanoseconds = storageHeader.microseconds * 1000ul;
+    const quint64 seconds = storageHeader.seconds;
+    const quint8 length = static_cast<quint8>(ecuId.size());
+    appendBytes("DLT", 3);
+    appendBytes(reinterpret_cast<const char*>(&version), 1);
+    appendBytes(reinterpret_cast<const char*>(&nanoseconds), 4);
+    appendBytes(reinterpret_cast<const char*>(&seconds), 5);
+    appendBytes(reinterpret_cast<const char*>(&length), 1);
+    appendBytes(ecuId.constData(), length);
+
+    appendBytes(header.constData(), static_cast<size_t>(header.size()));
+    appendBytes(payload.data(), payload.size());
+
+    if(keepWritten)
+        keepMessage(size);
+    appendedBytes += buffer.size() - size;
+    bufferedMessages++;
+    added(lock, wasEmpty);
+}
+
+void QDltFileWriter::write(const char *data, qint64 size)
+{
+    write(data, size, nullptr, 0);
+}
+
+void QDltFileWriter::write(const char *header, qint64 headerSize, const char *payload, qint64 payloadSize)
+{
+    headerSize = std::max<qint64>(headerSize, 0);
+    payloadSize = std::max<qint64>(payloadSize, 0);
+    if(!device || headerSize + payloadSize == 0)
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    const bool wasEmpty = buffer.empty();
+
+    appendBytes(header, static_cast<size_t>(headerSize));
+    appendBytes(payload, static_cast<size_t>(payloadSize));
+
+    // the header and the payload are one message for the flush policy
+    appendedBytes += static_cast<quint64>(headerSize + payloadSize);
+    bufferedMessages++;
+    added(lock, wasEmpty);
+}
+
+bool QDltFileWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if(!device)
+        return !failed;
+
+    flushTarget = appendedBytes;
+    wake.notify_one();
+    written.wait(lock, [this]() { return syncedBytes >= flushTarget; });
+
+    return !failed;
+}
+
+QString QDltFileWriter::errorString() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return error;
+}
+
+quint64 QDltFileWriter::getWriteCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return writeCount;
+}
+
+void QDltFileWriter::start(QIODevice *device)
+{
+    this->device = device;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    startSize = device->size();
+    appendedBytes = 0;
+    writtenBytes = 0;
+    flushTarget = 0;
+    syncedBytes = 0;
+    writeCount = 0;
+    bufferedMessages = 0;
+    buffer.clear();
+    keptData.clear();
+    keptMessages.clear();
+    stopRequested = false;
+    failed = false;
+    error.clear();
+
+    thread = std::thread(&QDltFileWriter::run, this);
+}
+
+void QDltFileWriter::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+        wake.notify_one();
+    }
+    if(thread.joinable())
+        thread.join();
+}
+
+bool QDltFileWriter::flushNeeded(std::chrono::steady_clock::time_point now) const
+{
+    // flush() waits until the written data is synced, even if nothing is buffered
+    if(buffer.empty())
+        return flushTarget > syncedBytes;
+
+    return stopRequested
+        || flushTarget > writtenBytes
+        || static_cast<qint64>(buffer.size()) >= bufferLimit()
+        || (flushBytes > 0 && static_cast<qint64>(buffer.size()) >= flushBytes)
+        || (flushMessages > 0 && bufferedMessages >= flushMessages)
+        || (flushMilliseconds > 0 && now >= bufferTime + std::chrono::milliseconds(flushMilliseconds));
+}
+
+qint64 QDltFileWriter::bufferLimit() const
+{
+    return std::max(minBufferLimit, 4 * flushBytes);
+}
+
+void QDltFileWriter::keepMessage(size_t offset)
+{
+    // the message was just appended to the buffer at the offset
+    keptData.insert(keptData.end(), buffer.begin() + offset, buffer.end());
+    keptMessages.push_back({startSize + static_cast<qint64>(appendedBytes), static_cast<int>(buffer.size() - offset)});
+}
+
+void QDltFileWriter::added(std::unique_lock<std::mutex> &lock, bool wasEmpty)
+{
+    if(wasEmpty)
+    {
+        // the thread starts waiting for the time policy with the first message
+        bufferTime = std::chrono::steady_clock::now();
+        wake.notify_one();
+    }
+    else if((flushBytes > 0 && static_cast<qint64>(buffer.size()) >= flushBytes) ||
+            (flushMessages > 0 && bufferedMessages == flushMessages))
+    {
+        wake.notify_one();
+    }
+
+    // limit the memory, when the file system cannot keep up
+    if(static_cast<qint64>(buffer.size()) >= bufferLimit())
+    {
+        wake.notify_one();
+        written.wait(lock, [this]() { return static_cast<qint64>(buffer.size()) < bufferLimit(); });
+    }
+}
+
+void QDltFileWriter::run()
+{
+    std::vector<char> writeBuffer;
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for(;;)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if(!flushNeeded(now))
+        {
+            if(stopRequested)
+                break;
+            if(!buffer.empty() && flushMilliseconds > 0)
+                wake.wait_until(lock, bufferTime + std::chrono::milliseconds(flushMilliseconds));
+            else
+                wake.wait(lock);
+            continue;
+        }
+
+        // new messages are added to the other buffer, while this one is written
+        const bool sync = flushTarget > syncedBytes;
+        writeBuffer.swap(buffer);
+        bufferedMessages = 0;
+        written.notify_all();
+        lock.unlock();
+
+        qint64 pos = 0;
+        const qint64 size = static_cast<qint64>(writeBuffer.size());
+        bool ok = true;
+        while(pos < size)
+        {
+            const qint64 bytes = device->write(writeBuffer.data() + pos, size - pos);
+            if(bytes <= 0)
+            {
+                ok = false;
+                break;
+            }
+            pos += bytes;
+        }
+        qint64 fileSize = -1;
+        bool syncFailed = false;
+        if(QFileDevice *fileDevice = qobject_cast<QFileDevice*>(device))
+        {
+            ok = fileDevice->flush() && ok;
+            // flush() waits for the data on the storage device, so it is synced by this thread
+            if(ok && sync && !syncFile(fileDevice))
+            {
+                ok = false;
+                syncFailed = true;
+            }
+            fileSize = fileDevice->size();
+        }
+        const QString writeError = ok ? QString() : syncFailed ? QString("Syncing the file failed") : device->errorString();
+        writeBuffer.clear();
+
+        lock.lock();
+        writtenBytes += static_cast<quint64>(size);
+        if(sync)
+            syncedBytes = writtenBytes;
+        if(ok && fileSize >= 0 && fileSize != startSize + static_cast<qint64>(writtenBytes))
+        {
+            // the file was written otherwise, the positions of the kept messages are wrong
+            qDebug() << "File changed by another writer" << fileSize - startSize - static_cast<qint64>(writtenBytes) << "bytes";
+            startSize = fileSize - static_cast<qint64>(writtenBytes);
+            keptData.clear();
+            keptMessages.clear();
+        }
+        if(size > 0)
+            writeCount++;
+        if(!ok)
+        {
+            qDebug() << "Failed writing DLT messages" << writeError;
+            failed = true;
+            error = writeError;
+        }
+        written.notify_all();
+
+        if(size > 0 && writtenCallback)
+        {
+            const std::function<void()> callback = writtenCallback;
+            lock.unlock();
+            callback();
+            lock.lock();
+        }
+    }
+}
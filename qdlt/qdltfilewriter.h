@@ -0,0 +1,177 @@
+#ifndef QDLTFILEWRITER_H
+#define QDLTFILEWRITER_H
+
+#include "export_rules.h"
+#include "dlt_common.h"
+
+#include <QFile>
+#include <QString>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+//! Write DLT messages to a file in large blocks from a background thread.
+/*!
+  The messages are formatted together with their storage header into a
+  buffer in memory. A background thread writes the buffer to the file, when
+  one of the flush policies is reached: the number of buffered bytes, the
+  number of buffered messages or the time since the first buffered message.
+  While the thread writes, new messages are added to a second buffer, so
+  writing messages is not blocked by the file system.
+  The messages are written by one thread, flush() writes all buffered
+  messages and waits until they are synced to the storage device. It must
+  be called before the file is used otherwise, e.g. copied or closed.
+  Optionally the written messages are kept in memory, so the reader of the
+  file can add them to its index without reading the file again.
+*/
+class QDLT_EXPORT QDltFileWriter
+{
+public:
+    //! A message kept after it was written to the file.
+    struct WrittenMessage
+    {
+        //! Position of the message in the file.
+        qint64 pos;
+        //! Size of the message including the storage header.
+        int size;
+    };
+
+    //! Constructor.
+    QDltFileWriter();
+
+    //! Destructor, writes the buffered messages and closes the file.
+    ~QDltFileWriter();
+
+    //! Set the flush policies, a value of 0 disables the policy.
+    /*!
+      \param bytes Number of buffered bytes.
+      \param messages Number of buffered messages.
+      \param milliseconds Time since the first buffered message.
+    */
+    void setFlushPolicy(qint64 bytes, int messages, int milliseconds);
+
+    //! Set a function called by the background thread after data was written to the file.
+    void setWrittenCallback(std::function<void()> callback);
+
+    //! Keep the messages written by writeMessage() and writeMessageV2() in memory.
+    /*!
+      The kept messages must be taken regularly with takeWrittenMessages(),
+      data added with write() is not kept.
+    */
+    void setKeepWrittenMessages(bool keep);
+
+    //! Take the kept messages, which are completely written to the file.
+    /*!
+      If the file was written otherwise, the size of the file differs from the
+      written data. The kept messages are dropped then, as their positions are
+      not known.
+      \param data The messages are appended one after the other including their storage headers.
+      \param messages The position and size of each message appended to data, in the order of the file.
+    */
+    void takeWrittenMessages(std::vector<char> &data, std::vector<WrittenMessage> &messages);
+
+    //! Open a file, the messages are appended to the existing content.
+    /*!
+      \return false if the file cannot be opened.
+    */
+    bool open(const QString &fileName);
+
+    //! Write to a device opened by the caller, the device is not closed by the writer.
+    /*!
+      The device must not be used by the caller, until the writer is closed.
+    */
+    void setDevice(QIODevice *device);
+
+    //! Write the buffered messages and close the file.
+    void close();
+
+    //! Check if a file or device is open.
+    bool isOpen() const { return device != nullptr; }
+
+    //! Get the name of the opened file, empty for devices.
+    QString getFileName() const;
+
+    //! Get the size of the file including the buffered messages.
+    qint64 size() const;
+
+    //! Add a message with a version 1 storage header.
+    void writeMessage(const DltStorageHeader &storageHeader, const QByteArray &header, std::string_view payload);
+
+    //! Add a message with a version 2 storage header, which contains the full ECU id.
+    void writeMessageV2(const DltStorageHeader &storageHeader, const QByteArray &ecuId, const QByteArray &header, std::string_view payload);
+
+    //! Add data, which is already formatted as DLT messages with storage header.
+    /*!
+      The data is counted as one message by the flush policy.
+    */
+    void write(const char *data, qint64 size);
+
+    //! Add one message, which is already formatted with storage header, from its header and payload.
+    /*!
+      \param header The storage header and the headers of the message.
+      \param headerSize The size of the headers.
+      \param payload The payload of the message.
+      \param payloadSize The size of the payload.
+    */
+    void write(const char *header, qint64 headerSize, const char *payload, qint64 payloadSize);
+
+    //! Write all buffered messages and wait until they are synced to the storage device.
+    /*!
+      The file is synced by the background thread, writes triggered by the
+      flush policies are only passed to the operating system.
+      \return false if writing or syncing failed since the file was opened.
+    */
+    bool flush();
+
+    //! Get the error of the last failed write.
+    QString errorString() const;
+
+    //! Get the number of writes to the file since it was opened.
+    quint64 getWriteCount() const;
+
+private:
+    void start(QIODevice *device);
+    void stop();
+    void run();
+    bool flushNeeded(std::chrono::steady_clock::time_point now) const;
+    qint64 bufferLimit() const;
+    void added(std::unique_lock<std::mutex> &lock, bool wasEmpty);
+    void appendBytes(const char *data, size_t size) { buffer.insert(buffer.end(), data, data + size); }
+    void keepMessage(size_t offset);
+
+    QFile file;
+    QIODevice *device;
+
+    qint64 flushBytes;
+    int flushMessages;
+    int flushMilliseconds;
+    std::function<void()> writtenCallback;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable written;
+    std::thread thread;
+
+    std::vector<char> buffer;
+    int bufferedMessages;
+    bool keepWritten;
+    std::vector<char> keptData;
+    std::vector<WrittenMessage> keptMessages;
+    std::chrono::steady_clock::time_point bufferTime;
+    qint64 startSize;
+    quint64 appendedBytes;
+    quint64 writtenBytes;
+    quint64 flushTarget;
+    quint64 syncedBytes;
+    quint64 writeCount;
+    bool stopRequested;
+    bool failed;
+    QString error;
+};
+
+#endif // QDLTFILEWRITER_H
@@ -82,6 +82,8 @@ QDltFilter& QDltFilter::operator= (QDltFilter const& _filter)
     payloadRegularExpression = _filter.payloadRegularExpression;
     contextRegularExpression = _filter.contextRegularExpression;
     appidRegularExpression   = _filter.appidRegularExpression;
+    headerRegexPrefilter     = _filter.headerRegexPrefilter;
+    payloadRegexPrefilter    = _filter.payloadRegexPrefilter;
 
     return *this;
 }
@@ -155,6 +157,15 @@ bool QDltFilter::compileRegexps()
         (ignoreCase_Payload ? QRegularExpression::CaseInsensitiveOption
                             : QRegularExpression::NoPatternOption));
 
+    // only texts containing the literals of an expression are matched by the expression,
+    // which is compiled with the JIT compiler now instead of at the first match
+    headerRegexPrefilter.setRegularExpression(headerRegularExpression);
+    payloadRegexPrefilter.setRegularExpression(payloadRegularExpression);
+    if(enableRegexp_Header)
+        headerRegularExpression.optimize();
+    if(enableRegexp_Payload)
+        payloadRegularExpression.optimize();
+
     return (headerRegularExpression.isValid() &&
             payloadRegularExpression.isValid() &&
             contextRegularExpression.isValid() &&
@@ -164,99 +175,113 @@ bool QDltFilter::compileRegexps()
 bool QDltFilter::match(const QDltMsg &msg) const
 {
 
-    if( (true == enableEcuid) && (msg.getEcuid() != ecuid))
+    if( (true == enableEcuid) && !matchEcuid(msg.getEcuid()) )
     {
         return false;
     }
 
-    if( true == enableRegexp_Appid )
+    if( (true == enableApid) && !matchApid(msg.getApid()) )
     {
-        if( (true == enableApid) && ( false == appidRegularExpression.match(msg.getApid()).hasMatch() ) )
-        {
-            return false;
-        }
-
+        return false;
     }
-    else
+
+    if( (true == enableCtid) && !matchCtid(msg.getCtid()) )
     {
-        if( (true == enableApid) && (msg.getApid() != apid))
-        {
-            return false;
-        }
+        return false;
     }
 
-    if(true == enableRegexp_Context)
+    if( (true == enableHeader) && !matchHeader(msg.toStringHeader()) )
     {
-        if( (true == enableCtid) && ( false == contextRegularExpression.match(msg.getCtid()).hasMatch() ) )
-        {
-            return false;
-        }
+        return false;
     }
-    else
+
+    if( (true == enablePayload) && !matchPayload(msg.toStringPayload()) )
     {
-        if( (true ==enableCtid) && ( false == msg.getCtid().contains(ctid) ) )
-        {
-            return false;
-        }
+        return false;
     }
 
-    if(true == enableRegexp_Header)
+    return matchMessageInfo(msg.getMessageId(),msg.getType(),msg.getSubtype());
+}
+
+bool QDltFilter::isMetadataFilter() const
+{
+    return !enableHeader && !enablePayload;
+}
+
+bool QDltFilter::matchEcuid(const QString &ecuid) const
+{
+    return ecuid == this->ecuid;
+}
+
+bool QDltFilter::matchApid(const QString &apid) const
+{
+    if( true == enableRegexp_Appid )
     {
-        if( (true == enableHeader) && ( false == headerRegularExpression.match(msg.toStringHeader()).hasMatch() ) )
-        {
-            return false;
-        }
+        return appidRegularExpression.match(apid).hasMatch();
     }
-    else
+
+    return apid == this->apid;
+}
+
+bool QDltFilter::matchCtid(const QString &ctid) const
+{
+    if(true == enableRegexp_Context)
     {
-        if( ( true == enableHeader ) && ( false == msg.toStringHeader().contains(header,ignoreCase_Header?Qt::CaseInsensitive:Qt::CaseSensitive)) )
-        {
-            return false;
-        }
+        return contextRegularExpression.match(ctid).hasMatch();
     }
 
-    if( true == enableRegexp_Payload)
+    return ctid.contains(this->ctid);
+}
+
+bool QDltFilter::matchHeader(const QString &text) const
+{
+    if(true == enableRegexp_Header)
     {
-        if( (true == enablePayload) && ( false == payloadRegularExpression.match(msg.toStringPayload()).hasMatch() ) )
-        {
-            return false;
-        }
+        return headerRegexPrefilter.mayMatch(text) && headerRegularExpression.match(text).hasMatch();
     }
-    else
+
+    return text.contains(header,ignoreCase_Header?Qt::CaseInsensitive:Qt::CaseSensitive);
+}
+
+bool QDltFilter::matchPayload(const QString &text) const
+{
+    if( true == enableRegexp_Payload)
     {
-        if( (true == enablePayload) && ( false == msg.toStringPayload().contains(payload,ignoreCase_Payload?Qt::CaseInsensitive:Qt::CaseSensitive)) )
-        {
-            return false;
-        }
+        return payloadRegexPrefilter.mayMatch(text) && payloadRegularExpression.match(text).hasMatch();
     }
 
+    return text.contains(payload,ignoreCase_Payload?Qt::CaseInsensitive:Qt::CaseSensitive);
+}
+
+bool QDltFilter::matchMessageInfo(unsigned int messageId, int type, int subtype) const
+{
     if (true == enableMessageId)
     {
         if (messageIdMax==0)
         {
-            if(  false == ((msg.getMessageId()==messageIdMin)) )
+            if(  false == ((messageId==messageIdMin)) )
                 {
                     return false;
                 }
         }
         else 
         {
-            if( false == ((msg.getMessageId()>=messageIdMin)&&(msg.getMessageId()<messageIdMax)) )
+            if( false == ((messageId>=messageIdMin)&&(messageId<messageIdMax)) )
                 {
                     return false;
                 }
         }
     }
 
-    if(enableCtrlMsgs && !((msg.getType() == QDltMsg::DltTypeControl)))
+    if(enableCtrlMsgs && !((type == QDltMsg::DltTypeControl)))
     {
         return false;
     }
-    if(enableLogLevelMax && !((msg.getType() == QDltMsg::DltTypeLog) && (msg.getSubtype() <= logLevelMax)))
+    if(enableLogLevelMax && !((type == QDltMsg::DltTypeLog) && (subtype <= logLevelMax)))
     {
         return false;
     }
-    if(enableLogLevelMin && !((msg.getType() == QDltMsg::DltTypeLog) && (msg.getSubtype() >= logLevelMin)))
+    if(enableLogLevelMin && !((type == QDltMsg::DltTypeLog) && (subtype >= logLevelMin)))
     {
         return false;
     }
@@ -33,6 +33,7 @@
 
 #include "export_rules.h"
 #include "qdltmsg.h"
+#include "qdltregexprefilter.h"
 
 
 class QDLT_EXPORT QDltFilter
@@ -85,6 +86,10 @@ public:
     QRegularExpression contextRegularExpression;
     QRegularExpression appidRegularExpression;
 
+    // literals of the header and payload regular expressions, checked before the expressions run
+    QDltRegexPrefilter headerRegexPrefilter;
+    QDltRegexPrefilter payloadRegexPrefilter;
+
     //! Constructor.
     /*!
     */
@@ -131,6 +136,31 @@ public:
     */
     bool match(const QDltMsg &msg) const;
 
+    //! Check if the filter only checks message header fields stored in QDltMetadataIndex.
+    /*!
+      Header and payload text are not stored, all other conditions are.
+      \return true if the filter can be matched against a metadata index
+    */
+    bool isMetadataFilter() const;
+
+    //! Check if the ECU id condition of the filter matches.
+    bool matchEcuid(const QString &ecuid) const;
+
+    //! Check if the application id condition of the filter matches.
+    bool matchApid(const QString &apid) const;
+
+    //! Check if the context id condition of the filter matches.
+    bool matchCtid(const QString &ctid) const;
+
+    //! Check if the message id, control message and log level conditions of the filter match.
+    bool matchMessageInfo(unsigned int messageId, int type, int subtype) const;
+
+    //! Check if the header text condition of the filter matches.
+    bool matchHeader(const QString &text) const;
+
+    //! Check if the payload text condition of the filter matches.
+    bool matchPayload(const QString &text) const;
+
     //! Save filter parameters in XML file.
     /*!
     */
@@ -19,6 +19,7 @@
  * @licence end@
  */
 
+#include <algorithm>
 #include <regex>
 #include <stdlib.h>
 
@@ -75,6 +76,9 @@ void QDltFilterList::clearFilter()
         delete filter;
     }
     filters.clear();
+
+    // the sorted and compiled filters point to the deleted filters
+    updateSortedFilter();
     //qDebug() << "clearFilter: Clear filter";
 }
 
@@ -93,16 +97,15 @@ void QDltFilterList::addFilter(QDltFilter *_filter)
 #ifdef USECOLOR
 QColor QDltFilterList::checkMarker(const QDltMsg &msg)
 {
-    QDltFilter *filter;
+    CompiledFilterMsg compiledMsg(msg, headerMatcher, payloadMatcher);
     QColor color;
 
-    for(int numfilter=0;numfilter<mfilters.size();numfilter++)
+    // same result as filter->match() for each marker in order
+    for(const CompiledFilter &compiled : compiledMfilters)
     {
-        filter = mfilters[numfilter];
-
-        if(filter->match(msg))
+        if(matchCompiledFilter(compiled, compiledMsg))
         {
-            color = filter->filterColour;
+            color = compiled.filter->filterColour;
             break;
         }
     }
@@ -111,16 +114,15 @@ QColor QDltFilterList::checkMarker(const QDltMsg &msg)
 #else
 QString QDltFilterList::checkMarker(const QDltMsg &msg)
 {
-    QDltFilter *filter;
+    CompiledFilterMsg compiledMsg(msg, headerMatcher, payloadMatcher);
     QString color=""; // invalid colour
 
-    for(int numfilter=0;numfilter<mfilters.size();numfilter++)
+    // same result as filter->match() for each marker in order
+    for(const CompiledFilter &compiled : compiledMfilters)
     {
-        filter = mfilters[numfilter];
-
-        if(filter->match(msg))
+        if(matchCompiledFilter(compiled, compiledMsg))
         {
-            color = filter->filterColour;
+            color = compiled.filter->filterColour;
             break;
         }
     }
@@ -178,51 +180,454 @@ bool QDltFilterList::applyRegExStringMsg(QDltMsg &msg) const
     return result;
 }
 
+namespace {
+
+// the payload text is rendered into one buffer per thread, which keeps its capacity
+QString &payloadTextBuffer()
+{
+    thread_local QString buffer;
+    return buffer;
+}
+
+// the results of the multi pattern matchers are kept in buffers per thread too
+QBitArray &headerMatchesBuffer()
+{
+    thread_local QBitArray buffer;
+    return buffer;
+}
+
+QBitArray &payloadMatchesBuffer()
+{
+    thread_local QBitArray buffer;
+    return buffer;
+}
+
+// filters whose text patterns are searched by a multi pattern matcher
+bool isPlainHeaderFilter(const QDltFilter *filter)
+{
+    return filter->enableHeader && !filter->enableRegexp_Header;
+}
+
+bool isPlainPayloadFilter(const QDltFilter *filter)
+{
+    return filter->enablePayload && !filter->enableRegexp_Payload;
+}
+
+// number of characters of a packed id, which contains no zero characters
+int packedIdLength(quint32 id)
+{
+    int length = 0;
+    while(length < 4 && (id >> (length * 8)) != 0)
+        length++;
+    return length;
+}
+
+// the characters of a packed id from start with the given length, packed again
+quint32 packedIdPart(quint32 id, int start, int length)
+{
+    const quint32 part = id >> (start * 8);
+    return length >= 4 ? part : part & ((1u << (length * 8)) - 1);
+}
+
+// same search as QDltFilter::matchCtid() for packed ids
+bool packedIdContains(quint32 id, quint32 text)
+{
+    const int idLength = packedIdLength(id);
+    const int textLength = packedIdLength(text);
+    for(int start = 0; start + textLength <= idLength; start++)
+    {
+        if(packedIdPart(id, start, textLength) == text)
+            return true;
+    }
+    return false;
+}
+
+}
+
+class QDltFilterList::CompiledFilterMsg
+{
+public:
+    CompiledFilterMsg(const QDltMsg &msg, const QDltMultiPatternMatcher &headerMatcher, const QDltMultiPatternMatcher &payloadMatcher)
+        : msg(msg)
+        , ecuidCreated(false)
+        , apidCreated(false)
+        , headerCreated(false)
+        , payloadCreated(false)
+        , payloadText(payloadTextBuffer())
+        , headerMatcher(headerMatcher)
+        , headerMatched(false)
+        , headerMatches(headerMatchesBuffer())
+        , payloadMatcher(payloadMatcher)
+        , payloadMatched(false)
+        , payloadMatches(payloadMatchesBuffer())
+    {
+        ecuidPacked = msg.getPackedEcuid(packedEcuid);
+        apidPacked = msg.getPackedApid(packedApid);
+        ctidPacked = msg.getPackedCtid(packedCtid);
+    }
+
+    const QString &ecuid()
+    {
+        if(!ecuidCreated)
+        {
+            ecuidText = msg.getEcuid();
+            ecuidCreated = true;
+        }
+        return ecuidText;
+    }
+
+    const QString &apid()
+    {
+        if(!apidCreated)
+        {
+            apidText = msg.getApid();
+            apidCreated = true;
+        }
+        return apidText;
+    }
+
+    const QString &header()
+    {
+        if(!headerCreated)
+        {
+            headerText = msg.toStringHeader();
+            headerCreated = true;
+        }
+        return headerText;
+    }
+
+    const QString &payload()
+    {
+        if(!payloadCreated)
+        {
+            payloadText.truncate(0);
+            msg.appendToStringPayload(payloadText);
+            payloadCreated = true;
+        }
+        return payloadText;
+    }
+
+    //! Check if the header text contains a pattern of the header matcher, all patterns are searched at the first call.
+    bool headerContains(int pattern)
+    {
+        if(!headerMatched)
+        {
+            headerMatcher.match(header(), headerMatches);
+            headerMatched = true;
+        }
+        return headerMatches.testBit(pattern);
+    }
+
+    //! Check if the payload text contains a pattern of the payload matcher, all patterns are searched at the first call.
+    bool payloadContains(int pattern)
+    {
+        if(!payloadMatched)
+        {
+            payloadMatcher.match(payload(), payloadMatches);
+            payloadMatched = true;
+        }
+        return payloadMatches.testBit(pattern);
+    }
+
+    const QDltMsg &msg;
+    bool ecuidPacked;
+    quint32 packedEcuid;
+    bool apidPacked;
+    quint32 packedApid;
+    bool ctidPacked;
+    quint32 packedCtid;
+
+private:
+    bool ecuidCreated;
+    QString ecuidText;
+    bool apidCreated;
+    QString apidText;
+    bool headerCreated;
+    QString headerText;
+    bool payloadCreated;
+    QString &payloadText;
+    const QDltMultiPatternMatcher &headerMatcher;
+    bool headerMatched;
+    QBitArray &headerMatches;
+    const QDltMultiPatternMatcher &payloadMatcher;
+    bool payloadMatched;
+    QBitArray &payloadMatches;
+};
+
+QDltFilterList::CompiledFilter QDltFilterList::compileFilter(const QDltFilter *filter, bool useHeaderMatcher, bool usePayloadMatcher)
+{
+    CompiledFilter compiledFilter;
+    compiledFilter.filter = filter;
+    compiledFilter.checkMessageInfo = filter->enableMessageId || filter->enableCtrlMsgs || filter->enableLogLevelMax || filter->enableLogLevelMin;
+    compiledFilter.ecuidPacked = filter->enableEcuid && QDltMsg::packId(filter->ecuid, compiledFilter.ecuid);
+    compiledFilter.apidPacked = filter->enableApid && !filter->enableRegexp_Appid && QDltMsg::packId(filter->apid, compiledFilter.apid);
+    // an empty context id is contained in all context ids
+    compiledFilter.ctidPacked = filter->enableCtid && !filter->enableRegexp_Context && !filter->ctid.isEmpty() && QDltMsg::packId(filter->ctid, compiledFilter.ctid);
+
+    // same search as QDltFilter::matchHeader() and matchPayload()
+    compiledFilter.headerPattern = -1;
+    if(useHeaderMatcher && isPlainHeaderFilter(filter))
+        compiledFilter.headerPattern = headerMatcher.addPattern(filter->header, filter->ignoreCase_Header ? Qt::CaseInsensitive : Qt::CaseSensitive);
+    compiledFilter.payloadPattern = -1;
+    if(usePayloadMatcher && isPlainPayloadFilter(filter))
+        compiledFilter.payloadPattern = payloadMatcher.addPattern(filter->payload, filter->ignoreCase_Payload ? Qt::CaseInsensitive : Qt::CaseSensitive);
+
+    // text of the header and payload is created for the message, regular expressions are slower than search
+    compiledFilter.cost = (filter->enableCtid ? 1 : 0) +
+                          (filter->enableHeader ? (filter->enableRegexp_Header ? 8 : 4) : 0) +
+                          (filter->enablePayload ? (filter->enableRegexp_Payload ? 32 : 16) : 0);
+
+    return compiledFilter;
+}
+
+void QDltFilterList::compileFilters(const QList<QDltFilter*> &filters, CompiledFilterSet &compiled, bool useHeaderMatcher, bool usePayloadMatcher)
+{
+    compiled.filtersByApid.clear();
+    compiled.filters.clear();
+
+    for(const QDltFilter *filter : filters)
+    {
+        const CompiledFilter compiledFilter = compileFilter(filter, useHeaderMatcher, usePayloadMatcher);
+
+        if(compiledFilter.apidPacked && compiledFilter.ctidPacked)
+            compiled.filtersByApid[compiledFilter.apid].filtersByCtid[compiledFilter.ctid].append(compiledFilter);
+        else if(compiledFilter.apidPacked)
+            compiled.filtersByApid[compiledFilter.apid].filters.append(compiledFilter);
+        else
+            compiled.filters.append(compiledFilter);
+    }
+
+    // the filters are or-ed, so the order does not change the result
+    auto byCost = [](const CompiledFilter &filter1, const CompiledFilter &filter2) { return filter1.cost < filter2.cost; };
+    std::stable_sort(compiled.filters.begin(), compiled.filters.end(), byCost);
+    for(CompiledApidFilters &filtersOfApid : compiled.filtersByApid)
+    {
+        std::stable_sort(filtersOfApid.filters.begin(), filtersOfApid.filters.end(), byCost);
+        for(QVector<CompiledFilter> &filtersOfCtid : filtersOfApid.filtersByCtid)
+            std::stable_sort(filtersOfCtid.begin(), filtersOfCtid.end(), byCost);
+    }
+}
+
+bool QDltFilterList::matchCompiledFilter(const CompiledFilter &compiled, CompiledFilterMsg &msg)
+{
+    const QDltFilter *filter = compiled.filter;
+
+    // same conditions as QDltFilter::match(), cheap checks first
+
+    if(compiled.checkMessageInfo && !filter->matchMessageInfo(msg.msg.getMessageId(), msg.msg.getType(), msg.msg.getSubtype()))
+        return false;
+
+    if(filter->enableEcuid)
+    {
+        // a packed filter id differs from all ids which cannot be packed
+        if(compiled.ecuidPacked ? (!msg.ecuidPacked || msg.packedEcuid != compiled.ecuid) : !filter->matchEcuid(msg.ecuid()))
+            return false;
+    }
+
+    if(filter->enableApid)
+    {
+        if(compiled.apidPacked ? (!msg.apidPacked || msg.packedApid != compiled.apid) : !filter->matchApid(msg.apid()))
+            return false;
+    }
+
+    if(filter->enableCtid)
+    {
+        // a packed filter id is not contained in ids which cannot be packed, as these may be longer
+        if(compiled.ctidPacked && msg.ctidPacked ? !packedIdContains(msg.packedCtid, compiled.ctid) : !filter->matchCtid(msg.msg.getCtid()))
+            return false;
+    }
+
+    if(filter->enableHeader && !(compiled.headerPattern >= 0 ? msg.headerContains(compiled.headerPattern) : filter->matchHeader(msg.header())))
+        return false;
+
+    if(filter->enablePayload && !(compiled.payloadPattern >= 0 ? msg.payloadContains(compiled.payloadPattern) : filter->matchPayload(msg.payload())))
+        return false;
+
+    return true;
+}
+
+bool QDltFilterList::matchCompiledFilters(const QVector<CompiledFilter> &filters, CompiledFilterMsg &msg)
+{
+    for(const CompiledFilter &filter : filters)
+    {
+        if(matchCompiledFilter(filter, msg))
+            return true;
+    }
+
+    return false;
+}
+
+bool QDltFilterList::matchCompiledFilters(const CompiledApidFilters &compiled, CompiledFilterMsg &msg)
+{
+    if(matchCompiledFilters(compiled.filters, msg))
+        return true;
+
+    if(compiled.filtersByCtid.isEmpty())
+        return false;
+
+    if(!msg.ctidPacked)
+    {
+        // a long context id may contain the context id of any filter
+        for(const QVector<CompiledFilter> &filtersOfCtid : compiled.filtersByCtid)
+        {
+            if(matchCompiledFilters(filtersOfCtid, msg))
+                return true;
+        }
+        return false;
+    }
+
+    // the context id of a filter is one of the parts of the context id of the message
+    const int length = packedIdLength(msg.packedCtid);
+    for(int start = 0; start < length; start++)
+    {
+        for(int partLength = 1; start + partLength <= length; partLength++)
+        {
+            const auto it = compiled.filtersByCtid.constFind(packedIdPart(msg.packedCtid, start, partLength));
+            if(it != compiled.filtersByCtid.constEnd() && matchCompiledFilters(it.value(), msg))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+bool QDltFilterList::matchCompiledFilters(const CompiledFilterSet &compiled, CompiledFilterMsg &msg)
+{
+    if(msg.apidPacked && !compiled.filtersByApid.isEmpty())
+    {
+        const auto it = compiled.filtersByApid.constFind(msg.packedApid);
+        if(it != compiled.filtersByApid.constEnd() && matchCompiledFilters(it.value(), msg))
+            return true;
+    }
+
+    return matchCompiledFilters(compiled.filters, msg);
+}
+
 bool QDltFilterList::checkFilter(QDltMsg &msg)
 {
-    QDltFilter *filter;
-    bool found = false;
-    bool filterActivated = false;
+    CompiledFilterMsg compiledMsg(msg, headerMatcher, payloadMatcher);
+    bool found;
 
     /* If there are no positive filters, or all positive filters
      * are disabled, the default case is to show all messages. Only
      * negative filters will be applied */
-    if(pfilters.size())
-        filterActivated = true;
-
-    if(filterActivated==false)
+    if(pfilters.isEmpty())
         found = true;
     else
-        found = false;
+        found = matchCompiledFilters(compiledPfilters, compiledMsg);
+
+    //we need only to check for negative filters, if the message would be shown! If discarded anyway, there is no need to apply it.
+    if(found && !nfilters.isEmpty())
+    {
+        // a negative filter has matched -> found = false
+        found = !matchCompiledFilters(compiledNfilters, compiledMsg);
+    }
 
+    return found;
+}
 
-    for(int numfilter=0;numfilter<pfilters.size();numfilter++)
+bool QDltFilterList::isMetadataFilter() const
+{
+    for(const QDltFilter *filter : pfilters)
     {
-        filter = pfilters[numfilter];
-        found = filter->match(msg);
-        if (found)
-          break;
+        if(!filter->isMetadataFilter())
+            return false;
+    }
+    for(const QDltFilter *filter : nfilters)
+    {
+        if(!filter->isMetadataFilter())
+            return false;
+    }
+
+    return true;
+}
+
+namespace {
+
+// a filter with the results of its id conditions for all interned ids
+typedef struct
+{
+    const QDltFilter *filter;
+    QVector<bool> ecuid;
+    QVector<bool> apid;
+    QVector<bool> ctid;
+} QDltMetadataFilter;
+
+QVector<QDltMetadataFilter> createMetadataFilters(const QList<QDltFilter*> &filters, const QDltMetadataIndex &metadata)
+{
+    QVector<QDltMetadataFilter> result;
+
+    for(const QDltFilter *filter : filters)
+    {
+        QDltMetadataFilter metadataFilter;
+        metadataFilter.filter = filter;
+        // each id is checked only once, not once per message
+        if(filter->enableEcuid)
+            for(const QString &ecuid : metadata.getEcuidTable())
+                metadataFilter.ecuid.append(filter->matchEcuid(ecuid));
+        if(filter->enableApid)
+            for(const QString &apid : metadata.getApidTable())
+                metadataFilter.apid.append(filter->matchApid(apid));
+        if(filter->enableCtid)
+            for(const QString &ctid : metadata.getCtidTable())
+                metadataFilter.ctid.append(filter->matchCtid(ctid));
+        result.append(metadataFilter);
     }
 
-    if (found || filterActivated==false ){
-        //we need only to check for negative filters, if the message would be shown! If discarded anyway, there is no need to apply it.
-        //if positive filter applied -> check for negative filters
-        //if no positive filters are active or no one exists, we need also to filter negatively
-        // if the message has been discarded by all positive filters before, we do not need to filter it away a second time
+    return result;
+}
+
+bool matchMetadataFilter(const QDltMetadataFilter &metadataFilter, const QDltMetadataIndex &metadata, int num)
+{
+    const QDltFilter *filter = metadataFilter.filter;
+
+    if(filter->enableEcuid && !metadataFilter.ecuid[metadata.getEcuidId(num)])
+        return false;
+    if(filter->enableApid && !metadataFilter.apid[metadata.getApidId(num)])
+        return false;
+    if(filter->enableCtid && !metadataFilter.ctid[metadata.getCtidId(num)])
+        return false;
 
-        for(int numfilter=0;numfilter<nfilters.size();numfilter++)
+    return filter->matchMessageInfo(metadata.getMessageId(num), metadata.getType(num), metadata.getSubtype(num));
+}
+
+}
+
+void QDltFilterList::checkFilter(const QDltMetadataIndex &metadata, int start, int end, QVector<int> &matches) const
+{
+    const QVector<QDltMetadataFilter> positive = createMetadataFilters(pfilters, metadata);
+    const QVector<QDltMetadataFilter> negative = createMetadataFilters(nfilters, metadata);
+
+    for(int num = qMax(0, start); num < qMin(end, metadata.size()); num++)
+    {
+        // messages which cannot be parsed are skipped
+        if(!metadata.isMsgValid(num))
+            continue;
+
+        // same logic as checkFilter() for a message
+        bool found = positive.isEmpty();
+        for(const QDltMetadataFilter &filter : positive)
         {
-            filter = nfilters[numfilter];
-            if (filter->match(msg))
+            if(matchMetadataFilter(filter, metadata, num))
             {
-                // a negative filter has matched -> found = false
-                found = false;
+                found = true;
                 break;
             }
         }
-      }
+        if(!found)
+            continue;
 
-    return found;
+        for(const QDltMetadataFilter &filter : negative)
+        {
+            if(matchMetadataFilter(filter, metadata, num))
+            {
+                found = false;
+                break;
+            }
+        }
+        if(found)
+            matches.append(num);
+    }
 }
 
 bool QDltFilterList::SaveFilter(QString _filename)
@@ -376,4 +781,26 @@ void QDltFilterList::updateSortedFilter()
         }
     }
 
+    // a single text pattern is searched faster by QString::contains(), several are searched together
+    int headerFilters = 0, payloadFilters = 0;
+    for(const QList<QDltFilter*> *list : {&pfilters, &nfilters, &mfilters})
+    {
+        for(const QDltFilter *filter : *list)
+        {
+            headerFilters += isPlainHeaderFilter(filter) ? 1 : 0;
+            payloadFilters += isPlainPayloadFilter(filter) ? 1 : 0;
+        }
+    }
+
+    headerMatcher.clear();
+    payloadMatcher.clear();
+
+    compileFilters(pfilters, compiledPfilters, headerFilters > 1, payloadFilters > 1);
+    compileFilters(nfilters, compiledNfilters, headerFilters > 1, payloadFilters > 1);
+    compiledMfilters.clear();
+    for(const QDltFilter *filter : mfilters)
+        compiledMfilters.append(compileFilter(filter, headerFilters > 1, payloadFilters > 1));
+
+    headerMatcher.compile();
+    payloadMatcher.compile();
 }
@@ -24,11 +24,15 @@
 
 #include "export_rules.h"
 #include "qdltfilter.h"
+#include "qdltmetadataindex.h"
 #include "qdltmsg.h"
+#include "qdltmultipatternmatcher.h"
 
 #include <QObject>
 #include <QString>
 #include <QFile>
+#include <QHash>
+#include <QVector>
 #include <QDateTime>
 #include <QMutex>
 #include <time.h>
@@ -103,6 +107,23 @@ public:
     */
     bool checkFilter(QDltMsg &msg);
 
+    //! Check if all active filters can be checked against a metadata index.
+    /*!
+      \return true if no active positive or negative filter checks header or payload text
+    */
+    bool isMetadataFilter() const;
+
+    //! Check the messages of a metadata index against the filters.
+    /*!
+      The result is the same as checking the parsed messages with checkFilter(),
+      messages which could not be parsed never match.
+      \param metadata The metadata index of the messages
+      \param start First row to be checked
+      \param end Row behind the last row to be checked
+      \param matches The matching rows are appended
+    */
+    void checkFilter(const QDltMetadataIndex &metadata, int start, int end, QVector<int> &matches) const;
+
     //! Save the filter.
     /*!
     */
@@ -125,6 +146,8 @@ public:
 
     //! Update the presorted list for performance improvement.
     /*!
+      The positive and negative filters and the markers are also compiled for
+      checkFilter() and checkMarker(). Must be called again after filters were added, removed or changed.
     */
     void updateSortedFilter();
 
@@ -153,6 +176,88 @@ private:
     //! List of nfilters.
     QList<QDltFilter*> nfilters;
 
+    //! A filter prepared for checkFilter().
+    /*!
+      ECU, application and context ids of up to four characters are packed
+      into an integer, so they are compared without comparing strings.
+      Plain text header and payload patterns are the ids of the patterns in
+      the multi pattern matchers, -1 if the filter matches the text itself.
+    */
+    typedef struct
+    {
+        const QDltFilter *filter;
+        bool checkMessageInfo;
+        bool ecuidPacked;
+        quint32 ecuid;
+        bool apidPacked;
+        quint32 apid;
+        bool ctidPacked;
+        quint32 ctid;
+        int headerPattern;
+        int payloadPattern;
+        int cost;
+    } CompiledFilter;
+
+    //! The compiled filters of one application id.
+    /*!
+      Filters with a plain context id are found by a hash lookup with each
+      part of the context id of the message, as the context id of the filter
+      is searched in the context id of the message.
+    */
+    typedef struct
+    {
+        QHash<quint32, QVector<CompiledFilter> > filtersByCtid;
+        QVector<CompiledFilter> filters;
+    } CompiledApidFilters;
+
+    //! The compiled positive or negative filters.
+    /*!
+      Filters matching an exact application id are found by a hash lookup
+      with the id of the message, all other filters are ordered from cheap
+      to expensive checks.
+    */
+    typedef struct
+    {
+        QHash<quint32, CompiledApidFilters> filtersByApid;
+        QVector<CompiledFilter> filters;
+    } CompiledFilterSet;
+
+    //! A message checked by the compiled filters, the header and payload text are only created if needed.
+    class CompiledFilterMsg;
+
+    //! Compile a filter, the text patterns are added to the multi pattern matchers if used.
+    CompiledFilter compileFilter(const QDltFilter *filter, bool useHeaderMatcher, bool usePayloadMatcher);
+
+    //! Compile the positive and negative filters.
+    void compileFilters(const QList<QDltFilter*> &filters, CompiledFilterSet &compiled, bool useHeaderMatcher, bool usePayloadMatcher);
+
+    //! Check if a compiled filter matches.
+    static bool matchCompiledFilter(const CompiledFilter &compiled, CompiledFilterMsg &msg);
+
+    //! Check if any of the compiled filters of a list matches.
+    static bool matchCompiledFilters(const QVector<CompiledFilter> &filters, CompiledFilterMsg &msg);
+
+    //! Check if any of the compiled filters of an application id matches.
+    static bool matchCompiledFilters(const CompiledApidFilters &compiled, CompiledFilterMsg &msg);
+
+    //! Check if any of the compiled filters matches.
+    static bool matchCompiledFilters(const CompiledFilterSet &compiled, CompiledFilterMsg &msg);
+
+    //! Compiled positive filters.
+    CompiledFilterSet compiledPfilters;
+
+    //! Compiled negative filters.
+    CompiledFilterSet compiledNfilters;
+
+    //! Compiled markers, in the order of the markers, the first matching marker sets the colour.
+    QVector<CompiledFilter> compiledMfilters;
+
+    //! Plain text header patterns of all filters and markers, searched in one pass over the header text.
+    QDltMultiPatternMatcher headerMatcher;
+
+    //! Plain text payload patterns of all filters and markers, searched in one pass over the payload text.
+    QDltMultiPatternMatcher payloadMatcher;
+
 };
 
 #endif // QDLT_FILTER_LIST_H
@@ -0,0 +1,420 @@
+#include "qdltfulltextindex.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFile>
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+// size of the MD5 checksum at the end of a full text index file
+const int checksumSize = 16;
+
+ushort foldCharacter(ushort character)
+{
+    if(character < 128)
+        return (character >= 'A' && character <= 'Z') ? character + ('a' - 'A') : character;
+    return static_cast<ushort>(QChar::toCaseFolded(static_cast<uint>(character)));
+}
+
+// words are runs of letters, digits and underscores, surrogates separate words
+bool isWordCharacter(ushort character)
+{
+    if(character < 128)
+        return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') ||
+               (character >= '0' && character <= '9') || character == '_';
+    return QChar(character).isLetterOrNumber();
+}
+
+QString foldText(const QString &text)
+{
+    QString folded(text.size(), Qt::Uninitialized);
+    QChar *data = folded.data();
+    for(int pos = 0; pos < text.size(); pos++)
+        data[pos] = QChar(text[pos].isSurrogate() ? text[pos].unicode() : foldCharacter(text[pos].unicode()));
+    return folded;
+}
+
+void appendVarint(QByteArray &data, quint32 value)
+{
+    while(value >= 0x80)
+    {
+        data += static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    data += static_cast<char>(value);
+}
+
+bool readVarint(const QByteArray &data, int &pos, quint32 &value)
+{
+    value = 0;
+    for(int shift = 0; shift < 35; shift += 7)
+    {
+        if(pos >= data.size())
+            return false;
+        const uchar byte = static_cast<uchar>(data[pos++]);
+        value |= static_cast<quint32>(byte & 0x7f) << shift;
+        if(!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+bool readBytes(const QByteArray &data, int &pos, quint32 size, QByteArray &bytes)
+{
+    if(size > static_cast<quint32>(data.size() - pos))
+        return false;
+    bytes = data.mid(pos, static_cast<int>(size));
+    pos += static_cast<int>(size);
+    return true;
+}
+
+QVector<int> unite(const QVector<int> &list1, const QVector<int> &list2)
+{
+    QVector<int> result;
+    result.reserve(list1.size() + list2.size());
+    std::set_union(list1.begin(), list1.end(), list2.begin(), list2.end(), std::back_inserter(result));
+    return result;
+}
+
+QVector<int> intersect(const QVector<int> &list1, const QVector<int> &list2)
+{
+    QVector<int> result;
+    std::set_intersection(list1.begin(), list1.end(), list2.begin(), list2.end(), std::back_inserter(result));
+    return result;
+}
+
+}
+
+QDltFullTextIndex::QDltFullTextIndex()
+    : messages(0)
+{
+}
+
+void QDltFullTextIndex::clear()
+{
+    messages = 0;
+    words.clear();
+    postings.clear();
+    wordPositions.clear();
+    invalid.clear();
+    renderKey.clear();
+}
+
+void QDltFullTextIndex::addWord(const QString &word, int num)
+{
+    int position;
+    const QHash<QString, int>::const_iterator it = wordPositions.constFind(word);
+    if(it == wordPositions.constEnd())
+    {
+        position = static_cast<int>(words.size());
+        words.append(word);
+        postings.append(Posting());
+        wordPositions.insert(word, position);
+    }
+    else
+    {
+        position = it.value();
+    }
+
+    // each message is stored once per word, as distance to the message before
+    Posting &posting = postings[position];
+    if(posting.last == num)
+        return;
+    appendVarint(posting.data, static_cast<quint32>(num - posting.last));
+    posting.last = num;
+}
+
+void QDltFullTextIndex::addText(const QString &text, int num)
+{
+    // the word is collected in one buffer per thread, which keeps its capacity
+    thread_local QString word;
+    word.truncate(0);
+
+    for(const QChar &character : text)
+    {
+        const ushort folded = character.isSurrogate() ? character.unicode() : foldCharacter(character.unicode());
+        if(isWordCharacter(folded))
+        {
+            word.append(QChar(folded));
+        }
+        else if(!word.isEmpty())
+        {
+            addWord(word, num);
+            word.truncate(0);
+        }
+    }
+    if(!word.isEmpty())
+        addWord(word, num);
+}
+
+void QDltFullTextIndex::append(const QString &header, const QString &payload)
+{
+    addText(header, messages);
+    addText(payload, messages);
+    messages++;
+}
+
+void QDltFullTextIndex::appendInvalid()
+{
+    invalid.append(messages);
+    messages++;
+}
+
+bool QDltFullTextIndex::isSearchable(const QString &text)
+{
+    bool hasWord = false;
+
+    for(const QChar &character : text)
+    {
+        // caseless matching of characters outside of the basic multilingual plane is not supported
+        if(character.isSurrogate())
+            return false;
+        if(isWordCharacter(foldCharacter(character.unicode())))
+            hasWord = true;
+    }
+
+    return hasWord;
+}
+
+QVector<int> QDltFullTextIndex::decode(const QByteArray &data)
+{
+    QVector<int> result;
+    int pos = 0;
+    int num = -1;
+    quint32 delta;
+
+    while(pos < data.size() && readVarint(data, pos, delta))
+    {
+        num += static_cast<int>(delta);
+        result.append(num);
+    }
+
+    return result;
+}
+
+QVector<int> QDltFullTextIndex::findWord(const QString &word, bool startOpen, bool endOpen) const
+{
+    // a complete word is found directly
+    if(!startOpen && !endOpen)
+    {
+        const QHash<QString, int>::const_iterator it = wordPositions.constFind(word);
+        return it == wordPositions.constEnd() ? QVector<int>() : decode(postings[it.value()].data);
+    }
+
+    // a partial word is searched in all words
+    QVector<int> result;
+    for(int position = 0; position < words.size(); position++)
+    {
+        const QString &candidate = words[position];
+        const bool found = (startOpen && endOpen) ? candidate.contains(word) :
+                           startOpen ? candidate.endsWith(word) : candidate.startsWith(word);
+        if(found)
+            result += decode(postings[position].data);
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
+    return result;
+}
+
+QVector<int> QDltFullTextIndex::find(const QString &text) const
+{
+    const QString folded = foldText(text);
+    QVector<int> result;
+    bool first = true;
+    int pos = 0;
+
+    while(pos < folded.size())
+    {
+        if(!isWordCharacter(folded[pos].unicode()))
+        {
+            pos++;
+            continue;
+        }
+
+        int end = pos;
+        while(end < folded.size() && isWordCharacter(folded[end].unicode()))
+            end++;
+
+        // the first and the last word of the text may be part of a longer word
+        const QVector<int> found = findWord(folded.mid(pos, end - pos), pos == 0, end == folded.size());
+        result = first ? found : intersect(result, found);
+        first = false;
+        if(result.isEmpty())
+            break;
+        pos = end;
+    }
+
+    return result;
+}
+
+bool QDltFullTextIndex::findAll(const QStringList &texts, QVector<int> &result) const
+{
+    bool searched = false;
+
+    result.clear();
+    for(const QString &text : texts)
+    {
+        if(!isSearchable(text))
+            continue;
+        result = searched ? intersect(result, find(text)) : find(text);
+        searched = true;
+    }
+
+    if(!searched)
+        return false;
+
+    result = unite(result, invalid);
+
+    return true;
+}
+
+bool QDltFullTextIndex::findAny(const QStringList &texts, QVector<int> &result) const
+{
+    result.clear();
+    for(const QString &text : texts)
+    {
+        if(!isSearchable(text))
+        {
+            result.clear();
+            return false;
+        }
+        result = unite(result, find(text));
+    }
+
+    if(texts.isEmpty())
+        return false;
+
+    result = unite(result, invalid);
+
+    return true;
+}
+
+bool QDltFullTextIndex::save(const QString &filename, const QByteArray &key) const
+{
+    QByteArray data;
+
+    // header
+    appendVarint(data, QDLT_FULL_TEXT_INDEX_FILE_VERSION);
+    appendVarint(data, static_cast<quint32>(messages));
+    appendVarint(data, static_cast<quint32>(key.size()));
+    data += key;
+    appendVarint(data, static_cast<quint32>(renderKey.size()));
+    data += renderKey;
+
+    // messages which could not be parsed
+    appendVarint(data, static_cast<quint32>(invalid.size()));
+    for(int num : invalid)
+        appendVarint(data, static_cast<quint32>(num));
+
+    // words with their posting lists
+    appendVarint(data, static_cast<quint32>(words.size()));
+    for(int position = 0; position < words.size(); position++)
+    {
+        const QByteArray word = words[position].toUtf8();
+        appendVarint(data, static_cast<quint32>(word.size()));
+        data += word;
+        appendVarint(data, static_cast<quint32>(postings[position].last));
+        appendVarint(data, static_cast<quint32>(postings[position].data.size()));
+        data += postings[position].data;
+    }
+
+    data += QCryptographicHash::hash(data, QCryptographicHash::Md5);
+
+    QFile file(filename);
+
+    // open full text index file
+    if(!file.open(QFile::WriteOnly))
+        return false;
+
+    // write the complete file at once
+    if(file.write(data) != data.size())
+    {
+        file.close();
+        file.remove();
+        return false;
+    }
+
+    file.close();
+
+    return true;
+}
+
+bool QDltFullTextIndex::load(const QString &filename, const QByteArray &key)
+{
+    QFile file(filename);
+    quint32 version, count, size, value;
+    QByteArray bytes;
+    int pos = 0;
+
+    clear();
+
+    // open full text index file
+    if(!file.open(QFile::ReadOnly))
+        return false;
+
+    QByteArray data = file.readAll();
+    file.close();
+
+    // check the checksum first, so all sizes can be trusted
+    if(data.size() < checksumSize ||
+       QCryptographicHash::hash(QByteArray::fromRawData(data.constData(), data.size() - checksumSize), QCryptographicHash::Md5) != data.right(checksumSize))
+    {
+        qDebug() << "Loading full text index file" << filename << "failed, file is corrupt";
+        return false;
+    }
+    data.chop(checksumSize);
+
+    if(!readVarint(data, pos, version) || version != QDLT_FULL_TEXT_INDEX_FILE_VERSION ||
+       !readVarint(data, pos, count) || count > static_cast<quint32>(INT_MAX) ||
+       !readVarint(data, pos, size) || !readBytes(data, pos, size, bytes) || bytes != key ||
+       !readVarint(data, pos, size) || !readBytes(data, pos, size, renderKey) ||
+       !readVarint(data, pos, size))
+    {
+        clear();
+        return false;
+    }
+    messages = static_cast<int>(count);
+
+    for(quint32 num = 0; num < size; num++)
+    {
+        if(!readVarint(data, pos, value))
+        {
+            clear();
+            return false;
+        }
+        invalid.append(static_cast<int>(value));
+    }
+
+    if(!readVarint(data, pos, count))
+    {
+        clear();
+        return false;
+    }
+    for(quint32 position = 0; position < count; position++)
+    {
+        Posting posting;
+        if(!readVarint(data, pos, size) || !readBytes(data, pos, size, bytes) ||
+           !readVarint(data, pos, value) || !readVarint(data, pos, size) || !readBytes(data, pos, size, posting.data))
+        {
+            clear();
+            return false;
+        }
+        posting.last = static_cast<int>(value);
+        words.append(QString::fromUtf8(bytes));
+        wordPositions.insert(words.last(), static_cast<int>(position));
+        postings.append(posting);
+    }
+
+    if(pos != data.size())
+    {
+        qDebug() << "Loading full text index file" << filename << "failed, wrong size";
+        clear();
+        return false;
+    }
+
+    return true;
+}
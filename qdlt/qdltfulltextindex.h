@@ -0,0 +1,136 @@
+#ifndef QDLTFULLTEXTINDEX_H
+#define QDLTFULLTEXTINDEX_H
+
+#include "export_rules.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+//! Version of full text index files.
+#define QDLT_FULL_TEXT_INDEX_FILE_VERSION 1
+
+//! Inverted index of the words of the text of all messages of a DLT log file.
+/*!
+  The header and payload text of each message is split into words, runs of
+  letters, digits and underscores, which are case folded. For each word the
+  numbers of the messages containing it are stored in a posting list, delta
+  and varint compressed.
+  A search text is split into words the same way. A message can only contain
+  the text, if it contains all words of the text, where the first word of the
+  text may be the end of a word of the message and the last word of the text
+  may be the start of a word of the message. The index finds all candidate
+  messages, they still have to be checked with the search text itself.
+  Messages which could not be parsed are always candidates.
+  The text of a message depends on decoder plugins and settings, the key of
+  the text rendering is stored with the index and must be checked before
+  the index is used.
+*/
+class QDLT_EXPORT QDltFullTextIndex
+{
+public:
+    //! Constructor.
+    QDltFullTextIndex();
+
+    //! Remove all messages and words.
+    void clear();
+
+    //! Get the number of messages.
+    int size() const { return messages; }
+
+    //! Get the number of different words.
+    int wordCount() const { return static_cast<int>(words.size()); }
+
+    //! Set the key of the text rendering of the messages.
+    void setRenderKey(const QByteArray &key) { renderKey = key; }
+
+    //! Get the key of the text rendering of the messages.
+    const QByteArray &getRenderKey() const { return renderKey; }
+
+    //! Append the text of the next message.
+    /*!
+      \param header The header text of the message
+      \param payload The payload text of the message
+    */
+    void append(const QString &header, const QString &payload);
+
+    //! Append a message which could not be parsed, it is a candidate of every search.
+    void appendInvalid();
+
+    //! Check if a text can be searched with the index.
+    /*!
+      Texts without any word and texts with characters outside of the basic
+      multilingual plane cannot be searched.
+      \param text The search text
+      \return true if the index finds all messages containing the text
+    */
+    static bool isSearchable(const QString &text);
+
+    //! Find the messages which may contain all texts.
+    /*!
+      \param texts The search texts, texts which are not searchable do not restrict the result
+      \param result The sorted numbers of the candidate messages
+      \return false if no text is searchable, every message is a candidate then
+    */
+    bool findAll(const QStringList &texts, QVector<int> &result) const;
+
+    //! Find the messages which may contain any of the texts.
+    /*!
+      \param texts The search texts
+      \param result The sorted numbers of the candidate messages
+      \return false if a text is not searchable, every message is a candidate then
+    */
+    bool findAny(const QStringList &texts, QVector<int> &result) const;
+
+    //! Save the full text index to a file.
+    /*!
+      \param filename The name of the file.
+      \param key Data identifying the indexed DLT log file, checked when loading.
+      \return true if the file was written successfully.
+    */
+    bool save(const QString &filename, const QByteArray &key) const;
+
+    //! Load the full text index from a file.
+    /*!
+      \param filename The name of the file.
+      \param key Data identifying the indexed DLT log file, must be the key used when saving.
+      \return false if the file cannot be read, is corrupt or was saved with another key.
+    */
+    bool load(const QString &filename, const QByteArray &key);
+
+private:
+    //! Delta and varint compressed message numbers of one word.
+    struct Posting
+    {
+        Posting() : last(-1) {}
+
+        QByteArray data;
+        int last;
+    };
+
+    void addText(const QString &text, int num);
+    void addWord(const QString &word, int num);
+    QVector<int> find(const QString &text) const;
+    QVector<int> findWord(const QString &word, bool startOpen, bool endOpen) const;
+    static QVector<int> decode(const QByteArray &data);
+
+    //! Number of appended messages.
+    int messages;
+
+    //! All words, the posting list of a word has the same position.
+    QVector<QString> words;
+    QVector<Posting> postings;
+
+    //! Position of each word in words.
+    QHash<QString, int> wordPositions;
+
+    //! Sorted numbers of the messages which could not be parsed.
+    QVector<int> invalid;
+
+    //! Key of the text rendering.
+    QByteArray renderKey;
+};
+
+#endif // QDLTFULLTEXTINDEX_H
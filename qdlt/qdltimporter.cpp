@@ -64,6 +64,10 @@ void QDltImporter::dltIpcFromPCAP(QString fileName)
     {
         qDebug() << "Failed opening WriteOnly" << outputfile->fileName();
     }
+    else
+    {
+        writer.setDevice(outputfile);
+    }
 
     int progressCounter = 1;
     emit progress("PCAP",1,0);
@@ -76,7 +80,7 @@ void QDltImporter::dltIpcFromPCAP(QString fileName)
     if(inputfile.read((char*)&globalHeader,sizeof(pcap_hdr_t))!=sizeof(pcap_hdr_t))
     {
         inputfile.close();
-        outputfile->close();
+        closeOutputfile();
         qDebug() << "fromPCAP:" << "Cannot open file" << fileName;
         return;
     }
@@ -98,7 +102,7 @@ void QDltImporter::dltIpcFromPCAP(QString fileName)
          if(record.length() != recordHeader.incl_len)
          {
              inputfile.close();
-             outputfile->close();
+             closeOutputfile();
              qDebug() << "fromPCAP: PCAP file not complete!";
              qDebug() << "fromPCAP:" << "Size Error: Cannot read Record";
              return;
@@ -109,7 +113,7 @@ void QDltImporter::dltIpcFromPCAP(QString fileName)
          if(record.size()<(qsizetype)(pos+2))
          {
              inputfile.close();
-             outputfile->close();
+             closeOutputfile();
              qDebug() << "dltFromPCAP:" << "Size Error: Cannot read Record";
              return;
          }
@@ -118,20 +122,20 @@ void QDltImporter::dltIpcFromPCAP(QString fileName)
          if(!dltFromEthernetFrame(record,pos,etherType,recordHeader.ts_sec,recordHeader.ts_usec))
          {
              inputfile.close();
-             outputfile->close();
+             closeOutputfile();
              qDebug() << "fromPCAP:" << "Size Error: Cannot read Ethernet Frame";
              return;
          }
          if(!ipcFromEthernetFrame(record,pos,etherType,recordHeader.ts_sec,recordHeader.ts_usec))
          {
              inputfile.close();
-             outputfile->close();
+             closeOutputfile();
              qDebug() << "fromPCAP:" << "Size Error: Cannot read Ethernet Frame";
              return;
          }
     }
     inputfile.close();
-    outputfile->close();
+    closeOutputfile();
 
     emit progress("",3,100);
 
@@ -167,6 +171,10 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
     {
         qDebug() << "Failed opening WriteOnly" << outputfile->fileName();
     }
+    else
+    {
+        writer.setDevice(outputfile);
+    }
 
     int progressCounter = 1;
     emit progress("MF4",1,0);
@@ -176,7 +184,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
     if(inputfile.read((char*)&mdfIdblock,sizeof(mdf_idblock_t))!=sizeof(mdf_idblock_t))
     {
         inputfile.close();
-        outputfile->close();
+        closeOutputfile();
         qDebug() << "fromMF4:" << "Size Error: Cannot reard Id Block";
         return;
     }
@@ -188,7 +196,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
     if(inputfile.read((char*)&mdfHeader,sizeof(mdf_hdr_t))!=sizeof(mdf_hdr_t))
     {
         inputfile.close();
-        outputfile->close();
+        closeOutputfile();
         qDebug() << "fromMF4:" << "Size Error: Cannot read mdf header";
         return;
     }
@@ -197,7 +205,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
         if(inputfile.read((char*)&hdBlockLinks,sizeof(mdf_hdblocklinks_t))!=sizeof(mdf_hdblocklinks_t))
         {
             inputfile.close();
-            outputfile->close();
+            closeOutputfile();
             qDebug() << "fromMF4:" << "Size Error: Cannot read HD Block";
             return;
         }
@@ -209,7 +217,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
             if(inputfile.read((char*)&mdfDgHeader,sizeof(mdf_hdr_t))!=sizeof(mdf_hdr_t))
             {
                 inputfile.close();
-                outputfile->close();
+                closeOutputfile();
                 qDebug() << "fromMF4:" << "Size Error: Cannot reard DG Block";
                 return;
             }
@@ -219,7 +227,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                 if(inputfile.read((char*)&mdfDgBlockLinks,sizeof(mdf_dgblocklinks_t))!=sizeof(mdf_dgblocklinks_t))
                 {
                     inputfile.close();
-                    outputfile->close();
+                    closeOutputfile();
                     qDebug() << "fromMF4:" << "Size Error: Cannot reard DG Block";
                     return;
                 }
@@ -232,7 +240,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                     if(inputfile.read((char*)&mdfCgHeader,sizeof(mdf_hdr_t))!=sizeof(mdf_hdr_t))
                     {
                         inputfile.close();
-                        outputfile->close();
+                        closeOutputfile();
                         qDebug() << "fromMF4:" << "Size Error: Cannot reard CG Block";
                         return;
                     }
@@ -243,7 +251,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                         if(inputfile.read((char*)&mdfCgBlockLinks,sizeof(mdf_cgblocklinks_t))!=sizeof(mdf_cgblocklinks_t))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot reard CG Block";
                             return;
                         }
@@ -263,7 +271,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                             {
                                 qDebug() << "fromMF4:" << "Size Error: Cannot reard CN Block";
                                 inputfile.close();
-                                outputfile->close();
+                                closeOutputfile();
                                 return;
                             }
                             if(mdfCnHeader.id[0]=='#' && mdfCnHeader.id[1]=='#' && mdfCnHeader.id[2]=='C' && mdfCnHeader.id[3]=='N')
@@ -273,7 +281,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                                 if(inputfile.read((char*)&mdfChBlockLinks,sizeof(mdf_cnblocklinks_t))!=sizeof(mdf_cnblocklinks_t))
                                 {
                                     inputfile.close();
-                                    outputfile->close();
+                                    closeOutputfile();
                                     qDebug() << "fromMF4:" << "Size Error: Cannot reard CN Block";
                                     return;
                                 }
@@ -283,7 +291,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                                 if(inputfile.read((char*)&mdfTxHeader,sizeof(mdf_hdr_t))!=sizeof(mdf_hdr_t))
                                 {
                                     inputfile.close();
-                                    outputfile->close();
+                                    closeOutputfile();
                                     qDebug() << "fromMF4:" << "Size Error: Cannot reard Tx Block";
                                     return;
                                 }
@@ -296,7 +304,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                                     if(cnNameReadLength != cnNameLength )
                                     {
                                         inputfile.close();
-                                        outputfile->close();
+                                        closeOutputfile();
                                         qDebug() << "fromMF4:" << "Size Error: Cannot read cn name";
                                         return;
                                     }
@@ -323,7 +331,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
     if(inputfile.read((char*)&mdfHeader,sizeof(mdf_hdr_t))!=sizeof(mdf_hdr_t))
     {
         inputfile.close();
-        outputfile->close();
+        closeOutputfile();
         qDebug() << "fromMF4: Cannot read datalist header";
         return;
     }
@@ -345,7 +353,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
     else
     {
         inputfile.close();
-        outputfile->close();
+        closeOutputfile();
         qDebug() << "fromMF4: Cannot find Datalist or Datablock";
         return;
     }
@@ -358,7 +366,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
             if(inputfile.read((char*)&addressOfDataBlock,sizeof(quint64))!=sizeof(quint64))
             {
                 inputfile.close();
-                outputfile->close();
+                closeOutputfile();
                 qDebug() << "fromMF4: Cannot read datablock address";
                 return;
             }
@@ -366,7 +374,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
             if(inputfile.read((char*)&mdfHeader,sizeof(mdf_hdr_t))!=sizeof(mdf_hdr_t))
             {
                 inputfile.close();
-                outputfile->close();
+                closeOutputfile();
                 qDebug() << "fromMF4: Cannot read datablock header";
                 return;
             }
@@ -404,7 +412,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                 if(inputfile.read((char*)&recordId,sizeof(quint16))!=sizeof(quint16))
                 {
                     inputfile.close();
-                    outputfile->close();
+                    closeOutputfile();
                     qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                     return;
                 }
@@ -419,7 +427,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                         if(inputfile.read((char*)&lengthVLSD,sizeof(quint32))!=sizeof(quint32))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
@@ -434,63 +442,63 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                         if(inputfile.read((char*)&ethFrame.timeStamp,sizeof(quint64))!=sizeof(quint64))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.asynchronous,sizeof(quint8))!=sizeof(quint8))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.source,6)!=6)
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.destination,6)!=6)
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.etherType,sizeof(quint16))!=sizeof(quint16))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.crc,sizeof(quint32))!=sizeof(quint32))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.receivedDataByteCount,sizeof(quint32))!=sizeof(quint32))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.dataLength,sizeof(quint32))!=sizeof(quint32))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.dataBytes,sizeof(quint64))!=sizeof(quint64))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
@@ -500,14 +508,14 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                             if(!dltFromEthernetFrame(recordData,0,ethFrame.etherType,time/1000000000ul,time%1000000000ul/1000ul))
                             {
                                 inputfile.close();
-                                outputfile->close();
+                                closeOutputfile();
                                 qDebug() << "fromMF4: ERROR:" << "Size Error: Cannot read Ethernet Frame";
                                 return;
                             }
                             if(!ipcFromEthernetFrame(recordData,0,ethFrame.etherType,time/1000000000ul,time%1000000000ul/1000ul))
                             {
                                 inputfile.close();
-                                outputfile->close();
+                                closeOutputfile();
                                 qDebug() << "fromMF4: ERROR:" << "Size Error: Cannot read Ethernet Frame";
                                 return;
                             }
@@ -521,70 +529,70 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                         if(inputfile.read((char*)&ethFrame.timeStamp,sizeof(quint64))!=sizeof(quint64))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.asynchronous,sizeof(quint8))!=sizeof(quint8))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.source,6)!=6)
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.destination,6)!=6)
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.etherType,sizeof(quint16))!=sizeof(quint16))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.crc,sizeof(quint32))!=sizeof(quint32))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.receivedDataByteCount,sizeof(quint32))!=sizeof(quint32))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.beaconTimeStamp,sizeof(quint64))!=sizeof(quint64)) // TODO: Beacon Time Stamp
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.dataLength,sizeof(quint32))!=sizeof(quint32))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&ethFrame.dataBytes,sizeof(quint64))!=sizeof(quint64))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
@@ -595,7 +603,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                             if(!dltFromEthernetFrame(recordData,pos,ethFrame.etherType,time/1000000000ul,time%1000000000ul/1000ul))
                             {
                                 inputfile.close();
-                                outputfile->close();
+                                closeOutputfile();
                                 qDebug() << "fromMF4: ERROR:" << "Size Error: Cannot read Ethernet Frame";
                                 return;
                             }
@@ -603,7 +611,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                             if(!ipcFromEthernetFrame(recordData,pos,ethFrame.etherType,time/1000000000ul,time%1000000000ul/1000ul))
                             {
                                 inputfile.close();
-                                outputfile->close();
+                                closeOutputfile();
                                 qDebug() << "fromMF4: ERROR:" << "Size Error: Cannot read Ethernet Frame";
                                 return;
                             }
@@ -617,49 +625,49 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                         if(inputfile.read((char*)&dltFrameBlock.timeStamp,sizeof(quint64))!=sizeof(quint64))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&dltFrameBlock.asynchronous,sizeof(quint8))!=sizeof(quint8))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&dltFrameBlock.currentFragmentNumber,sizeof(quint16))!=sizeof(quint16))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&dltFrameBlock.lastFragmentNumber,sizeof(quint16))!=sizeof(quint16))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&dltFrameBlock.ecuId,sizeof(quint32))!=sizeof(quint32))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&dltFrameBlock.dataLength,sizeof(quint32))!=sizeof(quint32))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&dltFrameBlock.dataBytes,sizeof(quint32))!=sizeof(quint32))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
@@ -670,7 +678,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                             if(!dltFrame(recordData,pos,time/1000000000ul,time%1000000000ul/1000ul))
                             {
                                 inputfile.close();
-                                outputfile->close();
+                                closeOutputfile();
                                 qDebug() << "fromMF4: ERROR:" << "Size Error: Cannot read DLTFrame";
                                 return;
                             }
@@ -684,63 +692,63 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                         if(inputfile.read((char*)&plpRaw.timeStamp,sizeof(quint64))!=sizeof(quint64))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&plpRaw.asynchronous,sizeof(quint8))!=sizeof(quint8))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&plpRaw.probeId,sizeof(quint16))!=sizeof(quint16))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&plpRaw.msgType,sizeof(quint16))!=sizeof(quint16))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&plpRaw.probeFlags,sizeof(quint16))!=sizeof(quint16))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&plpRaw.dataFlags,sizeof(quint16))!=sizeof(quint16))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&plpRaw.dataCounter,sizeof(quint16))!=sizeof(quint16))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&plpRaw.dataLength,sizeof(quint16))!=sizeof(quint16))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
                         if(inputfile.read((char*)&plpRaw.dataBytes,sizeof(quint32))!=sizeof(quint32))
                         {
                             inputfile.close();
-                            outputfile->close();
+                            closeOutputfile();
                             qDebug() << "fromMF4:" << "Size Error: Cannot read Record";
                             return;
                         }
@@ -750,7 +758,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
                             if(!ipcFromPlpRaw(&plpRaw,recordData,time/1000000000ul,time%1000000000ul/1000ul))
                             {
                                 inputfile.close();
-                                outputfile->close();
+                                closeOutputfile();
                                 qDebug() << "fromMF4: ERROR:" << "Size Error: Cannot read Ethernet Frame";
                                 return;
                             }
@@ -775,7 +783,7 @@ void QDltImporter::dltIpcFromMF4(QString fileName)
     }
 
     inputfile.close();
-    outputfile->close();
+    closeOutputfile();
 
     emit progress("",3,100);
 
@@ -1239,9 +1247,14 @@ void QDltImporter::writeDLTMessageToFile(QByteArray &bufferHeader,char* bufferPa
 
     dlt_set_id(str.ecu, ecuId.toLatin1());
 
-    outputfile->write((char*)&str,sizeof(DltStorageHeader));
-    outputfile->write(bufferHeader);
-    outputfile->write(bufferPayload,bufferPayloadSize);
+    writer.writeMessage(str, bufferHeader, std::string_view(bufferPayload, bufferPayloadSize));
+}
+
+void QDltImporter::closeOutputfile()
+{
+    /* the buffered messages are written, before the file is closed */
+    writer.close();
+    outputfile->close();
 }
 
 void QDltImporter::setPcapPorts(const QString &importPcapPorts)
@@ -8,6 +8,7 @@
 
 #include "export_rules.h"
 #include "dlt_common.h"
+#include "qdltfilewriter.h"
 
 #include <optional>
 
@@ -189,6 +190,7 @@ public:
     bool ipcFromPlpRaw(mdf_plpRaw_t *plpRaw, QByteArray &record,quint32 sec = 0,quint32 usec = 0);
 
     void writeDLTMessageToFile(QByteArray &bufferHeader,char* bufferPayload,quint32 bufferPayloadSize,QString ecuId,quint32 sec = 0,quint32 usec = 0);
+    void closeOutputfile();
 
     mdf_idblock_t mdfIdblock;
     mdf_hdblocklinks_t hdBlockLinks;
@@ -207,6 +209,7 @@ public:
     QMap<quint16,QString> channelGroupName;
 
     QFile *outputfile;
+    QDltFileWriter writer;
     QStringList fileNames;
 
     QList<unsigned short> pcapPorts;
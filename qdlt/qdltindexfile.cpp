@@ -0,0 +1,363 @@
+#include "qdltindexfile.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QThread>
+#include <QtEndian>
+
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// number of entries stored in one block
+const quint32 entriesPerBlock = 4096;
+
+// version, flags, entries per block, entry count (64 bit), block count, metadata size, checksum
+const qint64 fileHeaderSize = 32;
+
+// first entry (64 bit), entry count, data size, checksum
+const qint64 blockHeaderSize = 20;
+
+// smaller indexes are decoded by a single thread
+const qint64 parallelDecodeMinEntries = 1024 * 1024;
+
+// maximum size of an encoded 64 bit value
+const int maxVarintSize = 10;
+
+typedef struct
+{
+    const uchar *data;
+    qint64 first;
+    quint32 entries;
+    quint32 size;
+    quint32 checksum;
+    qint64 offset;
+} Block;
+
+quint32 adler32(const uchar *data, qint64 size)
+{
+    quint32 a = 1, b = 0;
+
+    while(size > 0)
+    {
+        // largest number of bytes before the sums must be reduced to avoid an overflow
+        qint64 count = qMin<qint64>(size, 5552);
+        size -= count;
+        while(count--)
+        {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+
+    return (b << 16) | a;
+}
+
+inline quint64 zigzagEncode(qint64 value)
+{
+    return (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63);
+}
+
+inline qint64 zigzagDecode(quint64 value)
+{
+    return static_cast<qint64>(value >> 1) ^ -static_cast<qint64>(value & 1);
+}
+
+inline uchar *writeVarint(uchar *data, quint64 value)
+{
+    while(value >= 0x80)
+    {
+        *data++ = static_cast<uchar>(value | 0x80);
+        value >>= 7;
+    }
+    *data++ = static_cast<uchar>(value);
+
+    return data;
+}
+
+inline bool readVarint(const uchar *&data, const uchar *end, quint64 &value)
+{
+    // most differences of message positions need one or two bytes
+    if(data < end && !(data[0] & 0x80))
+    {
+        value = data[0];
+        data += 1;
+        return true;
+    }
+    if(end - data >= 2 && !(data[1] & 0x80))
+    {
+        value = (data[0] & 0x7f) | (static_cast<quint64>(data[1]) << 7);
+        data += 2;
+        return true;
+    }
+
+    value = 0;
+    for(int shift = 0; data < end && shift < 64; shift += 7)
+    {
+        const uchar byte = *data++;
+        value |= static_cast<quint64>(byte & 0x7f) << shift;
+        if(!(byte & 0x80))
+            return true;
+    }
+
+    return false;
+}
+
+bool decodeBlock(const Block &block, qint64 *index)
+{
+    if(adler32(block.data, block.size) != block.checksum)
+        return false;
+
+    const uchar *data = block.data;
+    const uchar *end = block.data + block.size;
+    qint64 value = block.first;
+    quint64 difference;
+
+    index[0] = value;
+    for(quint32 num = 1; num < block.entries; num++)
+    {
+        if(!readVarint(data, end, difference))
+            return false;
+        value += zigzagDecode(difference);
+        index[num] = value;
+    }
+
+    return data == end;
+}
+
+bool decodeBlocks(const std::vector<Block> &blocks, size_t start, size_t end, qint64 *index)
+{
+    for(size_t num = start; num < end; num++)
+    {
+        if(!decodeBlock(blocks[num], index + blocks[num].offset))
+            return false;
+    }
+
+    return true;
+}
+
+}
+
+QByteArray QDltIndexFile::encode(const QVector<qint64> &index, const QByteArray &metadata)
+{
+    const qint64 entryCount = index.size();
+    const quint32 blockCount = static_cast<quint32>((entryCount + entriesPerBlock - 1) / entriesPerBlock);
+    QByteArray data;
+
+    data.resize(static_cast<int>(fileHeaderSize));
+    uchar *header = reinterpret_cast<uchar *>(data.data());
+    qToLittleEndian<quint32>(QDLT_INDEX_FILE_VERSION_BLOCKS, header);
+    qToLittleEndian<quint32>(0, header + 4); // flags, reserved
+    qToLittleEndian<quint32>(entriesPerBlock, header + 8);
+    qToLittleEndian<quint64>(static_cast<quint64>(entryCount), header + 12);
+    qToLittleEndian<quint32>(blockCount, header + 20);
+    qToLittleEndian<quint32>(static_cast<quint32>(metadata.size()), header + 24);
+    data += metadata;
+
+    // the checksum covers the header and the metadata
+    QByteArray checked = data.left(static_cast<int>(fileHeaderSize - 4)) + metadata;
+    qToLittleEndian<quint32>(adler32(reinterpret_cast<const uchar *>(checked.constData()), checked.size()),
+                             reinterpret_cast<uchar *>(data.data()) + 28);
+
+    for(qint64 start = 0; start < entryCount; start += entriesPerBlock)
+    {
+        const quint32 entries = static_cast<quint32>(qMin<qint64>(entriesPerBlock, entryCount - start));
+        const int blockPos = data.size();
+
+        // reserve the maximum size, shrinked after encoding
+        data.resize(static_cast<int>(blockPos + blockHeaderSize + (entries - 1) * maxVarintSize));
+        uchar *block = reinterpret_cast<uchar *>(data.data()) + blockPos;
+        uchar *payload = block + blockHeaderSize;
+        uchar *pos = payload;
+
+        for(quint32 num = 1; num < entries; num++)
+            pos = writeVarint(pos, zigzagEncode(index[start + num] - index[start + num - 1]));
+
+        const quint32 size = static_cast<quint32>(pos - payload);
+        qToLittleEndian<qint64>(index[start], block);
+        qToLittleEndian<quint32>(entries, block + 8);
+        qToLittleEndian<quint32>(size, block + 12);
+        qToLittleEndian<quint32>(adler32(payload, size), block + 16);
+        data.resize(static_cast<int>(blockPos + blockHeaderSize + size));
+    }
+
+    return data;
+}
+
+bool QDltIndexFile::decode(const char *data, qint64 size, QVector<qint64> &index, QByteArray *metadata)
+{
+    const uchar *bytes = reinterpret_cast<const uchar *>(data);
+
+    index.clear();
+    if(metadata)
+        metadata->clear();
+
+    if(size < 4)
+        return false;
+
+    const quint32 version = qFromLittleEndian<quint32>(bytes);
+
+    if(version == QDLT_INDEX_FILE_VERSION_RAW)
+    {
+        // one qint64 per entry, an incomplete entry at the end is ignored
+        const qint64 entryCount = (size - 4) / static_cast<qint64>(sizeof(qint64));
+        if(entryCount > std::numeric_limits<int>::max())
+            return false;
+        index.resize(static_cast<int>(entryCount));
+        memcpy(index.data(), data + 4, entryCount * sizeof(qint64));
+        return true;
+    }
+
+    if(version != QDLT_INDEX_FILE_VERSION_BLOCKS || size < fileHeaderSize)
+        return false;
+
+    const quint32 blockEntries = qFromLittleEndian<quint32>(bytes + 8);
+    const quint64 entryCount = qFromLittleEndian<quint64>(bytes + 12);
+    const quint32 blockCount = qFromLittleEndian<quint32>(bytes + 20);
+    const quint32 metadataSize = qFromLittleEndian<quint32>(bytes + 24);
+    const quint32 checksum = qFromLittleEndian<quint32>(bytes + 28);
+
+    if(blockEntries == 0 || entryCount > static_cast<quint64>(std::numeric_limits<int>::max()) ||
+       static_cast<qint64>(metadataSize) > size - fileHeaderSize)
+        return false;
+
+    QByteArray checked(data, static_cast<int>(fileHeaderSize - 4));
+    checked.append(data + fileHeaderSize, static_cast<int>(metadataSize));
+    if(adler32(reinterpret_cast<const uchar *>(checked.constData()), checked.size()) != checksum)
+        return false;
+
+    // walk through the block headers, to know where each block is decoded to
+    std::vector<Block> blocks;
+    blocks.reserve(blockCount);
+    qint64 pos = fileHeaderSize + metadataSize;
+    qint64 offset = 0;
+    for(quint32 num = 0; num < blockCount; num++)
+    {
+        if(size - pos < blockHeaderSize)
+            return false;
+
+        Block block;
+        block.first = qFromLittleEndian<qint64>(bytes + pos);
+        block.entries = qFromLittleEndian<quint32>(bytes + pos + 8);
+        block.size = qFromLittleEndian<quint32>(bytes + pos + 12);
+        block.checksum = qFromLittleEndian<quint32>(bytes + pos + 16);
+        block.data = bytes + pos + blockHeaderSize;
+        block.offset = offset;
+
+        if(block.entries == 0 || block.entries > blockEntries || static_cast<qint64>(block.size) > size - pos - blockHeaderSize)
+            return false;
+
+        pos += blockHeaderSize + block.size;
+        offset += block.entries;
+        blocks.push_back(block);
+    }
+    if(pos != size || static_cast<quint64>(offset) != entryCount)
+        return false;
+
+    if(metadata)
+        *metadata = QByteArray(data + fileHeaderSize, static_cast<int>(metadataSize));
+
+    index.resize(static_cast<int>(entryCount));
+    qint64 *values = index.data();
+    bool ok = true;
+
+    const int threadCount = qMin<qint64>(QThread::idealThreadCount(), static_cast<qint64>(entryCount) / parallelDecodeMinEntries + 1);
+    if(threadCount <= 1)
+    {
+        ok = decodeBlocks(blocks, 0, blocks.size(), values);
+    }
+    else
+    {
+        // the blocks are independent, decode them in parallel
+        std::vector<std::thread> threads;
+        std::vector<char> results(threadCount, 0);
+        const size_t blocksPerThread = (blocks.size() + threadCount - 1) / threadCount;
+        for(int num = 0; num < threadCount; num++)
+        {
+            const size_t start = qMin(blocks.size(), num * blocksPerThread);
+            const size_t end = qMin(blocks.size(), start + blocksPerThread);
+            threads.emplace_back([&blocks, &results, start, end, values, num]() {
+                results[num] = decodeBlocks(blocks, start, end, values);
+            });
+        }
+        for(std::thread &thread : threads)
+            thread.join();
+        for(char result : results)
+            ok = ok && result;
+    }
+
+    if(!ok)
+    {
+        index.clear();
+        if(metadata)
+            metadata->clear();
+    }
+
+    return ok;
+}
+
+bool QDltIndexFile::save(const QString &filename, const QVector<qint64> &index, const QByteArray &metadata)
+{
+    const QByteArray data = encode(index, metadata);
+
+    QFile file(filename);
+
+    // open index file
+    if(!file.open(QFile::WriteOnly))
+        return false;
+
+    // write the complete file at once
+    if(file.write(data) != data.size())
+    {
+        file.close();
+        file.remove();
+        return false;
+    }
+
+    file.close();
+
+    return true;
+}
+
+bool QDltIndexFile::load(const QString &filename, QVector<qint64> &index, QByteArray *metadata)
+{
+    QFile file(filename);
+    bool ok;
+
+    index.clear();
+    if(metadata)
+        metadata->clear();
+
+    // open index file
+    if(!file.open(QFile::ReadOnly))
+        return false;
+
+    const qint64 size = file.size();
+    if(size <= 0)
+        return false;
+
+    // map the file into memory, read it at once if mapping fails
+    uchar *data = file.map(0, size);
+    if(data)
+    {
+        ok = decode(reinterpret_cast<const char *>(data), size, index, metadata);
+        file.unmap(data);
+    }
+    else
+    {
+        const QByteArray buffer = file.readAll();
+        ok = decode(buffer.constData(), buffer.size(), index, metadata);
+    }
+
+    file.close();
+
+    if(!ok)
+        qDebug() << "Loading index file" << filename << "failed, unknown version or corrupt";
+
+    return ok;
+}
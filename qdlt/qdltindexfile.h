@@ -0,0 +1,58 @@
+#ifndef QDLTINDEXFILE_H
+#define QDLTINDEXFILE_H
+
+#include "export_rules.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+//! Version of index files with one raw qint64 per entry.
+#define QDLT_INDEX_FILE_VERSION_RAW 2
+
+//! Version of index files with delta encoded blocks.
+#define QDLT_INDEX_FILE_VERSION_BLOCKS 3
+
+//! Read and write index cache files (.dix).
+/*!
+  Index files are written in version 3, which stores the entries in blocks.
+  Each block starts with a header containing the first entry, the number of
+  entries, the size and the checksum of the block data. The following entries
+  are stored as zigzag and varint encoded differences to the previous entry,
+  which needs about two bytes per entry for the positions of DLT messages.
+  The file header contains the number of entries and blocks, optional
+  metadata of the caller and a checksum.
+
+  Version 3 files are loaded by mapping the file into memory or by a single
+  read; as the blocks are independent, large indexes are decoded by several
+  threads. Index files of version 2 are still loaded.
+*/
+class QDLT_EXPORT QDltIndexFile
+{
+public:
+    //! Save an index in the current index file version.
+    /*!
+      \param filename The name of the index file.
+      \param index The index to be saved.
+      \param metadata Additional data stored in the file header.
+      \return true if the file was written successfully.
+    */
+    static bool save(const QString &filename, const QVector<qint64> &index, const QByteArray &metadata = QByteArray());
+
+    //! Load an index file of version 2 or 3.
+    /*!
+      \param filename The name of the index file.
+      \param index The loaded index, empty if loading failed.
+      \param metadata If not null, filled with the metadata stored in the file header.
+      \return false if the file cannot be read, has an unknown version or is corrupt.
+    */
+    static bool load(const QString &filename, QVector<qint64> &index, QByteArray *metadata = nullptr);
+
+    //! Encode an index in the format of version 3.
+    static QByteArray encode(const QVector<qint64> &index, const QByteArray &metadata = QByteArray());
+
+    //! Decode an index in the format of version 2 or 3.
+    static bool decode(const char *data, qint64 size, QVector<qint64> &index, QByteArray *metadata = nullptr);
+};
+
+#endif // QDLTINDEXFILE_H
@@ -1,59 +1,143 @@
 #ifndef QDLTLRUCACHE_HPP
 #define QDLTLRUCACHE_HPP
 
-#include <unordered_map>
-#include <list>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <stdexcept>
+#include <vector>
 
+//! Cache which keeps the recently used values, with an approximated LRU eviction.
+/*!
+  All slots are allocated by the constructor, put() and get() do not allocate
+  memory. The keys are found in an open addressing hash table with linear
+  probing, which stores the numbers of the slots. When the cache is full, the
+  slot to be replaced is selected with the CLOCK algorithm: a hand runs over
+  the slots and takes the first slot which was not read since the hand passed
+  it last time. A value which was put but never read is replaced first, so a
+  single pass over many keys does not push out the values in use.
+  Values must be default constructible and copy assignable.
+*/
 template<typename Key, typename Value>
 class QDltLruCache {
 
     struct CacheEntry {
-        Key key;
-        Value value;
+        Key key{};
+        Value value{};
+        bool referenced{false};
     };
 
-    using CacheListIterator = typename std::list<CacheEntry>::iterator;
+    static constexpr std::uint32_t Empty = UINT32_MAX;
+
 public:
 
     QDltLruCache(size_t capacity) :
-        m_capacity(capacity) {
+        m_capacity(capacity > 0 ? capacity : 1) {
+        // the table is kept at most half full, so the probe sequences stay short
+        size_t tableSize = 2;
+        while (tableSize < 2 * m_capacity)
+            tableSize *= 2;
+        m_mask = tableSize - 1;
+        m_table.assign(tableSize, Empty);
+        m_cacheItems.resize(m_capacity);
     }
 
     void put(const Key& key, const Value& value) {
-        auto it = m_keyIteratorsMap.find(key);
-        m_cacheItems.push_front(CacheEntry{key, value});
-        if (it != m_keyIteratorsMap.end()) {
-            m_cacheItems.erase(it->second);
-            m_keyIteratorsMap.erase(it);
+        size_t position = find(key);
+        if (m_table[position] != Empty) {
+            CacheEntry& entry = m_cacheItems[m_table[position]];
+            entry.value = value;
+            entry.referenced = true;
+            return;
         }
-        m_keyIteratorsMap[key] = m_cacheItems.begin();
 
-        if (m_keyIteratorsMap.size() > m_capacity) {
-            auto last = std::prev(m_cacheItems.end());
-            m_keyIteratorsMap.erase(last->key);
-            m_cacheItems.pop_back();
+        std::uint32_t slot;
+        if (m_size < m_capacity) {
+            slot = static_cast<std::uint32_t>(m_size++);
+        } else {
+            slot = evict();
+            // removing the evicted key may move the probe sequence of the new key
+            position = find(key);
         }
+
+        CacheEntry& entry = m_cacheItems[slot];
+        entry.key = key;
+        entry.value = value;
+        entry.referenced = false;
+        m_table[position] = slot;
     }
 
     const Value& get(const Key& key) {
-        auto it = m_keyIteratorsMap.find(key);
-        if (it == m_keyIteratorsMap.end()) {
+        const std::uint32_t slot = m_table[find(key)];
+        if (slot == Empty) {
             throw std::range_error("no such key in cache found");
         }
 
-        m_cacheItems.splice(m_cacheItems.begin(), m_cacheItems, it->second);
-        return it->second->value;
+        CacheEntry& entry = m_cacheItems[slot];
+        entry.referenced = true;
+        return entry.value;
     }
 
     bool exists(const Key& key) const {
-        return m_keyIteratorsMap.find(key) != m_keyIteratorsMap.end();
+        return m_table[find(key)] != Empty;
+    }
+
+    void clear() {
+        std::fill(m_table.begin(), m_table.end(), Empty);
+        for (CacheEntry& entry : m_cacheItems)
+            entry = CacheEntry();
+        m_size = 0;
+        m_hand = 0;
     }
 
 private:
-    std::list<CacheEntry> m_cacheItems;
-    std::unordered_map<Key, CacheListIterator> m_keyIteratorsMap;
+    size_t bucket(const Key& key) const {
+        // std::hash of integers is the identity, the multiplication spreads consecutive keys
+        return static_cast<size_t>((static_cast<std::uint64_t>(std::hash<Key>()(key)) * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & m_mask;
+    }
+
+    // position of the key in the table, or of the empty position where it would be inserted
+    size_t find(const Key& key) const {
+        size_t position = bucket(key);
+        while (m_table[position] != Empty && !(m_cacheItems[m_table[position]].key == key))
+            position = (position + 1) & m_mask;
+        return position;
+    }
+
+    // the slot of the first value not read since the last pass of the hand
+    std::uint32_t evict() {
+        while (m_cacheItems[m_hand].referenced) {
+            m_cacheItems[m_hand].referenced = false;
+            m_hand = (m_hand + 1) % m_capacity;
+        }
+
+        const std::uint32_t slot = static_cast<std::uint32_t>(m_hand);
+        m_hand = (m_hand + 1) % m_capacity;
+        remove(find(m_cacheItems[slot].key));
+        return slot;
+    }
+
+    // remove a position from the table, the following entries of the probe sequence are shifted back
+    void remove(size_t hole) {
+        size_t position = (hole + 1) & m_mask;
+        while (m_table[position] != Empty) {
+            const size_t home = bucket(m_cacheItems[m_table[position]].key);
+            if (((position - home) & m_mask) >= ((position - hole) & m_mask)) {
+                m_table[hole] = m_table[position];
+                hole = position;
+            }
+            position = (position + 1) & m_mask;
+        }
+        m_table[hole] = Empty;
+    }
+
+    std::vector<CacheEntry> m_cacheItems;
+    std::vector<std::uint32_t> m_table;
     const size_t m_capacity;
+    size_t m_mask{0};
+    size_t m_size{0};
+    size_t m_hand{0};
 };
 
 #endif // QDLTLRUCACHE_HPP
@@ -0,0 +1,339 @@
+#include "qdltmetadataindex.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFile>
+#include <QtEndian>
+
+namespace {
+
+// ids are stored in 16 bit, the last id is reserved to mark an overflow
+const int maxTableSize = 0xffff;
+
+// size of the MD5 checksum at the end of a metadata index file
+const int checksumSize = 16;
+
+template<typename T>
+void writeColumn(QByteArray &data, const QVector<T> &column)
+{
+    const int pos = data.size();
+    data.resize(pos + column.size() * static_cast<int>(sizeof(T)));
+    qToLittleEndian<T>(column.constData(), column.size(), data.data() + pos);
+}
+
+template<typename T>
+bool readColumn(const QByteArray &data, int &pos, int size, QVector<T> &column)
+{
+    const qint64 bytes = static_cast<qint64>(size) * sizeof(T);
+    if(bytes > data.size() - pos)
+        return false;
+    column.resize(size);
+    qFromLittleEndian<T>(data.constData() + pos, size, column.data());
+    pos += static_cast<int>(bytes);
+    return true;
+}
+
+void writeValue(QByteArray &data, quint32 value)
+{
+    const int pos = data.size();
+    data.resize(pos + 4);
+    qToLittleEndian<quint32>(value, data.data() + pos);
+}
+
+bool readValue(const QByteArray &data, int &pos, quint32 &value)
+{
+    if(data.size() - pos < 4)
+        return false;
+    value = qFromLittleEndian<quint32>(data.constData() + pos);
+    pos += 4;
+    return true;
+}
+
+void writeTable(QByteArray &data, const QStringList &table)
+{
+    writeValue(data, static_cast<quint32>(table.size()));
+    for(const QString &text : table)
+    {
+        const QByteArray utf8 = text.toUtf8();
+        writeValue(data, static_cast<quint32>(utf8.size()));
+        data += utf8;
+    }
+}
+
+bool readTable(const QByteArray &data, int &pos, QStringList &table)
+{
+    quint32 count, length;
+
+    table.clear();
+    if(!readValue(data, pos, count) || count > static_cast<quint32>(maxTableSize))
+        return false;
+    for(quint32 num = 0; num < count; num++)
+    {
+        if(!readValue(data, pos, length) || length > static_cast<quint32>(data.size() - pos))
+            return false;
+        table.append(QString::fromUtf8(data.constData() + pos, static_cast<int>(length)));
+        pos += static_cast<int>(length);
+    }
+    return true;
+}
+
+template<typename T>
+bool validIds(const QVector<T> &column, const QStringList &table)
+{
+    for(T id : column)
+    {
+        if(id >= table.size())
+            return false;
+    }
+    return true;
+}
+
+}
+
+QDltMetadataIndex::QDltMetadataIndex()
+    : overflow(false)
+{
+}
+
+void QDltMetadataIndex::clear()
+{
+    ecuids.clear();
+    apids.clear();
+    ctids.clear();
+    ecuidTable.clear();
+    apidTable.clear();
+    ctidTable.clear();
+    ecuidLookup.clear();
+    apidLookup.clear();
+    ctidLookup.clear();
+    flags.clear();
+    types.clear();
+    subtypes.clear();
+    modes.clear();
+    messageIds.clear();
+    times.clear();
+    microseconds.clear();
+    timestamps.clear();
+    overflow = false;
+}
+
+void QDltMetadataIndex::reserve(int size)
+{
+    ecuids.reserve(size);
+    apids.reserve(size);
+    ctids.reserve(size);
+    flags.reserve(size);
+    types.reserve(size);
+    subtypes.reserve(size);
+    modes.reserve(size);
+    messageIds.reserve(size);
+    times.reserve(size);
+    microseconds.reserve(size);
+    timestamps.reserve(size);
+}
+
+quint16 QDltMetadataIndex::intern(QStringList &table, QHash<QString, quint16> &lookup, const QString &id)
+{
+    const auto it = lookup.constFind(id);
+    if(it != lookup.constEnd())
+        return it.value();
+
+    if(table.size() >= maxTableSize)
+    {
+        overflow = true;
+        return 0;
+    }
+
+    const quint16 value = static_cast<quint16>(table.size());
+    table.append(id);
+    lookup.insert(id, value);
+
+    return value;
+}
+
+void QDltMetadataIndex::appendRow(quint8 flag, quint16 ecuid, quint16 apid, quint16 ctid, quint8 type, quint8 subtype, quint8 mode,
+                                  quint32 messageId, qint64 time, quint32 microseconds, quint32 timestamp)
+{
+    flags.append(flag);
+    ecuids.append(ecuid);
+    apids.append(apid);
+    ctids.append(ctid);
+    types.append(type);
+    subtypes.append(subtype);
+    modes.append(mode);
+    messageIds.append(messageId);
+    times.append(time);
+    this->microseconds.append(microseconds);
+    timestamps.append(timestamp);
+}
+
+void QDltMetadataIndex::append(const QDltMsg &msg)
+{
+    const quint16 ecuid = intern(ecuidTable, ecuidLookup, msg.getEcuid());
+    const quint16 apid = intern(apidTable, apidLookup, msg.getApid());
+    const quint16 ctid = intern(ctidTable, ctidLookup, msg.getCtid());
+
+    appendRow(FlagValid, ecuid, apid, ctid,
+              static_cast<quint8>(msg.getType()), static_cast<quint8>(msg.getSubtype()), static_cast<quint8>(msg.getMode()),
+              msg.getMessageId(), static_cast<qint64>(msg.getTime()), msg.getMicroseconds(), msg.getTimestamp());
+}
+
+void QDltMetadataIndex::appendInvalid()
+{
+    // invalid rows use the first entry of each string table
+    const quint16 ecuid = intern(ecuidTable, ecuidLookup, QString());
+    const quint16 apid = intern(apidTable, apidLookup, QString());
+    const quint16 ctid = intern(ctidTable, ctidLookup, QString());
+
+    appendRow(0, ecuid, apid, ctid, 0, 0, 0, 0, 0, 0, 0);
+}
+
+QDltMetadataIndex QDltMetadataIndex::mid(int pos, int length) const
+{
+    QDltMetadataIndex result;
+
+    result.ecuids = ecuids.mid(pos, length);
+    result.apids = apids.mid(pos, length);
+    result.ctids = ctids.mid(pos, length);
+    result.ecuidTable = ecuidTable;
+    result.apidTable = apidTable;
+    result.ctidTable = ctidTable;
+    result.ecuidLookup = ecuidLookup;
+    result.apidLookup = apidLookup;
+    result.ctidLookup = ctidLookup;
+    result.flags = flags.mid(pos, length);
+    result.types = types.mid(pos, length);
+    result.subtypes = subtypes.mid(pos, length);
+    result.modes = modes.mid(pos, length);
+    result.messageIds = messageIds.mid(pos, length);
+    result.times = times.mid(pos, length);
+    result.microseconds = microseconds.mid(pos, length);
+    result.timestamps = timestamps.mid(pos, length);
+    result.overflow = overflow;
+
+    return result;
+}
+
+void QDltMetadataIndex::rebuildLookup()
+{
+    ecuidLookup.clear();
+    apidLookup.clear();
+    ctidLookup.clear();
+    for(int num = 0; num < ecuidTable.size(); num++)
+        ecuidLookup.insert(ecuidTable[num], static_cast<quint16>(num));
+    for(int num = 0; num < apidTable.size(); num++)
+        apidLookup.insert(apidTable[num], static_cast<quint16>(num));
+    for(int num = 0; num < ctidTable.size(); num++)
+        ctidLookup.insert(ctidTable[num], static_cast<quint16>(num));
+}
+
+bool QDltMetadataIndex::save(const QString &filename, const QByteArray &key) const
+{
+    QByteArray data;
+
+    if(overflow)
+        return false;
+
+    // header
+    writeValue(data, QDLT_METADATA_INDEX_FILE_VERSION);
+    writeValue(data, static_cast<quint32>(size()));
+    writeValue(data, static_cast<quint32>(key.size()));
+    data += key;
+
+    // string tables and columns
+    writeTable(data, ecuidTable);
+    writeTable(data, apidTable);
+    writeTable(data, ctidTable);
+    writeColumn(data, flags);
+    writeColumn(data, ecuids);
+    writeColumn(data, apids);
+    writeColumn(data, ctids);
+    writeColumn(data, types);
+    writeColumn(data, subtypes);
+    writeColumn(data, modes);
+    writeColumn(data, messageIds);
+    writeColumn(data, times);
+    writeColumn(data, microseconds);
+    writeColumn(data, timestamps);
+
+    data += QCryptographicHash::hash(data, QCryptographicHash::Md5);
+
+    QFile file(filename);
+
+    // open metadata index file
+    if(!file.open(QFile::WriteOnly))
+        return false;
+
+    // write the complete file at once
+    if(file.write(data) != data.size())
+    {
+        file.close();
+        file.remove();
+        return false;
+    }
+
+    file.close();
+
+    return true;
+}
+
+bool QDltMetadataIndex::load(const QString &filename, const QByteArray &key)
+{
+    QFile file(filename);
+    quint32 version, rows, keySize;
+    int pos = 0;
+
+    clear();
+
+    // open metadata index file
+    if(!file.open(QFile::ReadOnly))
+        return false;
+
+    QByteArray data = file.readAll();
+    file.close();
+
+    // check the checksum first, so all sizes can be trusted
+    if(data.size() < checksumSize ||
+       QCryptographicHash::hash(QByteArray::fromRawData(data.constData(), data.size() - checksumSize), QCryptographicHash::Md5) != data.right(checksumSize))
+    {
+        qDebug() << "Loading metadata index file" << filename << "failed, file is corrupt";
+        return false;
+    }
+    data.chop(checksumSize);
+
+    if(!readValue(data, pos, version) || version != QDLT_METADATA_INDEX_FILE_VERSION ||
+       !readValue(data, pos, rows) || rows > static_cast<quint32>(data.size()) ||
+       !readValue(data, pos, keySize) || keySize > static_cast<quint32>(data.size() - pos) ||
+       QByteArray::fromRawData(data.constData() + pos, static_cast<int>(keySize)) != key)
+    {
+        return false;
+    }
+    pos += static_cast<int>(keySize);
+
+    const int size = static_cast<int>(rows);
+    bool ok = readTable(data, pos, ecuidTable) && readTable(data, pos, apidTable) && readTable(data, pos, ctidTable) &&
+              readColumn(data, pos, size, flags) &&
+              readColumn(data, pos, size, ecuids) &&
+              readColumn(data, pos, size, apids) &&
+              readColumn(data, pos, size, ctids) &&
+              readColumn(data, pos, size, types) &&
+              readColumn(data, pos, size, subtypes) &&
+              readColumn(data, pos, size, modes) &&
+              readColumn(data, pos, size, messageIds) &&
+              readColumn(data, pos, size, times) &&
+              readColumn(data, pos, size, microseconds) &&
+              readColumn(data, pos, size, timestamps) &&
+              pos == data.size() &&
+              validIds(ecuids, ecuidTable) && validIds(apids, apidTable) && validIds(ctids, ctidTable);
+
+    if(!ok)
+    {
+        qDebug() << "Loading metadata index file" << filename << "failed, unknown format";
+        clear();
+        return false;
+    }
+
+    rebuildLookup();
+
+    return true;
+}
@@ -0,0 +1,135 @@
+#ifndef QDLTMETADATAINDEX_H
+#define QDLTMETADATAINDEX_H
+
+#include "export_rules.h"
+#include "qdltmsg.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+//! Version of metadata index files.
+#define QDLT_METADATA_INDEX_FILE_VERSION 1
+
+//! Header fields of all messages of a DLT log file, stored column by column.
+/*!
+  The metadata index contains one row per message of the index of a DLT log
+  file. ECU, application and context ids are interned, each column stores the
+  number of the id in a string table. Together with type, subtype, mode,
+  message id, time and timestamp this is all filters need, which do not check
+  the header or payload text. Such filters are checked by a scan over the
+  columns without reading and parsing the messages again.
+  A row is marked invalid, if the message could not be parsed, as such
+  messages are skipped when filtering.
+*/
+class QDLT_EXPORT QDltMetadataIndex
+{
+public:
+    //! Constructor.
+    QDltMetadataIndex();
+
+    //! Remove all rows and string tables.
+    void clear();
+
+    //! Get the number of rows.
+    int size() const { return static_cast<int>(flags.size()); }
+
+    //! Reserve memory for a number of rows.
+    void reserve(int size);
+
+    //! Append the header fields of a parsed message.
+    void append(const QDltMsg &msg);
+
+    //! Append a row for a message which could not be parsed.
+    void appendInvalid();
+
+    //! Get a copy of a range of rows.
+    /*!
+      \param pos First row to be copied.
+      \param length Number of rows to be copied.
+      \return The rows, the string tables are copied completely.
+    */
+    QDltMetadataIndex mid(int pos, int length) const;
+
+    //! Check if all rows could be stored.
+    /*!
+      \return false if a string table overflowed, the index must not be used then.
+    */
+    bool isValid() const { return !overflow; }
+
+    //! Check if the message of a row could be parsed.
+    bool isMsgValid(int num) const { return flags[num] & FlagValid; }
+
+    //! Get the interned ids of a row, the number of the string in the string table.
+    int getEcuidId(int num) const { return ecuids[num]; }
+    int getApidId(int num) const { return apids[num]; }
+    int getCtidId(int num) const { return ctids[num]; }
+
+    //! Get the string tables of the interned ids.
+    const QStringList &getEcuidTable() const { return ecuidTable; }
+    const QStringList &getApidTable() const { return apidTable; }
+    const QStringList &getCtidTable() const { return ctidTable; }
+
+    //! Get the header fields of a row.
+    QString getEcuid(int num) const { return ecuidTable[ecuids[num]]; }
+    QString getApid(int num) const { return apidTable[apids[num]]; }
+    QString getCtid(int num) const { return ctidTable[ctids[num]]; }
+    QDltMsg::DltTypeDef getType(int num) const { return static_cast<QDltMsg::DltTypeDef>(types[num]); }
+    int getSubtype(int num) const { return subtypes[num]; }
+    QDltMsg::DltModeDef getMode(int num) const { return static_cast<QDltMsg::DltModeDef>(modes[num]); }
+    unsigned int getMessageId(int num) const { return messageIds[num]; }
+    time_t getTime(int num) const { return static_cast<time_t>(times[num]); }
+    unsigned int getMicroseconds(int num) const { return microseconds[num]; }
+    unsigned int getTimestamp(int num) const { return timestamps[num]; }
+
+    //! Save the metadata index to a file.
+    /*!
+      \param filename The name of the file.
+      \param key Data identifying the indexed DLT log file, checked when loading.
+      \return true if the file was written successfully.
+    */
+    bool save(const QString &filename, const QByteArray &key) const;
+
+    //! Load the metadata index from a file.
+    /*!
+      \param filename The name of the file.
+      \param key Data identifying the indexed DLT log file, must be the key used when saving.
+      \return false if the file cannot be read, is corrupt or was saved with another key.
+    */
+    bool load(const QString &filename, const QByteArray &key);
+
+private:
+    typedef enum { FlagValid = 0x01 } Flags;
+
+    quint16 intern(QStringList &table, QHash<QString, quint16> &lookup, const QString &id);
+    void appendRow(quint8 flag, quint16 ecuid, quint16 apid, quint16 ctid, quint8 type, quint8 subtype, quint8 mode,
+                   quint32 messageId, qint64 time, quint32 microseconds, quint32 timestamp);
+    void rebuildLookup();
+
+    //! Interned ids and their string tables.
+    QVector<quint16> ecuids;
+    QVector<quint16> apids;
+    QVector<quint16> ctids;
+    QStringList ecuidTable;
+    QStringList apidTable;
+    QStringList ctidTable;
+    QHash<QString, quint16> ecuidLookup;
+    QHash<QString, quint16> apidLookup;
+    QHash<QString, quint16> ctidLookup;
+
+    //! Message info and time columns.
+    QVector<quint8> flags;
+    QVector<quint8> types;
+    QVector<quint8> subtypes;
+    QVector<quint8> modes;
+    QVector<quint32> messageIds;
+    QVector<qint64> times;
+    QVector<quint32> microseconds;
+    QVector<quint32> timestamps;
+
+    //! More different ids than fit into a string table.
+    bool overflow;
+};
+
+#endif // QDLTMETADATAINDEX_H
@@ -42,6 +42,25 @@ namespace {
                                        "get_local_time","use_ecu_id","use_session_id","use_timestamp","use_extended_header","set_default_log_level","set_default_trace_status",
                                        "get_software_version","message_buffer_overflow"};
     constexpr const char * const qDltCtrlReturnType [] = {"ok","not_supported","error","3","4","5","6","7","no_matching_context_id"};
+
+    // write an id into a header field of four bytes
+    void writeId(char *field, const QString &id)
+    {
+        strncpy(field,id.toLatin1().constData(),id.size()>3?4:id.size()+1);
+    }
+
+    // length of an id in a header field of four bytes, the first byte is always part of the id
+    int idLength(const char *text)
+    {
+        if(text[1]==0)
+            return 1;
+        else if(text[2]==0)
+            return 2;
+        else if(text[3]==0)
+            return 3;
+        else
+            return 4;
+    }
 }
 
 QDltMsg::QDltMsg()
@@ -51,15 +70,107 @@ QDltMsg::QDltMsg()
 
 QString QDltMsg::getStringFromId(const char *text)
 {
-    if(text[1]==0)
-        return QString(QByteArray(text,1));
-    else if(text[2]==0)
-        return QString(QByteArray(text,2));
-    else if(text[3]==0)
-        return QString(QByteArray(text,3));
-    else
-        return QString(QByteArray(text,4));
+    return QString(QByteArray(text,idLength(text)));
+}
+
+bool QDltMsg::packId(const QString &id, quint32 &value)
+{
+    value = 0;
+
+    if(id.size() > 4)
+        return false;
+
+    for(int num = 0; num < id.size(); num++)
+    {
+        const ushort character = id.at(num).unicode();
+        if(character == 0 || character > 0x7f)
+        {
+            value = 0;
+            return false;
+        }
+        value |= static_cast<quint32>(character) << (num * 8);
+    }
+
+    return true;
+}
+
+QString QDltMsg::getIdString(quint32 packed, QString LongIds::*longId) const
+{
+    if(packed == 0)
+        return longIds.constData() ? longIds.constData()->*longId : QString();
+
+    char text[4];
+    qToLittleEndian(packed, text);
+
+    return QString::fromLatin1(text, static_cast<int>(qstrnlen(text, 4)));
+}
+
+void QDltMsg::setIdString(quint32 &packed, QString LongIds::*longId, const QString &id)
+{
+    if(packId(id, packed))
+    {
+        if(hasLongId(longId))
+            (longIds.data()->*longId).clear();
+        return;
+    }
+
+    if(!longIds)
+        longIds = new LongIds;
+    longIds.data()->*longId = id;
+}
+
+void QDltMsg::setIdBytes(quint32 &packed, QString LongIds::*longId, const char *text, int size)
+{
+    /* ids of up to four ASCII characters are packed without building a string */
+    packed = 0;
+    bool packable = (size <= 4);
+    for(int num = 0; packable && num < size; num++)
+    {
+        const uchar character = static_cast<uchar>(text[num]);
+        if(character == 0 || character > 0x7f)
+            packable = false;
+        else
+            packed |= static_cast<quint32>(character) << (num * 8);
+    }
+
+    if(packable)
+    {
+        if(hasLongId(longId))
+            (longIds.data()->*longId).clear();
+        return;
+    }
+
+    /* other ids, e.g. with zero bytes, are converted as before */
+    setIdString(packed, longId, QString(QByteArray(text, size)));
+}
+
+QString QDltMsg::getSessionName() const
+{
+    return longIds.constData() ? longIds.constData()->sessionName : QString();
+}
+
+void QDltMsg::setSessionName(QString sessionName)
+{
+    if(!longIds)
+    {
+        if(sessionName.isEmpty())
+            return;
+        longIds = new LongIds;
+    }
+    longIds->sessionName = sessionName;
+}
 
+void QDltMsg::setHeader(QByteArray &data)
+{
+    headerAndPayload = data + getPayload();
+    storedHeaderSize = data.size();
+}
+
+void QDltMsg::setPayload(QByteArray &data)
+{
+    parseLazyArguments();
+    headerAndPayload.truncate(storedHeaderSize);
+    headerAndPayload += data;
 }
 
 QString QDltMsg::getTypeString() const
@@ -309,10 +420,8 @@ quint32 QDltMsg::checkMsgSize(const char *data,quint32 size,bool supportDLTv2)
     }
 }
 
-bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader,bool supportDLTv2)
+bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader,bool supportDLTv2,bool lazyArguments)
 {
-    unsigned int offset;
-    QDltArgument argument;
     const DltStorageHeader *storageheader = 0;
     const DltStandardHeader *standardheader = 0;
     const DltExtendedHeader *extendedheader = 0;
@@ -406,8 +515,9 @@ bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader,bool supportD
         /* store header size */
         headerSize = headersize;
 
-        /* copy header */
-        header = buf.mid(0,headersize);
+        /* copy header and the available part of the payload into one buffer, deep copy, buf may be a view on a memory mapped file */
+        storedHeaderSize = headersize;
+        headerAndPayload = QByteArray(buf.constData(),headersize + qBound(0,(int)payloadSize,(int)buf.size() - (int)headersize));
 
         /* load standard header extra parameters and Extended header if used */
         if (extra_size>0)
@@ -445,24 +555,24 @@ bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader,bool supportD
         /* extract ecu id */
         if ( DLT_IS_HTYP_WEID(standardheader->htyp) )
         {
-            ecuid = QDltMsg::getStringFromId(headerextra.ecu);
+            setIdBytes(ecuid, &LongIds::ecuid, headerextra.ecu, idLength(headerextra.ecu));
         }
         else
         {
             if(storageheader)
-                ecuid = QDltMsg::getStringFromId(storageheader->ecu);
+                setIdBytes(ecuid, &LongIds::ecuid, storageheader->ecu, idLength(storageheader->ecu));
         }
 
         /* extract application id */
         if ((DLT_IS_HTYP_UEH(standardheader->htyp)) && (extendedheader->apid[0]!=0))
         {
-            apid = QDltMsg::getStringFromId(extendedheader->apid);
+            setIdBytes(apid, &LongIds::apid, extendedheader->apid, idLength(extendedheader->apid));
         }
 
         /* extract context id */
         if ((DLT_IS_HTYP_UEH(standardheader->htyp)) && (extendedheader->ctid[0]!=0))
         {
-            ctid = QDltMsg::getStringFromId(extendedheader->ctid);
+            setIdBytes(ctid, &LongIds::ctid, extendedheader->ctid, idLength(extendedheader->ctid));
         }
 
         /* extract type */
@@ -531,48 +641,41 @@ bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader,bool supportD
             return false;
         }
 
-        /* copy payload */
-        if(payloadSize>0)
-            payload = buf.mid(headersize,payloadSize);
+        /* the payload was copied with the header */
+        const char *payloadData = headerAndPayload.constData() + headersize;
+        const int payloadLength = headerAndPayload.size() - headersize;
 
         /* set messageid if non verbose */
-        if((mode == DltModeNonVerbose) && payload.size()>=4) {
+        if((mode == DltModeNonVerbose) && payloadLength>=4) {
             /* message id is always in big endian format */
             if(endianness == QDlt::DltEndiannessLittleEndian) {
-                messageId = (*((unsigned int*) payload.constData()));
+                messageId = (*((unsigned int*) payloadData));
             }
             else {
-                messageId = DLT_SWAP_32((*((unsigned int*) payload.constData())));
+                messageId = DLT_SWAP_32((*((unsigned int*) payloadData)));
             }
         }
 
         /* set service id if message of type control */
-        if((type == DltTypeControl) && payload.size()>=4) {
+        if((type == DltTypeControl) && payloadLength>=4) {
             if(endianness == QDlt::DltEndiannessLittleEndian)
-                ctrlServiceId = *((unsigned int*) payload.constData());
+                ctrlServiceId = *((unsigned int*) payloadData);
             else
-                ctrlServiceId = DLT_SWAP_32(*((unsigned int*) payload.constData()));
+                ctrlServiceId = DLT_SWAP_32(*((unsigned int*) payloadData));
         }
 
         /* set return type if message of type control response */
-        if((type == QDltMsg::DltTypeControl) && (subtype == QDltMsg::DltControlResponse) && payload.size()>=5) {
-            ctrlReturnType = *((unsigned char*) &(payload.constData()[4]));
+        if((type == QDltMsg::DltTypeControl) && (subtype == QDltMsg::DltControlResponse) && payloadLength>=5) {
+            ctrlReturnType = *((unsigned char*) &(payloadData[4]));
         }
 
-        /* get the arguments of the payload */
-        if(mode==DltModeVerbose) {
-            offset = 0;
-            arguments.clear();
-            for(int num=0;num<numberOfArguments;num++) {
-                if(argument.setArgument(payload,offset,endianness)==false) {
-                    /* There was an error parsing the arguments */
-                    return false;
-                }
-                arguments.append(argument);
-            }
+        /* get the arguments of the payload, or when they are needed */
+        if(lazyArguments) {
+            arguments.parsed = false;
+            return true;
         }
 
-        return true;
+        return parsePayloadArguments();
     }
     else if(versionNumber==2)
     {
@@ -716,13 +819,13 @@ bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader,bool supportD
             if(buf.size() < (int)(sizeStorageHeader + headerLength + length)) {
                 return false; // length error
             }
-            ecuid = QString(buf.mid(headerLength + sizeStorageHeader,length));
+            setIdBytes(ecuid, &LongIds::ecuid, buf.constData() + headerLength + sizeStorageHeader, length);
             headerLength += length;
         }
         else
         {
             if(storageheader)
-                ecuid = QString(QByteArray(storageheader->ecu,4));
+                setIdBytes(ecuid, &LongIds::ecuid, storageheader->ecu, sizeof(storageheader->ecu));
         }
 
         /* read optional App Id and Ctx Id */
@@ -736,14 +839,14 @@ bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader,bool supportD
             if(buf.size() < (int)(sizeStorageHeader + headerLength + length)) {
                 return false; // length error
             }
-            apid = QString(buf.mid(headerLength + sizeStorageHeader,length));
+            setIdBytes(apid, &LongIds::apid, buf.constData() + headerLength + sizeStorageHeader, length);
             headerLength += length;
             length = *((quint8*) (buf.constData() + headerLength + sizeStorageHeader));
             headerLength += 1;
             if(buf.size() < (int)(sizeStorageHeader + headerLength + length)) {
                 return false; // length error
             }
-            ctid = QString(buf.mid(headerLength + sizeStorageHeader,length));
+            setIdBytes(ctid, &LongIds::ctid, buf.constData() + headerLength + sizeStorageHeader, length);
             headerLength += length;
         }
 
@@ -864,40 +967,32 @@ bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader,bool supportD
         headersize = headerSize;
         payloadSize = messageLength - (headerSize - sizeStorageHeader);
 
-        /* copy header */
-        header = buf.mid(0,headersize);
-
-        /* copy payload */
-        if(payloadSize>0)
-            payload = buf.mid(headersize,payloadSize);
+        /* copy header and the available part of the payload into one buffer */
+        storedHeaderSize = headersize;
+        headerAndPayload = QByteArray(buf.constData(),headersize + qBound(0,payloadSize,(int)buf.size() - (int)headersize));
+        const char *payloadData = headerAndPayload.constData() + headersize;
+        const int payloadLength = headerAndPayload.size() - headersize;
 
         /* set service id if message of type control */
-        if((type == DltTypeControl) && payload.size()>=4) {
+        if((type == DltTypeControl) && payloadLength>=4) {
             if(endianness == QDlt::DltEndiannessLittleEndian)
-                ctrlServiceId = *((unsigned int*) payload.constData());
+                ctrlServiceId = *((unsigned int*) payloadData);
             else
-                ctrlServiceId = DLT_SWAP_32(*((unsigned int*) payload.constData()));
+                ctrlServiceId = DLT_SWAP_32(*((unsigned int*) payloadData));
         }
 
         /* set return type if message of type control response */
-        if((type == QDltMsg::DltTypeControl) && (subtype == QDltMsg::DltControlResponse) && payload.size()>=5) {
-            ctrlReturnType = *((unsigned char*) &(payload.constData()[4]));
+        if((type == QDltMsg::DltTypeControl) && (subtype == QDltMsg::DltControlResponse) && payloadLength>=5) {
+            ctrlReturnType = *((unsigned char*) &(payloadData[4]));
         }
 
-        /* get the arguments of the payload */
-        if(mode==DltModeVerbose && !withSegementation) {
-            offset = 0;
-            arguments.clear();
-            for(int num=0;num<numberOfArguments;num++) {
-                if(argument.setArgument(payload,offset,endianness)==false) {
-                    /* There was an error parsing the arguments */
-                    return false;
-                }
-                arguments.append(argument);
-            }
+        /* get the arguments of the payload, or when they are needed */
+        if(lazyArguments) {
+            arguments.parsed = false;
+            return true;
         }
 
-        return true;
+        return parsePayloadArguments();
     }
     else
     {
@@ -909,23 +1004,94 @@ bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader,bool supportD
 bool QDltMsg::parseArguments()
 {
     QDltArgument argument;
-    unsigned int offset = 0;
+    unsigned int offset = storedHeaderSize; // the payload follows the header in the buffer
+
+    arguments.parsed = true;
+    arguments.valid = true;
 
     /* get the arguments of the payload */
     if(mode==DltModeVerbose) {
-        arguments.clear();
+        arguments.list.clear();
         for(int num=0;num<numberOfArguments;num++) {
-            if(argument.setArgument(payload,offset,endianness)==false) {
+            if(argument.setArgument(headerAndPayload,offset,endianness)==false) {
                 /* There was an error parsing the arguments */
+                arguments.valid = false;
                 return false;
             }
-            arguments.append(argument);
+            argument.setOffsetPayload(argument.getOffsetPayload() - storedHeaderSize);
+            arguments.list.append(argument);
         }
     }
 
     return true;
 }
 
+bool QDltMsg::parsePayloadArguments() const
+{
+    QDltArgument argument;
+    unsigned int offset = storedHeaderSize; // the payload follows the header in the buffer
+    bool valid = true;
+
+    /* get the arguments of the payload, segmented payloads are parsed when all segments are combined */
+    if(mode==DltModeVerbose && !withSegementation) {
+        arguments.list.clear();
+        for(int num=0;num<numberOfArguments;num++) {
+            if(argument.setArgument(headerAndPayload,offset,endianness)==false) {
+                /* There was an error parsing the arguments */
+                valid = false;
+                break;
+            }
+            argument.setOffsetPayload(argument.getOffsetPayload() - storedHeaderSize);
+            arguments.list.append(argument);
+        }
+    }
+
+    /* other threads only check the flag, it is set when the arguments are complete */
+    arguments.valid = valid;
+    arguments.parsed.store(true, std::memory_order_release);
+
+    return valid;
+}
+
+void QDltMsg::parseLazyArguments() const
+{
+    if(arguments.parsed.load(std::memory_order_acquire))
+        return;
+
+    /* several threads may call const getters of a lazily parsed message */
+    std::lock_guard<std::mutex> lock(arguments.mutex);
+    if(!arguments.parsed.load(std::memory_order_relaxed))
+        parsePayloadArguments();
+}
+
+QDltMsg::Arguments::Arguments(const Arguments &other)
+{
+    std::lock_guard<std::mutex> lock(other.mutex);
+    list = other.list;
+    valid = other.valid;
+    parsed = other.parsed.load();
+}
+
+QDltMsg::Arguments &QDltMsg::Arguments::operator=(const Arguments &other)
+{
+    if(this != &other)
+    {
+        std::scoped_lock lock(mutex, other.mutex);
+        list = other.list;
+        valid = other.valid;
+        parsed = other.parsed.load();
+    }
+
+    return *this;
+}
+
+bool QDltMsg::hasValidArguments() const
+{
+    parseLazyArguments();
+
+    return arguments.valid;
+}
+
 bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
     DltStorageHeader storageheader;
     DltStandardHeader standardheader;
@@ -936,12 +1102,15 @@ bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
     buf.clear();
 
     /* prepare payload */
-    payload.clear();
-    for (int num = 0;num<arguments.size();num++)
+    parseLazyArguments();
+    QByteArray payload;
+    for (int num = 0;num<arguments.list.size();num++)
     {
-        if(!(arguments[num].getArgument(payload,mode==DltModeVerbose)))
+        if(!(arguments.list[num].getArgument(payload,mode==DltModeVerbose)))
             return false;
     }
+    headerAndPayload.truncate(storedHeaderSize);
+    headerAndPayload += payload;
 
     /* write storageheader */
     if(withStorageHeader)
@@ -950,7 +1119,7 @@ bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
         storageheader.pattern[1] = 'L';
         storageheader.pattern[2] = 'T';
         storageheader.pattern[3] = 0x01;
-        strncpy(storageheader.ecu,ecuid.toLatin1().constData(),ecuid.size()>3?4:ecuid.size()+1);
+        writeId(storageheader.ecu,getEcuid());
         storageheader.microseconds = microseconds;
         storageheader.seconds = time;
         buf += QByteArray((const char *)&storageheader,sizeof(DltStorageHeader));
@@ -964,7 +1133,7 @@ bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
     
     // Determine if we need extended header - for verbose mode or non-verbose with valid apid/ctid
     bool needOfExtendedHeader = (mode == DltModeVerbose) ||
-                             (mode == DltModeNonVerbose && (!apid.isEmpty() || !ctid.isEmpty()));
+                             (mode == DltModeNonVerbose && (apid != 0 || ctid != 0 || hasLongId(&LongIds::apid) || hasLongId(&LongIds::ctid)));
     
     if(needOfExtendedHeader) {
         standardheader.htyp |= DLT_HTYP_UEH;
@@ -990,7 +1159,7 @@ bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
 
     /* write standard header extra */
     if(mode == DltModeVerbose) {
-        strncpy(headerextra.ecu,ecuid.toLatin1().constData(),ecuid.size()>3?4:ecuid.size()+1);
+        writeId(headerextra.ecu,getEcuid());
         buf += QByteArray((const char *)&(headerextra.ecu),sizeof(headerextra.ecu));
         headerextra.seid = DLT_SWAP_32(sessionid);
         buf += QByteArray((const char *)&(headerextra.seid),sizeof(headerextra.seid));
@@ -1000,8 +1169,8 @@ bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
 
     /* write extendedheader */
     if(needOfExtendedHeader) {
-        strncpy(extendedheader.apid,apid.toLatin1().constData(),apid.size()>3?4:apid.size()+1);
-        strncpy(extendedheader.ctid,ctid.toLatin1().constData(),ctid.size()>3?4:ctid.size()+1);
+        writeId(extendedheader.apid,getApid());
+        writeId(extendedheader.ctid,getCtid());
         extendedheader.msin = 0;
         if(mode == DltModeVerbose) {
             extendedheader.msin |= DLT_MSIN_VERB;
@@ -1021,9 +1190,10 @@ bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
 
 void QDltMsg::clear()
 {
-    ecuid.clear();
-    apid.clear();
-    ctid.clear();
+    ecuid = 0;
+    apid = 0;
+    ctid = 0;
+    longIds = QSharedDataPointer<LongIds>();
     type = DltTypeUnknown;
     subtype = DltLogUnknown;
     mode = DltModeUnknown;
@@ -1032,15 +1202,16 @@ void QDltMsg::clear()
     microseconds = 0;
     timestamp = 0;
     sessionid = 0;
-    sessionName.clear();
     numberOfArguments = 0;
     messageId = 0;
     ctrlServiceId = 0;
     ctrlReturnType = 0;
-    arguments.clear();
-    payload.clear();
+    arguments.list.clear();
+    arguments.parsed = true;
+    arguments.valid = true;
+    headerAndPayload.clear();
+    storedHeaderSize = 0;
     payloadSize = 0;
-    header.clear();
     headerSize = 0;
     versionNumber=0;
 
@@ -1078,35 +1249,40 @@ void QDltMsg::clear()
 
 void QDltMsg::clearArguments()
 {
-    arguments.clear();
+    parseLazyArguments();
+    arguments.list.clear();
 }
 
 int QDltMsg::sizeArguments() const
 {
-    return arguments.size();
+    parseLazyArguments();
+    return arguments.list.size();
 }
 
 bool QDltMsg::getArgument(int index,QDltArgument &argument) const
 {
-      if(index<0 || index>=arguments.size())
+      parseLazyArguments();
+      if(index<0 || index>=arguments.list.size())
           return false;
 
-      argument = arguments.at(index);
+      argument = arguments.list.at(index);
 
       return true;
 }
 
 void QDltMsg::addArgument(QDltArgument argument, int index)
 {
+    parseLazyArguments();
     if(index == -1)
-        arguments.append(argument);
+        arguments.list.append(argument);
     else
-        arguments.insert(index,argument);
+        arguments.list.insert(index,argument);
 }
 
 void QDltMsg::removeArgument(int index)
 {
-    arguments.removeAt(index);
+    parseLazyArguments();
+    arguments.list.removeAt(index);
 }
 
 
@@ -1133,31 +1309,48 @@ QString QDltMsg::toStringHeader() const
 QString QDltMsg::toStringPayload() const
 {
     QString text;
-    QDltArgument argument;
-    QByteArray data;
 
-    text.reserve(1024);
+    appendToStringPayload(text);
+
+    return text;
+}
 
+void QDltMsg::appendToStringPayload(QString &text) const
+{
     if((getMode()==QDltMsg::DltModeNonVerbose) && (getType()!=QDltMsg::DltTypeControl) && (getNumberOfArguments() == 0)) {
-        text += QString("[%1] ").arg(getMessageId());
-        if(versionNumber==2)
-            data = payload.mid(0,(payload.size()>260)?260:payload.size());
-        else
-            data = payload.mid(4,(payload.size()>260)?256:(payload.size()-4));
-        if(!data.isEmpty())
+        const char *payload = headerAndPayload.constData() + storedHeaderSize;
+        const int payloadSize = headerAndPayload.size() - storedHeaderSize;
+        int offset, size;
+        if(versionNumber==2) {
+            offset = 0;
+            size = (payloadSize>260)?260:payloadSize;
+        }
+        else {
+            offset = 4;
+            size = (payloadSize>260)?256:(payloadSize-4);
+        }
+        text += QLatin1Char('[');
+        QDlt::appendNumber(text, (qulonglong)getMessageId());
+        text += QLatin1String("] ");
+        if(size>0)
         {
-            text += QDlt::toAsciiTable(data,false,false,true,1024,1024,false);
-            text += "|";
-            text += QDlt::toAscii(data, false);
+            // the same text as QDlt::toAsciiTable() with ASCII output in one line and QDlt::toAscii() in hex format
+            text += QLatin1Char(' ');
+            QDlt::appendPrintable(text, payload + offset, size);
+            text += QLatin1Char('|');
+            QDlt::appendHex(text, payload + offset, size);
         }
-        return text;
+        return;
     }
 
     if( getType()==QDltMsg::DltTypeControl && getSubtype()==QDltMsg::DltControlResponse) {
+        const QByteArray payload = getPayload();
+        QByteArray data;
 
         if(getCtrlServiceId() == DLT_SERVICE_ID_MARKER)
         {
-            return "MARKER";
+            text += QLatin1String("MARKER");
+            return;
         }
 
         text += QString("[%1 %2] ").arg(getCtrlServiceIdString()).arg(getCtrlReturnTypeString());
@@ -1219,18 +1412,22 @@ QString QDltMsg::toStringPayload() const
             text += QDlt::toAscii(data);
         }
 
-        return text;
+        return;
     }
 
     if( getType()==QDltMsg::DltTypeControl) {
-        text += QString("[%1] ").arg(getCtrlServiceIdString());
-        data = payload.mid(4,(payload.size()>260)?256:(payload.size()-4));
-        text += QDlt::toAscii(data);
-
-        return text;
+        const char *payload = headerAndPayload.constData() + storedHeaderSize;
+        const int payloadSize = headerAndPayload.size() - storedHeaderSize;
+        text += QLatin1Char('[');
+        text += getCtrlServiceIdString();
+        text += QLatin1String("] ");
+        QDlt::appendHex(text, payload + 4, (payloadSize>260)?256:(payloadSize-4));
+
+        return;
     }
 
-    if(withSegementation && arguments.isEmpty())
+    parseLazyArguments();
+    if(withSegementation && arguments.list.isEmpty())
     {
         if(segmentationFrameType==0)
         {
@@ -1248,20 +1445,15 @@ QString QDltMsg::toStringPayload() const
         {
             text += "Segmentation: Abort Frame with abort reason " + QString("%1").arg(segmentationAbortReason);;
         }
-        return text;
+        return;
     }
 
-    for(int num=0;num<arguments.size();num++) {
-        if(getArgument(num,argument)) {
-            if(num!=0) {
-                text += " ";
-            }
-            text += argument.toString();
+    for(int num=0;num<arguments.list.size();num++) {
+        if(num!=0) {
+            text += QLatin1Char(' ');
         }
-
+        arguments.list.at(num).appendToString(text);
     }
-
-    return text;
 }
 
 uint8_t QDltMsg::getVersionNumber() const
@@ -1512,10 +1704,11 @@ void QDltMsg::genMsg()
     QDltArgument argument;
 
     // clear existing payload
-    payload.clear();
+    parseLazyArguments();
+    QByteArray payload;
 
     // Generate payload for all arguments
-    for(int num=0;num<arguments.size();num++) {
+    for(int num=0;num<arguments.list.size();num++) {
         if(getArgument(num,argument)) {
             argument.getArgument(payload,true);
         }
@@ -1526,7 +1719,7 @@ void QDltMsg::genMsg()
     payloadSize = payload.size();
 
     // clear existing header
-    header.clear();
+    QByteArray header;
 
     // write standardheader
     standardheader.htyp = 0x01 << 5; /* intialise with version number 0x1 */
@@ -1536,12 +1729,12 @@ void QDltMsg::genMsg()
     
     // Determine if we need extended header - for verbose mode or non-verbose with valid apid/ctid
     bool needOfExtendedHeader = (mode == DltModeVerbose) ||
-                             (mode == DltModeNonVerbose && (!apid.isEmpty() || !ctid.isEmpty()));
+                             (mode == DltModeNonVerbose && (apid != 0 || ctid != 0 || hasLongId(&LongIds::apid) || hasLongId(&LongIds::ctid)));
     
     if(mode == DltModeVerbose) {
         uint16_t standardheaderlen = sizeof(DltStandardHeader) + sizeof(DltExtendedHeader) + payload.size();
         standardheader.htyp |= DLT_HTYP_UEH;
-        if(!ecuid.isEmpty()) {
+        if(ecuid != 0 || hasLongId(&LongIds::ecuid)) {
             standardheader.htyp |= DLT_HTYP_WEID;
             standardheaderlen += sizeof(headerextra.ecu);
         }
@@ -1569,8 +1762,8 @@ void QDltMsg::genMsg()
 
     // write standard header extra
     if(mode == DltModeVerbose) {
-        if(!ecuid.isEmpty()) {
-            strncpy(headerextra.ecu,ecuid.toLatin1().constData(),ecuid.size()>3?4:ecuid.size()+1);
+        if(ecuid != 0 || hasLongId(&LongIds::ecuid)) {
+            writeId(headerextra.ecu,getEcuid());
             header += QByteArray((const char *)&(headerextra.ecu),sizeof(headerextra.ecu));
         }
         if(sessionid!=0) {
@@ -1585,8 +1778,8 @@ void QDltMsg::genMsg()
 
     // write extendedheader
     if(needOfExtendedHeader) {
-        strncpy(extendedheader.apid,apid.toLatin1().constData(),apid.size()>3?4:apid.size()+1);
-        strncpy(extendedheader.ctid,ctid.toLatin1().constData(),ctid.size()>3?4:ctid.size()+1);
+        writeId(extendedheader.apid,getApid());
+        writeId(extendedheader.ctid,getCtid());
         extendedheader.msin = 0;
         if(mode == DltModeVerbose) {
             extendedheader.msin |= DLT_MSIN_VERB;
@@ -1600,4 +1793,8 @@ void QDltMsg::genMsg()
     // set header size
     headerSize = header.size();
 
+    // store header and payload in one buffer
+    storedHeaderSize = header.size();
+    headerAndPayload = header + payload;
+
 }
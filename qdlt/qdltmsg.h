@@ -23,6 +23,10 @@
 #define QDLT_MSG_H
 
 #include <QString>
+#include <QSharedData>
+
+#include <atomic>
+#include <mutex>
 
 #include "export_rules.h"
 #include "qdltbase.h"
@@ -32,6 +36,10 @@
 /*!
   This class provide access to a single DLT message from a DLT log file.
   This class is currently not thread safe.
+  Only the const getters may be called by several threads at the same time,
+  also when the arguments are parsed lazily. The first getter needing the
+  arguments parses them, the other threads wait until the arguments are
+  complete.
 */
 class QDLT_EXPORT QDltMsg
 {
@@ -67,6 +75,16 @@ public:
     */
     static QString getStringFromId(const char *text);
 
+    //! Pack an id of up to four ASCII characters into an integer.
+    /*!
+      The first character is stored in the lowest byte, unused bytes are zero.
+      Equal integers mean equal ids.
+      \param id The id to be packed.
+      \param value The packed id, zero if the id cannot be packed.
+      \return True if the id could be packed, false if it is longer or contains other characters.
+    */
+    static bool packId(const QString &id, quint32 &value);
+
     //! Get the time of the DLT message, when the DLT message is logged.
     /*!
       \return The time when the DLT message is logged.
@@ -133,13 +151,13 @@ public:
     /*!
       \return The session name of the DLT message.
     */
-    QString getSessionName() const { return sessionName; }
+    QString getSessionName() const;
 
     //! Set the session name of the DLT message.
     /*!
       \param sessionName The session name of the DLT message.
     */
-    void setSessionName(QString sessionName) { this->sessionName = sessionName; }
+    void setSessionName(QString sessionName);
 
     //! Get the message counter of the DLT message.
     /*!
@@ -159,37 +177,61 @@ public:
     /*!
       \return The ecu id of the DLT message.
     */
-    QString getEcuid() const { return ecuid; }
+    QString getEcuid() const { return getIdString(ecuid, &LongIds::ecuid); }
 
     //! Set the ecu id of the DLT message.
     /*!
       \param _ecuid The ecu id of the DLT message.
     */
-    void setEcuid(QString _ecuid) { ecuid = _ecuid; }
+    void setEcuid(QString _ecuid) { setIdString(ecuid, &LongIds::ecuid, _ecuid); }
+
+    //! Get the ecu id of the DLT message packed into an integer.
+    /*!
+      \sa packId()
+      \param value The packed ecu id, zero if it cannot be packed.
+      \return True if the id is packed, false if it is too long to be packed.
+    */
+    bool getPackedEcuid(quint32 &value) const { value = ecuid; return !hasLongId(&LongIds::ecuid); }
 
     //! Get the application id of the DLT message.
     /*!
       \return The application id.
     */
-    QString getApid() const { return apid; }
+    QString getApid() const { return getIdString(apid, &LongIds::apid); }
 
     //! Set the application id of the DLT message.
     /*!
       \param id The application id.
     */
-    void setApid(QString id) { apid = id; }
+    void setApid(QString id) { setIdString(apid, &LongIds::apid, id); }
+
+    //! Get the application id of the DLT message packed into an integer.
+    /*!
+      \sa packId()
+      \param value The packed application id, zero if it cannot be packed.
+      \return True if the id is packed, false if it is too long to be packed.
+    */
+    bool getPackedApid(quint32 &value) const { value = apid; return !hasLongId(&LongIds::apid); }
 
     //! Get the context id of the DLT message.
     /*!
       \return The contex id.
     */
-    QString getCtid() const { return ctid; }
+    QString getCtid() const { return getIdString(ctid, &LongIds::ctid); }
 
     //! Set the context id of the DLT message.
     /*!
       \param id The context id.
     */
-    void setCtid(QString id) { ctid = id; }
+    void setCtid(QString id) { setIdString(ctid, &LongIds::ctid, id); }
+
+    //! Get the context id of the DLT message packed into an integer.
+    /*!
+      \sa packId()
+      \param value The packed context id, zero if it cannot be packed.
+      \return True if the id is packed, false if it is too long to be packed.
+    */
+    bool getPackedCtid(quint32 &value) const { value = ctid; return !hasLongId(&LongIds::ctid); }
 
     //! Get the type of the DLT message.
     /*!
@@ -225,7 +267,7 @@ public:
       \sa DltEndiannessDef
       \param _endianness The endianness of the DLT message.
     */
-    void setEndianness(QDlt::DltEndiannessDef _endianness) { endianness = _endianness; }
+    void setEndianness(QDlt::DltEndiannessDef _endianness) { parseLazyArguments(); endianness = _endianness; }
 
     //! Get the text of the endianness of the DLT message.
     /*!
@@ -271,7 +313,7 @@ public:
       DLT Ctrl messages are also in non-verbose mode.
       \param _mode The mode of the DLT message.
     */
-    void setMode(DltModeDef _mode) { mode = _mode; }
+    void setMode(DltModeDef _mode) { parseLazyArguments(); mode = _mode; }
 
     //! Get the text of the mode (verbose or non-verbose).
     /*!
@@ -295,20 +337,20 @@ public:
       E.g. if a non-verbose message is decoded these two parameters are different.
       \param noargs The number of arguments in the payload.
     */
-    void setNumberOfArguments(unsigned char noargs) { numberOfArguments = noargs; }
+    void setNumberOfArguments(unsigned char noargs) { parseLazyArguments(); numberOfArguments = noargs; }
 
     //! Get the binary header of the DLT message.
     /*!
       \return Byte Array containing the complete header of the DLT message.
     */
-    QByteArray getHeader() const { return header; }
+    QByteArray getHeader() const { return headerAndPayload.left(storedHeaderSize); }
 
     //! Set the binary header of the DLT message.
     /*!
       Be careful with this function, binary data and interpreted data will not be in sync anymore.
       \param data The new header of the DLT message
     */
-    void setHeader(QByteArray &data) { header = data; }
+    void setHeader(QByteArray &data);
 
     //! Get the size of the header.
     /*!
@@ -321,14 +363,14 @@ public:
     /*!
       \return Byte Array containing the complete payload of the DLT message.
     */
-    QByteArray getPayload() const { return payload; }
+    QByteArray getPayload() const { return headerAndPayload.mid(storedHeaderSize); }
 
     //! Set the binary payload of the DLT message.
     /*!
       Be careful with this function, binary data and interpreted data will not be in sync anymore.
       \param data The new payload of the DLT message
     */
-    void setPayload(QByteArray &data) { payload = data; }
+    void setPayload(QByteArray &data);
 
     //! Generate binary header and payload.
     /*!
@@ -422,11 +464,15 @@ public:
       corresponding buffers. If it fails, but at least the header can be read, the payload
       size can be retrieved, which is perhaps wrong.
       This function returns false, if an error in the decoded message was found.
+      If the arguments are parsed lazily, only the headers are decoded. The arguments are parsed
+      from the payload when they are accessed the first time, errors in the arguments are not
+      reported by this function then, but by hasValidArguments().
       \param buf the buffer containing the DLT messages.
       \param withSH message to be parsed contains storage header, default true.
+      \param lazyArguments parse the arguments when they are needed, default false.
       \return True if the operation was successful, false if there was an error.
     */
-    bool setMsg(const QByteArray& buf,bool withStorageHeader = true,bool supportDLTv2 = false);
+    bool setMsg(const QByteArray& buf,bool withStorageHeader = true,bool supportDLTv2 = false,bool lazyArguments = false);
 
     //! Check the message size provided by a byte array containing the DLT message, without parsing the whole message.
     /*!
@@ -439,6 +485,13 @@ public:
     //! Parse the arguments from the Payload.
     bool parseArguments();
 
+    //! Check if the arguments could be parsed from the payload.
+    /*!
+      Lazily parsed arguments are parsed by this call.
+      \return false if there was an error parsing the arguments.
+    */
+    bool hasValidArguments() const;
+
     //! Get the message written into a byte array containing the DLT message.
     /*!
       This function returns false, if an error in the data was found.
@@ -463,6 +516,15 @@ public:
     */
     QString toStringPayload() const;
 
+    //! Print Payload content into a string provided by the caller.
+    /*!
+      Same text as toStringPayload(), appended to text. A string truncated with text.truncate(0)
+      keeps its capacity, so rendering many messages into the same string needs no new allocations
+      for verbose and non-verbose messages.
+      \param text string the payload text is appended to
+    */
+    void appendToStringPayload(QString &text) const;
+
     // Setter and Getters for new DLTv2 parameters
     uint8_t getVersionNumber() const;
     void setVersionNumber(uint8_t newVersionNumber);
@@ -538,14 +600,38 @@ public:
 
 private:
 
-    //! The header parameter ECU Id.
-    QString ecuid;
+    //! Ids which cannot be packed and the session name, both are only used by some DLTv2 messages.
+    struct LongIds : public QSharedData
+    {
+        QString ecuid;
+        QString apid;
+        QString ctid;
+        QString sessionName;
+    };
+
+    //! The header parameter ECU Id, packed or zero if it is stored in longIds.
+    quint32 ecuid;
+
+    //! The header parameter application Id, packed or zero if it is stored in longIds.
+    quint32 apid;
+
+    //! The header parameter context Id, packed or zero if it is stored in longIds.
+    quint32 ctid;
+
+    //! Ids which cannot be packed and the session name, null if there are none.
+    QSharedDataPointer<LongIds> longIds;
+
+    //! Build the string of a packed id or an id stored in longIds.
+    QString getIdString(quint32 packed, QString LongIds::*longId) const;
+
+    //! Store an id packed or in longIds.
+    void setIdString(quint32 &packed, QString LongIds::*longId, const QString &id);
 
-    //! The header parameter application Id.
-    QString apid;
+    //! Store an id of size bytes read from a message.
+    void setIdBytes(quint32 &packed, QString LongIds::*longId, const char *text, int size);
 
-    //! The header parameter context Id.
-    QString ctid;
+    //! Check if the id is stored in longIds.
+    bool hasLongId(QString LongIds::*longId) const { return longIds.constData() && !(longIds.constData()->*longId).isEmpty(); }
 
     //! The header parameter type of the message.
     DltTypeDef type;
@@ -571,21 +657,22 @@ private:
     //! The session id of the DLT message.
     unsigned int sessionid;
 
-    //! The session name of the DLT message.
-    QString sessionName;
-
     //! The message counter of a context.
     unsigned char messageCounter;
 
     //! The number of arguments of the DLT message.
     unsigned char numberOfArguments;
 
-    //! The complete header of the DLT message.
-    QByteArray header;
+    //! The complete header followed by the complete payload of the DLT message, in one buffer.
+    QByteArray headerAndPayload;
+
+    //! The number of header bytes in headerAndPayload.
+    int storedHeaderSize;
+
+    //! The size of the header, also set if the message was too small.
     int headerSize;
 
-    //! The complete payload of the DLT message.
-    QByteArray payload;
+    //! The size of the payload, also set if the message was too small.
     int payloadSize;
 
     //! The message id if this is a non-verbose message and no control message.
@@ -597,8 +684,30 @@ private:
     //! The return type if the message is a ctrl response message.
     unsigned char ctrlReturnType;
 
-    //! List of arguments of the DLT message.
-    QList<QDltArgument> arguments;
+    //! Arguments of the DLT message, parsed when first needed if setMsg() was called with lazyArguments.
+    /*!
+      Const getters of several threads may parse lazy arguments at the same time.
+      The parsing is guarded by the mutex, the flag is set when the list is complete.
+      A copy of the message locks the mutex of the original.
+    */
+    struct Arguments
+    {
+        Arguments() : parsed(true), valid(true) {}
+        Arguments(const Arguments &other);
+        Arguments &operator=(const Arguments &other);
+
+        QList<QDltArgument> list;
+        std::atomic<bool> parsed;
+        bool valid;
+        mutable std::mutex mutex;
+    };
+    mutable Arguments arguments;
+
+    //! Parse the arguments now, if they are parsed lazily and not parsed yet.
+    void parseLazyArguments() const;
+
+    //! Parse the arguments from the payload in verbose mode.
+    bool parsePayloadArguments() const;
 
     //! New parameters of DLTv2 protocol
     uint8_t versionNumber;
@@ -0,0 +1,174 @@
+#include "qdltmsgqueue.h"
+
+#include <QMutexLocker>
+
+QDltMsgQueue::QDltMsgQueue(int size)
+    : bufferSize(qMax(1, size)),
+      pool(new Slot[bufferSize]),
+      waitingProducers(0),
+      waitingConsumers(0),
+      filledSlots(bufferSize, nullptr),
+      readPosition(0),
+      filledCount(0),
+      stopRequested(false)
+{
+    freeSlots.reserve(bufferSize);
+    for(int num = bufferSize - 1; num >= 0; num--)
+    {
+        pool[num].index = -1;
+        freeSlots.append(&pool[num]);
+    }
+}
+
+QDltMsgQueue::~QDltMsgQueue()
+{
+    delete[] pool;
+}
+
+int QDltMsgQueue::size() const
+{
+    QMutexLocker locker(&mutex);
+
+    return filledCount;
+}
+
+void QDltMsgQueue::pushFree(Slot *slot)
+{
+    freeSlots.append(slot);
+}
+
+void QDltMsgQueue::pushFilled(Slot *slot)
+{
+    // there are never more filled slots than slots in the pool
+    filledSlots[(readPosition + filledCount) % bufferSize] = slot;
+    filledCount++;
+}
+
+QDltMsgQueue::Slot *QDltMsgQueue::acquire()
+{
+    QVector<Slot*> slots;
+
+    return acquire(slots, 1) ? slots.first() : nullptr;
+}
+
+int QDltMsgQueue::acquire(QVector<Slot*> &slots, int maxCount)
+{
+    QMutexLocker locker(&mutex);
+
+    slots.clear();
+
+    while(freeSlots.isEmpty() && !stopRequested)
+    {
+        waitingProducers++;
+        slotReleased.wait(&mutex);
+        waitingProducers--;
+    }
+    if(stopRequested)
+        return 0;
+
+    const int count = qMin(qMax(1, maxCount), static_cast<int>(freeSlots.size()));
+    for(int num = 0; num < count; num++)
+    {
+        slots.append(freeSlots.last());
+        freeSlots.removeLast();
+    }
+
+    return count;
+}
+
+void QDltMsgQueue::enqueue(Slot *slot)
+{
+    QMutexLocker locker(&mutex);
+
+    pushFilled(slot);
+    if(waitingConsumers > 0)
+        slotEnqueued.wakeOne();
+}
+
+void QDltMsgQueue::enqueue(const QVector<Slot*> &slots)
+{
+    if(slots.isEmpty())
+        return;
+
+    QMutexLocker locker(&mutex);
+
+    for(Slot *slot : slots)
+        pushFilled(slot);
+
+    // all waiting consumers can take a part of the batch
+    if(waitingConsumers > 0)
+    {
+        if(slots.size() == 1)
+            slotEnqueued.wakeOne();
+        else
+            slotEnqueued.wakeAll();
+    }
+}
+
+QDltMsgQueue::Slot *QDltMsgQueue::dequeue()
+{
+    QVector<Slot*> slots;
+
+    return dequeue(slots, 1) ? slots.first() : nullptr;
+}
+
+int QDltMsgQueue::dequeue(QVector<Slot*> &slots, int maxCount)
+{
+    QMutexLocker locker(&mutex);
+
+    slots.clear();
+
+    while(filledCount == 0 && !stopRequested)
+    {
+        waitingConsumers++;
+        slotEnqueued.wait(&mutex);
+        waitingConsumers--;
+    }
+
+    const int count = qMin(qMax(1, maxCount), filledCount);
+    for(int num = 0; num < count; num++)
+    {
+        slots.append(filledSlots[readPosition]);
+        readPosition = (readPosition + 1) % bufferSize;
+    }
+    filledCount -= count;
+
+    return count;
+}
+
+void QDltMsgQueue::release(Slot *slot)
+{
+    QMutexLocker locker(&mutex);
+
+    pushFree(slot);
+    if(waitingProducers > 0)
+        slotReleased.wakeOne();
+}
+
+void QDltMsgQueue::release(const QVector<Slot*> &slots)
+{
+    if(slots.isEmpty())
+        return;
+
+    QMutexLocker locker(&mutex);
+
+    for(Slot *slot : slots)
+        pushFree(slot);
+
+    if(waitingProducers > 0)
+    {
+        if(slots.size() == 1)
+            slotReleased.wakeOne();
+        else
+            slotReleased.wakeAll();
+    }
+}
+
+void QDltMsgQueue::enqueueStopRequest()
+{
+    QMutexLocker locker(&mutex);
+
+    stopRequested = true;
+    slotReleased.wakeAll();
+    slotEnqueued.wakeAll();
+}
@@ -0,0 +1,122 @@
+#ifndef QDLTMSGQUEUE_H
+#define QDLTMSGQUEUE_H
+
+#include <QMutex>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "export_rules.h"
+#include "qdltmsg.h"
+
+//! Bounded queue of messages passed between threads.
+/*!
+  The queue owns a pool of message slots, so no message is allocated while
+  messages are passed. A producer takes free slots with acquire(), fills in
+  the message and its index and passes them on with enqueue(). A consumer
+  takes the filled slots with dequeue() and gives them back with release()
+  when they are processed.
+  Any number of producers and consumers can use the queue at the same time,
+  slots are dequeued in the order they were enqueued. Threads block while no
+  slot is available and are woken up by wait conditions, so a waiting thread
+  uses no CPU time. All calls exist for batches of slots, so the queue is
+  only locked once per batch.
+*/
+class QDLT_EXPORT QDltMsgQueue
+{
+public:
+    //! A message and its index in the DLT log file.
+    typedef struct
+    {
+        QDltMsg msg;
+        int index;
+    } Slot;
+
+    //! Constructor.
+    /*!
+      \param bufferSize Number of message slots.
+    */
+    explicit QDltMsgQueue(int bufferSize);
+
+    //! Destructor, the slots must not be used any more.
+    ~QDltMsgQueue();
+
+    //! Get the number of message slots.
+    int capacity() const { return bufferSize; }
+
+    //! Get the number of enqueued slots not yet dequeued.
+    int size() const;
+
+    //! Take a free slot, blocks until a slot is released.
+    /*!
+      \return The slot, nullptr if stop was requested.
+    */
+    Slot *acquire();
+
+    //! Take free slots, blocks until at least one slot is free.
+    /*!
+      \param slots The free slots, the vector is cleared before.
+      \param maxCount Maximum number of slots taken.
+      \return Number of slots taken, 0 if stop was requested.
+    */
+    int acquire(QVector<Slot*> &slots, int maxCount);
+
+    //! Pass a filled slot to the consumers.
+    void enqueue(Slot *slot);
+
+    //! Pass filled slots to the consumers.
+    void enqueue(const QVector<Slot*> &slots);
+
+    //! Take the next filled slot, blocks until a slot is enqueued.
+    /*!
+      \return The slot, nullptr if stop was requested and all slots are dequeued.
+    */
+    Slot *dequeue();
+
+    //! Take the next filled slots, blocks until at least one slot is enqueued.
+    /*!
+      \param slots The filled slots, the vector is cleared before.
+      \param maxCount Maximum number of slots taken.
+      \return Number of slots taken, 0 if stop was requested and all slots are dequeued.
+    */
+    int dequeue(QVector<Slot*> &slots, int maxCount);
+
+    //! Give back a slot to the free slots.
+    void release(Slot *slot);
+
+    //! Give back slots to the free slots.
+    void release(const QVector<Slot*> &slots);
+
+    //! Request to stop, wakes up all waiting threads.
+    /*!
+      Producers get no more free slots, consumers dequeue the remaining
+      filled slots.
+    */
+    void enqueueStopRequest();
+
+private:
+    Q_DISABLE_COPY(QDltMsgQueue)
+
+    void pushFree(Slot *slot);
+    void pushFilled(Slot *slot);
+
+    const int bufferSize;
+    Slot *pool;
+
+    mutable QMutex mutex;
+    QWaitCondition slotReleased;
+    QWaitCondition slotEnqueued;
+    int waitingProducers;
+    int waitingConsumers;
+
+    //! Stack of free slots, the last released slot is used first while it is still in the CPU cache.
+    QVector<Slot*> freeSlots;
+
+    //! Ring buffer of filled slots.
+    QVector<Slot*> filledSlots;
+    int readPosition;
+    int filledCount;
+
+    bool stopRequested;
+};
+
+#endif // QDLTMSGQUEUE_H
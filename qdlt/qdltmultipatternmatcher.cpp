@@ -0,0 +1,213 @@
+#include "qdltmultipatternmatcher.h"
+
+#include <algorithm>
+
+namespace {
+
+ushort foldCharacter(ushort character)
+{
+    return static_cast<ushort>(QChar::toCaseFolded(static_cast<uint>(character)));
+}
+
+}
+
+QDltMultiPatternMatcher::QDltMultiPatternMatcher()
+    : patternCount(0)
+{
+}
+
+void QDltMultiPatternMatcher::clear()
+{
+    patternCount = 0;
+    caseSensitiveIds.clear();
+    caseInsensitiveIds.clear();
+    emptyPatternIds.clear();
+    caseSensitive.clear();
+    caseInsensitive.clear();
+}
+
+int QDltMultiPatternMatcher::addPattern(const QString &pattern, Qt::CaseSensitivity cs)
+{
+    // an empty pattern is contained in every text, independent of the case sensitivity
+    if(pattern.isEmpty())
+    {
+        if(emptyPatternIds.isEmpty())
+            emptyPatternIds.append(patternCount++);
+        return emptyPatternIds.first();
+    }
+
+    QHash<QString, int> *ids = &caseSensitiveIds;
+    QString key = pattern;
+    if(cs == Qt::CaseInsensitive)
+    {
+        // QString::contains() folds surrogate pairs as one character, the automaton folds single characters
+        for(const QChar &character : pattern)
+        {
+            if(character.isSurrogate())
+                return -1;
+        }
+
+        ids = &caseInsensitiveIds;
+        for(QChar &character : key)
+            character = QChar(foldCharacter(character.unicode()));
+    }
+
+    const auto it = ids->constFind(key);
+    if(it != ids->constEnd())
+        return it.value();
+
+    ids->insert(key, patternCount);
+    return patternCount++;
+}
+
+void QDltMultiPatternMatcher::compile()
+{
+    QVector<QString> patterns;
+    QVector<int> ids;
+
+    for(auto it = caseSensitiveIds.constBegin(); it != caseSensitiveIds.constEnd(); ++it)
+    {
+        patterns.append(it.key());
+        ids.append(it.value());
+    }
+    caseSensitive.compile(patterns, ids, false);
+
+    patterns.clear();
+    ids.clear();
+    for(auto it = caseInsensitiveIds.constBegin(); it != caseInsensitiveIds.constEnd(); ++it)
+    {
+        patterns.append(it.key());
+        ids.append(it.value());
+    }
+    caseInsensitive.compile(patterns, ids, true);
+}
+
+void QDltMultiPatternMatcher::match(const QString &text, QBitArray &matches) const
+{
+    matches.fill(false, patternCount);
+
+    for(int id : emptyPatternIds)
+        matches.setBit(id);
+
+    caseSensitive.match(text.constData(), static_cast<int>(text.size()), matches);
+    caseInsensitive.match(text.constData(), static_cast<int>(text.size()), matches);
+}
+
+QDltMultiPatternMatcher::Automaton::Automaton()
+{
+    clear();
+}
+
+void QDltMultiPatternMatcher::Automaton::clear()
+{
+    foldCase = false;
+    classCount = 0;
+    std::fill(latin1Classes, latin1Classes + 256, quint16(0));
+    otherClasses.clear();
+    transitions.clear();
+    outputStart.clear();
+    outputs.clear();
+}
+
+void QDltMultiPatternMatcher::Automaton::compile(const QVector<QString> &patterns, const QVector<int> &ids, bool foldCase)
+{
+    clear();
+    this->foldCase = foldCase;
+    if(patterns.isEmpty())
+        return;
+
+    // each character used by a pattern gets its own class, all other characters share class 0
+    QHash<ushort, quint16> classes;
+    for(const QString &pattern : patterns)
+    {
+        for(const QChar &character : pattern)
+        {
+            if(!classes.contains(character.unicode()))
+                classes.insert(character.unicode(), static_cast<quint16>(classes.size() + 1));
+        }
+    }
+    classCount = classes.size() + 1;
+    for(int character = 0; character < 256; character++)
+        latin1Classes[character] = classes.value(foldCase ? foldCharacter(static_cast<ushort>(character)) : static_cast<ushort>(character), 0);
+    otherClasses = classes;
+
+    // trie of the patterns, -1 is a missing transition
+    transitions.fill(-1, classCount);
+    QVector<QVector<int> > stateOutputs(1);
+    for(int num = 0; num < patterns.size(); num++)
+    {
+        int state = 0;
+        for(const QChar &character : patterns[num])
+        {
+            int &next = transitions[state * classCount + classes.value(character.unicode())];
+            if(next < 0)
+            {
+                next = stateOutputs.size();
+                transitions.resize(transitions.size() + classCount);
+                std::fill(transitions.end() - classCount, transitions.end(), -1);
+                stateOutputs.append(QVector<int>());
+            }
+            state = transitions[state * classCount + classes.value(character.unicode())];
+        }
+        stateOutputs[state].append(ids[num]);
+    }
+
+    // breadth first, the failure state of a state is always processed before the state
+    const int stateCount = stateOutputs.size();
+    QVector<int> failure(stateCount, 0);
+    QVector<int> queue;
+    queue.reserve(stateCount);
+    for(int cls = 0; cls < classCount; cls++)
+    {
+        int &next = transitions[cls];
+        if(next < 0)
+            next = 0;
+        else
+            queue.append(next);
+    }
+    for(int position = 0; position < queue.size(); position++)
+    {
+        const int state = queue[position];
+        stateOutputs[state] += stateOutputs[failure[state]];
+
+        for(int cls = 0; cls < classCount; cls++)
+        {
+            const int fallback = transitions[failure[state] * classCount + cls];
+            int &next = transitions[state * classCount + cls];
+            if(next < 0)
+            {
+                next = fallback;
+            }
+            else
+            {
+                failure[next] = fallback;
+                queue.append(next);
+            }
+        }
+    }
+
+    outputStart.reserve(stateCount + 1);
+    for(const QVector<int> &stateOutput : stateOutputs)
+    {
+        outputStart.append(outputs.size());
+        outputs += stateOutput;
+    }
+    outputStart.append(outputs.size());
+}
+
+void QDltMultiPatternMatcher::Automaton::match(const QChar *text, int length, QBitArray &matches) const
+{
+    if(isEmpty())
+        return;
+
+    const int *table = transitions.constData();
+    const int *start = outputStart.constData();
+    int state = 0;
+
+    for(int num = 0; num < length; num++)
+    {
+        state = table[state * classCount + characterClass(text[num].unicode())];
+        for(int output = start[state]; output < start[state + 1]; output++)
+            matches.setBit(outputs[output]);
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef QDLTMULTIPATTERNMATCHER_H
+#define QDLTMULTIPATTERNMATCHER_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "export_rules.h"
+
+//! Search for many plain text patterns in one pass over a text.
+/*!
+  The patterns are compiled into an Aho-Corasick automaton, so the time to
+  search a text does not depend on the number of patterns. The result for
+  each pattern is the same as of QString::contains() with the case
+  sensitivity of the pattern.
+  Case insensitive patterns are case folded and searched by a second
+  automaton, its character table folds the characters of the text.
+  Once compiled, match() can be called by several threads at the same time.
+*/
+class QDLT_EXPORT QDltMultiPatternMatcher
+{
+public:
+    //! Constructor of a matcher without patterns.
+    QDltMultiPatternMatcher();
+
+    //! Remove all patterns.
+    void clear();
+
+    //! Add a pattern, compile() must be called before the next match().
+    /*!
+      \param pattern The text searched for
+      \param cs The case sensitivity of the search
+      \return The id of the pattern, the same id is returned for an already added pattern,
+              -1 if the pattern is case insensitive and contains surrogate pairs
+    */
+    int addPattern(const QString &pattern, Qt::CaseSensitivity cs);
+
+    //! Get the number of added patterns, the ids of the patterns are below.
+    int size() const { return patternCount; }
+
+    //! Build the automatons of the added patterns.
+    void compile();
+
+    //! Search all patterns in a text.
+    /*!
+      \param text The searched text
+      \param matches Resized to size(), a bit is set for each pattern found in the text
+    */
+    void match(const QString &text, QBitArray &matches) const;
+
+private:
+    //! An automaton for the case sensitive or the case insensitive patterns.
+    class Automaton
+    {
+    public:
+        Automaton();
+        void clear();
+        void compile(const QVector<QString> &patterns, const QVector<int> &ids, bool foldCase);
+        void match(const QChar *text, int length, QBitArray &matches) const;
+        bool isEmpty() const { return classCount == 0; }
+
+    private:
+        //! Character class of a text character, 0 for characters not used by any pattern.
+        int characterClass(ushort character) const
+        {
+            if(character < 256)
+                return latin1Classes[character];
+            return otherClasses.value(foldCase ? static_cast<ushort>(QChar::toCaseFolded(static_cast<uint>(character))) : character, 0);
+        }
+
+        bool foldCase;
+        int classCount;
+        quint16 latin1Classes[256];
+        QHash<ushort, quint16> otherClasses;
+
+        //! Next state for each state and character class, failure transitions are resolved.
+        QVector<int> transitions;
+
+        //! Ids of the patterns found when a state is entered, outputs[outputStart[state]] to outputs[outputStart[state+1]].
+        QVector<int> outputStart;
+        QVector<int> outputs;
+    };
+
+    int patternCount;
+    QHash<QString, int> caseSensitiveIds;
+    QHash<QString, int> caseInsensitiveIds;
+    QVector<int> emptyPatternIds;
+
+    Automaton caseSensitive;
+    Automaton caseInsensitive;
+};
+
+#endif // QDLTMULTIPATTERNMATCHER_H
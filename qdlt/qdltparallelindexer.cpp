@@ -0,0 +1,315 @@
+#include "qdltparallelindexer.h"
+
+#include <QDebug>
+#include <QThread>
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// default minimum size of a range, smaller files are scanned by a single worker
+const qint64 defaultRangeSize = 16 * 1024 * 1024;
+
+// each worker gets several ranges for a smooth progress and load balancing
+const int rangesPerThread = 4;
+
+// number of messages a worker records to find the message where its scan joins the scan of the previous range
+const int maxSyncPoints = 16;
+
+// the later messages of a range are recorded at this interval, so the scans still join after a corrupt region
+const int syncPointInterval = 256;
+
+// size of the blocks read while stitching, the previous scan normally joins within the first messages
+const qint64 stitchBlockSize = 64 * 1024;
+
+}
+
+QDltParallelIndexer::QDltParallelIndexer(const QString &fileName)
+    : fileName(fileName)
+    , threadCount(QThread::idealThreadCount())
+    , rangeSize(defaultRangeSize)
+    , blockSize(1024 * 1024)
+    , startPosition(0)
+    , fileSize(0)
+    , nextRange(0)
+    , stopFlag(false)
+    , bytesScanned(0)
+    , started(false)
+    , finished(false)
+    , errors(0)
+    , successful(false)
+{
+}
+
+QDltParallelIndexer::~QDltParallelIndexer()
+{
+    stop();
+    wait();
+}
+
+bool QDltParallelIndexer::start()
+{
+    if(started)
+        return false;
+
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Cannot open file in QDltParallelIndexer" << file.errorString();
+        return false;
+    }
+    fileSize = file.size();
+    file.close();
+
+    stopFlag = false;
+    bytesScanned = 0;
+    nextRange = 0;
+    result.clear();
+    errors = 0;
+    successful = false;
+    finished = false;
+    started = true;
+
+    if(fileSize <= startPosition)
+    {
+        // nothing to do for an empty file or if nothing was appended
+        successful = true;
+        finished = true;
+        return true;
+    }
+
+    // split the file into ranges
+    const int threads = qMax(1, threadCount);
+    const qint64 bytesToScan = getBytesToScan();
+    const qint64 size = qMax(qMax(rangeSize, blockSize), (bytesToScan + threads * rangesPerThread - 1) / (threads * rangesPerThread));
+    ranges.clear();
+    for(qint64 pos = startPosition; pos < fileSize; pos += size)
+    {
+        Range range;
+        range.start = pos;
+        range.end = qMin(pos + size, fileSize);
+        range.endPos = range.start;
+        range.done = false;
+        range.ok = false;
+        ranges.push_back(range);
+    }
+
+    const int workerCount = qMin(threads, static_cast<int>(ranges.size()));
+    for(int num = 0; num < workerCount; num++)
+        workers.emplace_back(&QDltParallelIndexer::runWorker, this);
+    stitcher = std::thread(&QDltParallelIndexer::runStitcher, this);
+
+    return true;
+}
+
+bool QDltParallelIndexer::wait(unsigned long msecs)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if(!started)
+            return true;
+        if(msecs == ULONG_MAX)
+            indexDone.wait(lock, [this] { return finished; });
+        else if(!indexDone.wait_for(lock, std::chrono::milliseconds(msecs), [this] { return finished; }))
+            return false;
+    }
+
+    join();
+
+    return true;
+}
+
+void QDltParallelIndexer::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopFlag = true;
+    }
+    rangeDone.notify_all();
+}
+
+bool QDltParallelIndexer::index(QVector<qint64> &index)
+{
+    index.clear();
+
+    if(!start())
+        return false;
+    wait();
+
+    index = takeIndex();
+
+    return successful;
+}
+
+QVector<qint64> QDltParallelIndexer::takeIndex()
+{
+    QVector<qint64> index;
+    index.swap(result);
+
+    return index;
+}
+
+void QDltParallelIndexer::join()
+{
+    // workers are still running, if the scan joined the last message before the last range
+    stopFlag = true;
+
+    for(std::thread &worker : workers)
+        worker.join();
+    workers.clear();
+    if(stitcher.joinable())
+        stitcher.join();
+
+    ranges.clear();
+}
+
+bool QDltParallelIndexer::readBlock(QFile &file, qint64 pos, qint64 size, QByteArray &buffer)
+{
+    buffer.resize(static_cast<int>(qMin(size, fileSize - pos)));
+    if(buffer.isEmpty())
+        return true;
+
+    if(!file.seek(pos))
+        return false;
+    const qint64 length = file.read(buffer.data(), buffer.size());
+    if(length < 0)
+        return false;
+    buffer.resize(static_cast<int>(length));
+
+    return true;
+}
+
+void QDltParallelIndexer::runWorker()
+{
+    QFile file(fileName);
+    const bool opened = file.open(QIODevice::ReadOnly);
+    QByteArray buffer;
+    int num;
+
+    while((num = nextRange++) < static_cast<int>(ranges.size()))
+    {
+        Range &range = ranges[num];
+        QDltStorageHeaderScanner &scanner = range.scanner;
+        bool ok = opened;
+        qint64 pos = range.start;
+        qint64 scanned = range.start;
+
+        scanner.reset(fileSize);
+        scanner.setSyncPointLimit(maxSyncPoints);
+        scanner.setSyncPointInterval(syncPointInterval);
+
+        // the scan ends behind the range, the next range is joined while stitching
+        while(ok && !stopFlag && !scanner.isFinished() && pos < range.end)
+        {
+            if(!readBlock(file, pos, blockSize, buffer))
+            {
+                qWarning() << "Error reading input file" << fileName;
+                ok = false;
+                break;
+            }
+            if(buffer.isEmpty())
+                break;
+
+            pos = scanner.scanBlock(buffer.constData(), buffer.size(), pos, range.index);
+
+            if(pos > scanned)
+            {
+                bytesScanned += qMin(pos, range.end) - qMin(scanned, range.end);
+                scanned = pos;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            range.endPos = pos;
+            range.ok = ok && !stopFlag;
+            range.done = true;
+        }
+        rangeDone.notify_all();
+    }
+}
+
+void QDltParallelIndexer::runStitcher()
+{
+    QFile file(fileName);
+    bool ok = file.open(QIODevice::ReadOnly);
+    QDltStorageHeaderScanner scanner(fileSize);
+    QVector<qint64> index;
+    QByteArray buffer;
+    qint64 pos = 0;
+    qint64 stitchedErrors = 0;
+
+    for(int num = 0; ok && num < static_cast<int>(ranges.size()) && !scanner.isFinished(); num++)
+    {
+        Range &range = ranges[num];
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            rangeDone.wait(lock, [this, &range] { return range.done || stopFlag; });
+            if(!range.done || !range.ok)
+            {
+                ok = false;
+                break;
+            }
+        }
+
+        if(num == 0)
+        {
+            // the first range was scanned from the start position, just like a sequential scan
+            index.swap(range.index);
+            scanner = range.scanner;
+            pos = range.endPos;
+            continue;
+        }
+
+        // continue the previous scan until it accepts a message the worker accepted too
+        bool joined = false;
+        scanner.setSyncPointLimit(INT_MAX);
+        while(!joined && !stopFlag && !scanner.isFinished() && pos < range.end)
+        {
+            if(!readBlock(file, pos, stitchBlockSize, buffer))
+            {
+                qWarning() << "Error reading input file" << fileName;
+                ok = false;
+                break;
+            }
+            if(buffer.isEmpty())
+                break;
+
+            scanner.clearSyncPoints();
+            pos = scanner.scanBlock(buffer.constData(), buffer.size(), pos, index);
+
+            // the sync points of the worker are sorted by position
+            const QVector<QDltStorageHeaderScanner::SyncPoint> &workerSyncPoints = range.scanner.getSyncPoints();
+            for(const QDltStorageHeaderScanner::SyncPoint &syncPoint : scanner.getSyncPoints())
+            {
+                const auto workerSyncPoint = std::lower_bound(workerSyncPoints.cbegin(), workerSyncPoints.cend(), syncPoint.pos,
+                    [](const QDltStorageHeaderScanner::SyncPoint &point, qint64 pos) { return point.pos < pos; });
+                if(workerSyncPoint == workerSyncPoints.cend() || workerSyncPoint->pos != syncPoint.pos)
+                    continue;
+
+                // both scans are identical from here on, take over the result of the worker
+                index.resize(syncPoint.indexSize);
+                index += range.index.mid(workerSyncPoint->indexSize);
+                stitchedErrors += syncPoint.errors - workerSyncPoint->errors;
+                scanner = range.scanner;
+                pos = range.endPos;
+                joined = true;
+                break;
+            }
+        }
+
+        // free the memory of the worker result
+        range.index = QVector<qint64>();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        successful = ok && !stopFlag;
+        result.swap(index);
+        errors = stitchedErrors + scanner.getErrors();
+        finished = true;
+    }
+    indexDone.notify_all();
+}
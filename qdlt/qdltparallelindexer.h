@@ -0,0 +1,152 @@
+#ifndef QDLTPARALLELINDEXER_H
+#define QDLTPARALLELINDEXER_H
+
+#include "export_rules.h"
+#include "qdltstorageheaderscanner.h"
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! Create the index of a DLT log file with several threads.
+/*!
+  The file is split into byte ranges, which are scanned in parallel by
+  worker threads with QDltStorageHeaderScanner. Each worker starts
+  unsynchronised at the beginning of its range.
+  The results are stitched in file order: the scan of the previous range
+  is continued into the next range, until it accepts a message which was
+  accepted by the worker of that range too. From this message on both
+  scans are identical and the result of the worker is taken over.
+  So the created index is identical to the index of a sequential scan.
+*/
+class QDLT_EXPORT QDltParallelIndexer
+{
+public:
+    //! Constructor.
+    /*!
+      \param fileName The DLT log file to be indexed.
+    */
+    explicit QDltParallelIndexer(const QString &fileName = QString());
+
+    //! Destructor, stops a running indexing.
+    ~QDltParallelIndexer();
+
+    //! Set the DLT log file to be indexed.
+    void setFileName(const QString &fileName) { this->fileName = fileName; }
+
+    //! Get the DLT log file to be indexed.
+    QString getFileName() const { return fileName; }
+
+    //! Set the number of worker threads, default is the number of cores.
+    void setThreadCount(int count) { threadCount = count; }
+
+    //! Set the minimum size of the ranges scanned by the workers.
+    void setRangeSize(qint64 size) { rangeSize = size; }
+
+    //! Set the size of the blocks read from the file.
+    void setBlockSize(qint64 size) { blockSize = size; }
+
+    //! Set the file position where indexing starts, default is the beginning of the file.
+    /*!
+      The position must be the start of a message, e.g. the last message of
+      an index created before the file has grown. The created index contains
+      the messages from this position on.
+    */
+    void setStartPosition(qint64 pos) { startPosition = pos; }
+
+    //! Get the file position where indexing starts.
+    qint64 getStartPosition() const { return startPosition; }
+
+    //! Start indexing in background threads.
+    /*!
+      \return false if the file cannot be opened.
+    */
+    bool start();
+
+    //! Wait until indexing is finished.
+    /*!
+      \param msecs Maximum time to wait.
+      \return true if indexing is finished.
+    */
+    bool wait(unsigned long msecs = ULONG_MAX);
+
+    //! Request to stop indexing, can be called from any thread.
+    void stop();
+
+    //! Create the index and wait until it is finished.
+    /*!
+      \param index The created index.
+      \return true if the index was created successfully.
+    */
+    bool index(QVector<qint64> &index);
+
+    //! Check if the index was created completely, valid after wait() returned true.
+    bool isSuccessful() const { return successful; }
+
+    //! Get the created index, valid after wait() returned true.
+    QVector<qint64> takeIndex();
+
+    //! Get the number of wrong storage headers found, valid after wait() returned true.
+    qint64 getErrors() const { return errors; }
+
+    //! Get the size of the indexed file.
+    qint64 getFileSize() const { return fileSize; }
+
+    //! Get the number of bytes to be scanned from the start position to the end of the file.
+    qint64 getBytesToScan() const { return qMax<qint64>(0, fileSize - startPosition); }
+
+    //! Get the number of bytes scanned so far.
+    qint64 getBytesScanned() const { return qMin(bytesScanned.load(), fileSize); }
+
+private:
+    //! A byte range of the file scanned by a worker.
+    typedef struct
+    {
+        qint64 start;
+        qint64 end;
+        qint64 endPos;
+        QDltStorageHeaderScanner scanner;
+        QVector<qint64> index;
+        bool done;
+        bool ok;
+    } Range;
+
+    void runWorker();
+    void runStitcher();
+    bool readBlock(QFile &file, qint64 pos, qint64 size, QByteArray &buffer);
+    void join();
+
+    QString fileName;
+    int threadCount;
+    qint64 rangeSize;
+    qint64 blockSize;
+    qint64 startPosition;
+    qint64 fileSize;
+
+    std::vector<Range> ranges;
+    std::atomic<int> nextRange;
+    std::atomic<bool> stopFlag;
+    std::atomic<qint64> bytesScanned;
+
+    std::mutex mutex;
+    std::condition_variable rangeDone;
+    std::condition_variable indexDone;
+    bool started;
+    bool finished;
+
+    std::vector<std::thread> workers;
+    std::thread stitcher;
+
+    QVector<qint64> result;
+    qint64 errors;
+    bool successful;
+};
+
+#endif // QDLTPARALLELINDEXER_H
@@ -0,0 +1,331 @@
+#include "qdltregexprefilter.h"
+
+#include <algorithm>
+
+namespace {
+
+// Get the length of a quantifier at a position of a pattern, 0 if there is none, -1 if it cannot be parsed.
+int quantifierLength(const QString &pattern, int pos, int &minimum)
+{
+    const QChar character = pattern[pos];
+    if(character == '*' || character == '?')
+    {
+        minimum = 0;
+        return 1;
+    }
+    if(character == '+')
+    {
+        minimum = 1;
+        return 1;
+    }
+    if(character != '{')
+        return 0;
+
+    // {n}, {n,} and {n,m}, other forms are a literal or a quantifier depending on the PCRE2 version
+    int end = pos + 1;
+    while(end < pattern.size() && pattern[end].isDigit() && pattern[end].unicode() < 128)
+        end++;
+    if(end == pos + 1)
+        return -1;
+    minimum = pattern.mid(pos + 1, end - pos - 1).toInt();
+    if(end < pattern.size() && pattern[end] == ',')
+    {
+        end++;
+        while(end < pattern.size() && pattern[end].isDigit() && pattern[end].unicode() < 128)
+            end++;
+    }
+    if(end >= pattern.size() || pattern[end] != '}')
+        return -1;
+    return end - pos + 1;
+}
+
+// Get the position behind a character class starting at a position, -1 if the class does not end.
+int skipClass(const QString &pattern, int pos)
+{
+    int end = pos + 1;
+    if(end < pattern.size() && pattern[end] == '^')
+        end++;
+    // a closing bracket at the start is a character of the class
+    if(end < pattern.size() && pattern[end] == ']')
+        end++;
+
+    while(end < pattern.size())
+    {
+        const QChar character = pattern[end];
+        if(character == '\\')
+        {
+            end += 2;
+        }
+        else if(character == '[' && end + 1 < pattern.size() &&
+                (pattern[end + 1] == ':' || pattern[end + 1] == '.' || pattern[end + 1] == '='))
+        {
+            // POSIX class like [:alpha:]
+            const int close = pattern.indexOf(QString(pattern[end + 1]) + ']', end + 2);
+            if(close < 0)
+                return -1;
+            end = close + 2;
+        }
+        else if(character == ']')
+        {
+            return end + 1;
+        }
+        else
+        {
+            end++;
+        }
+    }
+
+    return -1;
+}
+
+// Get the position behind a group starting at a position, -1 if the group does not end.
+int skipGroup(const QString &pattern, int pos)
+{
+    int depth = 0;
+    int end = pos;
+
+    while(end < pattern.size())
+    {
+        const QChar character = pattern[end];
+        if(character == '\\')
+        {
+            end += 2;
+        }
+        else if(character == '[')
+        {
+            end = skipClass(pattern, end);
+            if(end < 0)
+                return -1;
+        }
+        else if(character == '(')
+        {
+            depth++;
+            end++;
+        }
+        else if(character == ')')
+        {
+            depth--;
+            end++;
+            if(depth == 0)
+                return end;
+        }
+        else
+        {
+            end++;
+        }
+    }
+
+    return -1;
+}
+
+// Check for constructs which change how the rest of the pattern is parsed or matched.
+bool isAnalysable(const QString &pattern)
+{
+    // verbs like (*ACCEPT) end the match early, quoted text \Q..\E and comments may contain anything
+    if(pattern.contains("(*") || pattern.contains("\\Q") || pattern.contains("(?#"))
+        return false;
+
+    // options changed inside of the pattern, like (?i) or (?x)
+    static const QString optionCharacters("imnsxarJU-^");
+    for(int pos = pattern.indexOf("(?"); pos >= 0; pos = pattern.indexOf("(?", pos + 2))
+    {
+        if(pos + 2 < pattern.size() && optionCharacters.contains(pattern[pos + 2]))
+            return false;
+    }
+
+    return true;
+}
+
+}
+
+QDltRegexPrefilter::QDltRegexPrefilter()
+    : rejectedCount(0)
+{
+}
+
+QDltRegexPrefilter::QDltRegexPrefilter(const QDltRegexPrefilter &other)
+    : literals(other.literals)
+    , matchers(other.matchers)
+    , rejectedCount(other.getRejectedCount())
+{
+}
+
+QDltRegexPrefilter &QDltRegexPrefilter::operator=(const QDltRegexPrefilter &other)
+{
+    literals = other.literals;
+    matchers = other.matchers;
+    rejectedCount.store(other.getRejectedCount(), std::memory_order_relaxed);
+    return *this;
+}
+
+void QDltRegexPrefilter::setRegularExpression(const QRegularExpression &regExp)
+{
+    clear();
+
+    // white space is ignored by extended patterns
+    if(!regExp.isValid() || (regExp.patternOptions() & QRegularExpression::ExtendedPatternSyntaxOption))
+        return;
+
+    const bool caseInsensitive = regExp.patternOptions() & QRegularExpression::CaseInsensitiveOption;
+    literals = extractLiterals(regExp.pattern(), caseInsensitive);
+    for(const QString &literal : literals)
+        matchers.append(QStringMatcher(literal, caseInsensitive ? Qt::CaseInsensitive : Qt::CaseSensitive));
+}
+
+void QDltRegexPrefilter::clear()
+{
+    literals.clear();
+    matchers.clear();
+    rejectedCount.store(0, std::memory_order_relaxed);
+}
+
+bool QDltRegexPrefilter::mayMatch(const QString &text) const
+{
+    for(const QStringMatcher &matcher : matchers)
+    {
+        if(matcher.indexIn(text) < 0)
+        {
+            rejectedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QStringList QDltRegexPrefilter::extractLiterals(const QString &pattern, bool caseInsensitive)
+{
+    if(!isAnalysable(pattern))
+        return QStringList();
+
+    QStringList result;
+    QString literal;
+    // number of characters of the last atom in literal, 0 if the last atom was no literal character
+    int lastAtomSize = 0;
+
+    auto endLiteral = [&]() {
+        if(!literal.isEmpty())
+            result.append(literal);
+        literal.clear();
+        lastAtomSize = 0;
+    };
+    auto appendCharacter = [&](QChar character) {
+        // caseless matching of non ASCII characters differs between PCRE2 and QString
+        if(caseInsensitive && character.unicode() >= 128)
+        {
+            endLiteral();
+            return;
+        }
+        literal.append(character);
+        lastAtomSize = 1;
+    };
+
+    int pos = 0;
+    while(pos < pattern.size())
+    {
+        // a quantifier belongs to the atom before
+        int minimum = 0;
+        const int length = quantifierLength(pattern, pos, minimum);
+        if(length < 0)
+            return QStringList();
+        if(length > 0)
+        {
+            // an optional character is not part of the literal, a repeated one ends the literal
+            if(minimum == 0)
+                literal.chop(lastAtomSize);
+            endLiteral();
+            pos += length;
+            // lazy and possessive quantifiers
+            if(pos < pattern.size() && (pattern[pos] == '?' || pattern[pos] == '+'))
+                pos++;
+            continue;
+        }
+
+        const QChar character = pattern[pos];
+        if(character == '|' || character == ')')
+        {
+            // alternatives on the top level
+            return QStringList();
+        }
+        else if(character == '(')
+        {
+            endLiteral();
+            pos = skipGroup(pattern, pos);
+            if(pos < 0)
+                return QStringList();
+        }
+        else if(character == '[')
+        {
+            endLiteral();
+            pos = skipClass(pattern, pos);
+            if(pos < 0)
+                return QStringList();
+        }
+        else if(character == '.' || character == '^' || character == '$')
+        {
+            endLiteral();
+            pos++;
+        }
+        else if(character == '\\')
+        {
+            if(pos + 1 >= pattern.size())
+                return QStringList();
+            const QChar escaped = pattern[pos + 1];
+            const ushort code = escaped.unicode();
+            pos += 2;
+
+            if(escaped.isSurrogate())
+            {
+                return QStringList();
+            }
+            else if(code >= 128 || !escaped.isLetterOrNumber())
+            {
+                // escaped special character
+                appendCharacter(escaped);
+            }
+            else if(code == 't' || code == 'n' || code == 'r' || code == 'f' || code == 'a' || code == 'e')
+            {
+                const char control[] = {'\t', '\n', '\r', '\f', '\a', '\x1b'};
+                appendCharacter(QLatin1Char(control[QString("tnrfae").indexOf(escaped)]));
+            }
+            else if(QString("dDwWsShHvVRNXbBAzZG").contains(escaped))
+            {
+                // character types and assertions
+                endLiteral();
+            }
+            else
+            {
+                // back references, code points, properties and others
+                return QStringList();
+            }
+        }
+        else if(character.isHighSurrogate() && pos + 1 < pattern.size() && pattern[pos + 1].isLowSurrogate())
+        {
+            if(caseInsensitive)
+            {
+                endLiteral();
+            }
+            else
+            {
+                literal.append(character);
+                literal.append(pattern[pos + 1]);
+                lastAtomSize = 2;
+            }
+            pos += 2;
+        }
+        else
+        {
+            appendCharacter(character);
+            pos++;
+        }
+    }
+    endLiteral();
+
+    // the longest literal is the most selective one
+    std::stable_sort(result.begin(), result.end(), [](const QString &literal1, const QString &literal2) {
+        return literal1.size() > literal2.size();
+    });
+    result.removeDuplicates();
+
+    return result;
+}
@@ -0,0 +1,73 @@
+#ifndef QDLTREGEXPREFILTER_H
+#define QDLTREGEXPREFILTER_H
+
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QStringMatcher>
+#include <QVector>
+
+#include <atomic>
+
+#include "export_rules.h"
+
+//! Literals which a text must contain to match a regular expression.
+/*!
+  The literal text of a regular expression outside of groups, character
+  classes and optional parts must be contained in every matching text. The
+  literals are searched with QStringMatcher first, so the regular expression
+  only runs on the texts containing all of them.
+  Patterns which cannot be analysed safely, like patterns with alternatives
+  on the top level, verbs or changed options, have no literals and every
+  text is a candidate.
+  mayMatch() can be called by several threads at the same time.
+*/
+class QDLT_EXPORT QDltRegexPrefilter
+{
+public:
+    //! Constructor of a prefilter without literals.
+    QDltRegexPrefilter();
+
+    //! Copy constructor, the rejected count is copied.
+    QDltRegexPrefilter(const QDltRegexPrefilter &other);
+
+    //! Copy operator, the rejected count is copied.
+    QDltRegexPrefilter &operator=(const QDltRegexPrefilter &other);
+
+    //! Extract the literals of a regular expression, the rejected count is reset.
+    /*!
+      \param regExp The regular expression, invalid expressions have no literals
+    */
+    void setRegularExpression(const QRegularExpression &regExp);
+
+    //! Remove all literals, the rejected count is reset.
+    void clear();
+
+    //! Get the literals, the longest first.
+    QStringList getLiterals() const { return literals; }
+
+    //! Check if a text contains all literals.
+    /*!
+      \param text The text to be checked
+      \return false if the text cannot match the regular expression
+    */
+    bool mayMatch(const QString &text) const;
+
+    //! Get the number of texts rejected by mayMatch().
+    quint64 getRejectedCount() const { return rejectedCount.load(std::memory_order_relaxed); }
+
+    //! Extract the literals of a regular expression pattern.
+    /*!
+      \param pattern The pattern of the regular expression
+      \param caseInsensitive True if the pattern is matched case insensitive, only ASCII literals are extracted then
+      \return The literals, empty if the pattern cannot be analysed or has no literals
+    */
+    static QStringList extractLiterals(const QString &pattern, bool caseInsensitive);
+
+private:
+    QStringList literals;
+    QVector<QStringMatcher> matchers;
+    mutable std::atomic<quint64> rejectedCount;
+};
+
+#endif // QDLTREGEXPREFILTER_H
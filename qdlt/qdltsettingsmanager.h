@@ -80,6 +80,8 @@ public:
     int pluginsAutoloadPath; // local setting
     QString pluginsAutoloadPathName; // local setting
     int filterCache; // local setting
+    int textBlockIndex; // local setting
+    int fullTextIndex; // local setting
     QByteArray geometry; // local setting
     QByteArray windowState; // local setting
     int RefreshRate; // local setting
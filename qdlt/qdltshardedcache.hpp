@@ -0,0 +1,65 @@
+#ifndef QDLTSHARDEDCACHE_HPP
+#define QDLTSHARDEDCACHE_HPP
+
+#include <QCache>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <array>
+
+//! Cache which can be accessed by many threads concurrently.
+/*!
+  The cache is split into shards selected by the hash of the key, each shard
+  is a QCache with its own lock. So threads accessing different keys rarely
+  wait for each other. Values are copied out while the shard is locked, as a
+  cached object may be deleted by another thread at any time.
+*/
+template<typename Key, typename Value, int ShardCount = 16>
+class QDltShardedCache {
+
+    struct Shard {
+        QMutex mutex;
+        QCache<Key, Value> cache;
+    };
+
+public:
+
+    void setMaxCost(qsizetype cost) {
+        for (Shard& shard : m_shards) {
+            QMutexLocker locker(&shard.mutex);
+            shard.cache.setMaxCost(qMax<qsizetype>(1, (cost + ShardCount - 1) / ShardCount));
+        }
+    }
+
+    bool insert(const Key& key, Value* value, qsizetype cost = 1) {
+        Shard& shard = shardForKey(key);
+        QMutexLocker locker(&shard.mutex);
+        return shard.cache.insert(key, value, cost);
+    }
+
+    bool get(const Key& key, Value& value) const {
+        Shard& shard = shardForKey(key);
+        QMutexLocker locker(&shard.mutex);
+        const Value* cached = shard.cache.object(key);
+        if (!cached)
+            return false;
+        value = *cached;
+        return true;
+    }
+
+    void clear() {
+        for (Shard& shard : m_shards) {
+            QMutexLocker locker(&shard.mutex);
+            shard.cache.clear();
+        }
+    }
+
+private:
+    Shard& shardForKey(const Key& key) const {
+        return m_shards[qHash(key) % ShardCount];
+    }
+
+    mutable std::array<Shard, ShardCount> m_shards;
+};
+
+#endif // QDLTSHARDEDCACHE_HPP
@@ -0,0 +1,95 @@
+#ifndef QDLTSPSCQUEUE_HPP
+#define QDLTSPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+//! Bounded queue passing values from one producer thread to one consumer thread without locks.
+/*!
+  The values are stored in a ring buffer of preallocated slots, its capacity
+  is rounded up to a power of two. The producer only writes the tail position
+  and the consumer only writes the head position, each side keeps a copy of
+  the position of the other side and only reads it again when the queue seems
+  to be full or empty. The positions are kept in separate cache lines, so the
+  two threads do not invalidate each others cache lines on every call.
+  Exactly one thread may call push() and exactly one thread may call pop().
+  Values are moved into and out of the slots, the slot of a popped value keeps
+  the moved-from value until it is used again.
+*/
+template<typename T>
+class QDltSpscQueue {
+
+public:
+
+    explicit QDltSpscQueue(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity)
+            size *= 2;
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    QDltSpscQueue(const QDltSpscQueue&) = delete;
+    QDltSpscQueue& operator=(const QDltSpscQueue&) = delete;
+
+    size_t capacity() const {
+        return m_slots.size();
+    }
+
+    //! Add a value, called by the producer, returns false if the queue is full.
+    bool push(T&& value) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache == m_slots.size()) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache == m_slots.size())
+                return false;
+        }
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T& value) {
+        T copy(value);
+        return push(std::move(copy));
+    }
+
+    //! Take the oldest value, called by the consumer, returns false if the queue is empty.
+    bool pop(T& value) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache)
+                return false;
+        }
+        value = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! Number of values in the queue, may be outdated when it is returned.
+    size_t size() const {
+        const size_t head = m_head.load(std::memory_order_acquire);
+        return m_tail.load(std::memory_order_acquire) - head;
+    }
+
+    bool isEmpty() const {
+        return size() == 0;
+    }
+
+private:
+    std::vector<T> m_slots;
+    size_t m_mask{0};
+
+    // written by the consumer
+    alignas(64) std::atomic<size_t> m_head{0};
+    size_t m_tailCache{0};
+
+    // written by the producer
+    alignas(64) std::atomic<size_t> m_tail{0};
+    size_t m_headCache{0};
+};
+
+#endif // QDLTSPSCQUEUE_HPP
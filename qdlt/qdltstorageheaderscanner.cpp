@@ -0,0 +1,344 @@
+#include "qdltstorageheaderscanner.h"
+
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(_M_AMD64)
+#define QDLT_SCANNER_X86_64
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define QDLT_SCANNER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define QDLT_SCANNER_TARGET_AVX2
+#endif
+
+namespace {
+
+bool cpuSupportsAvx2()
+{
+#if defined(QDLT_SCANNER_X86_64)
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    // AVX supported by CPU and YMM registers saved by the OS
+    if(!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)))
+        return false;
+    if((_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+#else
+    return false;
+#endif
+}
+
+#if defined(QDLT_SCANNER_X86_64)
+inline int countTrailingZeros(quint32 mask)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+qint64 findPatternScalar(const char *data, qint64 length)
+{
+    qint64 num = 0;
+
+    while(num + 3 < length)
+    {
+        const char *found = static_cast<const char *>(memchr(data + num, 'D', length - 3 - num));
+        if(!found)
+            return -1;
+        num = found - data;
+        if(data[num + 1] == 'L' && data[num + 2] == 'T' && (data[num + 3] == 0x01 || data[num + 3] == 0x02))
+            return num;
+        num++;
+    }
+
+    return -1;
+}
+
+#if defined(QDLT_SCANNER_X86_64)
+qint64 findPatternSse2(const char *data, qint64 length)
+{
+    const __m128i patternD = _mm_set1_epi8('D');
+    const __m128i patternL = _mm_set1_epi8('L');
+    const __m128i patternT = _mm_set1_epi8('T');
+    const __m128i version1 = _mm_set1_epi8(0x01);
+    const __m128i version2 = _mm_set1_epi8(0x02);
+    qint64 num = 0;
+
+    // compare 16 candidate positions at once, the remaining pattern bytes are only loaded if a 'D' was found
+    for(; num + 16 + 3 <= length; num += 16)
+    {
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + num));
+        const __m128i matchD = _mm_cmpeq_epi8(d, patternD);
+        if(!_mm_movemask_epi8(matchD))
+            continue;
+        const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + num + 1));
+        const __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + num + 2));
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + num + 3));
+        const __m128i match = _mm_and_si128(
+            _mm_and_si128(matchD, _mm_cmpeq_epi8(l, patternL)),
+            _mm_and_si128(_mm_cmpeq_epi8(t, patternT), _mm_or_si128(_mm_cmpeq_epi8(v, version1), _mm_cmpeq_epi8(v, version2))));
+        const quint32 mask = static_cast<quint32>(_mm_movemask_epi8(match));
+        if(mask)
+            return num + countTrailingZeros(mask);
+    }
+
+    const qint64 found = findPatternScalar(data + num, length - num);
+    return (found < 0) ? -1 : num + found;
+}
+
+QDLT_SCANNER_TARGET_AVX2 qint64 findPatternAvx2(const char *data, qint64 length)
+{
+    const __m256i patternD = _mm256_set1_epi8('D');
+    const __m256i patternL = _mm256_set1_epi8('L');
+    const __m256i patternT = _mm256_set1_epi8('T');
+    const __m256i version1 = _mm256_set1_epi8(0x01);
+    const __m256i version2 = _mm256_set1_epi8(0x02);
+    qint64 num = 0;
+
+    for(; num + 32 + 3 <= length; num += 32)
+    {
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + num));
+        const __m256i matchD = _mm256_cmpeq_epi8(d, patternD);
+        if(_mm256_testz_si256(matchD, matchD))
+            continue;
+        const __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + num + 1));
+        const __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + num + 2));
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + num + 3));
+        const __m256i match = _mm256_and_si256(
+            _mm256_and_si256(matchD, _mm256_cmpeq_epi8(l, patternL)),
+            _mm256_and_si256(_mm256_cmpeq_epi8(t, patternT), _mm256_or_si256(_mm256_cmpeq_epi8(v, version1), _mm256_cmpeq_epi8(v, version2))));
+        const quint32 mask = static_cast<quint32>(_mm256_movemask_epi8(match));
+        if(mask)
+            return num + countTrailingZeros(mask);
+    }
+
+    const qint64 found = findPatternScalar(data + num, length - num);
+    return (found < 0) ? -1 : num + found;
+}
+#endif
+
+std::atomic<int> &activeScanMode()
+{
+    static std::atomic<int> mode(QDltStorageHeaderScanner::getBestScanMode());
+    return mode;
+}
+
+//! Read the message length from storage header and standard header.
+/*!
+  \return false if the buffer does not contain the complete length information.
+*/
+bool readMessageLength(const char *data, qint64 length, qint64 &lengthEnd, qint64 &messageLength)
+{
+    qint64 storageLength;
+
+    if(data[3] == 0x01)
+    {
+        storageLength = 16;
+    }
+    else
+    {
+        if(length < 14)
+            return false;
+        storageLength = 14 + static_cast<unsigned char>(data[13]);
+    }
+
+    if(length <= storageLength)
+        return false;
+
+    // DLT protocol version decides where the length field is located
+    const quint8 version = (static_cast<unsigned char>(data[storageLength]) & 0xe0) >> 5;
+    const qint64 lengthOffset = (version == 2) ? 5 : 2;
+
+    if(length < storageLength + lengthOffset + 2)
+        return false;
+
+    messageLength = ((static_cast<unsigned char>(data[storageLength + lengthOffset]) << 8) |
+                     static_cast<unsigned char>(data[storageLength + lengthOffset + 1])) + storageLength;
+    lengthEnd = storageLength + lengthOffset + 2;
+
+    return true;
+}
+
+}
+
+QDltStorageHeaderScanner::QDltStorageHeaderScanner(qint64 fileSize)
+    : syncPointLimit(0)
+    , syncPointInterval(0)
+{
+    reset(fileSize);
+}
+
+void QDltStorageHeaderScanner::reset(qint64 _fileSize)
+{
+    fileSize = _fileSize;
+    currentMessagePos = 0;
+    nextMessagePos = 0;
+    errors = 0;
+    finished = false;
+    messagesSinceSyncPoint = 0;
+    syncPoints.clear();
+}
+
+qint64 QDltStorageHeaderScanner::scanBlock(const char *data, qint64 length, qint64 pos, QVector<qint64> &index)
+{
+    qint64 num = 0;
+
+    while(num < length && !finished)
+    {
+        const qint64 found = findPattern(data + num, length - num);
+        if(found < 0)
+        {
+            // the last three bytes could be the beginning of a pattern continued in the next block
+            if(num < length - 3)
+                num = length - 3;
+            break;
+        }
+        num += found;
+
+        const qint64 messagePos = pos + num;
+
+        if(nextMessagePos == 0 || nextMessagePos == messagePos)
+        {
+            qint64 lengthEnd, messageLength;
+
+            if(!readMessageLength(data + num, length - num, lengthEnd, messageLength))
+            {
+                // header split between blocks, read next block starting with this header
+                if(num > 0)
+                    return messagePos;
+                // header truncated at end of file
+                break;
+            }
+
+            if(nextMessagePos == 0)
+            {
+                // very first message detected or the first message after an error occurred
+                if(messagePos != 0)
+                    errors++;
+            }
+            else
+            {
+                // add message only when the next one starts exactly behind it
+                index.append(currentMessagePos);
+            }
+
+            currentMessagePos = messagePos;
+            nextMessagePos = messagePos + messageLength;
+
+            if(syncPoints.size() < syncPointLimit ||
+               (syncPointInterval > 0 && ++messagesSinceSyncPoint >= syncPointInterval))
+            {
+                syncPoints.append({messagePos, errors, static_cast<int>(index.size())});
+                messagesSinceSyncPoint = 0;
+            }
+
+            if(nextMessagePos == fileSize)
+            {
+                // last message found in file
+                index.append(currentMessagePos);
+                finished = true;
+                break;
+            }
+
+            // move directly to next message, the payload is not searched for headers
+            if(messageLength <= lengthEnd)
+                num += lengthEnd;
+            else if(nextMessagePos <= pos + length)
+                num = nextMessagePos - pos;
+            else
+                return nextMessagePos;
+        }
+        else if(nextMessagePos > messagePos)
+        {
+            // header detected before end of message
+            errors++;
+            num += 4;
+        }
+        else
+        {
+            // header detected after end of message
+            // start search for new message back after last header found
+            nextMessagePos = 0;
+            return currentMessagePos + 5;
+        }
+    }
+
+    return (num > 0) ? pos + num : pos + length;
+}
+
+qint64 QDltStorageHeaderScanner::findPattern(const char *data, qint64 length)
+{
+    switch(activeScanMode().load(std::memory_order_relaxed))
+    {
+#if defined(QDLT_SCANNER_X86_64)
+    case ScanModeAvx2:
+        return findPatternAvx2(data, length);
+    case ScanModeSse2:
+        return findPatternSse2(data, length);
+#endif
+    default:
+        return findPatternScalar(data, length);
+    }
+}
+
+QDltStorageHeaderScanner::ScanMode QDltStorageHeaderScanner::getScanMode()
+{
+    return static_cast<ScanMode>(activeScanMode().load());
+}
+
+bool QDltStorageHeaderScanner::setScanMode(ScanMode mode)
+{
+    if(!isScanModeSupported(mode))
+        return false;
+
+    activeScanMode().store(mode);
+
+    return true;
+}
+
+bool QDltStorageHeaderScanner::isScanModeSupported(ScanMode mode)
+{
+    switch(mode)
+    {
+    case ScanModeScalar:
+        return true;
+#if defined(QDLT_SCANNER_X86_64)
+    case ScanModeSse2:
+        return true;
+    case ScanModeAvx2:
+        return cpuSupportsAvx2();
+#endif
+    default:
+        return false;
+    }
+}
+
+QDltStorageHeaderScanner::ScanMode QDltStorageHeaderScanner::getBestScanMode()
+{
+    if(isScanModeSupported(ScanModeAvx2))
+        return ScanModeAvx2;
+    if(isScanModeSupported(ScanModeSse2))
+        return ScanModeSse2;
+
+    return ScanModeScalar;
+}
@@ -0,0 +1,139 @@
+#ifndef QDLTSTORAGEHEADERSCANNER_H
+#define QDLTSTORAGEHEADERSCANNER_H
+
+#include "export_rules.h"
+
+#include <QVector>
+
+//! Find DLT messages in a DLT log file by their storage header.
+/*!
+  The scanner searches for the storage header pattern "DLT\x01" or "DLT\x02"
+  and chains the found messages by the message length from the standard header.
+  A message is only accepted, if the next message starts exactly behind it or
+  the message ends exactly at the end of the file.
+  The pattern search is vectorized with SSE2 or AVX2, the implementation is
+  selected at runtime depending on the capabilities of the CPU.
+  The file is passed block by block, the scanner tells the caller from which
+  file position the next block must be read.
+*/
+class QDLT_EXPORT QDltStorageHeaderScanner
+{
+public:
+    //! The implementation used to search for the storage header pattern.
+    typedef enum { ScanModeScalar = 0, ScanModeSse2, ScanModeAvx2 } ScanMode;
+
+    //! A message accepted by the scanner, used to stitch scans of consecutive file ranges.
+    typedef struct
+    {
+        qint64 pos;     //!< Position of the accepted message.
+        qint64 errors;  //!< Number of errors after the message was accepted.
+        int indexSize;  //!< Size of the index before the message was accepted.
+    } SyncPoint;
+
+    //! Constructor.
+    /*!
+      \param fileSize The size of the file to be scanned.
+    */
+    explicit QDltStorageHeaderScanner(qint64 fileSize = 0);
+
+    //! Reset the scanner to start a new scan.
+    /*!
+      \param fileSize The size of the file to be scanned.
+    */
+    void reset(qint64 fileSize);
+
+    //! Scan one block of the file and append the found messages to the index.
+    /*!
+      \param data The data of the block.
+      \param length The length of the block.
+      \param pos The position of the block in the file.
+      \param index The index the positions of the found messages are appended to.
+      \return The file position the next block must be read from.
+    */
+    qint64 scanBlock(const char *data, qint64 length, qint64 pos, QVector<qint64> &index);
+
+    //! Check if the last message of the file was found.
+    /*!
+      \return true if the last message ends exactly at the end of the file.
+    */
+    bool isFinished() const { return finished; }
+
+    //! Get the number of wrong storage headers found during the scan.
+    /*!
+      \return Number of errors.
+    */
+    qint64 getErrors() const { return errors; }
+
+    //! Record the first accepted messages as sync points.
+    /*!
+      Two scans accepting the same message continue identically from there on.
+      \param limit Maximum number of recorded sync points, 0 disables recording.
+    */
+    void setSyncPointLimit(int limit) { syncPointLimit = limit; }
+
+    //! Record every n-th of the following accepted messages as sync points too.
+    /*!
+      \param interval Number of messages between recorded sync points, 0 disables recording.
+    */
+    void setSyncPointInterval(int interval) { syncPointInterval = interval; }
+
+    //! Get the recorded sync points.
+    const QVector<SyncPoint> &getSyncPoints() const { return syncPoints; }
+
+    //! Clear the recorded sync points, following messages are recorded again.
+    void clearSyncPoints() { syncPoints.clear(); }
+
+    //! Find the first storage header pattern in a buffer.
+    /*!
+      \param data The buffer to be searched.
+      \param length The length of the buffer.
+      \return Offset of the pattern in the buffer, -1 if not found.
+    */
+    static qint64 findPattern(const char *data, qint64 length);
+
+    //! Get the implementation currently used by findPattern().
+    static ScanMode getScanMode();
+
+    //! Select the implementation used by findPattern().
+    /*!
+      \param mode The implementation to be used.
+      \return false if the mode is not supported by this CPU, the mode is not changed then.
+    */
+    static bool setScanMode(ScanMode mode);
+
+    //! Check if an implementation is supported by this CPU.
+    static bool isScanModeSupported(ScanMode mode);
+
+    //! Get the best implementation supported by this CPU.
+    static ScanMode getBestScanMode();
+
+private:
+    //! Size of the scanned file.
+    qint64 fileSize;
+
+    //! Position of the message currently checked.
+    qint64 currentMessagePos;
+
+    //! Expected position of the next message, 0 if not in sync.
+    qint64 nextMessagePos;
+
+    //! Number of wrong storage headers found.
+    qint64 errors;
+
+    //! The last message of the file was found.
+    bool finished;
+
+    //! Maximum number of recorded sync points.
+    int syncPointLimit;
+
+    //! Number of messages between sync points recorded behind the limit.
+    int syncPointInterval;
+
+    //! Number of messages since the last sync point recorded behind the limit.
+    int messagesSinceSyncPoint;
+
+    //! The recorded sync points.
+    QVector<SyncPoint> syncPoints;
+};
+
+#endif // QDLTSTORAGEHEADERSCANNER_H
@@ -0,0 +1,253 @@
+#include "qdlttextblockindex.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFile>
+#include <QtEndian>
+
+#include <algorithm>
+
+namespace {
+
+// size of the MD5 checksum at the end of a text block index file
+const int checksumSize = 16;
+
+// the bit positions of a trigram are 15 bit values
+const int filterBits = QDLT_TEXT_BLOCK_FILTER_SIZE * 8;
+static_assert(filterBits == 0x8000, "the bit positions of a trigram do not fit the filter size");
+
+ushort foldCharacter(ushort character)
+{
+    if(character < 128)
+        return (character >= 'A' && character <= 'Z') ? character + ('a' - 'A') : character;
+    return static_cast<ushort>(QChar::toCaseFolded(static_cast<uint>(character)));
+}
+
+// two bit positions of a trigram of folded characters, taken from the high bits of a multiplicative hash
+void trigramBits(ushort first, ushort second, ushort third, quint16 &bit1, quint16 &bit2)
+{
+    quint64 hash = (static_cast<quint64>(first) << 32) | (static_cast<quint64>(second) << 16) | third;
+    hash *= Q_UINT64_C(0x9E3779B97F4A7C15);
+    bit1 = static_cast<quint16>(hash >> 49);
+    bit2 = static_cast<quint16>((hash >> 34) & (filterBits - 1));
+}
+
+// call a function for the bits of all trigrams of a text, surrogates are not part of any trigram
+template<typename Function>
+void forEachTrigram(const QString &text, Function function)
+{
+    ushort first = 0, second = 0;
+    int count = 0;
+
+    for(const QChar &character : text)
+    {
+        if(character.isSurrogate())
+        {
+            count = 0;
+            continue;
+        }
+
+        const ushort third = foldCharacter(character.unicode());
+        if(++count >= 3)
+        {
+            quint16 bit1, bit2;
+            trigramBits(first, second, third, bit1, bit2);
+            function(bit1);
+            function(bit2);
+        }
+        first = second;
+        second = third;
+    }
+}
+
+void writeValue(QByteArray &data, quint32 value)
+{
+    const int pos = data.size();
+    data.resize(pos + 4);
+    qToLittleEndian<quint32>(value, data.data() + pos);
+}
+
+bool readValue(const QByteArray &data, int &pos, quint32 &value)
+{
+    if(data.size() - pos < 4)
+        return false;
+    value = qFromLittleEndian<quint32>(data.constData() + pos);
+    pos += 4;
+    return true;
+}
+
+bool readBytes(const QByteArray &data, int &pos, quint32 size, QByteArray &bytes)
+{
+    if(size > static_cast<quint32>(data.size() - pos))
+        return false;
+    bytes = data.mid(pos, static_cast<int>(size));
+    pos += static_cast<int>(size);
+    return true;
+}
+
+}
+
+QDltTextBlockIndex::QDltTextBlockIndex()
+    : messages(0)
+{
+}
+
+void QDltTextBlockIndex::clear()
+{
+    messages = 0;
+    filters.clear();
+    complete.clear();
+    renderKey.clear();
+}
+
+void QDltTextBlockIndex::startMessage()
+{
+    if(messages % QDLT_TEXT_BLOCK_SIZE == 0)
+    {
+        filters.append(QByteArray(QDLT_TEXT_BLOCK_FILTER_SIZE, 0));
+        complete.append(true);
+    }
+    messages++;
+}
+
+void QDltTextBlockIndex::addText(const QString &text)
+{
+    uchar *filter = reinterpret_cast<uchar*>(filters.data()) + (blockCount() - 1) * QDLT_TEXT_BLOCK_FILTER_SIZE;
+
+    forEachTrigram(text, [filter](quint16 bit) {
+        filter[bit >> 3] |= static_cast<uchar>(1 << (bit & 7));
+    });
+}
+
+void QDltTextBlockIndex::append(const QString &header, const QString &payload)
+{
+    startMessage();
+    addText(header);
+    addText(payload);
+}
+
+void QDltTextBlockIndex::appendInvalid()
+{
+    startMessage();
+    complete.last() = false;
+}
+
+QDltTextBlockIndex::Query QDltTextBlockIndex::query(const QStringList &literals)
+{
+    Query result;
+
+    for(const QString &literal : literals)
+        forEachTrigram(literal, [&result](quint16 bit) { result.append(bit); });
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
+    return result;
+}
+
+bool QDltTextBlockIndex::mayContain(int num, const Query &query) const
+{
+    const int block = num / QDLT_TEXT_BLOCK_SIZE;
+
+    // messages which are not indexed and blocks with broken messages are always searched
+    if(query.isEmpty() || num < 0 || block >= blockCount() || !complete[block])
+        return true;
+
+    const uchar *filter = reinterpret_cast<const uchar*>(filters.constData()) + block * QDLT_TEXT_BLOCK_FILTER_SIZE;
+    for(quint16 bit : query)
+    {
+        if(!(filter[bit >> 3] & (1 << (bit & 7))))
+            return false;
+    }
+
+    return true;
+}
+
+bool QDltTextBlockIndex::save(const QString &filename, const QByteArray &key) const
+{
+    QByteArray data;
+
+    // header
+    writeValue(data, QDLT_TEXT_BLOCK_INDEX_FILE_VERSION);
+    writeValue(data, static_cast<quint32>(messages));
+    writeValue(data, static_cast<quint32>(key.size()));
+    data += key;
+    writeValue(data, static_cast<quint32>(renderKey.size()));
+    data += renderKey;
+
+    // one byte per block for the complete flag, then the filters
+    for(bool blockComplete : complete)
+        data += blockComplete ? '\1' : '\0';
+    data += filters;
+
+    data += QCryptographicHash::hash(data, QCryptographicHash::Md5);
+
+    QFile file(filename);
+
+    // open text block index file
+    if(!file.open(QFile::WriteOnly))
+        return false;
+
+    // write the complete file at once
+    if(file.write(data) != data.size())
+    {
+        file.close();
+        file.remove();
+        return false;
+    }
+
+    file.close();
+
+    return true;
+}
+
+bool QDltTextBlockIndex::load(const QString &filename, const QByteArray &key)
+{
+    QFile file(filename);
+    quint32 version, count, keySize, renderKeySize;
+    QByteArray fileKey, flags;
+    int pos = 0;
+
+    clear();
+
+    // open text block index file
+    if(!file.open(QFile::ReadOnly))
+        return false;
+
+    QByteArray data = file.readAll();
+    file.close();
+
+    // check the checksum first, so all sizes can be trusted
+    if(data.size() < checksumSize ||
+       QCryptographicHash::hash(QByteArray::fromRawData(data.constData(), data.size() - checksumSize), QCryptographicHash::Md5) != data.right(checksumSize))
+    {
+        qDebug() << "Loading text block index file" << filename << "failed, file is corrupt";
+        return false;
+    }
+    data.chop(checksumSize);
+
+    if(!readValue(data, pos, version) || version != QDLT_TEXT_BLOCK_INDEX_FILE_VERSION ||
+       !readValue(data, pos, count) || count > static_cast<quint32>(INT_MAX - QDLT_TEXT_BLOCK_SIZE) ||
+       !readValue(data, pos, keySize) || !readBytes(data, pos, keySize, fileKey) || fileKey != key ||
+       !readValue(data, pos, renderKeySize) || !readBytes(data, pos, renderKeySize, renderKey))
+    {
+        clear();
+        return false;
+    }
+
+    const quint32 blocks = (count + QDLT_TEXT_BLOCK_SIZE - 1) / QDLT_TEXT_BLOCK_SIZE;
+    if(!readBytes(data, pos, blocks, flags) ||
+       static_cast<qint64>(data.size() - pos) != static_cast<qint64>(blocks) * QDLT_TEXT_BLOCK_FILTER_SIZE)
+    {
+        qDebug() << "Loading text block index file" << filename << "failed, wrong size";
+        clear();
+        return false;
+    }
+
+    messages = static_cast<int>(count);
+    for(char flag : flags)
+        complete.append(flag != 0);
+    filters = data.mid(pos);
+
+    return true;
+}
@@ -0,0 +1,117 @@
+#ifndef QDLTTEXTBLOCKINDEX_H
+#define QDLTTEXTBLOCKINDEX_H
+
+#include "export_rules.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+//! Version of text block index files.
+#define QDLT_TEXT_BLOCK_INDEX_FILE_VERSION 1
+
+//! Number of messages summarised by one block of a text block index.
+#define QDLT_TEXT_BLOCK_SIZE 4096
+
+//! Size of the Bloom filter of one block in bytes.
+#define QDLT_TEXT_BLOCK_FILTER_SIZE 4096
+
+//! Trigram Bloom filters of the text of blocks of messages of a DLT log file.
+/*!
+  The messages of the index of a DLT log file are grouped into blocks of
+  QDLT_TEXT_BLOCK_SIZE messages. For each block all trigrams of the header
+  and payload text of its messages are added to a Bloom filter, two bits
+  per trigram. The characters are case folded, so the filters serve case
+  sensitive and case insensitive searches.
+  A search for literal text only has to read the messages of blocks, whose
+  filter contains all trigrams of the text. Blocks with a message which
+  could not be parsed are always searched.
+  The text of a message depends on decoder plugins and settings, the key of
+  the text rendering is stored with the index and must be checked before
+  the index is used.
+*/
+class QDLT_EXPORT QDltTextBlockIndex
+{
+public:
+    //! Bits of the trigrams of searched literals, created by query().
+    typedef QVector<quint16> Query;
+
+    //! Constructor.
+    QDltTextBlockIndex();
+
+    //! Remove all blocks.
+    void clear();
+
+    //! Get the number of messages.
+    int size() const { return messages; }
+
+    //! Get the number of blocks.
+    int blockCount() const { return static_cast<int>(complete.size()); }
+
+    //! Set the key of the text rendering of the messages.
+    void setRenderKey(const QByteArray &key) { renderKey = key; }
+
+    //! Get the key of the text rendering of the messages.
+    const QByteArray &getRenderKey() const { return renderKey; }
+
+    //! Append the text of the next message.
+    /*!
+      \param header The header text of the message
+      \param payload The payload text of the message
+    */
+    void append(const QString &header, const QString &payload);
+
+    //! Append a message which could not be parsed, its block is always searched.
+    void appendInvalid();
+
+    //! Create the query for literals, which are all contained in the searched texts.
+    /*!
+      Literals shorter than three characters are not checked.
+      \param literals The literals
+      \return The query, empty if no literal can be checked
+    */
+    static Query query(const QStringList &literals);
+
+    //! Check if the text of a message may contain the literals of a query.
+    /*!
+      \param num The number of the message
+      \param query The query of the literals
+      \return false if no message of the block of the message contains all literals
+    */
+    bool mayContain(int num, const Query &query) const;
+
+    //! Save the text block index to a file.
+    /*!
+      \param filename The name of the file.
+      \param key Data identifying the indexed DLT log file, checked when loading.
+      \return true if the file was written successfully.
+    */
+    bool save(const QString &filename, const QByteArray &key) const;
+
+    //! Load the text block index from a file.
+    /*!
+      \param filename The name of the file.
+      \param key Data identifying the indexed DLT log file, must be the key used when saving.
+      \return false if the file cannot be read, is corrupt or was saved with another key.
+    */
+    bool load(const QString &filename, const QByteArray &key);
+
+private:
+    void addText(const QString &text);
+    void startMessage();
+
+    //! Number of appended messages.
+    int messages;
+
+    //! Bloom filters of all blocks, QDLT_TEXT_BLOCK_FILTER_SIZE bytes per block.
+    QByteArray filters;
+
+    //! Per block, true if all messages of the block could be parsed.
+    QVector<bool> complete;
+
+    //! Key of the text rendering.
+    QByteArray renderKey;
+};
+
+#endif // QDLTTEXTBLOCKINDEX_H
@@ -0,0 +1,243 @@
+// Throughput and heap allocations of parsing a received DLT stream, against the former
+// growing buffer with byte-wise sync search.
+// The stream is received in pieces like from a TCP socket or a serial port.
+// Usage: bench_connection [number of generated messages | DLT file recorded from a connection]
+
+#include <dlt_common.h>
+#include <qdltserialconnection.h>
+#include <qdlttcpconnection.h>
+
+#include "testutils.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+std::atomic<quint64> allocations(0);
+
+}
+
+#if defined(__GLIBC__)
+// count the heap allocations of the whole process, including those of Qt
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+
+extern "C" void *malloc(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+#endif
+
+namespace {
+
+const int pieceSize = 1460;
+
+// the former receive buffer, the data not parsed yet was copied with every piece received
+class LegacyConnection {
+public:
+    explicit LegacyConnection(bool syncSerialHeader) : dataView(data), syncSerialHeader(syncSerialHeader), bytesError(0) {}
+
+    void add(const QByteArray &bytes) {
+        QByteArray dataViewArray = dataView;
+        data = dataViewArray + bytes;
+        dataView.align(data);
+    }
+
+    bool parseDlt(QDltMsg &msg) {
+        int found = 0;
+        int firstPos = 0;
+        int secondPos = 0;
+        char lastFound = 0;
+        const int cbuf_sz = dataView.size();
+        const char *cbuf = dataView.constData();
+
+        for (int num = 0; num < cbuf_sz; num++) {
+            if (cbuf[num] == 'D') {
+                lastFound = 'D';
+            } else if (lastFound == 'D' && cbuf[num] == 'L') {
+                lastFound = 'L';
+            } else if (lastFound == 'L' && cbuf[num] == 'S') {
+                lastFound = 'S';
+            } else if (lastFound == 'S' && cbuf[num] == 0x01) {
+                found++;
+                if (found == 1)
+                    firstPos = num + 1;
+                if (found == 2) {
+                    secondPos = num + 1;
+                    break;
+                }
+                lastFound = 0;
+            } else {
+                lastFound = 0;
+            }
+            if (!syncSerialHeader && num == 3)
+                break;
+        }
+
+        if (syncSerialHeader && !found) {
+            if (!lastFound) {
+                bytesError += dataView.size();
+                dataView.clear();
+            }
+            return false;
+        }
+
+        if (found == 2) {
+            const bool ok = msg.setMsg(dataView.mid(firstPos, secondPos - firstPos - 4), false);
+            dataView.advance(secondPos - 4);
+            return ok;
+        }
+
+        if (!msg.setMsg(dataView.mid(firstPos), false)) {
+            if (dataView.size() > DLT_MAX_MESSAGE_LEN) {
+                bytesError += dataView.size();
+                dataView.clear();
+            }
+            return false;
+        }
+
+        dataView.advance(firstPos + msg.getHeaderSize() + msg.getPayloadSize());
+        return true;
+    }
+
+private:
+    QByteArray data;
+    QDltDataView dataView;
+    bool syncSerialHeader;
+    unsigned long bytesError;
+};
+
+QByteArray createMessage(int num) {
+    QDltMsg msg = testutils::createMsg({QString("received value"), num});
+    msg.setMessageCounter(static_cast<unsigned char>(num));
+    return testutils::toBytes(msg, false);
+}
+
+// the messages of a recorded DLT file without their storage headers, as sent by the DLT daemon
+QList<QByteArray> readMessages(const QString &fileName) {
+    QList<QByteArray> messages;
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return messages;
+    const QByteArray data = file.readAll();
+
+    QDltMsg msg;
+    quint32 pos = 0;
+    while (pos < static_cast<quint32>(data.size())) {
+        const char *ptr = data.constData() + pos;
+        const quint32 size = msg.checkMsgSize(ptr, data.size() - pos);
+        if (size == 0)
+            break;
+        const quint32 storageHeaderSize = (ptr[3] == 0x02) ? 14 + static_cast<quint8>(ptr[13]) : sizeof(DltStorageHeader);
+        messages.append(QByteArray(ptr + storageHeaderSize, size - storageHeaderSize));
+        pos += size;
+    }
+    return messages;
+}
+
+void print(const char *name, int count, qint64 bytes, qint64 nsecs, quint64 allocated) {
+    printf("%-36s %8.1f MB/s %10.2f allocations/message\n", name, bytes / (nsecs / 1e9) / 1e6,
+           static_cast<double>(allocated) / count);
+}
+
+template <typename Feed>
+void bench(const char *name, const QByteArray &stream, int count, Feed feed) {
+    QElapsedTimer timer;
+    const quint64 before = allocations.load();
+    timer.start();
+    const int parsed = feed();
+    const qint64 nsecs = timer.nsecsElapsed();
+    const quint64 allocated = allocations.load() - before;
+    if (parsed != count)
+        printf("%s: %d of %d messages parsed\n", name, parsed, count);
+    print(name, count, stream.size(), nsecs, allocated);
+}
+
+template <typename Connection>
+int feedLegacy(Connection &connection, const QByteArray &stream) {
+    QDltMsg msg;
+    int parsed = 0;
+    for (int pos = 0; pos < stream.size(); pos += pieceSize) {
+        connection.add(QByteArray::fromRawData(stream.constData() + pos, qMin(pieceSize, stream.size() - pos)));
+        while (connection.parseDlt(msg))
+            parsed++;
+    }
+    return parsed;
+}
+
+// received directly into the buffer of the connection, like the ingest thread of the viewer
+int feed(QDltConnection &connection, const QByteArray &stream) {
+    QDltMsg msg;
+    int parsed = 0;
+    for (int pos = 0; pos < stream.size(); pos += pieceSize) {
+        const int size = qMin(pieceSize, stream.size() - pos);
+        memcpy(connection.reserve(size), stream.constData() + pos, size);
+        connection.commit(size);
+        while (connection.parseDlt(msg))
+            parsed++;
+    }
+    return parsed;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QList<QByteArray> messages;
+    if (argc > 1 && QFile::exists(argv[1]))
+        messages = readMessages(argv[1]);
+    if (messages.isEmpty()) {
+        const int count = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : 500000;
+        for (int num = 0; num < count; num++)
+            messages.append(createMessage(num));
+    }
+
+    QByteArray tcpStream, serialStream;
+    for (const QByteArray &message : std::as_const(messages)) {
+        tcpStream += message;
+        serialStream += QByteArray("DLS\x01", 4) + message;
+    }
+    const int count = messages.size();
+    printf("%d messages, %lld bytes, received in pieces of %d bytes\n", count, static_cast<long long>(tcpStream.size()), pieceSize);
+
+    bench("TCP former", tcpStream, count, [&]() {
+        LegacyConnection connection(false);
+        return feedLegacy(connection, tcpStream);
+    });
+    bench("TCP QDltTCPConnection", tcpStream, count, [&]() {
+        QDltTCPConnection connection;
+        return feed(connection, tcpStream);
+    });
+    bench("serial sync former", serialStream, count, [&]() {
+        LegacyConnection connection(true);
+        return feedLegacy(connection, serialStream);
+    });
+    bench("serial sync QDltSerialConnection", serialStream, count, [&]() {
+        QDltSerialConnection connection;
+        connection.setSyncSerialHeader(true);
+        return feed(connection, serialStream);
+    });
+
+#if !defined(__GLIBC__)
+    printf("allocations are only counted with glibc\n");
+#endif
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Micro-benchmark of the buffered file writer against writing and flushing every message.
+// Usage: bench_filewriter [number of messages]
+
+#include <qdltfilewriter.h>
+
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const int payloadSize = 100;
+
+DltStorageHeader storageHeader() {
+    DltStorageHeader header;
+    memcpy(header.pattern, "DLT\x01", 4);
+    header.seconds = 1700000000;
+    header.microseconds = 0;
+    memcpy(header.ecu, "ECU1", 4);
+    return header;
+}
+
+void print(const char* name, int count, qint64 nsecs, qint64 bytes) {
+    printf("%-32s %8.2f k messages/s %8.1f MB/s\n", name, count / (nsecs / 1e9) / 1e3, bytes / (nsecs / 1e9) / 1e6);
+}
+
+// the former way of the main window: a write call per part of the message and a flush
+qint64 benchPerMessage(const QString& fileName, int count) {
+    QFile file(fileName);
+    file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    const DltStorageHeader str = storageHeader();
+    const QByteArray header(16, 'h');
+    const QByteArray payload(payloadSize, 'p');
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int num = 0; num < count; num++) {
+        file.write(reinterpret_cast<const char*>(&str), sizeof(DltStorageHeader));
+        file.write(header);
+        file.write(payload.constData(), payload.size());
+        file.flush();
+    }
+    file.close();
+    return timer.nsecsElapsed();
+}
+
+qint64 benchWriter(const QString& fileName, int count, qint64 bytes, int messages, int milliseconds) {
+    QFile::remove(fileName);
+    QDltFileWriter writer;
+    writer.setFlushPolicy(bytes, messages, milliseconds);
+    writer.open(fileName);
+    const DltStorageHeader str = storageHeader();
+    const QByteArray header(16, 'h');
+    const QByteArray payload(payloadSize, 'p');
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int num = 0; num < count; num++)
+        writer.writeMessage(str, header, std::string_view(payload.constData(), payload.size()));
+    writer.close();
+    return timer.nsecsElapsed();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int count = argc > 1 ? atoi(argv[1]) : 1000000;
+    const qint64 bytes = qint64(count) * (sizeof(DltStorageHeader) + 16 + payloadSize);
+
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath("bench.dlt");
+
+    printf("%d messages with %d bytes payload\n", count, payloadSize);
+    print("write and flush per message", count, benchPerMessage(fileName, count), bytes);
+    print("writer 64 KB / 1000 / 100 ms", count, benchWriter(fileName, count, 64 * 1024, 1000, 100), bytes);
+    print("writer 1 MB / 10000 / 100 ms", count, benchWriter(fileName, count, 1024 * 1024, 10000, 100), bytes);
+    print("writer 4 MB / off / 100 ms", count, benchWriter(fileName, count, 4 * 1024 * 1024, 0, 100), bytes);
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+// Micro-benchmark of the compiled filter list against the former loop over all positive and negative filters.
+// Usage: bench_filterlist [number of messages] [number of application id filters]
+
+#include <qdltfilterlist.h>
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <cstdio>
+
+namespace {
+
+QVector<QDltMsg> createMessages(int count, int apids) {
+    QVector<QDltMsg> messages;
+    messages.reserve(count);
+    QRandomGenerator random(42);
+
+    for (int num = 0; num < count; num++) {
+        QDltMsg msg;
+        msg.setEcuid(random.bounded(2) ? "ECU1" : "ECU2");
+        msg.setApid(QString("A%1").arg(random.bounded(apids * 2)));
+        msg.setCtid(QString("C%1").arg(random.bounded(20)));
+        msg.setType(QDltMsg::DltTypeLog);
+        msg.setSubtype(random.bounded(1, 7));
+        msg.setMode(QDltMsg::DltModeVerbose);
+
+        QDltArgument arg;
+        arg.setValue(QVariant(QString("value %1 of some measurement").arg(random.bounded(100000))));
+        msg.addArgument(arg);
+        msg.setNumberOfArguments(1);
+
+        // parse the message again, as done when reading from a file
+        QByteArray buf;
+        msg.getMsg(buf, true);
+        QDltMsg parsed;
+        parsed.setMsg(buf, true);
+        messages.append(parsed);
+    }
+
+    return messages;
+}
+
+// a typical filter configuration, many application ids and a few payload filters
+void createFilters(QDltFilterList& filterList, int apids) {
+    for (int num = 0; num < apids; num++) {
+        QDltFilter* filter = new QDltFilter();
+        filter->type = QDltFilter::positive;
+        filter->enableFilter = true;
+        filter->enableApid = true;
+        filter->apid = QString("A%1").arg(num);
+        filter->enableLogLevelMax = num % 2;
+        filter->logLevelMax = 4;
+        filterList.addFilter(filter);
+    }
+
+    for (const char* payload : {"value 1", "measurement 42"}) {
+        QDltFilter* filter = new QDltFilter();
+        filter->type = QDltFilter::negative;
+        filter->enableFilter = true;
+        filter->enablePayload = true;
+        filter->payload = payload;
+        filterList.addFilter(filter);
+    }
+
+    filterList.updateSortedFilter();
+}
+
+// the filter check as done before by QDltFilterList::checkFilter()
+bool legacyCheckFilter(const QList<QDltFilter*>& pfilters, const QList<QDltFilter*>& nfilters, const QDltMsg& msg) {
+    bool found = pfilters.isEmpty();
+    for (QDltFilter* filter : pfilters) {
+        found = filter->match(msg);
+        if (found)
+            break;
+    }
+    if (found) {
+        for (QDltFilter* filter : nfilters) {
+            if (filter->match(msg))
+                return false;
+        }
+    }
+    return found;
+}
+
+template <typename Function>
+void measure(const char* name, QVector<QDltMsg>& messages, Function function) {
+    QElapsedTimer timer;
+    timer.start();
+    int matches = 0;
+    for (QDltMsg& msg : messages)
+        matches += function(msg) ? 1 : 0;
+    const double seconds = timer.nsecsElapsed() / 1e9;
+    printf("%-24s %8.2f M messages/s %10d matches\n", name, messages.size() / seconds / 1e6, matches);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int count = (argc > 1) ? QByteArray(argv[1]).toInt() : 1000000;
+    const int apids = (argc > 2) ? QByteArray(argv[2]).toInt() : 50;
+
+    QVector<QDltMsg> messages = createMessages(count, apids);
+    QDltFilterList filterList;
+    createFilters(filterList, apids);
+
+    QList<QDltFilter*> pfilters, nfilters;
+    for (QDltFilter* filter : filterList.filters) {
+        if (filter->isPositive())
+            pfilters.append(filter);
+        else if (filter->isNegative())
+            nfilters.append(filter);
+    }
+
+    printf("%d messages, %d filters\n", count, static_cast<int>(filterList.filters.size()));
+
+    measure("legacy filter loop", messages, [&](const QDltMsg& msg) { return legacyCheckFilter(pfilters, nfilters, msg); });
+    measure("compiled filters", messages, [&](QDltMsg& msg) { return filterList.checkFilter(msg); });
+
+    return 0;
+}
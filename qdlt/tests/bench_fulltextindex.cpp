@@ -0,0 +1,59 @@
+// Micro-benchmark of the full text index: time to create it and time to find the candidates compared to a scan.
+// Usage: bench_fulltextindex [number of messages]
+
+#include <qdltfulltextindex.h>
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <cstdio>
+
+namespace {
+
+QStringList createPayloads(int count) {
+    QStringList payloads;
+    QRandomGenerator random(42);
+
+    for (int num = 0; num < count; num++) {
+        // one message in ten thousand contains the searched text
+        if (random.bounded(10000) == 0)
+            payloads.append(QString("watchdog timeout of task %1 after %2 ms").arg(random.bounded(50)).arg(random.bounded(1000)));
+        else
+            payloads.append(QString("connection %1 of service %2 changed state to %3").arg(random.bounded(1000)).arg(random.bounded(5000)).arg(random.bounded(8)));
+    }
+
+    return payloads;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int count = (argc > 1) ? QByteArray(argv[1]).toInt() : 1000000;
+    const QStringList payloads = createPayloads(count);
+    const QString header("2024/01/01 12:00:00.000000 1234.5678 42 ECU1 APP1 CON1 0 log info verbose 1");
+
+    QElapsedTimer timer;
+    timer.start();
+    QDltFullTextIndex fullText;
+    for (const QString& payload : payloads)
+        fullText.append(header, payload);
+    printf("create %8.2f M messages/s, %d words\n", count / (timer.nsecsElapsed() / 1e9) / 1e6, fullText.wordCount());
+
+    for (const char* text : {"watchdog timeout", "service 42 changed", "timeout of task 7", "not contained"}) {
+        timer.restart();
+        QVector<int> candidates;
+        fullText.findAll({text}, candidates);
+        const double indexTime = timer.nsecsElapsed() / 1e6;
+
+        timer.restart();
+        int matches = 0;
+        for (const QString& payload : payloads)
+            matches += payload.contains(QLatin1String(text), Qt::CaseInsensitive) ? 1 : 0;
+        const double scanTime = timer.nsecsElapsed() / 1e6;
+
+        printf("%-20s %8d candidates %8.3f ms, scan %8d matches %8.3f ms\n", text, static_cast<int>(candidates.size()), indexTime,
+               matches, scanTime);
+    }
+
+    return 0;
+}
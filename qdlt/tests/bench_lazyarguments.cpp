@@ -0,0 +1,103 @@
+// Micro-benchmark of filtering with a header only filter, with arguments parsed when reading and lazily.
+// The loop is the one of DltFileIndexer::indexFilter() without decoder plugins.
+// Usage: bench_lazyarguments [dlt file ...], without files testfile.dlt and a synthetic file are used
+
+#include <qdltfile.h>
+#include <qdltfilterlist.h>
+
+#include "testutils.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryFile>
+
+#include <cstdio>
+
+namespace {
+
+// minimum number of messages read per measurement, small files are read several times
+const int minMessages = 1000000;
+
+bool createSyntheticFile(QTemporaryFile& file, int count) {
+    if (!file.open())
+        return false;
+
+    for (int num = 0; num < count; num++) {
+        // several arguments like typical log messages
+        QVariantList values;
+        for (int arg = 0; arg < 4; arg++) {
+            if (arg % 2)
+                values.append(num + arg);
+            else
+                values.append(QString("value %1 of measurement %2").arg(num).arg(arg));
+        }
+
+        QDltMsg msg = testutils::createMsg(values);
+        msg.setApid(QString("AP%1").arg(num % 20));
+        file.write(testutils::toBytes(msg));
+    }
+    file.flush();
+
+    return true;
+}
+
+void measure(const char* name, QDltFile& file, QDltFilterList& filterList, bool lazyArguments) {
+    QDltMsg msg;
+    int messages = 0, matches = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    do {
+        for (int ix = 0; ix < file.size(); ix++, messages++) {
+            if (file.getMsg(ix, msg, lazyArguments) && filterList.checkFilter(msg) && msg.hasValidArguments())
+                matches++;
+        }
+    } while (messages < minMessages && file.size() > 0);
+
+    const double seconds = timer.nsecsElapsed() / 1e9;
+    printf("%-24s %8.2f M messages/s %10d matches\n", name, messages / seconds / 1e6, matches);
+}
+
+void bench(const QString& fileName) {
+    QDltFile file;
+    // the cache would hide the parsing costs
+    file.setCacheSize(0);
+    if (!file.open(fileName) || !file.createIndex()) {
+        printf("cannot read %s\n", qPrintable(fileName));
+        return;
+    }
+    printf("%s: %d messages\n", qPrintable(fileName), file.size());
+
+    // a header only filter selecting a few messages
+    QDltFilterList filterList;
+    QDltFilter* filter = new QDltFilter();
+    filter->type = QDltFilter::positive;
+    filter->enableFilter = true;
+    filter->enableApid = true;
+    filter->apid = "AP7";
+    filterList.addFilter(filter);
+    filterList.updateSortedFilter();
+
+    measure("arguments parsed", file, filterList, false);
+    measure("arguments lazy", file, filterList, true);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        for (int num = 1; num < argc; num++)
+            bench(argv[num]);
+        return 0;
+    }
+
+    if (QFile::exists("testfile.dlt"))
+        bench("testfile.dlt");
+
+    QTemporaryFile file;
+    if (!createSyntheticFile(file, minMessages))
+        return 1;
+    bench(file.fileName());
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Micro-benchmark of the message cache of the table model against the former std::list based LRU cache.
+// Simulates the accesses of repaints while scrolling through the message table.
+// Usage: bench_lrucache [number of scroll steps]
+
+#include <qdltlrucache.hpp>
+
+#include <QByteArray>
+#include <QElapsedTimer>
+
+#include <cstdio>
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// rows visible in the table, data() is called for each column and role of a visible row
+const int visibleRows = 50;
+const int cellAccesses = 15 * 4;
+const int rowCount = 1000000;
+
+// the cache used before, one list node per put
+template<typename Key, typename Value>
+class LegacyLruCache {
+    struct CacheEntry {
+        Key key;
+        Value value;
+    };
+
+    using CacheListIterator = typename std::list<CacheEntry>::iterator;
+
+public:
+    LegacyLruCache(size_t capacity) : m_capacity(capacity) {}
+
+    void put(const Key& key, const Value& value) {
+        auto it = m_keyIteratorsMap.find(key);
+        m_cacheItems.push_front(CacheEntry{key, value});
+        if (it != m_keyIteratorsMap.end()) {
+            m_cacheItems.erase(it->second);
+            m_keyIteratorsMap.erase(it);
+        }
+        m_keyIteratorsMap[key] = m_cacheItems.begin();
+
+        if (m_keyIteratorsMap.size() > m_capacity) {
+            auto last = std::prev(m_cacheItems.end());
+            m_keyIteratorsMap.erase(last->key);
+            m_cacheItems.pop_back();
+        }
+    }
+
+    const Value& get(const Key& key) {
+        auto it = m_keyIteratorsMap.find(key);
+        if (it == m_keyIteratorsMap.end())
+            throw std::range_error("no such key in cache found");
+        m_cacheItems.splice(m_cacheItems.begin(), m_cacheItems, it->second);
+        return it->second->value;
+    }
+
+    bool exists(const Key& key) const { return m_keyIteratorsMap.find(key) != m_keyIteratorsMap.end(); }
+
+private:
+    std::list<CacheEntry> m_cacheItems;
+    std::unordered_map<Key, CacheListIterator> m_keyIteratorsMap;
+    const size_t m_capacity;
+};
+
+// first rows of the repaints: small scroll steps, page steps and a few jumps
+std::vector<int> scrollPositions(int steps) {
+    std::mt19937 random(42);
+    std::vector<int> positions;
+    positions.reserve(steps);
+    int top = 0;
+
+    for (int step = 0; step < steps; step++) {
+        const unsigned kind = random() % 100;
+        if (kind < 80)
+            top += static_cast<int>(random() % 7) - 2;
+        else if (kind < 97)
+            top += (random() % 2) ? visibleRows : -visibleRows;
+        else
+            top = static_cast<int>(random() % (rowCount - visibleRows));
+        top = qBound(0, top, rowCount - visibleRows);
+        positions.push_back(top);
+    }
+
+    return positions;
+}
+
+// the access pattern of TableModel::data(): exists() and get() on a hit, put() on a miss
+template<typename Cache>
+void bench(const char* name, Cache& cache, const std::vector<int>& positions) {
+    const QByteArray msg(256, 'x');
+    QElapsedTimer timer;
+    quint64 accesses = 0, misses = 0, size = 0;
+
+    timer.start();
+    for (int top : positions) {
+        for (int row = top; row < top + visibleRows; row++) {
+            for (int access = 0; access < cellAccesses; access++) {
+                QByteArray value;
+                if (cache.exists(row)) {
+                    value = cache.get(row);
+                } else {
+                    value = msg;
+                    cache.put(row, value);
+                    misses++;
+                }
+                size += value.size();
+                accesses++;
+            }
+        }
+    }
+    const qint64 nsecs = timer.nsecsElapsed();
+
+    printf("%-28s %8.1f ns/access   %6.2f %% misses   (%llu)\n", name, double(nsecs) / accesses,
+           100.0 * misses / accesses, static_cast<unsigned long long>(size % 10));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int steps = (argc > 1) ? QByteArray(argv[1]).toInt() : 20000;
+    const std::vector<int> positions = scrollPositions(steps);
+
+    printf("%d scroll steps, %d visible rows, %d accesses per row\n", steps, visibleRows, cellAccesses);
+
+    for (size_t capacity : {size_t(1), size_t(64), size_t(256), size_t(1024)}) {
+        char name[64];
+        LegacyLruCache<int, QByteArray> legacy(capacity);
+        snprintf(name, sizeof(name), "list LRU, capacity %zu", capacity);
+        bench(name, legacy, positions);
+
+        QDltLruCache<int, QByteArray> cache(capacity);
+        snprintf(name, sizeof(name), "CLOCK, capacity %zu", capacity);
+        bench(name, cache, positions);
+    }
+
+    return 0;
+}
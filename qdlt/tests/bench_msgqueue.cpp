@@ -0,0 +1,170 @@
+// Micro-benchmark of the message queue against the former sleep-polling ring buffer.
+// Usage: bench_msgqueue [number of messages]
+
+#include <qdltmsgqueue.h>
+
+#include <QElapsedTimer>
+#include <QPair>
+#include <QSharedPointer>
+#include <QThread>
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int queueSize = 1024;
+const int batchSize = 64;
+
+// the single producer, single consumer queue used before, with its adaptive sleeps
+class LegacyQueue {
+public:
+    LegacyQueue() : buffer(queueSize), readPosition(0), writePosition(0), stopRequested(false), writeSleepTime(0), readSleepTime(0) {}
+
+    void enqueue(const QSharedPointer<QDltMsg>& msg, int index) {
+        const int next = (writePosition.load() + 1) % queueSize;
+        while (next == readPosition.load()) {
+            if (writeSleepTime > 0)
+                QThread::usleep(writeSleepTime);
+            writeSleepTime = qMin(writeSleepTime + 10, 10000);
+        }
+        writeSleepTime = qMax(writeSleepTime - 10, 0);
+        buffer[writePosition.load()] = qMakePair(msg, index);
+        writePosition.store(next);
+    }
+
+    bool dequeue(QPair<QSharedPointer<QDltMsg>, int>& data) {
+        while (readPosition.load() == writePosition.load()) {
+            if (stopRequested)
+                return false;
+            if (readSleepTime > 0)
+                QThread::usleep(readSleepTime);
+            readSleepTime = qMin(readSleepTime + 10, 10000);
+        }
+        readSleepTime = qMax(readSleepTime - 10, 0);
+        data = buffer[readPosition.load()];
+        readPosition.store((readPosition.load() + 1) % queueSize);
+        return true;
+    }
+
+    void stop() { stopRequested = true; }
+
+private:
+    std::vector<QPair<QSharedPointer<QDltMsg>, int> > buffer;
+    std::atomic<int> readPosition, writePosition;
+    std::atomic<bool> stopRequested;
+    int writeSleepTime, readSleepTime;
+};
+
+void print(const char* name, int count, qint64 nsecs, const std::vector<qint64>& latencies) {
+    qint64 total = 0, maximum = 0;
+    for (qint64 latency : latencies) {
+        total += latency;
+        maximum = qMax(maximum, latency);
+    }
+    printf("%-28s %8.2f M messages/s   latency avg %8.1f us, max %8.1f us\n", name, count / (nsecs / 1e9) / 1e6,
+           latencies.empty() ? 0.0 : total / 1e3 / latencies.size(), maximum / 1e3);
+}
+
+// throughput with a producer filling all messages, latency with a producer sending every 50 us
+void benchLegacy(int count) {
+    for (bool paced : {false, true}) {
+        LegacyQueue queue;
+        QElapsedTimer timer;
+        const int messages = paced ? 2000 : count;
+        std::vector<qint64> sent(messages), latencies;
+        latencies.reserve(messages);
+        timer.start();
+
+        std::thread consumer([&]() {
+            QPair<QSharedPointer<QDltMsg>, int> data;
+            while (queue.dequeue(data))
+                latencies.push_back(timer.nsecsElapsed() - sent[data.second]);
+        });
+        for (int index = 0; index < messages; index++) {
+            if (paced)
+                QThread::usleep(50);
+            QSharedPointer<QDltMsg> msg = QSharedPointer<QDltMsg>::create();
+            sent[index] = timer.nsecsElapsed();
+            queue.enqueue(msg, index);
+        }
+        queue.stop();
+        consumer.join();
+        print(paced ? "legacy queue, paced" : "legacy queue", messages, timer.nsecsElapsed(), latencies);
+    }
+}
+
+void benchQueue(int count, int producerCount, int consumerCount) {
+    for (bool paced : {false, true}) {
+        QDltMsgQueue queue(queueSize);
+        QElapsedTimer timer;
+        const int messages = paced ? 2000 : count;
+        std::vector<qint64> sent(messages), latencies(messages);
+        timer.start();
+
+        std::vector<std::thread> consumers;
+        for (int num = 0; num < consumerCount; num++) {
+            consumers.emplace_back([&]() {
+                QVector<QDltMsgQueue::Slot*> slots;
+                while (queue.dequeue(slots, batchSize) > 0) {
+                    const qint64 now = timer.nsecsElapsed();
+                    for (QDltMsgQueue::Slot* slot : slots)
+                        latencies[slot->index] = now - sent[slot->index];
+                    queue.release(slots);
+                }
+            });
+        }
+
+        std::vector<std::thread> producers;
+        for (int num = 0; num < producerCount; num++) {
+            producers.emplace_back([&, num]() {
+                QVector<QDltMsgQueue::Slot*> slots;
+                for (int index = num; index < messages;) {
+                    if (paced) {
+                        QThread::usleep(50);
+                        QDltMsgQueue::Slot* slot = queue.acquire();
+                        slot->index = index;
+                        sent[index] = timer.nsecsElapsed();
+                        queue.enqueue(slot);
+                        index += producerCount;
+                        continue;
+                    }
+                    queue.acquire(slots, batchSize);
+                    int filled = 0;
+                    for (; filled < slots.size() && index < messages; filled++, index += producerCount) {
+                        slots[filled]->index = index;
+                        sent[index] = timer.nsecsElapsed();
+                    }
+                    queue.enqueue(slots.mid(0, filled));
+                    queue.release(slots.mid(filled));
+                }
+            });
+        }
+
+        for (std::thread& producer : producers)
+            producer.join();
+        queue.enqueueStopRequest();
+        for (std::thread& consumer : consumers)
+            consumer.join();
+
+        char name[64];
+        snprintf(name, sizeof(name), "queue %dP/%dC%s", producerCount, consumerCount, paced ? ", paced" : "");
+        print(name, messages, timer.nsecsElapsed(), latencies);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int count = (argc > 1) ? QByteArray(argv[1]).toInt() : 2000000;
+
+    printf("%d messages, queue size %d, batch size %d\n", count, queueSize, batchSize);
+
+    benchLegacy(count);
+    benchQueue(count, 1, 1);
+    benchQueue(count, 4, 4);
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+// Memory used by a cached message, like the copies stored by the message cache of QDltFile.
+// The former representation with ids as strings and separate header and payload buffers is rebuilt
+// from the same messages, to compare the bytes per message before and after.
+// Usage: bench_msgsize [number of messages]
+
+#include <qdltmsg.h>
+
+#include "testutils.h"
+
+#include <cstdio>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+
+size_t heapInUse() {
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+    return mallinfo2().uordblks;
+#elif defined(__GLIBC__)
+    return static_cast<size_t>(mallinfo().uordblks);
+#else
+    return 0;
+#endif
+}
+
+// the members of QDltMsg replaced by the compact representation
+struct FormerFields {
+    QString ecuid;
+    QString apid;
+    QString ctid;
+    QString sessionName;
+    QByteArray header;
+    int headerSize;
+    QByteArray payload;
+    int payloadSize;
+};
+
+// the members of QDltMsg replacing them
+struct CompactFields {
+    quint32 ecuid;
+    quint32 apid;
+    quint32 ctid;
+    void* longIds;
+    QByteArray headerAndPayload;
+    int storedHeaderSize;
+    int headerSize;
+    int payloadSize;
+};
+
+QByteArray createMessage(bool verbose) {
+    QDltMsg msg = testutils::createMsg(verbose ? QVariantList{QString("connection established to"), 4711} : QVariantList{});
+    msg.setCtid("CON");
+    if (!verbose)
+        msg.setMode(QDltMsg::DltModeNonVerbose);
+    return testutils::toBytes(msg);
+}
+
+// bytes per message of objects created by create(), including the heap allocations
+template <typename T, typename Create>
+double bytesPerObject(int count, Create create) {
+    std::vector<T*> objects;
+    objects.reserve(count);
+
+    const size_t before = heapInUse();
+    for (int num = 0; num < count; num++)
+        objects.push_back(create());
+    const size_t after = heapInUse();
+
+    for (T* object : objects)
+        delete object;
+
+    return static_cast<double>(after - before) / count;
+}
+
+void bench(const char* name, const QByteArray& buf, int count) {
+    QDltMsg parsed;
+    parsed.setMsg(buf, true);
+
+    const double message = bytesPerObject<QDltMsg>(count, [&buf]() {
+        QDltMsg* msg = new QDltMsg();
+        msg->setMsg(buf, true);
+        return msg;
+    });
+    const double former = bytesPerObject<FormerFields>(count, [&buf, &parsed]() {
+        FormerFields* fields = new FormerFields();
+        fields->ecuid = parsed.getEcuid();
+        fields->apid = parsed.getApid();
+        fields->ctid = parsed.getCtid();
+        fields->headerSize = parsed.getHeaderSize();
+        fields->header = QByteArray(buf.constData(), parsed.getHeaderSize());
+        fields->payloadSize = parsed.getPayloadSize();
+        fields->payload = QByteArray(buf.constData() + parsed.getHeaderSize(), parsed.getPayloadSize());
+        return fields;
+    });
+    const double compact = bytesPerObject<CompactFields>(count, [&buf, &parsed]() {
+        CompactFields* fields = new CompactFields();
+        fields->headerAndPayload = QByteArray(buf.constData(), parsed.getHeaderSize() + parsed.getPayloadSize());
+        return fields;
+    });
+
+    printf("%-12s sizeof(QDltMsg) %4d, bytes per cached message %7.1f, before %7.1f\n", name,
+           static_cast<int>(sizeof(QDltMsg)), message, message - compact + former);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int count = (argc > 1) ? QByteArray(argv[1]).toInt() : 100000;
+
+    if (heapInUse() == 0) {
+        printf("heap statistics are not available on this platform\n");
+        return 0;
+    }
+
+    bench("verbose", createMessage(true), count);
+    bench("non-verbose", createMessage(false), count);
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Micro-benchmark of a large set of plain text payload filters, checked one by one and by the multi pattern matcher.
+// Usage: bench_multipatternmatcher [number of messages] [number of payload filters]
+
+#include <qdltfilterlist.h>
+
+#include "testutils.h"
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <cstdio>
+
+namespace {
+
+QVector<QDltMsg> createMessages(int count) {
+    QVector<QDltMsg> messages;
+    messages.reserve(count);
+    QRandomGenerator random(42);
+
+    for (int num = 0; num < count; num++) {
+        const QString apid = QString("A%1").arg(random.bounded(50));
+        const QString ctid = QString("C%1").arg(random.bounded(20));
+        const int subtype = random.bounded(1, 7);
+        const QString text = QString("connection %1 of service %2 changed state to").arg(random.bounded(1000)).arg(random.bounded(5000));
+
+        QDltMsg msg = testutils::createMsg({text, random.bounded(100000)});
+        msg.setApid(apid);
+        msg.setCtid(ctid);
+        msg.setSubtype(subtype);
+        messages.append(testutils::parsed(msg));
+    }
+
+    return messages;
+}
+
+// positive payload filters like service names, every fourth one is case insensitive
+void createFilters(QDltFilterList& filterList, int count) {
+    for (int num = 0; num < count; num++) {
+        QDltFilter* filter = new QDltFilter();
+        filter->type = QDltFilter::positive;
+        filter->enableFilter = true;
+        filter->enablePayload = true;
+        filter->payload = QString("service %1 changed").arg(num * 17);
+        filter->ignoreCase_Payload = (num % 4) == 0;
+        filterList.addFilter(filter);
+    }
+
+    filterList.updateSortedFilter();
+}
+
+// the filter check as done before the text patterns were compiled, one payload search per filter
+bool checkFilterInterpreted(const QList<QDltFilter*>& pfilters, const QDltMsg& msg) {
+    for (QDltFilter* filter : pfilters) {
+        if (filter->match(msg))
+            return true;
+    }
+    return pfilters.isEmpty();
+}
+
+template <typename Function>
+void measure(const char* name, QVector<QDltMsg>& messages, Function function) {
+    QElapsedTimer timer;
+    timer.start();
+    int matches = 0;
+    for (QDltMsg& msg : messages)
+        matches += function(msg) ? 1 : 0;
+    const double seconds = timer.nsecsElapsed() / 1e9;
+    printf("%-24s %8.3f M messages/s %10d matches\n", name, messages.size() / seconds / 1e6, matches);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int count = (argc > 1) ? QByteArray(argv[1]).toInt() : 100000;
+    const int filters = (argc > 2) ? QByteArray(argv[2]).toInt() : 300;
+
+    QVector<QDltMsg> messages = createMessages(count);
+    QDltFilterList filterList;
+    createFilters(filterList, filters);
+
+    printf("%d messages, %d payload filters\n", count, filters);
+
+    measure("filter by filter", messages, [&](const QDltMsg& msg) { return checkFilterInterpreted(filterList.filters, msg); });
+    measure("multi pattern matcher", messages, [&](QDltMsg& msg) { return filterList.checkFilter(msg); });
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Micro-benchmark of rendering the payload text of verbose, non-verbose and control messages,
+// into a new string per message and into one reused string.
+// Usage: bench_payloadtext [number of iterations]
+
+#include <qdltmsg.h>
+
+#include <QElapsedTimer>
+
+#include <cstdio>
+
+namespace {
+
+QDltMsg createVerbose() {
+    QDltMsg msg;
+    msg.setType(QDltMsg::DltTypeLog);
+    msg.setSubtype(QDltMsg::DltLogInfo);
+    msg.setMode(QDltMsg::DltModeVerbose);
+
+    const QVariant values[] = {QVariant(QString("temperature of sensor")), QVariant(3), QVariant(QString("is")),
+                               QVariant(21.5), QVariant(QString("max")), QVariant(4000000000u)};
+    for (const QVariant& value : values) {
+        QDltArgument argument;
+        argument.setValue(value);
+        msg.addArgument(argument);
+    }
+    msg.setNumberOfArguments(6);
+
+    return msg;
+}
+
+QDltMsg createNonVerbose() {
+    QDltMsg msg;
+    msg.setType(QDltMsg::DltTypeLog);
+    msg.setMode(QDltMsg::DltModeNonVerbose);
+    QByteArray payload("\x10\x27\x00\x00", 4);
+    for (int num = 0; num < 48; num++)
+        payload.append(static_cast<char>(num * 7));
+    msg.setPayload(payload);
+
+    return msg;
+}
+
+QDltMsg createControl() {
+    QDltMsg msg;
+    msg.setType(QDltMsg::DltTypeControl);
+    msg.setSubtype(QDltMsg::DltControlRequest);
+    msg.setMode(QDltMsg::DltModeNonVerbose);
+    QByteArray payload("\x01\x00\x00\x00", 4);
+    payload.append("APP1CON1\x04\x00", 10);
+    msg.setPayload(payload);
+
+    return msg;
+}
+
+void bench(const char* name, const QDltMsg& msg, int count) {
+    QElapsedTimer timer;
+    qint64 length = 0;
+
+    timer.start();
+    for (int num = 0; num < count; num++)
+        length += msg.toStringPayload().size();
+    const qint64 copies = timer.nsecsElapsed();
+
+    QString text;
+    timer.start();
+    for (int num = 0; num < count; num++) {
+        text.truncate(0);
+        msg.appendToStringPayload(text);
+        length += text.size();
+    }
+    const qint64 reused = timer.nsecsElapsed();
+
+    printf("%-12s toStringPayload() %7.1f ns/msg, appendToStringPayload() %7.1f ns/msg (%lld)\n", name,
+           static_cast<double>(copies) / count, static_cast<double>(reused) / count, static_cast<long long>(length));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int count = (argc > 1) ? QByteArray(argv[1]).toInt() : 1000000;
+
+    bench("verbose", createVerbose(), count);
+    bench("non-verbose", createNonVerbose(), count);
+    bench("control", createControl(), count);
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Micro-benchmark of payload filters with regular expressions, with and without the literal prefilter.
+// Usage: bench_regexprefilter [number of messages]
+
+#include <qdltfilter.h>
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <cstdio>
+
+namespace {
+
+QStringList createPayloads(int count) {
+    QStringList payloads;
+    QRandomGenerator random(42);
+
+    for (int num = 0; num < count; num++) {
+        // one message in hundred contains the literals of the expressions
+        if (random.bounded(100) == 0)
+            payloads.append(QString("watchdog timeout of task %1 after %2 ms").arg(random.bounded(50)).arg(random.bounded(1000)));
+        else
+            payloads.append(QString("connection %1 of service %2 changed state to %3").arg(random.bounded(1000)).arg(random.bounded(5000)).arg(random.bounded(8)));
+    }
+
+    return payloads;
+}
+
+void measure(const char* name, const QStringList& payloads, const QDltFilter& filter) {
+    QElapsedTimer timer;
+    timer.start();
+    int matches = 0;
+    for (const QString& payload : payloads)
+        matches += filter.matchPayload(payload) ? 1 : 0;
+    const double seconds = timer.nsecsElapsed() / 1e9;
+    printf("%-24s %8.2f M messages/s %10d matches %10llu rejected\n", name, payloads.size() / seconds / 1e6, matches,
+           static_cast<unsigned long long>(filter.payloadRegexPrefilter.getRejectedCount()));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int count = (argc > 1) ? QByteArray(argv[1]).toInt() : 1000000;
+    const QStringList payloads = createPayloads(count);
+
+    for (const char* pattern : {"watchdog timeout of task \\d+ after [0-9]{3} ms", "Timeout.*\\d+ ms"}) {
+        QDltFilter filter;
+        filter.enablePayload = true;
+        filter.enableRegexp_Payload = true;
+        filter.ignoreCase_Payload = true;
+        filter.payload = pattern;
+        filter.compileRegexps();
+        printf("%s: %s\n", pattern, qPrintable(filter.payloadRegexPrefilter.getLiterals().join(", ")));
+
+        measure("with prefilter", payloads, filter);
+        filter.payloadRegexPrefilter.clear();
+        measure("regular expression only", payloads, filter);
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+// Micro-benchmark of the storage header scanner against the former byte-at-a-time indexing loop.
+// Usage: bench_storageheaderscanner [dlt file | size in MB of a synthetic file]
+
+#include <qdltmsg.h>
+#include <qdltstorageheaderscanner.h>
+
+#include "testutils.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRandomGenerator>
+
+#include <cstdio>
+
+namespace {
+
+constexpr qint64 blockSize = 1024 * 1024;
+
+QByteArray createSyntheticFile(qint64 size) {
+    QByteArray file;
+    file.reserve(size + 2048);
+    QRandomGenerator random(42);
+
+    while (file.size() < size) {
+        // binary payload with random length, like raw data arguments
+        QByteArray raw(random.bounded(20, 600), Qt::Uninitialized);
+        for (int num = 0; num < raw.size(); num++)
+            raw[num] = static_cast<char>(random.bounded(256));
+
+        QDltMsg msg = testutils::createMsg({raw});
+        file += testutils::toBytes(msg);
+    }
+
+    return file;
+}
+
+// the indexing loop as used before by QDltFile::updateIndex() and DltFileIndexer::index(), without error handling
+QVector<qint64> legacyIndex(const QByteArray& file) {
+    QVector<qint64> index;
+    char lastFound = 0;
+    qint64 current_message_pos = 0, next_message_pos = 0;
+    qint64 counter_header = 0, message_length = 0;
+    qint64 lengthOffset = 2, storageLength = 0;
+    const qint64 file_size = file.size();
+
+    for (qint64 pos = 0; pos < file_size; pos += blockSize) {
+        const char* data = file.constData() + pos;
+        const qint64 length = qMin(blockSize, file_size - pos);
+
+        for (qint64 number = 0; number < length; number++) {
+            if (counter_header > 0) {
+                counter_header++;
+                if (storageLength == 13 && counter_header == 13) {
+                    storageLength += ((unsigned char)data[number]) + 1;
+                } else if (counter_header == storageLength) {
+                    lengthOffset = ((((unsigned char)data[number]) & 0xe0) >> 5) == 2 ? 5 : 2;
+                } else if (counter_header == storageLength + lengthOffset) {
+                    message_length = (unsigned char)data[number];
+                } else if (counter_header == storageLength + 1 + lengthOffset) {
+                    counter_header = 0;
+                    message_length = (message_length << 8 | ((unsigned char)data[number])) + storageLength;
+                    next_message_pos = current_message_pos + message_length;
+                    if (next_message_pos == file_size) {
+                        index.append(current_message_pos);
+                        break;
+                    }
+                    if (message_length > storageLength + 2 + lengthOffset &&
+                        number + message_length - (storageLength + 2 + lengthOffset) < length)
+                        number += message_length - (storageLength + 2 + lengthOffset);
+                }
+            } else if (data[number] == 'D') {
+                lastFound = 'D';
+            } else if (lastFound == 'D' && data[number] == 'L') {
+                lastFound = 'L';
+            } else if (lastFound == 'L' && data[number] == 'T') {
+                lastFound = 'T';
+            } else if (lastFound == 'T' && (data[number] == 0x01 || data[number] == 0x02)) {
+                if (next_message_pos == 0 || next_message_pos == pos + number - 3) {
+                    if (next_message_pos != 0)
+                        index.append(current_message_pos);
+                    current_message_pos = pos + number - 3;
+                    counter_header = 3;
+                    storageLength = (data[number] == 0x01) ? 16 : 13;
+                }
+                lastFound = 0;
+            } else {
+                lastFound = 0;
+            }
+        }
+    }
+
+    return index;
+}
+
+QVector<qint64> scannerIndex(const QByteArray& file) {
+    QVector<qint64> index;
+    QDltStorageHeaderScanner scanner(file.size());
+    qint64 pos = 0;
+
+    while (!scanner.isFinished() && pos < file.size())
+        pos = scanner.scanBlock(file.constData() + pos, qMin(blockSize, file.size() - pos), pos, index);
+
+    return index;
+}
+
+template <typename Function>
+void measure(const char* name, const QByteArray& file, Function function) {
+    QElapsedTimer timer;
+    timer.start();
+    const QVector<qint64> index = function(file);
+    const double seconds = timer.nsecsElapsed() / 1e9;
+    printf("%-24s %8.2f GB/s %12lld messages\n", name, file.size() / seconds / 1e9,
+           static_cast<long long>(index.size()));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QByteArray file;
+
+    if (argc > 1 && QFile::exists(argv[1])) {
+        QFile f(argv[1]);
+        if (!f.open(QIODevice::ReadOnly))
+            return 1;
+        file = f.readAll();
+    } else {
+        const qint64 sizeMB = (argc > 1) ? QByteArray(argv[1]).toLongLong() : 512;
+        file = createSyntheticFile(sizeMB * 1024 * 1024);
+    }
+
+    printf("%lld bytes\n", static_cast<long long>(file.size()));
+
+    measure("legacy byte loop", file, legacyIndex);
+
+    const char* names[] = {"scanner scalar", "scanner sse2", "scanner avx2"};
+    for (auto mode : {QDltStorageHeaderScanner::ScanModeScalar, QDltStorageHeaderScanner::ScanModeSse2,
+                      QDltStorageHeaderScanner::ScanModeAvx2}) {
+        if (QDltStorageHeaderScanner::setScanMode(mode))
+            measure(names[mode], file, scannerIndex);
+    }
+
+    return 0;
+}
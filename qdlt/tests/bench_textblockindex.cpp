@@ -0,0 +1,53 @@
+// Micro-benchmark of the text block index: time to create it and fraction of blocks a search has to read.
+// Usage: bench_textblockindex [number of messages]
+
+#include <qdlttextblockindex.h>
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <cstdio>
+
+namespace {
+
+QStringList createPayloads(int count) {
+    QStringList payloads;
+    QRandomGenerator random(42);
+
+    for (int num = 0; num < count; num++) {
+        // one message in hundred thousand contains the searched text
+        if (random.bounded(100000) == 0)
+            payloads.append(QString("watchdog timeout of task %1 after %2 ms").arg(random.bounded(50)).arg(random.bounded(1000)));
+        else
+            payloads.append(QString("connection %1 of service %2 changed state to %3").arg(random.bounded(1000)).arg(random.bounded(5000)).arg(random.bounded(8)));
+    }
+
+    return payloads;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int count = (argc > 1) ? QByteArray(argv[1]).toInt() : 1000000;
+    const QStringList payloads = createPayloads(count);
+    const QString header("2024/01/01 12:00:00.000000 1234.5678 42 ECU1 APP1 CON1 0 log info verbose 1");
+
+    QElapsedTimer timer;
+    timer.start();
+    QDltTextBlockIndex textBlocks;
+    for (const QString& payload : payloads)
+        textBlocks.append(header, payload);
+    printf("create %8.2f M messages/s, %d blocks\n", count / (timer.nsecsElapsed() / 1e9) / 1e6, textBlocks.blockCount());
+
+    for (const char* literal : {"watchdog timeout", "connection", "state to 3", "not contained"}) {
+        const QDltTextBlockIndex::Query query = QDltTextBlockIndex::query({literal});
+        timer.restart();
+        int blocks = 0;
+        for (int num = 0; num < count; num += QDLT_TEXT_BLOCK_SIZE)
+            blocks += textBlocks.mayContain(num, query) ? 1 : 0;
+        printf("%-20s %6.2f %% of blocks read, %8.3f ms\n", literal, 100.0 * blocks / textBlocks.blockCount(),
+               timer.nsecsElapsed() / 1e6);
+    }
+
+    return 0;
+}
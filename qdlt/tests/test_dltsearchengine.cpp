@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "testutils.h"
+
+#include "dltsearchengine.h"
+#include <qdltfile.h>
+
+#include <QTemporaryFile>
+
+using testutils::createMessage;
+
+namespace {
+
+// every 97th message contains the searched text
+bool containsNeedle(int num) {
+    return num % 97 == 5;
+}
+
+class DltSearchEngineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempFile.open());
+        for (int num = 0; num < 10000; num++)
+            m_tempFile.write(createMessage(containsNeedle(num) ? QString("needle %1").arg(num) : QString("message %1").arg(num)));
+        m_tempFile.flush();
+        ASSERT_TRUE(m_file.open(m_tempFile.fileName()));
+        ASSERT_TRUE(m_file.createIndex());
+        m_matcher.setHeaderSearchEnabled(false);
+    }
+
+    QTemporaryFile m_tempFile;
+    QDltFile m_file;
+    DltMessageMatcher m_matcher;
+};
+
+} // namespace
+
+TEST_F(DltSearchEngineTest, findAllInOrder) {
+    QVector<int> expected;
+    for (int num = 100; num < 9000; num++) {
+        if (containsNeedle(num))
+            expected.append(num);
+    }
+
+    for (int threadCount : {1, 4}) {
+        DltSearchEngine engine(m_file, m_matcher, QString("NEEDLE"));
+        engine.setThreadCount(threadCount);
+        engine.setChunkSize(100);
+
+        QVector<int> found;
+        int lastProgress = 0;
+        EXPECT_TRUE(engine.findAll(100, 9000, [&](const QVector<int>& rows) { found += rows; },
+                                   [&](int checkedRows) { lastProgress = checkedRows; }));
+        EXPECT_EQ(found, expected);
+        EXPECT_EQ(lastProgress, 8900);
+    }
+}
+
+TEST_F(DltSearchEngineTest, findNearest) {
+    DltSearchEngine engine(m_file, m_matcher, QString("needle"));
+    engine.setThreadCount(4);
+    engine.setChunkSize(10);
+
+    EXPECT_EQ(engine.findNearest(-1, true), 5);
+    EXPECT_EQ(engine.findNearest(5, true), 102);
+    EXPECT_EQ(engine.findNearest(102, false), 5);
+    EXPECT_EQ(engine.findNearest(0, false), 9899);
+    EXPECT_EQ(engine.findNearest(-1, false), 9899);
+
+    // the search wraps around at the end
+    EXPECT_EQ(engine.findNearest(9899, true), 5);
+
+    DltSearchEngine notFound(m_file, m_matcher, QString("not contained"));
+    EXPECT_EQ(notFound.findNearest(-1, true), -1);
+}
+
+TEST_F(DltSearchEngineTest, candidateFunction) {
+    DltSearchEngine engine(m_file, m_matcher, QString("needle"));
+    engine.setCandidateFunction([](int msgIndex) { return msgIndex >= 5000; });
+
+    QVector<int> found;
+    EXPECT_TRUE(engine.findAll(0, m_file.sizeFilter(), [&](const QVector<int>& rows) { found += rows; }));
+    ASSERT_FALSE(found.isEmpty());
+    EXPECT_EQ(found.first(), 5049);
+    EXPECT_EQ(engine.getSkippedCount(), 5000u);
+}
+
+TEST_F(DltSearchEngineTest, cancel) {
+    DltSearchEngine engine(m_file, m_matcher, QString("needle"));
+    engine.setThreadCount(2);
+    engine.setChunkSize(10);
+    engine.setCandidateFunction([&](int) {
+        // cancelled from a worker thread while the search is running
+        engine.cancel();
+        return true;
+    });
+
+    QVector<int> found;
+    EXPECT_FALSE(engine.findAll(0, m_file.sizeFilter(), [&](const QVector<int>& rows) { found += rows; }));
+    EXPECT_TRUE(engine.isCancelled());
+    EXPECT_TRUE(found.isEmpty());
+
+    // the next search starts again
+    engine.setCandidateFunction({});
+    EXPECT_EQ(engine.findNearest(-1, true), 5);
+}
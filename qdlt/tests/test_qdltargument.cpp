@@ -62,3 +62,33 @@ TEST(QDltArgument, setValueString) {
     ASSERT_EQ(arg.toString(), QString::fromUtf8("übe"));
     ASSERT_EQ(arg.getValue(), QVariant(QString::fromUtf8("übe")));
 }
+
+TEST(QDltArgument, appendToString) {
+    const QVariant values[] = {QVariant(-5), QVariant(4000000000u), QVariant(-1234567890123LL), QVariant(18446744073709551615ULL),
+                               QVariant(1.5), QVariant(-0.000000126), QVariant(1e20), QVariant(QString("text")),
+                               QVariant(QByteArray("\x01\xab", 2))};
+    const QString expected[] = {"-5", "4000000000", "-1234567890123", "18446744073709551615",
+                                "1.50000000", "-0.00000013", QString("%1").arg(1e20, 0, 'f', 8), "text",
+                                "01 ab"};
+
+    // the text is appended to the content of the string
+    QString text("prefix");
+    for (int num = 0; num < 9; num++) {
+        QDltArgument arg;
+        ASSERT_TRUE(arg.setValue(values[num]));
+        EXPECT_EQ(arg.toString(), expected[num]);
+
+        text.truncate(6);
+        arg.appendToString(text);
+        EXPECT_EQ(text, "prefix" + expected[num]);
+    }
+
+    // big endian values
+    QDltArgument arg;
+    arg.setTypeInfo(QDltArgument::DltTypeInfoSInt);
+    arg.setEndianness(QDlt::DltEndiannessBigEndian);
+    arg.setData(QByteArray("\xff\xfe", 2));
+    EXPECT_EQ(arg.toString(), QString("-2"));
+    arg.setTypeInfo(QDltArgument::DltTypeInfoUInt);
+    EXPECT_EQ(arg.toString(), QString("65534"));
+}
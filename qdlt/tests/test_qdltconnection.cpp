@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "testutils.h"
+
+#include <qdltconnection.h>
+
+#include <cstring>
+
+namespace {
+
+// a message as sent by the DLT daemon, without storage header
+QByteArray createMessage(int num) {
+    QDltMsg msg = testutils::createMsg({QString("message %1").arg(num)});
+    msg.setMessageCounter(static_cast<unsigned char>(num));
+    return testutils::toBytes(msg, false);
+}
+
+const QByteArray serialHeader("DLS\x01", 4);
+
+QStringList parseAll(QDltConnection &connection) {
+    QStringList texts;
+    QDltMsg msg;
+    while (connection.parseDlt(msg))
+        texts.append(msg.toStringPayload());
+    return texts;
+}
+
+} // namespace
+
+TEST(QDltConnection, parseMessagesReceivedInPieces) {
+    QByteArray stream;
+    for (int num = 0; num < 100; num++)
+        stream += createMessage(num);
+
+    // every piece size splits the messages at other positions
+    for (int piece = 1; piece < 50; piece += 7) {
+        QDltConnection connection;
+        QStringList texts;
+        for (int pos = 0; pos < stream.size(); pos += piece) {
+            const QByteArray data = stream.mid(pos, piece);
+            memcpy(connection.reserve(data.size()), data.constData(), data.size());
+            connection.commit(data.size());
+            texts += parseAll(connection);
+        }
+
+        ASSERT_EQ(texts.size(), 100) << "piece size " << piece;
+        EXPECT_EQ(texts.first(), "message 0");
+        EXPECT_EQ(texts.last(), "message 99");
+        EXPECT_EQ(connection.available(), 0);
+        EXPECT_EQ(connection.bytesError, 0u);
+        EXPECT_EQ(connection.bytesReceived, static_cast<unsigned long>(stream.size()));
+    }
+}
+
+TEST(QDltConnection, messagesWithSerialHeader) {
+    QDltConnection connection;
+    connection.add(serialHeader + createMessage(1) + serialHeader + createMessage(2));
+
+    EXPECT_EQ(parseAll(connection), QStringList({"message 1", "message 2"}));
+    EXPECT_EQ(connection.syncFound, 2u);
+}
+
+TEST(QDltConnection, syncToSerialHeader) {
+    QDltConnection connection;
+    connection.setSyncSerialHeader(true);
+
+    // garbage before the first message and a message interrupted by the next serial header
+    const QByteArray interrupted = createMessage(2).left(10);
+    connection.add(QByteArray("garbage") + serialHeader + createMessage(1) + serialHeader + interrupted + serialHeader + createMessage(3));
+    EXPECT_EQ(parseAll(connection), QStringList({"message 1", "message 3"}));
+    EXPECT_EQ(connection.bytesError, static_cast<unsigned long>(7 + 4 + interrupted.size()));
+
+    // the start of a serial header at the end is kept
+    connection.add(QByteArray("noise") + serialHeader.left(2));
+    EXPECT_TRUE(parseAll(connection).isEmpty());
+    EXPECT_EQ(connection.available(), 2);
+    connection.add(serialHeader.mid(2) + createMessage(4));
+    EXPECT_EQ(parseAll(connection), QStringList({"message 4"}));
+}
+
+TEST(QDltConnection, incompleteMessageIsKept) {
+    const QByteArray message = createMessage(1);
+
+    QDltConnection connection;
+    connection.add(message.left(message.size() - 1));
+    QDltMsg msg;
+    EXPECT_FALSE(connection.parseDlt(msg));
+    EXPECT_EQ(connection.available(), message.size() - 1);
+
+    connection.add(message.right(1));
+    EXPECT_TRUE(connection.parseDlt(msg));
+    EXPECT_EQ(msg.toStringPayload(), "message 1");
+}
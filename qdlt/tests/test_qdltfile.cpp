@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+
+#include "testutils.h"
+
+#include <qdltfile.h>
+
+#include <QTemporaryFile>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using testutils::createMessage;
+
+TEST(QDltFile, readMessagesWithAndWithoutMemoryMapping) {
+    QVector<QByteArray> messages;
+    QTemporaryFile tempFile;
+    ASSERT_TRUE(tempFile.open());
+    for (int num = 0; num < 100; num++) {
+        messages.append(createMessage(QString("message %1").arg(num)));
+        tempFile.write(messages.last());
+    }
+    tempFile.flush();
+
+    for (bool memoryMapping : {true, false}) {
+        QDltFile file;
+        file.setMemoryMappingEnabled(memoryMapping);
+        ASSERT_TRUE(file.open(tempFile.fileName()));
+        ASSERT_TRUE(file.createIndex());
+        ASSERT_EQ(file.size(), messages.size());
+
+        for (int num = 0; num < messages.size(); num++) {
+            EXPECT_EQ(file.getMsg(num), messages[num]);
+
+            QDltMsg msg;
+            ASSERT_TRUE(file.getMsg(num, msg));
+            EXPECT_EQ(msg.toStringPayload(), QString("message %1").arg(num));
+        }
+    }
+}
+
+TEST(QDltFile, readMessagesAppendedAfterMapping) {
+    QTemporaryFile tempFile;
+    ASSERT_TRUE(tempFile.open());
+    QVector<QByteArray> messages;
+    for (int num = 0; num < 10; num++) {
+        messages.append(createMessage(QString("message %1").arg(num)));
+        tempFile.write(messages.last());
+    }
+    tempFile.flush();
+
+    QDltFile file;
+    ASSERT_TRUE(file.open(tempFile.fileName()));
+    ASSERT_TRUE(file.createIndex());
+    ASSERT_EQ(file.size(), 10);
+
+    // live logging appends to the file after it was mapped
+    for (int num = 10; num < 20000; num++) {
+        messages.append(createMessage(QString("message %1").arg(num)));
+        tempFile.write(messages.last());
+    }
+    tempFile.flush();
+    ASSERT_TRUE(file.updateIndex());
+    ASSERT_EQ(file.size(), messages.size());
+
+    for (int num = 0; num < messages.size(); num++)
+        EXPECT_EQ(file.getMsg(num), messages[num]);
+}
+
+TEST(QDltFile, concurrentReaders) {
+    QVector<QByteArray> messages;
+    QTemporaryFile tempFile;
+    ASSERT_TRUE(tempFile.open());
+    for (int num = 0; num < 5000; num++) {
+        messages.append(createMessage(QString("message %1").arg(num)));
+        tempFile.write(messages.last());
+    }
+    tempFile.flush();
+
+    for (bool memoryMapping : {true, false}) {
+        QDltFile file;
+        file.setMemoryMappingEnabled(memoryMapping);
+        // small cache, so the threads insert and evict messages all the time
+        file.setCacheSize(64);
+        ASSERT_TRUE(file.open(tempFile.fileName()));
+        ASSERT_TRUE(file.createIndex());
+        ASSERT_EQ(file.size(), messages.size());
+
+        std::atomic<int> errors(0);
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < 16; thread++) {
+            threads.emplace_back([&, thread]() {
+                for (int count = 0; count < messages.size(); count++) {
+                    // every thread reads in a different order
+                    const int num = (count * 7 + thread * 313) % messages.size();
+                    QDltMsg msg;
+                    if (file.getMsg(num) != messages[num])
+                        errors++;
+                    else if (!file.getMsg(num, msg) || msg.toStringPayload() != QString("message %1").arg(num))
+                        errors++;
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+
+        EXPECT_EQ(errors.load(), 0) << "memory mapping " << memoryMapping;
+    }
+}
+
+TEST(QDltFile, appendIndexOfWrittenMessages) {
+    QTemporaryFile tempFile;
+    ASSERT_TRUE(tempFile.open());
+    QVector<QByteArray> messages;
+    for (int num = 0; num < 10; num++) {
+        messages.append(createMessage(QString("message %1").arg(num)));
+        tempFile.write(messages.last());
+    }
+    tempFile.flush();
+
+    QDltFile file;
+    ASSERT_TRUE(file.open(tempFile.fileName()));
+    ASSERT_TRUE(file.createIndex());
+    EXPECT_EQ(file.getLastIndexPos(), tempFile.size() - messages.last().size());
+
+    // the position of messages written by live logging is known, the file is not read again
+    for (int num = 10; num < 20; num++) {
+        messages.append(createMessage(QString("message %1").arg(num)));
+        const qint64 pos = tempFile.size();
+        tempFile.write(messages.last());
+        tempFile.flush();
+
+        QDltMsg msg;
+        ASSERT_TRUE(msg.setMsg(messages.last(), true));
+        EXPECT_TRUE(file.appendIndex(pos, &msg));
+        EXPECT_EQ(file.getLastIndexPos(), pos);
+    }
+    ASSERT_EQ(file.size(), messages.size());
+    for (int num = 0; num < messages.size(); num++)
+        EXPECT_EQ(file.getMsg(num), messages[num]);
+
+    // only positions behind the last message can be appended
+    EXPECT_FALSE(file.appendIndex(file.getLastIndexPos(), nullptr));
+    EXPECT_EQ(file.size(), messages.size());
+
+    // messages appended otherwise are still found by reading the file
+    messages.append(createMessage("message 20"));
+    tempFile.write(messages.last());
+    tempFile.flush();
+    ASSERT_TRUE(file.updateIndex());
+    ASSERT_EQ(file.size(), messages.size());
+    EXPECT_EQ(file.getMsg(20), messages[20]);
+}
+
+TEST(QDltFile, appendIndexKeepsMetadataIndexComplete) {
+    QTemporaryFile tempFile;
+    ASSERT_TRUE(tempFile.open());
+
+    QDltFile file;
+    ASSERT_TRUE(file.open(tempFile.fileName()));
+    ASSERT_TRUE(file.createIndex());
+    ASSERT_EQ(file.size(), 0);
+
+    qint64 pos = 0;
+    for (int num = 0; num < 5; num++) {
+        const QByteArray data = createMessage(QString("message %1").arg(num));
+        tempFile.write(data);
+        QDltMsg msg;
+        ASSERT_TRUE(msg.setMsg(data, true));
+        ASSERT_TRUE(file.appendIndex(pos, num == 3 ? nullptr : &msg));
+        pos += data.size();
+    }
+    tempFile.flush();
+
+    EXPECT_TRUE(file.hasMetadataIndex());
+    const QDltMetadataIndex &metadata = file.getMetadataIndex();
+    ASSERT_EQ(metadata.size(), 5);
+    EXPECT_EQ(metadata.getApid(0), "APP");
+    EXPECT_TRUE(metadata.isMsgValid(2));
+    EXPECT_FALSE(metadata.isMsgValid(3));
+}
+
+TEST(QDltFile, readMessagesOfTruncatedFile) {
+    QTemporaryFile tempFile;
+    ASSERT_TRUE(tempFile.open());
+    QVector<QByteArray> messages;
+    for (int num = 0; num < 20000; num++) {
+        messages.append(createMessage(QString("message %1").arg(num)));
+        tempFile.write(messages.last());
+    }
+    tempFile.flush();
+
+    QDltFile file;
+    file.setMemoryMappingEnabled(true);
+    ASSERT_TRUE(file.open(tempFile.fileName()));
+    ASSERT_TRUE(file.createIndex());
+    ASSERT_EQ(file.size(), messages.size());
+    EXPECT_EQ(file.getMsg(100), messages[100]);
+
+    // the truncated file is indexed again, the mapping is not read behind the end of the file
+    ASSERT_TRUE(tempFile.resize(messages[0].size()));
+    ASSERT_TRUE(file.updateIndex());
+    ASSERT_EQ(file.size(), 1);
+    EXPECT_EQ(file.getMsg(0), messages[0]);
+    EXPECT_TRUE(file.getMsg(10000).isEmpty());
+}
+
+TEST(QDltFile, readMessagesWhileIndexIsUpdated) {
+    QTemporaryFile tempFile;
+    ASSERT_TRUE(tempFile.open());
+    QVector<QByteArray> messages;
+    for (int num = 0; num < 20000; num++)
+        messages.append(createMessage(QString("message %1").arg(num)));
+    tempFile.write(messages[0]);
+    tempFile.flush();
+
+    QDltFile file;
+    file.setCacheSize(0);
+    ASSERT_TRUE(file.open(tempFile.fileName()));
+    ASSERT_TRUE(file.createIndex());
+
+    // readers use the snapshot of the index, while live logging replaces it
+    std::atomic<bool> done(false);
+    std::atomic<int> errors(0);
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; thread++) {
+        threads.emplace_back([&]() {
+            while (!done) {
+                const int size = file.size();
+                for (int num = qMax(0, size - 100); num < size; num++) {
+                    if (file.getMsg(num) != messages[num])
+                        errors++;
+                }
+            }
+        });
+    }
+
+    qint64 pos = messages[0].size();
+    for (int num = 1; num < messages.size(); num++) {
+        tempFile.write(messages[num]);
+        tempFile.flush();
+        if (!(num % 1000 ? file.appendIndex(pos, nullptr) : file.updateIndex()))
+            errors++;
+        pos += messages[num].size();
+    }
+    EXPECT_TRUE(file.updateIndex());
+    done = true;
+    for (std::thread& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(errors.load(), 0);
+    ASSERT_EQ(file.size(), messages.size());
+    for (int num = 0; num < messages.size(); num++)
+        EXPECT_EQ(file.getMsg(num), messages[num]);
+}
@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+
+#include <qdltfilewriter.h>
+
+#include <QBuffer>
+#include <QTemporaryDir>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+DltStorageHeader storageHeader(quint32 seconds, qint32 microseconds) {
+    DltStorageHeader header;
+    memcpy(header.pattern, "DLT\x01", 4);
+    header.seconds = seconds;
+    header.microseconds = microseconds;
+    memcpy(header.ecu, "ECU1", 4);
+    return header;
+}
+
+QByteArray readFile(const QString &fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+} // namespace
+
+TEST(QDltFileWriter, writeMessages) {
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath("test.dlt");
+
+    QDltFileWriter writer;
+    ASSERT_TRUE(writer.open(fileName));
+    EXPECT_TRUE(writer.isOpen());
+    EXPECT_EQ(writer.getFileName(), fileName);
+
+    const DltStorageHeader str = storageHeader(1700000000, 123456);
+    const QByteArray header("HEADER");
+    writer.writeMessage(str, header, "payload");
+    EXPECT_EQ(writer.size(), qint64(sizeof(DltStorageHeader) + 6 + 7));
+
+    ASSERT_TRUE(writer.flush());
+    writer.close();
+    EXPECT_FALSE(writer.isOpen());
+
+    QByteArray expected(reinterpret_cast<const char*>(&str), sizeof(DltStorageHeader));
+    expected += header;
+    expected += "payload";
+    EXPECT_EQ(readFile(fileName), expected);
+}
+
+TEST(QDltFileWriter, storageHeaderV2) {
+    QBuffer device;
+    device.open(QIODevice::WriteOnly);
+
+    QDltFileWriter writer;
+    writer.setDevice(&device);
+    writer.writeMessageV2(storageHeader(0x01020304, 5), "ECU12", "H", "P");
+    writer.close();
+
+    const QByteArray data = device.data();
+    ASSERT_EQ(data.size(), 3 + 1 + 4 + 5 + 1 + 5 + 1 + 1);
+    EXPECT_EQ(data.left(4), QByteArray("DLT\x02", 4));
+
+    quint32 nanoseconds = 0;
+    memcpy(&nanoseconds, data.constData() + 4, 4);
+    EXPECT_EQ(nanoseconds, 5000u);
+
+    quint64 seconds = 0;
+    memcpy(&seconds, data.constData() + 8, 5);
+    EXPECT_EQ(seconds, 0x01020304u);
+
+    EXPECT_EQ(data.at(13), 5);
+    EXPECT_EQ(data.mid(14), QByteArray("ECU12HP"));
+}
+
+TEST(QDltFileWriter, appendsToExistingFile) {
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath("test.dlt");
+    {
+        QFile file(fileName);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write("existing");
+    }
+
+    QDltFileWriter writer;
+    ASSERT_TRUE(writer.open(fileName));
+    writer.write("new", 3);
+    EXPECT_EQ(writer.size(), 11);
+    writer.close();
+
+    EXPECT_EQ(readFile(fileName), QByteArray("existingnew"));
+}
+
+TEST(QDltFileWriter, messagesAreWrittenInBatches) {
+    QBuffer device;
+    device.open(QIODevice::WriteOnly);
+
+    QDltFileWriter writer;
+    writer.setFlushPolicy(0, 1000, 0);
+    writer.setDevice(&device);
+
+    const DltStorageHeader str = storageHeader(1, 2);
+    for (int num = 0; num < 10000; num++)
+        writer.writeMessage(str, QByteArray(), "0123456789");
+    writer.flush();
+
+    EXPECT_LE(writer.getWriteCount(), 10u);
+    EXPECT_GE(writer.getWriteCount(), 1u);
+    EXPECT_EQ(writer.size(), qint64(10000 * (sizeof(DltStorageHeader) + 10)));
+    writer.close();
+
+    EXPECT_EQ(device.data().size(), 10000 * int(sizeof(DltStorageHeader) + 10));
+}
+
+TEST(QDltFileWriter, headerAndPayloadAreOneMessage) {
+    QBuffer device;
+    device.open(QIODevice::WriteOnly);
+
+    QDltFileWriter writer;
+    writer.setFlushPolicy(0, 2, 0);
+    writer.setDevice(&device);
+
+    // the message policy is not reached by the header and payload of one message
+    writer.write("header", 6, "payload", 7);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(writer.getWriteCount(), 0u);
+
+    writer.write("header", 6, "payload", 7);
+    for (int num = 0; num < 500 && writer.getWriteCount() == 0; num++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(writer.getWriteCount(), 1u);
+    EXPECT_EQ(writer.size(), 26);
+
+    writer.close();
+    EXPECT_EQ(device.data(), QByteArray("headerpayloadheaderpayload"));
+}
+
+TEST(QDltFileWriter, flushAfterTime) {
+    QBuffer device;
+    device.open(QIODevice::WriteOnly);
+
+    std::atomic<int> callbacks(0);
+    QDltFileWriter writer;
+    writer.setFlushPolicy(0, 0, 10);
+    writer.setWrittenCallback([&callbacks]() { callbacks++; });
+    writer.setDevice(&device);
+
+    writer.write("data", 4);
+
+    // written by the background thread without flush()
+    for (int num = 0; num < 500 && callbacks == 0; num++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(callbacks, 1);
+    EXPECT_EQ(writer.getWriteCount(), 1u);
+
+    writer.close();
+    EXPECT_EQ(device.data(), QByteArray("data"));
+}
+
+TEST(QDltFileWriter, noFlushWithoutPolicy) {
+    QBuffer device;
+    device.open(QIODevice::WriteOnly);
+
+    QDltFileWriter writer;
+    writer.setFlushPolicy(1024 * 1024, 0, 0);
+    writer.setDevice(&device);
+
+    writer.write("data", 4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(writer.getWriteCount(), 0u);
+
+    // the buffered data is written when the writer is closed
+    writer.close();
+    EXPECT_EQ(device.data(), QByteArray("data"));
+}
+
+TEST(QDltFileWriter, keepWrittenMessages) {
+    QBuffer device;
+    device.open(QIODevice::WriteOnly);
+    device.write("existing");
+
+    QDltFileWriter writer;
+    writer.setFlushPolicy(0, 0, 0);
+    writer.setKeepWrittenMessages(true);
+    writer.setDevice(&device);
+
+    const DltStorageHeader str = storageHeader(1, 2);
+    writer.writeMessage(str, QByteArray("HEADER"), "first");
+    writer.write("raw", 3);
+    writer.writeMessage(str, QByteArray("HEADER"), "second");
+
+    // only messages written to the file are taken
+    std::vector<char> data;
+    std::vector<QDltFileWriter::WrittenMessage> messages;
+    writer.takeWrittenMessages(data, messages);
+    EXPECT_TRUE(messages.empty());
+
+    ASSERT_TRUE(writer.flush());
+    writer.takeWrittenMessages(data, messages);
+    ASSERT_EQ(messages.size(), 2u);
+    const int size = int(sizeof(DltStorageHeader)) + 6;
+    EXPECT_EQ(messages[0].pos, 8);
+    EXPECT_EQ(messages[0].size, size + 5);
+    EXPECT_EQ(messages[1].pos, 8 + size + 5 + 3);
+    EXPECT_EQ(messages[1].size, size + 6);
+
+    // the kept messages are the same as in the file
+    ASSERT_EQ(data.size(), size_t(2 * size + 11));
+    EXPECT_EQ(QByteArray(data.data(), messages[0].size), device.data().mid(messages[0].pos, messages[0].size));
+    EXPECT_EQ(QByteArray(data.data() + messages[0].size, messages[1].size), device.data().mid(messages[1].pos, messages[1].size));
+
+    data.clear();
+    messages.clear();
+    writer.takeWrittenMessages(data, messages);
+    EXPECT_TRUE(messages.empty());
+    writer.close();
+}
+
+TEST(QDltFileWriter, keptMessagesAreDroppedWhenFileIsWrittenOtherwise) {
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath("test.dlt");
+
+    QDltFileWriter writer;
+    writer.setKeepWrittenMessages(true);
+    ASSERT_TRUE(writer.open(fileName));
+
+    const DltStorageHeader str = storageHeader(1, 2);
+    const qint64 size = qint64(sizeof(DltStorageHeader)) + 5;
+    std::vector<char> data;
+    std::vector<QDltFileWriter::WrittenMessage> messages;
+    writer.writeMessage(str, QByteArray(), "first");
+    ASSERT_TRUE(writer.flush());
+    writer.takeWrittenMessages(data, messages);
+    ASSERT_EQ(messages.size(), 1u);
+
+    // another writer appends to the file, the position of the next message is not known
+    QFile other(fileName);
+    ASSERT_TRUE(other.open(QIODevice::WriteOnly | QIODevice::Append));
+    other.write("other");
+    other.close();
+    writer.writeMessage(str, QByteArray(), "secon");
+    ASSERT_TRUE(writer.flush());
+    messages.clear();
+    writer.takeWrittenMessages(data, messages);
+    EXPECT_TRUE(messages.empty());
+
+    // the following messages have their real positions again
+    EXPECT_EQ(writer.size(), 2 * size + 5);
+    writer.writeMessage(str, QByteArray(), "third");
+    ASSERT_TRUE(writer.flush());
+    writer.takeWrittenMessages(data, messages);
+    ASSERT_EQ(messages.size(), 1u);
+    EXPECT_EQ(messages[0].pos, 2 * size + 5);
+    writer.close();
+
+    EXPECT_EQ(readFile(fileName).mid(messages[0].pos + sizeof(DltStorageHeader)), QByteArray("third"));
+}
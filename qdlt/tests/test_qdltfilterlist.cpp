@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+
+#include <qdltfilterlist.h>
+
+#include <QRandomGenerator>
+
+namespace {
+
+const QStringList ids = {"", "A", "APP", "APP1", "APP2", "CTX", "CTX1", "ECU1", "ECU2", "LONGID", "app1"};
+
+QDltMsg createMessage(QRandomGenerator& random) {
+    QDltMsg msg;
+    msg.setEcuid(ids[random.bounded(ids.size())]);
+    msg.setApid(ids[random.bounded(ids.size())]);
+    msg.setCtid(ids[random.bounded(ids.size())]);
+    msg.setType(random.bounded(4) ? QDltMsg::DltTypeLog : QDltMsg::DltTypeControl);
+    msg.setSubtype(random.bounded(1, 7));
+    msg.setMode(random.bounded(2) ? QDltMsg::DltModeVerbose : QDltMsg::DltModeNonVerbose);
+    msg.setMessageId(random.bounded(20));
+
+    QDltArgument arg;
+    arg.setValue(QVariant(QString("payload %1 text").arg(random.bounded(100))));
+    msg.addArgument(arg);
+    msg.setNumberOfArguments(1);
+    return msg;
+}
+
+QDltFilter* createFilter(QRandomGenerator& random) {
+    QDltFilter* filter = new QDltFilter();
+    const int type = random.bounded(3);
+    filter->type = type == 0 ? QDltFilter::positive : type == 1 ? QDltFilter::negative : QDltFilter::marker;
+    filter->enableFilter = random.bounded(8) != 0;
+
+    filter->enableEcuid = random.bounded(4) == 0;
+    filter->ecuid = ids[random.bounded(ids.size())];
+    filter->enableApid = random.bounded(2) == 0;
+    filter->apid = ids[random.bounded(ids.size())];
+    filter->enableRegexp_Appid = random.bounded(5) == 0;
+    filter->enableCtid = random.bounded(4) == 0;
+    filter->ctid = ids[random.bounded(ids.size())].left(random.bounded(4));
+    filter->enableRegexp_Context = random.bounded(5) == 0;
+    filter->enablePayload = random.bounded(6) == 0;
+    filter->payload = QString("%1 TEXT").arg(random.bounded(10));
+    filter->ignoreCase_Payload = random.bounded(2) == 0;
+    filter->enableRegexp_Payload = random.bounded(4) == 0;
+    filter->enableHeader = random.bounded(10) == 0;
+    filter->header = ids[random.bounded(ids.size())];
+    filter->enableCtrlMsgs = random.bounded(10) == 0;
+    filter->enableLogLevelMax = random.bounded(5) == 0;
+    filter->logLevelMax = random.bounded(1, 7);
+    filter->enableLogLevelMin = random.bounded(5) == 0;
+    filter->logLevelMin = random.bounded(1, 7);
+    filter->enableMessageId = random.bounded(8) == 0;
+    filter->messageIdMin = random.bounded(20);
+    filter->messageIdMax = random.bounded(2) ? 0 : filter->messageIdMin + random.bounded(10);
+    filter->compileRegexps();
+    return filter;
+}
+
+// the filter check as done before the filters were compiled
+bool checkFilterInterpreted(const QDltFilterList& filterList, const QDltMsg& msg) {
+    QList<QDltFilter*> pfilters, nfilters;
+    for (QDltFilter* filter : filterList.filters) {
+        if (filter->isPositive() && filter->enableFilter)
+            pfilters.append(filter);
+        if (filter->isNegative() && filter->enableFilter)
+            nfilters.append(filter);
+    }
+
+    bool found = pfilters.isEmpty();
+    for (QDltFilter* filter : pfilters) {
+        found = filter->match(msg);
+        if (found)
+            break;
+    }
+    if (found) {
+        for (QDltFilter* filter : nfilters) {
+            if (filter->match(msg))
+                return false;
+        }
+    }
+    return found;
+}
+
+} // namespace
+
+TEST(QDltFilterList, compiledFiltersMatchInterpretedFilters) {
+    QRandomGenerator random(1);
+
+    QVector<QDltMsg> messages;
+    for (int num = 0; num < 300; num++)
+        messages.append(createMessage(random));
+
+    for (int run = 0; run < 200; run++) {
+        QDltFilterList filterList;
+        const int count = random.bounded(12);
+        for (int num = 0; num < count; num++)
+            filterList.addFilter(createFilter(random));
+        filterList.updateSortedFilter();
+
+        for (QDltMsg& msg : messages)
+            ASSERT_EQ(filterList.checkFilter(msg), checkFilterInterpreted(filterList, msg)) << "run " << run;
+    }
+}
+
+TEST(QDltFilterList, exactApplicationIds) {
+    QDltFilterList filterList;
+    for (const QString& apid : {"APP1", "APP2", "LONGID", ""}) {
+        QDltFilter* filter = new QDltFilter();
+        filter->enableFilter = true;
+        filter->enableApid = true;
+        filter->apid = apid;
+        filterList.addFilter(filter);
+    }
+    filterList.updateSortedFilter();
+
+    QDltMsg msg;
+    for (const QString& apid : ids) {
+        msg.setApid(apid);
+        const bool expected = apid == "APP1" || apid == "APP2" || apid == "LONGID" || apid.isEmpty();
+        EXPECT_EQ(filterList.checkFilter(msg), expected) << apid.toStdString();
+    }
+
+    // ids with more than four characters or zero characters are compared as strings
+    msg.setApid("APP1X");
+    EXPECT_FALSE(filterList.checkFilter(msg));
+    msg.setApid(QString("AP") + QChar(0));
+    EXPECT_FALSE(filterList.checkFilter(msg));
+}
+
+TEST(QDltFilterList, contextIdsOfApplicationIds) {
+    QDltFilterList filterList;
+    const QList<QPair<QString, QString>> filterIds = {{"APP1", "CTX"}, {"APP1", "TX1"}, {"APP2", "C"}, {"APP2", ""}};
+    for (const auto& ids : filterIds) {
+        QDltFilter* filter = new QDltFilter();
+        filter->enableFilter = true;
+        filter->enableApid = true;
+        filter->apid = ids.first;
+        filter->enableCtid = true;
+        filter->ctid = ids.second;
+        filterList.addFilter(filter);
+    }
+    filterList.updateSortedFilter();
+
+    // the context id of a filter is searched in the context id of the message
+    QDltMsg msg;
+    msg.setApid("APP1");
+    for (const QString& ctid : {"CTX", "CTX1", "XCTX", "TX1", "CT", "TX", "", "CONTEXT1", "LONGCTX"}) {
+        msg.setCtid(ctid);
+        const bool expected = QString(ctid).contains("CTX") || QString(ctid).contains("TX1");
+        EXPECT_EQ(filterList.checkFilter(msg), expected) << ctid;
+    }
+
+    // an empty context id matches all context ids of the application id
+    msg.setApid("APP2");
+    msg.setCtid("XYZ");
+    EXPECT_TRUE(filterList.checkFilter(msg));
+    msg.setApid("APP3");
+    msg.setCtid("CTX");
+    EXPECT_FALSE(filterList.checkFilter(msg));
+}
+
+TEST(QDltFilterList, clearFilter) {
+    QDltFilterList filterList;
+    QDltFilter* filter = new QDltFilter();
+    filter->enableFilter = true;
+    filter->enableApid = true;
+    filter->apid = "APP1";
+    filterList.addFilter(filter);
+    filterList.updateSortedFilter();
+
+    QDltMsg msg;
+    msg.setApid("APP2");
+    EXPECT_FALSE(filterList.checkFilter(msg));
+
+    // no filters left, all messages are shown
+    filterList.clearFilter();
+    EXPECT_TRUE(filterList.checkFilter(msg));
+}
+
+TEST(QDltFilterList, textPatternsMatchInterpretedFilters) {
+    QRandomGenerator random(2);
+    const QStringList words = {"payload", "PAYLOAD", "text", "1 text", "Text", "ECU1", "app1", "ctx", "", "none"};
+
+    QVector<QDltMsg> messages;
+    for (int num = 0; num < 300; num++)
+        messages.append(createMessage(random));
+
+    for (int run = 0; run < 100; run++) {
+        // many plain text filters and markers, all searched by the multi pattern matchers
+        QDltFilterList filterList;
+        const int count = random.bounded(2, 40);
+        for (int num = 0; num < count; num++) {
+            QDltFilter* filter = new QDltFilter();
+            const int type = random.bounded(3);
+            filter->type = type == 0 ? QDltFilter::positive : type == 1 ? QDltFilter::negative : QDltFilter::marker;
+            filter->enableFilter = random.bounded(8) != 0;
+            filter->filterColour = QString("#%1").arg(num, 6, 10, QChar('0'));
+            filter->enablePayload = random.bounded(4) != 0;
+            filter->payload = words[random.bounded(words.size())];
+            filter->ignoreCase_Payload = random.bounded(2) == 0;
+            filter->enableRegexp_Payload = random.bounded(10) == 0;
+            filter->enableHeader = random.bounded(3) == 0;
+            filter->header = words[random.bounded(words.size())];
+            filter->ignoreCase_Header = random.bounded(2) == 0;
+            filter->enableLogLevelMax = random.bounded(5) == 0;
+            filter->logLevelMax = random.bounded(1, 7);
+            filter->compileRegexps();
+            filterList.addFilter(filter);
+        }
+        filterList.updateSortedFilter();
+
+        for (QDltMsg& msg : messages) {
+            ASSERT_EQ(filterList.checkFilter(msg), checkFilterInterpreted(filterList, msg)) << "run " << run;
+
+            // the first matching marker sets the colour
+            auto expected = decltype(filterList.checkMarker(msg))();
+            for (QDltFilter* filter : filterList.filters) {
+                if (filter->isMarker() && filter->enableFilter && filter->match(msg)) {
+                    expected = filter->filterColour;
+                    break;
+                }
+            }
+            ASSERT_EQ(filterList.checkMarker(msg), expected) << "run " << run;
+        }
+    }
+}
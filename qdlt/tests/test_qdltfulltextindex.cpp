@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <qdltfulltextindex.h>
+
+#include <QFile>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+
+namespace {
+
+QDltFullTextIndex createIndex() {
+    QDltFullTextIndex fullText;
+    fullText.append("ECU1 APP1 CON1", "connection established");
+    fullText.append("ECU1 APP2 CON1", "Watchdog timeout of task_7");
+    fullText.appendInvalid();
+    fullText.append("ECU2 APP1 CON2", "connection lost, reconnecting");
+    fullText.append("ECU2 APP2 CON2", QString::fromUtf8("Temperatur über Grenzwert"));
+    return fullText;
+}
+
+QVector<int> findAll(const QDltFullTextIndex &fullText, const QStringList &texts) {
+    QVector<int> result;
+    EXPECT_TRUE(fullText.findAll(texts, result));
+    return result;
+}
+
+} // namespace
+
+TEST(QDltFullTextIndex, findAll) {
+    const QDltFullTextIndex fullText = createIndex();
+    ASSERT_EQ(fullText.size(), 5);
+
+    // messages which could not be parsed are always candidates
+    EXPECT_EQ(findAll(fullText, {"connection"}), QVector<int>({0, 2, 3}));
+    EXPECT_EQ(findAll(fullText, {"CONNECTION"}), QVector<int>({0, 2, 3}));
+    EXPECT_EQ(findAll(fullText, {"timeout of task"}), QVector<int>({1, 2}));
+
+    // the first and the last word may be part of a longer word, the words in between are complete
+    EXPECT_EQ(findAll(fullText, {"nection"}), QVector<int>({0, 2, 3}));
+    EXPECT_EQ(findAll(fullText, {"connect"}), QVector<int>({0, 2, 3}));
+    EXPECT_EQ(findAll(fullText, {"onnect"}), QVector<int>({0, 2, 3}));
+    EXPECT_EQ(findAll(fullText, {" connect "}), QVector<int>({2}));
+    EXPECT_EQ(findAll(fullText, {"ion lost, recon"}), QVector<int>({2, 3}));
+    EXPECT_EQ(findAll(fullText, {"dog time out"}), QVector<int>({2}));
+    EXPECT_EQ(findAll(fullText, {"task_7"}), QVector<int>({1, 2}));
+    EXPECT_EQ(findAll(fullText, {QString::fromUtf8("ÜBER")}), QVector<int>({2, 4}));
+
+    // header and payload are indexed, all texts must be contained
+    EXPECT_EQ(findAll(fullText, {"app1", "connection"}), QVector<int>({0, 2, 3}));
+    EXPECT_EQ(findAll(fullText, {"ecu2", "connection"}), QVector<int>({2, 3}));
+    EXPECT_EQ(findAll(fullText, {"ecu2", "--", "established"}), QVector<int>({2}));
+
+    // texts without words cannot be searched
+    QVector<int> result;
+    EXPECT_FALSE(fullText.findAll({"--", ""}, result));
+    EXPECT_FALSE(fullText.findAll({QString::fromUtf8("\xF0\x9F\x98\x80")}, result));
+    EXPECT_FALSE(QDltFullTextIndex::isSearchable(", "));
+    EXPECT_TRUE(QDltFullTextIndex::isSearchable(", a"));
+}
+
+TEST(QDltFullTextIndex, findAny) {
+    const QDltFullTextIndex fullText = createIndex();
+
+    QVector<int> result;
+    EXPECT_TRUE(fullText.findAny({"established", "watchdog"}, result));
+    EXPECT_EQ(result, QVector<int>({0, 1, 2}));
+    EXPECT_TRUE(fullText.findAny({"ecu2"}, result));
+    EXPECT_EQ(result, QVector<int>({2, 3, 4}));
+
+    // a text which cannot be searched may be contained in every message
+    EXPECT_FALSE(fullText.findAny({"established", "--"}, result));
+    EXPECT_FALSE(fullText.findAny({}, result));
+}
+
+TEST(QDltFullTextIndex, findsAllContainingMessages) {
+    QRandomGenerator random(11);
+    const QString characters = QString("abAB _-.1") + QChar(0x00e4) + QChar(0x00c4);
+
+    auto randomText = [&](int length) {
+        QString text;
+        for (int pos = 0; pos < length; pos++)
+            text.append(characters[random.bounded(characters.size())]);
+        return text;
+    };
+
+    QDltFullTextIndex fullText;
+    QStringList texts;
+    for (int num = 0; num < 2000; num++) {
+        texts.append(randomText(random.bounded(16)));
+        fullText.append(QString(), texts.last());
+    }
+
+    for (int run = 0; run < 300; run++) {
+        const QString search = randomText(random.bounded(1, 5));
+        QVector<int> result;
+        if (!fullText.findAll({search}, result))
+            continue;
+        // every message containing the text is a candidate
+        for (int num = 0; num < texts.size(); num++) {
+            if (texts[num].contains(search, Qt::CaseInsensitive))
+                ASSERT_TRUE(result.contains(num)) << search.toStdString() << " " << texts[num].toStdString();
+        }
+    }
+}
+
+TEST(QDltFullTextIndex, saveAndLoad) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filename = dir.filePath("test.dft");
+
+    QDltFullTextIndex fullText = createIndex();
+    fullText.setRenderKey("render key");
+    for (int num = 0; num < 1000; num++)
+        fullText.append("header", QString("value %1").arg(num % 100));
+    ASSERT_TRUE(fullText.save(filename, "key"));
+
+    QDltFullTextIndex loaded;
+    ASSERT_TRUE(loaded.load(filename, "key"));
+    EXPECT_EQ(loaded.size(), fullText.size());
+    EXPECT_EQ(loaded.wordCount(), fullText.wordCount());
+    EXPECT_EQ(loaded.getRenderKey(), QByteArray("render key"));
+    EXPECT_EQ(findAll(loaded, {"watchdog"}), QVector<int>({1, 2}));
+    EXPECT_EQ(findAll(loaded, {"value 42"}), findAll(fullText, {"value 42"}));
+
+    // appending after loading continues the posting lists
+    loaded.append("header", "watchdog");
+    EXPECT_EQ(findAll(loaded, {"watchdog"}), QVector<int>({1, 2, fullText.size()}));
+
+    // created for another file
+    EXPECT_FALSE(loaded.load(filename, "other key"));
+    EXPECT_EQ(loaded.size(), 0);
+
+    // corrupt file
+    QFile file(filename);
+    ASSERT_TRUE(file.open(QFile::ReadWrite));
+    file.seek(100);
+    file.write("x");
+    file.close();
+    EXPECT_FALSE(loaded.load(filename, "key"));
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <qdltindexfile.h>
+
+#include <QTemporaryFile>
+
+namespace {
+
+QVector<qint64> createIndex(int size) {
+    QVector<qint64> index;
+    qint64 pos = 0;
+    for (int num = 0; num < size; num++) {
+        index.append(pos);
+        pos += 20 + (num * 37) % 300;
+    }
+    return index;
+}
+
+} // namespace
+
+TEST(QDltIndexFile, encodeAndDecode) {
+    // empty, a single entry, one full block and several blocks
+    for (int size : {0, 1, 4096, 4097, 20000}) {
+        const QVector<qint64> index = createIndex(size);
+        const QByteArray data = QDltIndexFile::encode(index);
+
+        QVector<qint64> decoded;
+        ASSERT_TRUE(QDltIndexFile::decode(data.constData(), data.size(), decoded)) << size;
+        EXPECT_EQ(decoded, index);
+    }
+}
+
+TEST(QDltIndexFile, unsortedAndLargeDifferences) {
+    // filter indexes sorted by time are not ascending
+    const QVector<qint64> index = {500, 100, 0, 0x7fffffffffffLL, 3, -1, 42};
+    const QByteArray data = QDltIndexFile::encode(index);
+
+    QVector<qint64> decoded;
+    ASSERT_TRUE(QDltIndexFile::decode(data.constData(), data.size(), decoded));
+    EXPECT_EQ(decoded, index);
+}
+
+TEST(QDltIndexFile, metadata) {
+    const QVector<qint64> index = createIndex(10);
+    const QByteArray metadata("some metadata");
+    const QByteArray data = QDltIndexFile::encode(index, metadata);
+
+    QVector<qint64> decoded;
+    QByteArray decodedMetadata;
+    ASSERT_TRUE(QDltIndexFile::decode(data.constData(), data.size(), decoded, &decodedMetadata));
+    EXPECT_EQ(decoded, index);
+    EXPECT_EQ(decodedMetadata, metadata);
+}
+
+TEST(QDltIndexFile, compactSize) {
+    const QVector<qint64> index = createIndex(100000);
+    const QByteArray data = QDltIndexFile::encode(index);
+
+    // version 2 needs 8 bytes per entry
+    EXPECT_LT(data.size(), index.size() * 3);
+}
+
+TEST(QDltIndexFile, saveAndLoad) {
+    QTemporaryFile tempFile;
+    ASSERT_TRUE(tempFile.open());
+    tempFile.close();
+
+    const QVector<qint64> index = createIndex(50000);
+    ASSERT_TRUE(QDltIndexFile::save(tempFile.fileName(), index, "meta"));
+
+    QVector<qint64> loaded;
+    QByteArray metadata;
+    ASSERT_TRUE(QDltIndexFile::load(tempFile.fileName(), loaded, &metadata));
+    EXPECT_EQ(loaded, index);
+    EXPECT_EQ(metadata, QByteArray("meta"));
+}
+
+TEST(QDltIndexFile, loadVersion2) {
+    QTemporaryFile tempFile;
+    ASSERT_TRUE(tempFile.open());
+    const QVector<qint64> index = createIndex(1000);
+    const quint32 version = QDLT_INDEX_FILE_VERSION_RAW;
+    tempFile.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    tempFile.write(reinterpret_cast<const char*>(index.constData()), index.size() * sizeof(qint64));
+    tempFile.close();
+
+    QVector<qint64> loaded;
+    ASSERT_TRUE(QDltIndexFile::load(tempFile.fileName(), loaded));
+    EXPECT_EQ(loaded, index);
+}
+
+TEST(QDltIndexFile, rejectCorruptData) {
+    const QByteArray data = QDltIndexFile::encode(createIndex(10000), "meta");
+    QVector<qint64> decoded;
+
+    // truncated
+    EXPECT_FALSE(QDltIndexFile::decode(data.constData(), data.size() - 1, decoded));
+    EXPECT_TRUE(decoded.isEmpty());
+    EXPECT_FALSE(QDltIndexFile::decode(data.constData(), 10, decoded));
+
+    // modified header, metadata and block data
+    for (int pos : {12, 33, data.size() - 1}) {
+        QByteArray modified = data;
+        modified[pos] = static_cast<char>(modified[pos] ^ 0x01);
+        EXPECT_FALSE(QDltIndexFile::decode(modified.constData(), modified.size(), decoded)) << pos;
+        EXPECT_TRUE(decoded.isEmpty());
+    }
+
+    // unknown version
+    QByteArray modified = data;
+    modified[0] = 4;
+    EXPECT_FALSE(QDltIndexFile::decode(modified.constData(), modified.size(), decoded));
+}
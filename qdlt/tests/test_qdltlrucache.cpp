@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <qdltlrucache.hpp>
+
+#include <QString>
+
+#include <map>
+#include <random>
+#include <stdexcept>
+
+TEST(QDltLruCache, putAndGet) {
+    QDltLruCache<int, QString> cache(4);
+
+    EXPECT_FALSE(cache.exists(1));
+    EXPECT_THROW(cache.get(1), std::range_error);
+
+    cache.put(1, "one");
+    cache.put(2, "two");
+    ASSERT_TRUE(cache.exists(1));
+    EXPECT_EQ(cache.get(1), "one");
+    EXPECT_EQ(cache.get(2), "two");
+
+    cache.put(1, "uno");
+    EXPECT_EQ(cache.get(1), "uno");
+}
+
+TEST(QDltLruCache, valuesInUseAreKept) {
+    QDltLruCache<int, int> cache(4);
+
+    for (int key = 0; key < 4; key++)
+        cache.put(key, key);
+    EXPECT_EQ(cache.get(0), 0);
+    EXPECT_EQ(cache.get(2), 2);
+
+    // the values which were not read are replaced first
+    cache.put(4, 4);
+    cache.put(5, 5);
+    EXPECT_TRUE(cache.exists(0));
+    EXPECT_FALSE(cache.exists(1));
+    EXPECT_TRUE(cache.exists(2));
+    EXPECT_FALSE(cache.exists(3));
+    EXPECT_TRUE(cache.exists(4));
+    EXPECT_TRUE(cache.exists(5));
+}
+
+TEST(QDltLruCache, capacityOfOne) {
+    QDltLruCache<int, int> cache(1);
+
+    cache.put(1, 10);
+    EXPECT_EQ(cache.get(1), 10);
+    cache.put(2, 20);
+    EXPECT_FALSE(cache.exists(1));
+    EXPECT_EQ(cache.get(2), 20);
+}
+
+TEST(QDltLruCache, clear) {
+    QDltLruCache<int, int> cache(8);
+
+    for (int key = 0; key < 8; key++)
+        cache.put(key, key);
+    cache.clear();
+    for (int key = 0; key < 8; key++)
+        EXPECT_FALSE(cache.exists(key));
+
+    cache.put(3, 30);
+    EXPECT_EQ(cache.get(3), 30);
+}
+
+TEST(QDltLruCache, randomAccessKeepsCorrectValues) {
+    const int capacity = 50;
+    QDltLruCache<int, int> cache(capacity);
+    std::map<int, int> values;
+    std::mt19937 random(1);
+
+    for (int num = 0; num < 100000; num++) {
+        const int key = static_cast<int>(random() % 200);
+        if (random() % 2) {
+            cache.put(key, num);
+            values[key] = num;
+        } else if (cache.exists(key)) {
+            EXPECT_EQ(cache.get(key), values[key]);
+        }
+    }
+
+    int cached = 0;
+    for (int key = 0; key < 200; key++)
+        cached += cache.exists(key) ? 1 : 0;
+    EXPECT_EQ(cached, capacity);
+}
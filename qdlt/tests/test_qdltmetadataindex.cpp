@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include <qdltfilterlist.h>
+#include <qdltmetadataindex.h>
+
+#include <QTemporaryDir>
+
+namespace {
+
+QDltMsg createMessage(int num) {
+    QDltMsg msg;
+    msg.setEcuid(num % 3 ? "ECU1" : "ECU2");
+    msg.setApid(QString("AP%1").arg(num % 5));
+    msg.setCtid(QString("CT%1").arg(num % 7));
+    msg.setType(num % 11 ? QDltMsg::DltTypeLog : QDltMsg::DltTypeControl);
+    msg.setSubtype(num % 11 ? 1 + num % 6 : QDltMsg::DltControlResponse);
+    msg.setMode(QDltMsg::DltModeVerbose);
+    msg.setTime(1700000000 + num);
+    msg.setMicroseconds(num * 10);
+    msg.setTimestamp(num * 100);
+
+    QDltArgument arg;
+    arg.setValue(QVariant(QString("message %1").arg(num)));
+    msg.addArgument(arg);
+    msg.setNumberOfArguments(1);
+
+    // parse the message again, as done when reading from a file
+    QByteArray buf;
+    msg.getMsg(buf, true);
+    QDltMsg parsed;
+    parsed.setMsg(buf, true);
+    return parsed;
+}
+
+QDltFilter* createFilter(QDltFilter::FilterType type) {
+    QDltFilter* filter = new QDltFilter();
+    filter->type = type;
+    filter->enableFilter = true;
+    return filter;
+}
+
+} // namespace
+
+TEST(QDltMetadataIndex, appendAndGet) {
+    QDltMetadataIndex metadata;
+    for (int num = 0; num < 100; num++)
+        metadata.append(createMessage(num));
+    metadata.appendInvalid();
+
+    ASSERT_EQ(metadata.size(), 101);
+    EXPECT_TRUE(metadata.isValid());
+    EXPECT_EQ(metadata.getEcuidTable().size(), 2);
+    EXPECT_EQ(metadata.getApidTable().size(), 5);
+    EXPECT_EQ(metadata.getCtidTable().size(), 7);
+
+    for (int num = 0; num < 100; num++) {
+        const QDltMsg msg = createMessage(num);
+        EXPECT_TRUE(metadata.isMsgValid(num));
+        EXPECT_EQ(metadata.getEcuid(num), msg.getEcuid());
+        EXPECT_EQ(metadata.getApid(num), msg.getApid());
+        EXPECT_EQ(metadata.getCtid(num), msg.getCtid());
+        EXPECT_EQ(metadata.getType(num), msg.getType());
+        EXPECT_EQ(metadata.getSubtype(num), msg.getSubtype());
+        EXPECT_EQ(metadata.getMode(num), msg.getMode());
+        EXPECT_EQ(metadata.getMessageId(num), msg.getMessageId());
+        EXPECT_EQ(metadata.getTime(num), msg.getTime());
+        EXPECT_EQ(metadata.getMicroseconds(num), msg.getMicroseconds());
+        EXPECT_EQ(metadata.getTimestamp(num), msg.getTimestamp());
+    }
+    EXPECT_FALSE(metadata.isMsgValid(100));
+
+    const QDltMetadataIndex part = metadata.mid(10, 20);
+    ASSERT_EQ(part.size(), 20);
+    EXPECT_EQ(part.getApid(0), metadata.getApid(10));
+    EXPECT_EQ(part.getTimestamp(19), metadata.getTimestamp(29));
+}
+
+TEST(QDltMetadataIndex, sameResultAsMessageFilter) {
+    QVector<QDltMsg> messages;
+    QDltMetadataIndex metadata;
+    for (int num = 0; num < 500; num++) {
+        messages.append(createMessage(num));
+        metadata.append(messages.last());
+    }
+
+    QDltFilterList filterList;
+    QDltFilter* filter = createFilter(QDltFilter::positive);
+    filter->enableEcuid = true;
+    filter->ecuid = "ECU1";
+    filter->enableLogLevelMax = true;
+    filter->logLevelMax = 4;
+    filterList.addFilter(filter);
+
+    filter = createFilter(QDltFilter::positive);
+    filter->enableApid = true;
+    filter->enableRegexp_Appid = true;
+    filter->apid = "AP[34]";
+    filter->compileRegexps();
+    filterList.addFilter(filter);
+
+    filter = createFilter(QDltFilter::positive);
+    filter->enableCtrlMsgs = true;
+    filterList.addFilter(filter);
+
+    filter = createFilter(QDltFilter::negative);
+    filter->enableCtid = true;
+    filter->ctid = "T2";
+    filterList.addFilter(filter);
+
+    filter = createFilter(QDltFilter::marker);
+    filter->enablePayload = true;
+    filter->payload = "message 1";
+    filterList.addFilter(filter);
+    filterList.updateSortedFilter();
+
+    // markers do not change the filter result
+    ASSERT_TRUE(filterList.isMetadataFilter());
+
+    QVector<int> expected;
+    for (int num = 0; num < messages.size(); num++) {
+        if (filterList.checkFilter(messages[num]))
+            expected.append(num);
+    }
+    ASSERT_FALSE(expected.isEmpty());
+    ASSERT_LT(expected.size(), messages.size());
+
+    QVector<int> matches;
+    filterList.checkFilter(metadata, 0, metadata.size(), matches);
+    EXPECT_EQ(matches, expected);
+
+    // a range of rows
+    matches.clear();
+    filterList.checkFilter(metadata, 100, 200, matches);
+    QVector<int> expectedRange;
+    for (int num : expected)
+        if (num >= 100 && num < 200)
+            expectedRange.append(num);
+    EXPECT_EQ(matches, expectedRange);
+
+    // payload filters need the messages
+    filter = createFilter(QDltFilter::negative);
+    filter->enablePayload = true;
+    filter->payload = "message 1";
+    filterList.addFilter(filter);
+    filterList.updateSortedFilter();
+    EXPECT_FALSE(filterList.isMetadataFilter());
+}
+
+TEST(QDltMetadataIndex, invalidMessagesNeverMatch) {
+    QDltMetadataIndex metadata;
+    metadata.append(createMessage(1));
+    metadata.appendInvalid();
+    metadata.append(createMessage(2));
+
+    // no filters, all valid messages are shown
+    QDltFilterList filterList;
+    QVector<int> matches;
+    filterList.checkFilter(metadata, 0, metadata.size(), matches);
+    EXPECT_EQ(matches, QVector<int>({0, 2}));
+}
+
+TEST(QDltMetadataIndex, saveAndLoad) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filename = dir.filePath("test.dmi");
+
+    QDltMetadataIndex metadata;
+    for (int num = 0; num < 1000; num++)
+        metadata.append(createMessage(num));
+    metadata.appendInvalid();
+    ASSERT_TRUE(metadata.save(filename, "key"));
+
+    QDltMetadataIndex loaded;
+    ASSERT_TRUE(loaded.load(filename, "key"));
+    ASSERT_EQ(loaded.size(), metadata.size());
+    EXPECT_EQ(loaded.getEcuidTable(), metadata.getEcuidTable());
+    for (int num = 0; num < metadata.size(); num++) {
+        EXPECT_EQ(loaded.isMsgValid(num), metadata.isMsgValid(num));
+        EXPECT_EQ(loaded.getCtid(num), metadata.getCtid(num));
+        EXPECT_EQ(loaded.getSubtype(num), metadata.getSubtype(num));
+        EXPECT_EQ(loaded.getTime(num), metadata.getTime(num));
+        EXPECT_EQ(loaded.getTimestamp(num), metadata.getTimestamp(num));
+    }
+
+    // appending after loading uses the same ids
+    loaded.append(createMessage(5));
+    EXPECT_EQ(loaded.getEcuidTable().size(), metadata.getEcuidTable().size());
+
+    // created for another file
+    EXPECT_FALSE(loaded.load(filename, "other key"));
+    EXPECT_EQ(loaded.size(), 0);
+
+    // corrupt file
+    QFile file(filename);
+    ASSERT_TRUE(file.open(QFile::ReadWrite));
+    file.seek(100);
+    file.write("x");
+    file.close();
+    EXPECT_FALSE(loaded.load(filename, "key"));
+}
@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+
+#include "testutils.h"
+
+#include <qdltmsg.h>
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+QByteArray createMessage(int numberOfArguments, int argumentsInHeader) {
+    QVariantList values;
+    for (int num = 0; num < numberOfArguments; num++) {
+        if (num % 2)
+            values.append(num * 1000);
+        else
+            values.append(QString("text %1").arg(num));
+    }
+
+    QDltMsg msg = testutils::createMsg(values);
+    msg.setNumberOfArguments(argumentsInHeader);
+    return testutils::toBytes(msg);
+}
+
+} // namespace
+
+TEST(QDltMsg, lazyArgumentsAreParsedWhenAccessed) {
+    const QByteArray buf = createMessage(3, 3);
+
+    QDltMsg eager, lazy;
+    ASSERT_TRUE(eager.setMsg(buf, true));
+    ASSERT_TRUE(lazy.setMsg(buf, true, false, true));
+
+    // the header is decoded immediately
+    EXPECT_EQ(lazy.getApid(), QString("APP"));
+    EXPECT_EQ(lazy.getNumberOfArguments(), 3);
+    EXPECT_EQ(lazy.toStringHeader(), eager.toStringHeader());
+
+    ASSERT_EQ(lazy.sizeArguments(), eager.sizeArguments());
+    for (int num = 0; num < eager.sizeArguments(); num++) {
+        QDltArgument lazyArgument, eagerArgument;
+        ASSERT_TRUE(lazy.getArgument(num, lazyArgument));
+        ASSERT_TRUE(eager.getArgument(num, eagerArgument));
+        EXPECT_EQ(lazyArgument.toString(), eagerArgument.toString());
+    }
+    EXPECT_EQ(lazy.toStringPayload(), QString("text 0 1000 text 2"));
+    EXPECT_TRUE(lazy.hasValidArguments());
+
+    // a copy parses the arguments on its own
+    QDltMsg lazyCopy;
+    ASSERT_TRUE(lazyCopy.setMsg(buf, true, false, true));
+    QDltMsg copy = lazyCopy;
+    EXPECT_EQ(copy.toStringPayload(), eager.toStringPayload());
+}
+
+TEST(QDltMsg, lazyArgumentsOfSeveralThreads) {
+    const QByteArray buf = createMessage(20, 20);
+
+    QDltMsg eager;
+    ASSERT_TRUE(eager.setMsg(buf, true));
+    const QString expected = eager.toStringPayload();
+
+    // const getters and copies of several threads parse the arguments only once
+    for (int run = 0; run < 100; run++) {
+        QDltMsg lazy;
+        ASSERT_TRUE(lazy.setMsg(buf, true, false, true));
+        const QDltMsg& shared = lazy;
+
+        std::vector<std::thread> threads;
+        std::vector<int> errors(4, 0);
+        for (int thread = 0; thread < 4; thread++) {
+            threads.emplace_back([&shared, &expected, &errors, thread]() {
+                const QDltMsg copy = shared;
+                if (shared.sizeArguments() != 20 || !shared.hasValidArguments() || shared.toStringPayload() != expected ||
+                    copy.toStringPayload() != expected)
+                    errors[thread]++;
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+
+        EXPECT_EQ(errors, std::vector<int>(4, 0));
+    }
+}
+
+TEST(QDltMsg, lazyArgumentsBeforeChanges) {
+    const QByteArray buf = createMessage(2, 2);
+
+    // arguments are parsed with the values of the message, before they are changed
+    QDltMsg msg;
+    ASSERT_TRUE(msg.setMsg(buf, true, false, true));
+    msg.setNumberOfArguments(0);
+    EXPECT_EQ(msg.sizeArguments(), 2);
+
+    ASSERT_TRUE(msg.setMsg(buf, true, false, true));
+    QDltArgument arg;
+    arg.setValue(QVariant(QString("added")));
+    msg.addArgument(arg);
+    EXPECT_EQ(msg.toStringPayload(), QString("text 0 1000 added"));
+
+    // writing the message generates the payload from the arguments
+    ASSERT_TRUE(msg.setMsg(buf, true, false, true));
+    QByteArray written;
+    ASSERT_TRUE(msg.getMsg(written, true));
+    EXPECT_EQ(written, buf);
+}
+
+TEST(QDltMsg, brokenArguments) {
+    // the header announces more arguments than the payload contains
+    const QByteArray buf = createMessage(2, 3);
+
+    QDltMsg eager;
+    EXPECT_FALSE(eager.setMsg(buf, true));
+    EXPECT_FALSE(eager.hasValidArguments());
+
+    QDltMsg lazy;
+    EXPECT_TRUE(lazy.setMsg(buf, true, false, true));
+    EXPECT_FALSE(lazy.hasValidArguments());
+    EXPECT_EQ(lazy.sizeArguments(), eager.sizeArguments());
+
+    // the next message is valid again
+    EXPECT_TRUE(lazy.setMsg(createMessage(2, 2), true, false, true));
+    EXPECT_TRUE(lazy.hasValidArguments());
+}
+
+TEST(QDltMsg, packedAndLongIds) {
+    QDltMsg msg;
+    quint32 packed = 0;
+
+    msg.setApid("APP");
+    EXPECT_EQ(msg.getApid(), QString("APP"));
+    EXPECT_TRUE(msg.getPackedApid(packed));
+    EXPECT_EQ(packed, static_cast<quint32>('A' | ('P' << 8) | ('P' << 16)));
+
+    // ids which cannot be packed are stored as strings
+    msg.setApid("APPLICATION");
+    EXPECT_EQ(msg.getApid(), QString("APPLICATION"));
+    EXPECT_FALSE(msg.getPackedApid(packed));
+    EXPECT_EQ(packed, 0u);
+    msg.setCtid(QString::fromUtf8("C\xc3\xa4"));
+    EXPECT_EQ(msg.getCtid(), QString::fromUtf8("C\xc3\xa4"));
+    EXPECT_FALSE(msg.getPackedCtid(packed));
+
+    // a copy is independent of the original
+    QDltMsg copy = msg;
+    copy.setApid("APP2");
+    copy.setSessionName("session");
+    EXPECT_EQ(copy.getApid(), QString("APP2"));
+    EXPECT_EQ(msg.getApid(), QString("APPLICATION"));
+    EXPECT_TRUE(msg.getSessionName().isEmpty());
+    EXPECT_EQ(copy.getSessionName(), QString("session"));
+
+    msg.setEcuid("");
+    EXPECT_TRUE(msg.getEcuid().isEmpty());
+    EXPECT_TRUE(msg.getPackedEcuid(packed));
+    EXPECT_EQ(packed, 0u);
+
+    msg.clear();
+    EXPECT_TRUE(msg.getApid().isEmpty());
+    EXPECT_TRUE(msg.getCtid().isEmpty());
+}
+
+TEST(QDltMsg, idsWithZeroBytes) {
+    QDltMsg source = testutils::createMsg({QString("text")});
+    QByteArray buf = testutils::toBytes(source);
+
+    // the ECU id of the header starts with a zero byte, the context id has one after the first character
+    buf.replace(buf.lastIndexOf("ECU1"), 4, QByteArray("\0AB\0", 4));
+    buf.replace(buf.indexOf("CTX"), 4, QByteArray("C\0D\0", 4));
+
+    // the ids are decoded like getStringFromId()
+    QDltMsg msg;
+    ASSERT_TRUE(msg.setMsg(buf, true));
+    EXPECT_EQ(msg.getEcuid(), QString(QByteArray("\0AB", 3)));
+    EXPECT_EQ(msg.getEcuid(), QDltMsg::getStringFromId("\0AB\0"));
+    EXPECT_EQ(msg.getApid(), QString("APP"));
+    EXPECT_EQ(msg.getCtid(), QString("C"));
+
+    quint32 packed = 0;
+    EXPECT_TRUE(msg.getPackedCtid(packed));
+    EXPECT_EQ(packed, static_cast<quint32>('C'));
+}
+
+TEST(QDltMsg, headerAndPayload) {
+    const QByteArray buf = createMessage(2, 2);
+
+    QDltMsg msg;
+    ASSERT_TRUE(msg.setMsg(buf, true));
+    EXPECT_EQ(msg.getHeaderSize() + msg.getPayloadSize(), buf.size());
+    EXPECT_EQ(msg.getHeader(), buf.left(msg.getHeaderSize()));
+    EXPECT_EQ(msg.getPayload(), buf.mid(msg.getHeaderSize()));
+
+    // offsets of the arguments are relative to the payload
+    QDltArgument arg;
+    ASSERT_TRUE(msg.getArgument(0, arg));
+    EXPECT_EQ(arg.getOffsetPayload(), 0);
+
+    QByteArray payload("payload");
+    msg.setPayload(payload);
+    EXPECT_EQ(msg.getPayload(), payload);
+    EXPECT_EQ(msg.getHeader(), buf.left(msg.getHeaderSize()));
+
+    QByteArray header("header");
+    msg.setHeader(header);
+    EXPECT_EQ(msg.getHeader(), header);
+    EXPECT_EQ(msg.getPayload(), payload);
+
+    // a message too small for its payload keeps the header and the available part of the payload
+    QDltMsg truncated;
+    EXPECT_FALSE(truncated.setMsg(buf.left(buf.size() - 1), true));
+    EXPECT_EQ(truncated.getHeader(), buf.left(msg.getHeaderSize()));
+    EXPECT_EQ(truncated.getPayload(), buf.mid(msg.getHeaderSize(), msg.getPayloadSize() - 1));
+}
+
+TEST(QDltMsg, appendToStringPayload) {
+    // verbose
+    QDltMsg verbose;
+    ASSERT_TRUE(verbose.setMsg(createMessage(3, 3), true));
+    QString text("prefix ");
+    verbose.appendToStringPayload(text);
+    EXPECT_EQ(text, QString("prefix text 0 1000 text 2"));
+    EXPECT_EQ(verbose.toStringPayload(), QString("text 0 1000 text 2"));
+
+    // non-verbose, printable characters and the bytes in hex after the message id
+    QDltMsg nonVerbose;
+    nonVerbose.setType(QDltMsg::DltTypeLog);
+    nonVerbose.setMode(QDltMsg::DltModeNonVerbose);
+    QByteArray payload("\x01\x00\x00\x00" "AB\x01", 7);
+    nonVerbose.setPayload(payload);
+    text.truncate(0);
+    nonVerbose.appendToStringPayload(text);
+    EXPECT_EQ(text, QString("[0]  AB-|41 42 01"));
+    EXPECT_EQ(nonVerbose.toStringPayload(), text);
+
+    // control request, the bytes after the service id in hex
+    QDltMsg control;
+    control.setType(QDltMsg::DltTypeControl);
+    control.setSubtype(QDltMsg::DltControlRequest);
+    control.setMode(QDltMsg::DltModeNonVerbose);
+    payload = QByteArray("\x00\x00\x00\x00\xab\x10", 6);
+    control.setPayload(payload);
+    text.truncate(0);
+    control.appendToStringPayload(text);
+    EXPECT_EQ(text, QString("[] ab 10"));
+    EXPECT_EQ(control.toStringPayload(), text);
+}
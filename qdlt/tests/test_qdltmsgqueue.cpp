@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <qdltmsgqueue.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(QDltMsgQueue, slotsAreDequeuedInOrder) {
+    QDltMsgQueue queue(16);
+    const int count = 10000;
+
+    std::thread producer([&queue]() {
+        QVector<QDltMsgQueue::Slot*> slots;
+        int index = 0;
+        while (index < count) {
+            ASSERT_GT(queue.acquire(slots, qMin(5, count - index)), 0);
+            for (QDltMsgQueue::Slot* slot : slots) {
+                slot->index = index++;
+                slot->msg.setApid(QString::number(slot->index % 1000));
+            }
+            queue.enqueue(slots);
+        }
+        queue.enqueueStopRequest();
+    });
+
+    QVector<QDltMsgQueue::Slot*> slots;
+    int expected = 0;
+    while (queue.dequeue(slots, 7) > 0) {
+        for (QDltMsgQueue::Slot* slot : slots) {
+            EXPECT_EQ(slot->index, expected);
+            EXPECT_EQ(slot->msg.getApid(), QString::number(expected % 1000));
+            expected++;
+        }
+        queue.release(slots);
+    }
+    producer.join();
+
+    EXPECT_EQ(expected, count);
+}
+
+TEST(QDltMsgQueue, severalProducersAndConsumers) {
+    QDltMsgQueue queue(64);
+    const int producerCount = 4, consumerCount = 4, count = 20000;
+    std::atomic<long long> sum(0);
+    std::atomic<int> received(0);
+
+    std::vector<std::thread> consumers;
+    for (int num = 0; num < consumerCount; num++) {
+        consumers.emplace_back([&]() {
+            while (QDltMsgQueue::Slot* slot = queue.dequeue()) {
+                sum += slot->index;
+                received++;
+                queue.release(slot);
+            }
+        });
+    }
+
+    std::vector<std::thread> producers;
+    for (int num = 0; num < producerCount; num++) {
+        producers.emplace_back([&, num]() {
+            for (int index = num; index < count; index += producerCount) {
+                QDltMsgQueue::Slot* slot = queue.acquire();
+                slot->index = index;
+                queue.enqueue(slot);
+            }
+        });
+    }
+
+    for (std::thread& producer : producers)
+        producer.join();
+    queue.enqueueStopRequest();
+    for (std::thread& consumer : consumers)
+        consumer.join();
+
+    EXPECT_EQ(received, count);
+    EXPECT_EQ(sum, static_cast<long long>(count) * (count - 1) / 2);
+}
+
+TEST(QDltMsgQueue, stopRequest) {
+    QDltMsgQueue queue(2);
+
+    QDltMsgQueue::Slot* first = queue.acquire();
+    QDltMsgQueue::Slot* second = queue.acquire();
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    first->index = 1;
+    queue.enqueue(first);
+    EXPECT_EQ(queue.size(), 1);
+
+    // a producer waiting for a free slot is woken up
+    std::thread producer([&queue]() { EXPECT_EQ(queue.acquire(), nullptr); });
+    queue.enqueueStopRequest();
+    producer.join();
+
+    // remaining slots are still dequeued
+    QDltMsgQueue::Slot* slot = queue.dequeue();
+    ASSERT_EQ(slot, first);
+    EXPECT_EQ(slot->index, 1);
+    EXPECT_EQ(queue.dequeue(), nullptr);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <qdltmultipatternmatcher.h>
+
+#include <QRandomGenerator>
+
+namespace {
+
+QVector<bool> matchContains(const QStringList& patterns, const QVector<Qt::CaseSensitivity>& cs, const QString& text) {
+    QVector<bool> result;
+    for (int num = 0; num < patterns.size(); num++)
+        result.append(text.contains(patterns[num], cs[num]));
+    return result;
+}
+
+} // namespace
+
+TEST(QDltMultiPatternMatcher, overlappingPatterns) {
+    QDltMultiPatternMatcher matcher;
+    const int he = matcher.addPattern("he", Qt::CaseSensitive);
+    const int she = matcher.addPattern("she", Qt::CaseSensitive);
+    const int his = matcher.addPattern("his", Qt::CaseSensitive);
+    const int hers = matcher.addPattern("hers", Qt::CaseSensitive);
+    matcher.compile();
+    ASSERT_EQ(matcher.size(), 4);
+
+    QBitArray matches;
+    matcher.match("ushers", matches);
+    ASSERT_EQ(matches.size(), 4);
+    EXPECT_TRUE(matches.testBit(he));
+    EXPECT_TRUE(matches.testBit(she));
+    EXPECT_FALSE(matches.testBit(his));
+    EXPECT_TRUE(matches.testBit(hers));
+
+    matcher.match("this", matches);
+    EXPECT_FALSE(matches.testBit(he));
+    EXPECT_FALSE(matches.testBit(she));
+    EXPECT_TRUE(matches.testBit(his));
+    EXPECT_FALSE(matches.testBit(hers));
+}
+
+TEST(QDltMultiPatternMatcher, sameAndEmptyPatterns) {
+    QDltMultiPatternMatcher matcher;
+    const int text = matcher.addPattern("Text", Qt::CaseSensitive);
+    EXPECT_EQ(matcher.addPattern("Text", Qt::CaseSensitive), text);
+    const int folded = matcher.addPattern("TEXT", Qt::CaseInsensitive);
+    EXPECT_NE(folded, text);
+    EXPECT_EQ(matcher.addPattern("text", Qt::CaseInsensitive), folded);
+    const int empty = matcher.addPattern("", Qt::CaseSensitive);
+    EXPECT_EQ(matcher.addPattern(QString(), Qt::CaseInsensitive), empty);
+    matcher.compile();
+    EXPECT_EQ(matcher.size(), 3);
+
+    QBitArray matches;
+    matcher.match("some tExt", matches);
+    EXPECT_FALSE(matches.testBit(text));
+    EXPECT_TRUE(matches.testBit(folded));
+    EXPECT_TRUE(matches.testBit(empty));
+
+    // an empty text contains the empty pattern only
+    matcher.match(QString(), matches);
+    EXPECT_FALSE(matches.testBit(text));
+    EXPECT_FALSE(matches.testBit(folded));
+    EXPECT_TRUE(matches.testBit(empty));
+
+    matcher.clear();
+    EXPECT_EQ(matcher.size(), 0);
+    matcher.compile();
+    matcher.match("Text", matches);
+    EXPECT_EQ(matches.size(), 0);
+}
+
+TEST(QDltMultiPatternMatcher, caseFolding) {
+    // sharp s, final sigma, micro sign folding to greek mu and Kelvin sign folding to k
+    const QStringList patterns = {QString::fromUtf8("STRAßE"), QString::fromUtf8("ΣΟΦΟΣ"), QString::fromUtf8("µs"),
+                                  QString::fromUtf8("K"), "k"};
+    QDltMultiPatternMatcher matcher;
+    for (const QString& pattern : patterns)
+        ASSERT_GE(matcher.addPattern(pattern, Qt::CaseInsensitive), 0);
+    matcher.compile();
+
+    const QVector<Qt::CaseSensitivity> cs(patterns.size(), Qt::CaseInsensitive);
+    for (const char* text : {"straße", "σοφος and σοφοσ", "10 μS", "10 µs", "Kelvin", "K", "none"}) {
+        QBitArray matches;
+        matcher.match(QString::fromUtf8(text), matches);
+        const QVector<bool> expected = matchContains(patterns, cs, QString::fromUtf8(text));
+        for (int num = 0; num < patterns.size(); num++)
+            EXPECT_EQ(matches.testBit(num), expected[num]) << text << " " << patterns[num].toStdString();
+    }
+
+    // surrogate pairs are folded by QString::contains() as one character
+    EXPECT_EQ(matcher.addPattern(QString::fromUtf8("\U00010400"), Qt::CaseInsensitive), -1);
+    EXPECT_GE(matcher.addPattern(QString::fromUtf8("\U00010400"), Qt::CaseSensitive), 0);
+}
+
+TEST(QDltMultiPatternMatcher, sameResultAsContains) {
+    QRandomGenerator random(7);
+    const QString alphabet = QString::fromUtf8("abAB ßẞ0Ä");
+
+    auto randomText = [&](int maxLength) {
+        QString text;
+        const int length = random.bounded(maxLength + 1);
+        for (int num = 0; num < length; num++)
+            text.append(alphabet[random.bounded(alphabet.size())]);
+        return text;
+    };
+
+    for (int run = 0; run < 100; run++) {
+        QStringList patterns;
+        QVector<Qt::CaseSensitivity> cs;
+        QVector<int> ids;
+        QDltMultiPatternMatcher matcher;
+        const int count = random.bounded(1, 30);
+        for (int num = 0; num < count; num++) {
+            patterns.append(randomText(5));
+            cs.append(random.bounded(2) ? Qt::CaseSensitive : Qt::CaseInsensitive);
+            ids.append(matcher.addPattern(patterns.last(), cs.last()));
+        }
+        matcher.compile();
+
+        QBitArray matches;
+        for (int num = 0; num < 50; num++) {
+            const QString text = randomText(40);
+            matcher.match(text, matches);
+            const QVector<bool> expected = matchContains(patterns, cs, text);
+            for (int pattern = 0; pattern < patterns.size(); pattern++)
+                ASSERT_EQ(matches.testBit(ids[pattern]), expected[pattern])
+                    << "run " << run << " text " << text.toStdString() << " pattern " << patterns[pattern].toStdString();
+        }
+    }
+}
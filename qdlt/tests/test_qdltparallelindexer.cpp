@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include "testutils.h"
+
+#include <qdltmsg.h>
+#include <qdltparallelindexer.h>
+
+#include <QTemporaryFile>
+
+using testutils::createMessage;
+
+namespace {
+
+QVector<qint64> scanSequential(const QByteArray& file) {
+    QVector<qint64> index;
+    QDltStorageHeaderScanner scanner(file.size());
+    qint64 pos = 0;
+
+    while (!scanner.isFinished() && pos < file.size())
+        pos = scanner.scanBlock(file.constData() + pos, qMin<qint64>(1024, file.size() - pos), pos, index);
+
+    return index;
+}
+
+QVector<qint64> indexParallel(QTemporaryFile& tempFile, int threads, qint64 rangeSize) {
+    QDltParallelIndexer indexer(tempFile.fileName());
+    indexer.setThreadCount(threads);
+    indexer.setRangeSize(rangeSize);
+    indexer.setBlockSize(1024);
+
+    QVector<qint64> index;
+    EXPECT_TRUE(indexer.index(index));
+    return index;
+}
+
+} // namespace
+
+TEST(QDltParallelIndexer, identicalToSequentialScan) {
+    QByteArray file;
+    for (int num = 0; num < 2000; num++) {
+        // payloads with storage header patterns, so workers start on wrong headers
+        file += createMessage(QString("message %1 DLT\x01 DLT\x02 %2").arg(num).arg(QString(num % 30, 'D')));
+        // corrupt some messages to force resyncs
+        if (num % 97 == 0)
+            file.chop(3);
+        if (num % 131 == 0)
+            file += "DLT";
+    }
+
+    QTemporaryFile tempFile;
+    ASSERT_TRUE(tempFile.open());
+    tempFile.write(file);
+    tempFile.flush();
+
+    const QVector<qint64> expected = scanSequential(file);
+    ASSERT_GT(expected.size(), 1800);
+
+    for (int threads : {1, 2, 4, 8}) {
+        for (qint64 rangeSize : {1024, 1500, 4096, 100000}) {
+            EXPECT_EQ(indexParallel(tempFile, threads, rangeSize), expected)
+                << "threads " << threads << " range size " << rangeSize;
+        }
+    }
+}
+
+TEST(QDltParallelIndexer, joinBehindTheFirstMessagesOfARange) {
+    // the payload contains a chain of complete messages, workers starting inside it accept many of them
+    QByteArray chain;
+    for (int num = 0; num < 40; num++)
+        chain += createMessage(QString("inner %1").arg(num));
+
+    QByteArray file;
+    for (int num = 0; num < 300; num++) {
+        QDltMsg msg = testutils::createMsg({chain});
+        file += testutils::toBytes(msg);
+    }
+
+    QTemporaryFile tempFile;
+    ASSERT_TRUE(tempFile.open());
+    tempFile.write(file);
+    tempFile.flush();
+
+    const QVector<qint64> expected = scanSequential(file);
+    ASSERT_EQ(expected.size(), 300);
+
+    for (qint64 rangeSize : {1024, 5000, 100000}) {
+        EXPECT_EQ(indexParallel(tempFile, 4, rangeSize), expected) << "range size " << rangeSize;
+    }
+}
+
+TEST(QDltParallelIndexer, emptyFile) {
+    QTemporaryFile tempFile;
+    ASSERT_TRUE(tempFile.open());
+
+    EXPECT_TRUE(indexParallel(tempFile, 4, 1024).isEmpty());
+}
+
+TEST(QDltParallelIndexer, missingFile) {
+    QDltParallelIndexer indexer("does_not_exist.dlt");
+    QVector<qint64> index;
+
+    EXPECT_FALSE(indexer.index(index));
+    EXPECT_TRUE(index.isEmpty());
+}
+
+TEST(QDltParallelIndexer, startPosition) {
+    QByteArray file;
+    for (int num = 0; num < 2000; num++)
+        file += createMessage(QString("message %1").arg(num));
+
+    QTemporaryFile tempFile;
+    ASSERT_TRUE(tempFile.open());
+    tempFile.write(file);
+    tempFile.flush();
+
+    const QVector<qint64> expected = scanSequential(file);
+    ASSERT_EQ(expected.size(), 2000);
+
+    // continue indexing at a message, as done for files which have grown
+    for (int start : {0, 1, 999, 1999}) {
+        QDltParallelIndexer indexer(tempFile.fileName());
+        indexer.setThreadCount(4);
+        indexer.setRangeSize(1024);
+        indexer.setBlockSize(1024);
+        indexer.setStartPosition(expected[start]);
+
+        QVector<qint64> index;
+        ASSERT_TRUE(indexer.index(index));
+        EXPECT_EQ(index, expected.mid(start)) << "start " << start;
+    }
+
+    // nothing appended behind the start position
+    QDltParallelIndexer indexer(tempFile.fileName());
+    indexer.setStartPosition(file.size());
+    QVector<qint64> index;
+    EXPECT_TRUE(indexer.index(index));
+    EXPECT_TRUE(index.isEmpty());
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <qdltregexprefilter.h>
+
+#include <QRandomGenerator>
+
+TEST(QDltRegexPrefilter, extractLiterals) {
+    EXPECT_EQ(QDltRegexPrefilter::extractLiterals("connection", false), QStringList({"connection"}));
+    EXPECT_EQ(QDltRegexPrefilter::extractLiterals("error \\d+ in module", false), QStringList({" in module", "error "}));
+    EXPECT_EQ(QDltRegexPrefilter::extractLiterals("^value: (\\d+)ms$", false), QStringList({"value: ", "ms"}));
+    EXPECT_EQ(QDltRegexPrefilter::extractLiterals("colou?r", false), QStringList({"colo", "r"}));
+    EXPECT_EQ(QDltRegexPrefilter::extractLiterals("ab+c*d{2}e{0,3}f", false), QStringList({"ab", "d", "f"}));
+    EXPECT_EQ(QDltRegexPrefilter::extractLiterals("file\\.txt", false), QStringList({"file.txt"}));
+    EXPECT_EQ(QDltRegexPrefilter::extractLiterals("[a-z]+ id=[0-9a-f\\]]{4}", false), QStringList({" id="}));
+    EXPECT_EQ(QDltRegexPrefilter::extractLiterals("a.*?b", false), QStringList({"a", "b"}));
+    EXPECT_EQ(QDltRegexPrefilter::extractLiterals("tab\\there", false), QStringList({"tab\there"}));
+
+    // alternatives on the top level, optional groups and unsupported constructs have no literals
+    EXPECT_TRUE(QDltRegexPrefilter::extractLiterals("error|warning", false).isEmpty());
+    EXPECT_EQ(QDltRegexPrefilter::extractLiterals("(error|warning) found", false), QStringList({" found"}));
+    EXPECT_TRUE(QDltRegexPrefilter::extractLiterals("(?i)error", false).isEmpty());
+    EXPECT_TRUE(QDltRegexPrefilter::extractLiterals("(*ACCEPT)error", false).isEmpty());
+    EXPECT_TRUE(QDltRegexPrefilter::extractLiterals("\\Qa|b\\E", false).isEmpty());
+    EXPECT_TRUE(QDltRegexPrefilter::extractLiterals("(a)\\1", false).isEmpty());
+    EXPECT_TRUE(QDltRegexPrefilter::extractLiterals("\\x41BC", false).isEmpty());
+    EXPECT_TRUE(QDltRegexPrefilter::extractLiterals("a{,3}", false).isEmpty());
+    EXPECT_TRUE(QDltRegexPrefilter::extractLiterals("", false).isEmpty());
+
+    // case insensitive literals are ASCII only
+    EXPECT_EQ(QDltRegexPrefilter::extractLiterals(QString::fromUtf8("Straße \\d"), true), QStringList({"Stra", "e "}));
+}
+
+TEST(QDltRegexPrefilter, mayMatch) {
+    QRegularExpression regExp("temperature \\d+ (too high|too low)", QRegularExpression::CaseInsensitiveOption);
+    QDltRegexPrefilter prefilter;
+    prefilter.setRegularExpression(regExp);
+    EXPECT_EQ(prefilter.getLiterals(), QStringList({"temperature ", " "}));
+
+    EXPECT_TRUE(prefilter.mayMatch("TEMPERATURE 90 too high"));
+    EXPECT_TRUE(prefilter.mayMatch("temperature unknown"));
+    EXPECT_FALSE(prefilter.mayMatch("pressure 20 too low"));
+    EXPECT_FALSE(prefilter.mayMatch(QString()));
+    EXPECT_EQ(prefilter.getRejectedCount(), 2u);
+
+    QDltRegexPrefilter copy(prefilter);
+    EXPECT_EQ(copy.getRejectedCount(), 2u);
+    EXPECT_FALSE(copy.mayMatch("pressure"));
+
+    // no literals, every text is a candidate
+    prefilter.setRegularExpression(QRegularExpression("a|b"));
+    EXPECT_EQ(prefilter.getRejectedCount(), 0u);
+    EXPECT_TRUE(prefilter.mayMatch("c"));
+    prefilter.setRegularExpression(QRegularExpression("invalid("));
+    EXPECT_TRUE(prefilter.getLiterals().isEmpty());
+}
+
+TEST(QDltRegexPrefilter, sameResultAsRegularExpression) {
+    QRandomGenerator random(3);
+    const QStringList atoms = {"a", "b", "K", "k", "\\.", ".", "\\d", "[ab]", "(a|b)", "x", "?", "*", "+", "{2}", "{0,1}", "^", "$", " "};
+    // Kelvin sign matches k case insensitive
+    const QString characters = QString("abkK. 1x") + QChar(0x212A);
+
+    for (int run = 0; run < 300; run++) {
+        QString pattern;
+        const int count = random.bounded(1, 8);
+        for (int num = 0; num < count; num++)
+            pattern += atoms[random.bounded(atoms.size())];
+
+        const bool caseInsensitive = random.bounded(2) == 0;
+        const QRegularExpression regExp(pattern, caseInsensitive ? QRegularExpression::CaseInsensitiveOption
+                                                                 : QRegularExpression::NoPatternOption);
+        if (!regExp.isValid())
+            continue;
+        QDltRegexPrefilter prefilter;
+        prefilter.setRegularExpression(regExp);
+
+        // a text matching the regular expression is never rejected
+        for (int num = 0; num < 100; num++) {
+            QString text;
+            const int length = random.bounded(12);
+            for (int pos = 0; pos < length; pos++)
+                text.append(characters[random.bounded(characters.size())]);
+            if (regExp.match(text).hasMatch())
+                ASSERT_TRUE(prefilter.mayMatch(text)) << pattern.toStdString() << " " << text.toStdString();
+        }
+    }
+}
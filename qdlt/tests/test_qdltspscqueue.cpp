@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <qdltspscqueue.hpp>
+
+#include <QByteArray>
+
+#include <thread>
+
+TEST(QDltSpscQueue, capacityIsPowerOfTwo) {
+    QDltSpscQueue<int> queue(100);
+    EXPECT_EQ(queue.capacity(), 128u);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(QDltSpscQueue, pushUntilFull) {
+    QDltSpscQueue<int> queue(4);
+    int value = 0;
+
+    for (int num = 0; num < 4; num++)
+        EXPECT_TRUE(queue.push(num));
+    EXPECT_FALSE(queue.push(4));
+    EXPECT_EQ(queue.size(), 4u);
+
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.push(4));
+
+    for (int num = 1; num <= 4; num++) {
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, num);
+    }
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(QDltSpscQueue, valuesAreMoved) {
+    QDltSpscQueue<QByteArray> queue(2);
+    QByteArray data("message");
+    QByteArray value;
+
+    ASSERT_TRUE(queue.push(std::move(data)));
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, QByteArray("message"));
+}
+
+TEST(QDltSpscQueue, valuesArePassedInOrderBetweenThreads) {
+    QDltSpscQueue<int> queue(64);
+    const int count = 1000000;
+
+    std::thread producer([&queue]() {
+        for (int num = 0; num < count; num++) {
+            while (!queue.push(num))
+                std::this_thread::yield();
+        }
+    });
+
+    int expected = 0;
+    int value;
+    while (expected < count) {
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(value, expected);
+        expected++;
+    }
+    producer.join();
+
+    EXPECT_TRUE(queue.isEmpty());
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include "testutils.h"
+
+#include <qdltmsg.h>
+#include <qdltstorageheaderscanner.h>
+
+using testutils::createMessage;
+
+namespace {
+
+QVector<qint64> scanFile(const QByteArray& file, qint64 blockSize, qint64* errors = nullptr) {
+    QVector<qint64> index;
+    QDltStorageHeaderScanner scanner(file.size());
+    qint64 pos = 0;
+
+    while (!scanner.isFinished() && pos < file.size()) {
+        const qint64 length = qMin(blockSize, file.size() - pos);
+        pos = scanner.scanBlock(file.constData() + pos, length, pos, index);
+    }
+    if (errors)
+        *errors = scanner.getErrors();
+
+    return index;
+}
+
+} // namespace
+
+TEST(QDltStorageHeaderScanner, findPatternAllScanModes) {
+    const QDltStorageHeaderScanner::ScanMode bestMode = QDltStorageHeaderScanner::getScanMode();
+
+    QByteArray data(200, 'x');
+    data.replace(3, 3, "DLT");       // no version byte
+    data.replace(70, 4, "DLT\x02");  // storage header version 2
+    data.replace(196, 4, "DLT\x01"); // at the very end of the buffer
+
+    for (auto mode : {QDltStorageHeaderScanner::ScanModeScalar, QDltStorageHeaderScanner::ScanModeSse2,
+                      QDltStorageHeaderScanner::ScanModeAvx2}) {
+        if (!QDltStorageHeaderScanner::setScanMode(mode))
+            continue;
+
+        for (int offset = 0; offset <= 196; offset++) {
+            const qint64 expected = (offset <= 70) ? 70 - offset : 196 - offset;
+            EXPECT_EQ(QDltStorageHeaderScanner::findPattern(data.constData() + offset, data.size() - offset), expected);
+        }
+        EXPECT_EQ(QDltStorageHeaderScanner::findPattern(data.constData() + 197, 3), -1);
+    }
+
+    QDltStorageHeaderScanner::setScanMode(bestMode);
+}
+
+TEST(QDltStorageHeaderScanner, indexAllMessages) {
+    QByteArray file;
+    QVector<qint64> expected;
+    for (int num = 0; num < 500; num++) {
+        expected.append(file.size());
+        // payload containing a storage header pattern must not be indexed
+        file += createMessage(QString("message %1 DLT\x01 %2").arg(num).arg(QString(num % 50, 'D')));
+    }
+
+    // messages continued in the next block are skipped too, their payload is no error
+    for (qint64 blockSize : {300, 301, 1024, 4096, 1024 * 1024}) {
+        qint64 errors = -1;
+        EXPECT_EQ(scanFile(file, blockSize, &errors), expected) << "block size " << blockSize;
+        EXPECT_EQ(errors, 0) << "block size " << blockSize;
+    }
+}
+
+TEST(QDltStorageHeaderScanner, resyncAfterCorruption) {
+    const QByteArray message = createMessage("resync");
+    QByteArray file = "garbage" + message + message;
+    file += message.left(message.size() - 3) + message + message;
+
+    qint64 errors = 0;
+    const QVector<qint64> index = scanFile(file, 1024 * 1024, &errors);
+
+    // the truncated message is dropped, the message after it is found again
+    const qint64 resynced = 7 + 3 * message.size() - 3;
+    ASSERT_EQ(index.size(), 4);
+    EXPECT_EQ(index[0], 7);
+    EXPECT_EQ(index[1], 7 + message.size());
+    EXPECT_EQ(index[2], resynced);
+    EXPECT_EQ(index[3], resynced + message.size());
+    EXPECT_GT(errors, 0);
+}
+
+TEST(QDltStorageHeaderScanner, syncPointsThroughoutTheFile) {
+    QByteArray file;
+    QVector<qint64> positions;
+    for (int num = 0; num < 20; num++) {
+        positions.append(file.size());
+        file += createMessage(QString("message %1").arg(num));
+    }
+
+    QVector<qint64> index;
+    QDltStorageHeaderScanner scanner(file.size());
+    scanner.setSyncPointLimit(2);
+    scanner.setSyncPointInterval(3);
+    scanner.scanBlock(file.constData(), file.size(), 0, index);
+    ASSERT_TRUE(scanner.isFinished());
+
+    // the first messages, then every third message
+    QVector<qint64> syncPoints;
+    for (const QDltStorageHeaderScanner::SyncPoint& syncPoint : scanner.getSyncPoints()) {
+        EXPECT_EQ(index.indexOf(syncPoint.pos), syncPoint.indexSize);
+        syncPoints.append(syncPoint.pos);
+    }
+    EXPECT_EQ(syncPoints, QVector<qint64>({positions[0], positions[1], positions[4], positions[7], positions[10],
+                                           positions[13], positions[16], positions[19]}));
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <qdlttextblockindex.h>
+
+#include <QFile>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+
+namespace {
+
+QString payloadText(int num) {
+    return QString("connection %1 of service %2 changed state").arg(num).arg(num % 7);
+}
+
+} // namespace
+
+TEST(QDltTextBlockIndex, appendAndQuery) {
+    QDltTextBlockIndex textBlocks;
+    for (int num = 0; num < 3 * QDLT_TEXT_BLOCK_SIZE; num++) {
+        // a rare text in the second block only
+        const QString payload = (num == QDLT_TEXT_BLOCK_SIZE + 10) ? QString("Watchdog Timeout") : payloadText(num);
+        textBlocks.append("ECU1 APP1 CON1", payload);
+    }
+    ASSERT_EQ(textBlocks.size(), 3 * QDLT_TEXT_BLOCK_SIZE);
+    ASSERT_EQ(textBlocks.blockCount(), 3);
+
+    // literals are checked case insensitive
+    const QDltTextBlockIndex::Query query = QDltTextBlockIndex::query({"watchdog timeout"});
+    EXPECT_FALSE(textBlocks.mayContain(0, query));
+    EXPECT_TRUE(textBlocks.mayContain(QDLT_TEXT_BLOCK_SIZE, query));
+    EXPECT_TRUE(textBlocks.mayContain(2 * QDLT_TEXT_BLOCK_SIZE - 1, query));
+    EXPECT_FALSE(textBlocks.mayContain(2 * QDLT_TEXT_BLOCK_SIZE, query));
+
+    // header and payload text are indexed, all literals must be contained
+    EXPECT_TRUE(textBlocks.mayContain(0, QDltTextBlockIndex::query({"app1", "changed state"})));
+    EXPECT_FALSE(textBlocks.mayContain(0, QDltTextBlockIndex::query({"app1", "watchdog"})));
+
+    // short literals and messages which are not indexed are always searched
+    EXPECT_TRUE(QDltTextBlockIndex::query({"xy", ""}).isEmpty());
+    EXPECT_TRUE(textBlocks.mayContain(0, QDltTextBlockIndex::query({"xy"})));
+    EXPECT_TRUE(textBlocks.mayContain(3 * QDLT_TEXT_BLOCK_SIZE, query));
+}
+
+TEST(QDltTextBlockIndex, invalidMessagesAlwaysSearched) {
+    QDltTextBlockIndex textBlocks;
+    for (int num = 0; num < 2 * QDLT_TEXT_BLOCK_SIZE; num++) {
+        if (num == 5)
+            textBlocks.appendInvalid();
+        else
+            textBlocks.append(QString(), payloadText(num));
+    }
+
+    const QDltTextBlockIndex::Query query = QDltTextBlockIndex::query({"watchdog"});
+    EXPECT_TRUE(textBlocks.mayContain(0, query));
+    EXPECT_FALSE(textBlocks.mayContain(QDLT_TEXT_BLOCK_SIZE, query));
+}
+
+TEST(QDltTextBlockIndex, neverSkipsContainedText) {
+    QRandomGenerator random(7);
+    const QString characters = QString("abcABC 12") + QChar(0x00e4) + QChar(0x00c4) + QChar(0xd83d) + QChar(0xde00);
+
+    auto randomText = [&](int length) {
+        QString text;
+        for (int pos = 0; pos < length; pos++)
+            text.append(characters[random.bounded(characters.size())]);
+        return text;
+    };
+
+    QDltTextBlockIndex textBlocks;
+    QStringList texts;
+    for (int num = 0; num < 2 * QDLT_TEXT_BLOCK_SIZE; num++) {
+        texts.append(randomText(random.bounded(20)));
+        textBlocks.append(QString(), texts.last());
+    }
+
+    // a literal contained in a message, case insensitive, never skips the block of the message
+    for (int run = 0; run < 1000; run++) {
+        const int num = random.bounded(texts.size());
+        const QString &text = texts[num];
+        if (text.size() < 3)
+            continue;
+        const int pos = random.bounded(text.size() - 2);
+        QString literal = text.mid(pos, random.bounded(3, text.size() - pos + 1));
+        literal = random.bounded(2) ? literal.toUpper() : literal.toLower();
+        if (!text.contains(literal, Qt::CaseInsensitive))
+            continue;
+        ASSERT_TRUE(textBlocks.mayContain(num, QDltTextBlockIndex::query({literal}))) << literal.toStdString();
+    }
+}
+
+TEST(QDltTextBlockIndex, saveAndLoad) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filename = dir.filePath("test.dtb");
+
+    QDltTextBlockIndex textBlocks;
+    textBlocks.setRenderKey("render key");
+    for (int num = 0; num < QDLT_TEXT_BLOCK_SIZE + 100; num++)
+        textBlocks.append("header", payloadText(num));
+    textBlocks.appendInvalid();
+    ASSERT_TRUE(textBlocks.save(filename, "key"));
+
+    QDltTextBlockIndex loaded;
+    ASSERT_TRUE(loaded.load(filename, "key"));
+    EXPECT_EQ(loaded.size(), textBlocks.size());
+    EXPECT_EQ(loaded.blockCount(), 2);
+    EXPECT_EQ(loaded.getRenderKey(), QByteArray("render key"));
+    const QDltTextBlockIndex::Query query = QDltTextBlockIndex::query({"watchdog"});
+    EXPECT_FALSE(loaded.mayContain(0, query));
+    EXPECT_TRUE(loaded.mayContain(QDLT_TEXT_BLOCK_SIZE, query));
+
+    // appending after loading continues the last block
+    loaded.append("header", "watchdog");
+    EXPECT_EQ(loaded.size(), textBlocks.size() + 1);
+    EXPECT_EQ(loaded.blockCount(), 2);
+
+    // created for another file
+    EXPECT_FALSE(loaded.load(filename, "other key"));
+    EXPECT_EQ(loaded.size(), 0);
+
+    // corrupt file
+    QFile file(filename);
+    ASSERT_TRUE(file.open(QFile::ReadWrite));
+    file.seek(100);
+    file.write("x");
+    file.close();
+    EXPECT_FALSE(loaded.load(filename, "key"));
+}
@@ -0,0 +1,55 @@
+#ifndef TESTUTILS_H
+#define TESTUTILS_H
+
+#include <qdltmsg.h>
+
+#include <QByteArray>
+#include <QString>
+#include <QVariant>
+
+// DLT messages shared by the tests and benchmarks
+namespace testutils {
+
+// a verbose info log message of ECU1, APP and CTX with one argument per value
+inline QDltMsg createMsg(const QVariantList& values) {
+    QDltMsg msg;
+    msg.setEcuid("ECU1");
+    msg.setApid("APP");
+    msg.setCtid("CTX");
+    msg.setType(QDltMsg::DltTypeLog);
+    msg.setSubtype(QDltMsg::DltLogInfo);
+    msg.setMode(QDltMsg::DltModeVerbose);
+
+    for (const QVariant& value : values) {
+        QDltArgument arg;
+        arg.setValue(value);
+        msg.addArgument(arg);
+    }
+    msg.setNumberOfArguments(static_cast<unsigned char>(values.size()));
+
+    return msg;
+}
+
+// the message with storage header as in a DLT file, or without as sent by the DLT daemon
+inline QByteArray toBytes(QDltMsg& msg, bool withStorageHeader = true) {
+    QByteArray buf;
+    msg.getMsg(buf, withStorageHeader);
+    return buf;
+}
+
+// a message with one text argument
+inline QByteArray createMessage(const QString& text, bool withStorageHeader = true) {
+    QDltMsg msg = createMsg({text});
+    return toBytes(msg, withStorageHeader);
+}
+
+// the message parsed again, as done when reading it from a file
+inline QDltMsg parsed(QDltMsg& msg) {
+    QDltMsg result;
+    result.setMsg(toBytes(msg), true);
+    return result;
+}
+
+} // namespace testutils
+
+#endif // TESTUTILS_H
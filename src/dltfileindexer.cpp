@@ -10,8 +10,20 @@
 #include <QMutexLocker>
 #include <QDir>
 #include <QFileInfo>
+#include <QtEndian>
+#include <QTimeZone>
 
 #include "qdltoptmanager.h"
+#include "qdltsettingsmanager.h"
+#include "qdltparallelindexer.h"
+#include "qdltindexfile.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 extern "C" {
     #include "dlt_common.h"
@@ -54,6 +66,10 @@ DltFileIndexer::DltFileIndexer(QObject *parent) :
     msecsFilterCounter = 0;
     msecsDefaultFilterCounter = 0;
 
+    textBlockIndexEnabled = false;
+    fullTextIndexEnabled = false;
+    fullTextPass = false;
+
     filterIndexEnabled = false;
     filterIndexStart = 0;
     filterIndexEnd = 0;
@@ -81,6 +97,10 @@ DltFileIndexer::DltFileIndexer(QDltFile *dltFile, QDltPluginManager *pluginManag
     msecsFilterCounter = 0;
     msecsDefaultFilterCounter = 0;
 
+    textBlockIndexEnabled = false;
+    fullTextIndexEnabled = false;
+    fullTextPass = false;
+
     filterIndexEnabled = false;
     filterIndexStart = 0;
     filterIndexEnd = 0;
@@ -90,69 +110,85 @@ DltFileIndexer::~DltFileIndexer()
 {
 }
 
-bool DltFileIndexer::index(int num)
+bool DltFileIndexer::index()
 {
-    // start performance counter
-    //QTime time(0,0,0,0);
-    // time.start();
-
-    // load filter index if enabled
-    if(filterCacheEnabled && loadIndexCache(dltFile->getFileName(num)))
-    {
-        // loading index from filter is successful
-        qDebug() << "Successfully loaded index cache for file" << dltFile->getFileName(num);// << __LINE__;
-        return true;
-    }
-
-    // prepare indexing
-    QFile f(dltFile->getFileName(num));
-
-    // open file
-    if(!f.open(QIODevice::ReadOnly))
+    QList<int> files;
+    QList<QDltParallelIndexer*> indexers;
+    QVector<QVector<qint64> > indexes(dltFile->getNumberOfFiles());
+    QVector<qint64> startPositions(dltFile->getNumberOfFiles(),0);
+    QVector<qint64> cachedErrors(dltFile->getNumberOfFiles(),0);
+    QVector<QDltMetadataIndex> metadataIndexes(dltFile->getNumberOfFiles());
+    QVector<QDltTextBlockIndex> textBlockIndexes(dltFile->getNumberOfFiles());
+    QVector<QDltFullTextIndex> fullTextIndexes(dltFile->getNumberOfFiles());
+    qint64 totalSize = 0;
+    bool success = true;
+
+    errors_in_file = 0;
+
+    for(int num=0;num<dltFile->getNumberOfFiles();num++)
     {
-        qWarning() << "Cannot open file in DltFileIndexer " << f.errorString();
-        return false;
-    }
+        qint64 indexedSize = 0;
 
-    // clear old index
-    indexAllList.clear();
+        // load index cache if enabled
+        if(filterCacheEnabled && loadIndexCache(dltFile->getFileName(num),indexes[num],indexedSize,cachedErrors[num]))
+        {
+            if(QFileInfo(dltFile->getFileName(num)).size() == indexedSize)
+            {
+                // loading index from filter is successful
+                qDebug() << "Successfully loaded index cache for file" << dltFile->getFileName(num);// << __LINE__;
+                errors_in_file += cachedErrors[num];
+                // the metadata index is only valid for a completely cached index
+                if(loadMetadataCache(dltFile->getFileName(num),metadataIndexes[num]) && metadataIndexes[num].size() == indexes[num].size())
+                    qDebug() << "Loaded metadata index cache for file" << dltFile->getFileName(num);
+                else
+                    metadataIndexes[num].clear();
+                if(textBlockIndexEnabled && loadTextBlockCache(dltFile->getFileName(num),textBlockIndexes[num]) && textBlockIndexes[num].size() == indexes[num].size())
+                    qDebug() << "Loaded text block index cache for file" << dltFile->getFileName(num);
+                else
+                    textBlockIndexes[num].clear();
+                if(fullTextIndexEnabled && loadFullTextCache(dltFile->getFileName(num),fullTextIndexes[num]) && fullTextIndexes[num].size() == indexes[num].size())
+                    qDebug() << "Loaded full text index cache for file" << dltFile->getFileName(num);
+                else
+                    fullTextIndexes[num].clear();
+                continue;
+            }
 
-    // check if file is empty
-    if(f.size() <= 0)
-    {
-        // No need to do anything here.
-        f.close();
-        qWarning() << "File" << dltFile->getFileName(num) << "is empty";
-        return true; // because it is just empty, not an error ...
+            // the file has grown, index only the appended data
+            // the last message is indexed again, as it was only accepted because it ended at the end of the file
+            if(!indexes[num].isEmpty())
+                startPositions[num] = indexes[num].takeLast();
+            qDebug() << "Extend index cache for file" << dltFile->getFileName(num) << "from position" << startPositions[num];
+        }
+        else
+        {
+            indexes[num].clear();
+            cachedErrors[num] = 0;
+        }
+        files.append(num);
     }
 
-    int modulo = f.size()/200; // seems to be the propper ratio ...
-    if (modulo == 0) // avoid divison by zero ( very small files )
+    // index all remaining files at the same time, the cores are shared between them
+    const int threadCount = qMax(1, QThread::idealThreadCount() / qMax(1, static_cast<int>(files.size())));
+    for(int num : files)
     {
-         modulo = 1;
+        QDltParallelIndexer *indexer = new QDltParallelIndexer(dltFile->getFileName(num));
+        indexer->setThreadCount(threadCount);
+        indexer->setBlockSize(DLT_FILE_INDEXER_SEG_SIZE);
+        indexer->setStartPosition(startPositions[num]);
+        indexers.append(indexer);
+
+        qDebug() << "Start creating indexfile for" << dltFile->getFileName(num);
+        if(!indexer->start())
+        {
+            qWarning() << "Cannot open file in DltFileIndexer" << dltFile->getFileName(num);
+            success = false;
+            break;
+        }
+        if(indexer->getFileSize() <= 0)
+            qWarning() << "File" << dltFile->getFileName(num) << "is empty";
+        totalSize += indexer->getBytesToScan();
     }
 
-    qDebug() << "Start creating indexfile for" << dltFile->getFileName(num);
-
-    // Go through the segments and create new index
-    char lastFound = 0;
-    qint64 length = 0;
-    qint64 msgindex = 0;
-    qint64 pos = 0;
-    qint64 abspos = 0;
-    qint64 current_message_pos = 0;
-    qint64 next_message_pos = 0;
-    qint64 counter_header = 0;
-    qint64 message_length = 0;
-    qint64 readresult = 0;
-    qint64 file_size = f.size();
-    qint64 number=0;
-    quint8 version=1;
-    qint64 lengthOffset=2;
-    qint64 storageLength=0;
-    errors_in_file  = 0;
-    char *data = new char[DLT_FILE_INDEXER_SEG_SIZE];
-
     // Initialise progress bar
     emit(progressText(QString("CI %1/%2").arg(currentRun).arg(maxRun)));
     emit(progressMax(100));
@@ -160,221 +196,95 @@ bool DltFileIndexer::index(int num)
 
     unsigned int progressCounter = 1;
     unsigned int percent = 0;
-    unsigned long fileSize = f.size();
 
     qDebug() << "Create index: Start";
-    do
+    for(int num=0;success && num<indexers.size();num++)
     {
-        pos = f.pos();
-        readresult =f.read(data,DLT_FILE_INDEXER_SEG_SIZE);
-        if (length >= 0)
+        // wait for the indexers in the order of the files and update progress in the meantime
+        while(!indexers[num]->wait(100))
         {
-           length = readresult;
-        }
-        else
-        {
-            qDebug() << "Error reading input file" << f.fileName() << __LINE__;
-            f.close();
-            return false;
-        }
-
-        for(number=0;number < length;number++)
-        {
-            abspos= pos+number;
-            // search length of DLT message
-            if(counter_header>0)
-            {
-                counter_header++;
-                if(storageLength==13 && counter_header==13)
-                {
-                    storageLength += ((unsigned char)data[number]) + 1;
-                }
-                else if (counter_header==storageLength)
-                {
-                    // Read DLT protocol version
-                    version = (((unsigned char)data[number])&0xe0)>>5;
-                    if(version==1)
-                    {
-                        lengthOffset = 2;
-                    }
-                    else if(version==2)
-                    {
-                        lengthOffset = 5;
-                    }
-                    else
-                    {
-                        lengthOffset = 2;  // default
-                    }
-                }
-                else if (counter_header==storageLength+lengthOffset) // was 16
-                {
-                    // Read low byte of message length
-                    message_length = (unsigned char)data[number];
-                }
-                else if (counter_header==storageLength+1+lengthOffset) // was 17
-                {
-                    // Read high byte of message length
-                    counter_header = 0;
-                    message_length = (message_length<<8 | ((unsigned char)data[number])) + storageLength;
-                    next_message_pos = current_message_pos + message_length;
-                    if(next_message_pos==file_size)
-                    {
-                        // last message found in file
-                        indexAllList.append(current_message_pos);
-                        break;
-                    }
-                    // speed up move directly to next message, if inside current buffer
-                    if((message_length > (storageLength+2+lengthOffset))) // was 20
-                    {
-                        if((number+message_length-(storageLength+2+lengthOffset)<length))  // was 20
-                        {
-                            number+=message_length-(storageLength+2+lengthOffset);  // was 20
-                        }
-                    }
-                }
-            }
-            // find DLT Header
-            else if(data[number] == 'D')
-            {
-                lastFound = 'D';
-            }
-            else if(lastFound == 'D' && data[number] == 'L')
-            {
-                lastFound = 'L';
-            }
-            else if(lastFound == 'L' && data[number] == 'T')
-            {
-                lastFound = 'T';
-            }
-            else if(lastFound == 'T' && (data[number] == 0x01 || data[number] == 0x02))
-            {
-                if(next_message_pos == 0)
-                {
-                    // very first message detected or the first message after an error occurred
-                    current_message_pos = pos+number-3;
-                    counter_header = 3;
-                    if(data[number] == 0x01)
-                        storageLength = 16;
-                    else
-                        storageLength = 13;
-                    if(current_message_pos!=0)
-                    {
-                        // first messages not at beginning or error occurred before
-                        errors_in_file++;
-                        qDebug() << "ERROR in file" << dltFile->getFileName(num) << "detected new start sequence at index" << msgindex << "msg length" << message_length << "file position" << current_message_pos;
-                        qDebug() << "------------";
-                    }
-                    // speed up and move directly to message length, if it is still inside of the current buffer
-                    if(number+9<length)
-                    {
-                        number+=9;
-                        counter_header+=9;
-                    }
-                }
-                else if( next_message_pos == (pos+number-3) )
-                {
-                    // Add message only when it is in the correct position in relationship to the last message
-                    indexAllList.append(current_message_pos);
-                    msgindex++;
-                    current_message_pos = pos+number-3;
-                    counter_header = 3;
-                    if(data[number] == 0x01)
-                        storageLength = 16;
-                    else
-                        storageLength = 13;
-                    // speed up move directly to message length, if inside current buffer
-                    //if ( (errors_in_file > 0)  &&  ((pos%1000)) )    qDebug() << "Add index "<< msgindex << "at file position" << current_message_pos << pos << number << length;
-
-                    if(number+9 < length)
-                    {
-                        number+=9;
-                        counter_header+=9;
-                    }
-                }
-                else if(next_message_pos > (pos+number-3))
-                {
-                    // Header detected before end of message
-                     qDebug() << "ERROR: Header detected before end of message at index "<< msgindex << "msg length" << message_length << "at file position" << current_message_pos;
-                     errors_in_file++;
-                }
-                else //if(next_message_pos < (pos+number-3))
-                {
-                    // Header detected after end of message
-                    // start search for new message back after last header found
-                    qDebug() << "At index file:" << ( pos *100 )/file_size << "% -" << "Header detected after end of message, offset:" << (pos+number-3) - next_message_pos << "bytes";
-                    f.seek(current_message_pos+4);
-                    pos = current_message_pos+4;
-                    length = f.read(data,DLT_FILE_INDEXER_SEG_SIZE);
-                    number=0;
-                    next_message_pos = 0;
-                }
-                lastFound = 0;
-            }
-            else
-            {
-                lastFound = 0; // no hit, so just go on with search for the startsequence
-                //qDebug() << "DLT recived but not the stop sign 0x01" << msgindex;
-            }
-
-
             /* stop if requested */
             if(true == stopFlag)
             {
                 qDebug().noquote() << "Request stoping indexing received" << __LINE__ << __FILE__;
-                emit(progress((abspos)));
-                delete[] data;
-                f.close();
-                return false;
+                success = false;
+                break;
             }
 
-            if(fileSize)
-                percent = (f.pos()*100)/fileSize;
+            qint64 bytesScanned = 0;
+            for(QDltParallelIndexer *indexer : indexers)
+                bytesScanned += indexer->getBytesScanned();
+            if(totalSize > 0)
+                percent = (bytesScanned*100)/totalSize;
 
             if(percent>=progressCounter)
             {
-                progressCounter += 1;
+                progressCounter = percent + 1;
                 emit(progress(percent));
                 if((percent>0) && ((percent%10)==0))
                     qDebug() << "CI:" << percent << "%";
             }
-
-        } // end of for loop to read within one segment accross "number"
+        }
     }
-    while(length>0); // overall "do loop"
     qDebug() << "Create index: Finish";
 
-    if ( errors_in_file != 0 )
+    for(int num=0;success && num<indexers.size();num++)
     {
-    qDebug() << "Indexing error:" << errors_in_file << "wrong DLT message headers found during indexing" << msgindex << "messages";
-    }
+        QDltParallelIndexer *indexer = indexers[num];
+        const int fileNum = files[num];
 
-    if ( file_size > 0 )
-    {
-     qDebug().noquote() << "Created" << ( pos *100 )/file_size << "% index for file" << dltFile->getFileName(num);
-    }
+        if(!indexer->isSuccessful())
+        {
+            qDebug() << "Error reading input file" << indexer->getFileName() << __LINE__;
+            success = false;
+            break;
+        }
 
-    // write index if enabled
-    if(filterCacheEnabled)
-    {
-        saveIndexCache(dltFile->getFileName(num));
-        qDebug() << "Saved index cache for file" << dltFile->getFileName(num);
+        // append to the index loaded from cache, if only the appended data was indexed
+        indexes[fileNum] += indexer->takeIndex();
+        const qint64 errors = cachedErrors[fileNum] + indexer->getErrors();
+        errors_in_file += errors;
+        if ( errors != 0 )
+        {
+        qDebug() << "Indexing error:" << errors << "wrong DLT message headers found during indexing" << indexes[fileNum].size() << "messages";
+        }
+        qDebug().noquote() << "Created index for file" << dltFile->getFileName(fileNum);
+
+        // write index if enabled
+        if(filterCacheEnabled)
+        {
+            saveIndexCache(dltFile->getFileName(fileNum),indexes[fileNum],indexer->getFileSize(),errors);
+            qDebug() << "Saved index cache for file" << dltFile->getFileName(fileNum);
+        }
     }
-    emit(progress(pos));
 
-    // delete buffer
-    delete[] data;
+    // stop and delete indexers, stopped indexers are waited for in the destructor
+    for(QDltParallelIndexer *indexer : indexers)
+        indexer->stop();
+    qDeleteAll(indexers);
 
-    // close file
-    f.close();
+    if(!success)
+        return false;
 
-    //qDebug() << "Duration:" << time.elapsed()/1000 << __LINE__;
+    emit(progress(100));
+
+    for(int num=0;num<indexes.size();num++)
+    {
+        dltFile->setDltIndex(indexes[num],num);
+        dltFile->setMetadataIndex(metadataIndexes[num],num);
+        dltFile->setTextBlockIndex(textBlockIndexes[num],num);
+        dltFile->setFullTextIndex(fullTextIndexes[num],num);
+        currentRun++;
+    }
+    if(!indexes.isEmpty())
+        indexAllList = indexes.last();
 
     return true;
 }
 
 bool DltFileIndexer::indexFilter(QStringList filenames)
 {
-    QSharedPointer<QDltMsg> msg;
+    QDltMsg msg;
     QDltFilterList filterList;
     quint64 ix = 0;
     unsigned int iPercent = 0;
@@ -426,6 +336,36 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
         return true;
     }
 
+    // filters checking only header fields are checked against the metadata index, without reading the messages
+    if(mode == modeFilter && !(pluginsEnabled && !activeDecoderPlugins.isEmpty()) &&
+       filterList.isMetadataFilter() && dltFile->hasMetadataIndex())
+    {
+        return indexFilterMetadata(filterList,start,end,filenames);
+    }
+
+    // create the metadata index while all messages are parsed anyway
+    QDltMetadataIndex metadataIndex;
+    const bool createMetadataIndex = (mode == modeIndexAndFilter) && (start == 0) && (end == static_cast<quint64>(dltFile->size())) && !dltFile->hasMetadataIndex();
+    if(createMetadataIndex)
+        metadataIndex.reserve(dltFile->size());
+
+    // create the text block index of each file, the text is rendered as the search renders it
+    QVector<QDltTextBlockIndex> textBlockIndexes;
+    const QByteArray renderKey = textRenderKey(pluginsEnabled,activeDecoderPlugins);
+    const bool createTextIndex = (mode == modeIndexAndFilter) && (start == 0) && (end == static_cast<quint64>(dltFile->size()));
+    const bool createTextBlockIndex = createTextIndex && textBlockIndexEnabled && !dltFile->hasTextBlockIndex(renderKey);
+    const bool msgIdEnabled = QDltSettingsManager::getInstance()->value("startup/showMsgId", true).toBool();
+    const QByteArray msgIdFormat = QDltSettingsManager::getInstance()->value("startup/msgIdFormat", "0x%x").toString().toUtf8();
+    int textIndexFile = 0;
+    quint64 textIndexFileEnd = dltFile->getFileMsgNumber(0);
+    QString payloadText;
+    if(createTextBlockIndex)
+    {
+        textBlockIndexes.resize(dltFile->getNumberOfFiles());
+        for(QDltTextBlockIndex &textBlocks : textBlockIndexes)
+            textBlocks.setRenderKey(renderKey);
+    }
+
     // Initialise progress bar
     emit(progressText(QString("CFI %1/%2").arg(currentRun).arg(maxRun)));
     emit(progressMax(100));
@@ -464,43 +404,81 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
     unsigned int progressCounter = 1;
     emit progress(0);
 
-    // Start reading messages
-    for(ix=start;ix<end;ix++)
+    // when only filtering, the arguments are only parsed if needed by decoder plugins or filters
+    const bool lazyArguments = (mode == modeFilter) && !createMetadataIndex;
+
+    // when only filtering, the messages are independent of each other and filtered by several threads
+    // viewer plugins and the metadata index need the messages in order, when the file is loaded
+    const bool parallel = multithreaded && (mode == modeFilter) && !createMetadataIndex &&
+                          (end-start) >= 2*DLT_FILE_INDEXER_FILTER_RANGE_SIZE && QThread::idealThreadCount() > 1;
+    if(parallel)
     {
-        msg = QSharedPointer<QDltMsg>::create(); // create new instance to be filled by getMsg(), otherwise shared pointer would be empty or pointing to last message
+        if(!indexFilterParallel(filterList,start,end,silentMode,lazyArguments))
+            return false;
+    }
+    else
+    {
+        // Start reading messages
+        for(ix=start;ix<end;ix++)
+        {
+            // the text block index is split into the files while reading
+            while(createTextBlockIndex && ix >= textIndexFileEnd && textIndexFile + 1 < dltFile->getNumberOfFiles())
+                textIndexFileEnd += dltFile->getFileMsgNumber(++textIndexFile);
 
-        if(!dltFile->getMsg(ix, *msg))
-            continue; // Skip broken messages
+            if(!dltFile->getMsg(ix, msg, lazyArguments))
+            {
+                if(createMetadataIndex)
+                    metadataIndex.appendInvalid();
+                if(createTextBlockIndex)
+                    textBlockIndexes[textIndexFile].appendInvalid();
+                continue; // Skip broken messages
+            }
 
-        /*if(true == useIndexerThread)
-        {
-            indexerThread.enqueueMessage(msg, ix);
-        }
-        else
-        {*/
-            indexerThread.processMessage(msg, ix);
-        //}
+            // store the header fields before decoder plugins change the message
+            if(createMetadataIndex)
+                metadataIndex.append(msg);
 
-        if((end-start)!=0)
-            iPercent = ( (ix-start)*100 )/(end-start);
-        if(iPercent>=progressCounter)
-        {
-            progressCounter += 1;
-            emit progress(iPercent); // every 1%
-            if((iPercent>0) && ((iPercent%10)==0))
-                qDebug() << "CFI:" << iPercent << "%"; // every 10%
-        }
+            /*if(true == useIndexerThread)
+            {
+                indexerThread.enqueueMessage(msg, ix);
+            }
+            else
+            {*/
+                indexerThread.processMessage(msg, ix);
+            //}
 
-        // stop if requested
-        if(stopFlag)
-        {
-            /*if(useIndexerThread)
+            // the text of the decoded message, header with message id and payload like in the search
+            if(createTextBlockIndex)
             {
-                indexerThread.requestStop();
-                indexerThread.wait();
-            }*/
+                QString header = msg.toStringHeader();
+                if(msgIdEnabled)
+                    header += ' ' + QString::asprintf(msgIdFormat.constData(), msg.getMessageId());
+                payloadText.truncate(0);
+                msg.appendToStringPayload(payloadText);
+                textBlockIndexes[textIndexFile].append(header,payloadText);
+            }
 
-            return false;
+            if((end-start)!=0)
+                iPercent = ( (ix-start)*100 )/(end-start);
+            if(iPercent>=progressCounter)
+            {
+                progressCounter += 1;
+                emit progress(iPercent); // every 1%
+                if((iPercent>0) && ((iPercent%10)==0))
+                    qDebug() << "CFI:" << iPercent << "%"; // every 10%
+            }
+
+            // stop if requested
+            if(stopFlag)
+            {
+                /*if(useIndexerThread)
+                {
+                    indexerThread.requestStop();
+                    indexerThread.wait();
+                }*/
+
+                return false;
+            }
         }
     }
     emit(progress(100));
@@ -519,6 +497,31 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
     if(sortByTimeEnabled || sortByTimestampEnabled)
         indexFilterList = QVector<qint64>::fromList(indexFilterListSorted.values());
 
+    // split the metadata index into the files and write it next to the index cache
+    if(createMetadataIndex && metadataIndex.isValid())
+    {
+        int first = 0;
+        for(int num=0;num<dltFile->getNumberOfFiles();num++)
+        {
+            const int count = dltFile->getFileMsgNumber(num);
+            const QDltMetadataIndex fileMetadataIndex = dltFile->getNumberOfFiles() == 1 ? metadataIndex : metadataIndex.mid(first,count);
+            dltFile->setMetadataIndex(fileMetadataIndex,num);
+            if(filterCacheEnabled)
+                saveMetadataCache(dltFile->getFileName(num),fileMetadataIndex);
+            first += count;
+        }
+    }
+
+    if(createTextBlockIndex)
+    {
+        for(int num=0;num<dltFile->getNumberOfFiles();num++)
+        {
+            dltFile->setTextBlockIndex(textBlockIndexes[num],num);
+            if(filterCacheEnabled)
+                saveTextBlockCache(dltFile->getFileName(num),textBlockIndexes[num]);
+        }
+    }
+
     // write filter index if enabled
     if(filterCacheEnabled)
     {
@@ -531,9 +534,262 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
     return true;
 }
 
+bool DltFileIndexer::indexFilterMetadata(QDltFilterList &filterList, quint64 start, quint64 end, QStringList filenames)
+{
+    QVector<int> matches;
+    qint64 offset = 0;
+
+    qDebug() << "### Create filter index from metadata index";
+
+    emit(progressText(QString("CFI %1/%2").arg(currentRun).arg(maxRun)));
+    emit(progressMax(100));
+    emit(progress(0));
+
+    for(int num=0;num<dltFile->getNumberOfFiles();num++)
+    {
+        const QDltMetadataIndex &metadata = dltFile->getMetadataIndex(num);
+        const qint64 fileStart = qMax<qint64>(0,static_cast<qint64>(start)-offset);
+        const qint64 fileEnd = qMin<qint64>(metadata.size(),static_cast<qint64>(end)-offset);
+
+        matches.clear();
+        if(fileStart < fileEnd)
+            filterList.checkFilter(metadata,static_cast<int>(fileStart),static_cast<int>(fileEnd),matches);
+
+        for(int row : matches)
+        {
+            const qint64 ix = offset + row;
+            if(sortByTimeEnabled)
+                indexFilterListSorted.insert(DltFileIndexerKey(metadata.getTime(row), metadata.getMicroseconds(row), static_cast<int>(ix)), ix);
+            else if(sortByTimestampEnabled)
+                indexFilterListSorted.insert(DltFileIndexerKey(metadata.getTimestamp(row), static_cast<int>(ix)), ix);
+            else
+                indexFilterList.append(ix);
+        }
+
+        offset += metadata.size();
+
+        // stop if requested
+        if(stopFlag)
+            return false;
+    }
+
+    emit(progress(100));
+
+    // use sorted values if sort by time enabled
+    if(sortByTimeEnabled || sortByTimestampEnabled)
+        indexFilterList = QVector<qint64>::fromList(indexFilterListSorted.values());
+
+    // write filter index if enabled
+    if(filterCacheEnabled)
+    {
+        saveFilterIndexCache(filterList, indexFilterList, filenames);
+        qDebug() << "Saved filter index cache for files" << filenames;
+    }
+
+    qDebug() << "Create filter index from metadata index: Finish";
+
+    return true;
+}
+
+bool DltFileIndexer::indexFilterParallel(QDltFilterList &filterList, quint64 start, quint64 end, bool silentMode, bool lazyArguments)
+{
+    std::vector<FilterRange> ranges;
+    std::vector<DltFileIndexerThread*> indexerThreads;
+    std::vector<std::thread> workers;
+    std::atomic<int> nextRange(0);
+    std::atomic<quint64> messagesFiltered(0);
+    std::atomic<bool> stopWorkers(false);
+    std::mutex mutex;
+    std::condition_variable workerDone;
+    int runningWorkers;
+
+    // split the messages into ranges, each worker takes the next range when it is finished
+    for(quint64 pos=start;pos<end;pos+=DLT_FILE_INDEXER_FILTER_RANGE_SIZE)
+    {
+        FilterRange range;
+        range.start = pos;
+        range.end = qMin<quint64>(pos+DLT_FILE_INDEXER_FILTER_RANGE_SIZE,end);
+        ranges.push_back(range);
+    }
+
+    const int workerCount = qMin(QThread::idealThreadCount(),static_cast<int>(ranges.size()));
+    runningWorkers = workerCount;
+    qDebug() << "Create filter index with" << workerCount << "threads";
+
+    // decoder plugins are not thread safe, the plugin manager decodes one message at a time
+    for(int num=0;num<workerCount;num++)
+        indexerThreads.push_back(new DltFileIndexerThread(this,&filterList,sortByTimeEnabled,sortByTimestampEnabled,
+                                                          nullptr,nullptr,pluginManager,&activeViewerPlugins,silentMode));
+
+    for(int num=0;num<workerCount;num++)
+    {
+        workers.emplace_back([&,num]()
+        {
+            QDltMsg msg;
+            DltFileIndexerThread *indexerThread = indexerThreads[num];
+            int rangeNum;
+
+            while(!stopWorkers && (rangeNum = nextRange++) < static_cast<int>(ranges.size()))
+            {
+                FilterRange &range = ranges[rangeNum];
+                indexerThread->setIndexFilterList(&range.indexFilterList,&range.indexFilterListSorted);
+
+                for(quint64 ix=range.start;ix<range.end && !stopWorkers;ix++)
+                {
+                    if(dltFile->getMsg(ix, msg, lazyArguments))
+                        indexerThread->processMessage(msg, ix);
+                }
+                messagesFiltered += range.end - range.start;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            runningWorkers--;
+            workerDone.notify_one();
+        });
+    }
+
+    // update progress until all workers are finished
+    unsigned int progressCounter = 1;
+    std::unique_lock<std::mutex> lock(mutex);
+    while(!workerDone.wait_for(lock,std::chrono::milliseconds(100),[&]() { return runningWorkers == 0; }))
+    {
+        // stop if requested
+        if(stopFlag)
+            stopWorkers = true;
+
+        const unsigned int iPercent = static_cast<unsigned int>((messagesFiltered*100)/(end-start));
+        if(iPercent>=progressCounter)
+        {
+            progressCounter = iPercent + 1;
+            emit progress(iPercent);
+            if((iPercent>0) && ((iPercent%10)==0))
+                qDebug() << "CFI:" << iPercent << "%";
+        }
+    }
+    lock.unlock();
+
+    for(std::thread &worker : workers)
+        worker.join();
+    for(DltFileIndexerThread *indexerThread : indexerThreads)
+        delete indexerThread;
+
+    if(stopFlag || stopWorkers)
+        return false;
+
+    // merge the results in the order of the ranges, sorted results are ordered by the key
+    for(const FilterRange &range : ranges)
+    {
+        if(sortByTimeEnabled || sortByTimestampEnabled)
+        {
+            for(auto it=range.indexFilterListSorted.constBegin();it!=range.indexFilterListSorted.constEnd();++it)
+                indexFilterListSorted.insert(it.key(),it.value());
+        }
+        else
+        {
+            indexFilterList += range.indexFilterList;
+        }
+    }
+
+    return true;
+}
+
+bool DltFileIndexer::indexFullText()
+{
+    // wait for the lock, searches and live updates hold it only for a short time
+    const auto lockIndex = [this]() {
+        while(!indexLock.tryLock(100))
+        {
+            if(stopFlag)
+                return false;
+        }
+        return true;
+    };
+
+    // the messages indexed now, messages appended later are not covered by the index
+    const QByteArray renderKey = textRenderKey(pluginsEnabled,activeDecoderPlugins);
+    QVector<int> fileMessages;
+    if(!lockIndex())
+        return false;
+    if(!dltFile->hasFullTextIndex(renderKey))
+    {
+        for(int num=0;num<dltFile->getNumberOfFiles();num++)
+            fileMessages.append(dltFile->getFileMsgNumber(num));
+    }
+    indexLock.unlock();
+    if(fileMessages.isEmpty())
+        return true;
+
+    qDebug() << "Create full text index: Start";
+
+    // the text of the decoded message, header with message id and payload like in the search
+    const bool msgIdEnabled = QDltSettingsManager::getInstance()->value("startup/showMsgId", true).toBool();
+    const QByteArray msgIdFormat = QDltSettingsManager::getInstance()->value("startup/msgIdFormat", "0x%x").toString().toUtf8();
+    const bool silentMode = !QDltOptManager::getInstance()->issilentMode();
+    QVector<QDltFullTextIndex> fullTextIndexes(fileMessages.size());
+    QDltMsg msg;
+    QString payloadText;
+    int ix = 0;
+    for(int num=0;num<fileMessages.size();num++)
+    {
+        fullTextIndexes[num].setRenderKey(renderKey);
+        for(int end=ix+fileMessages[num];ix<end;ix++)
+        {
+            // the messages are read from the snapshot of the index, live updates may append messages meanwhile
+            if(!dltFile->getMsg(ix, msg))
+            {
+                fullTextIndexes[num].appendInvalid();
+                continue;
+            }
+            if(pluginsEnabled)
+                pluginManager->decodeMsg(msg, silentMode);
+
+            QString header = msg.toStringHeader();
+            if(msgIdEnabled)
+                header += ' ' + QString::asprintf(msgIdFormat.constData(), msg.getMessageId());
+            payloadText.truncate(0);
+            msg.appendToStringPayload(payloadText);
+            fullTextIndexes[num].append(header,payloadText);
+
+            if(stopFlag)
+                return false;
+        }
+    }
+
+    // the index is only used, if the files were not changed meanwhile
+    if(!lockIndex())
+        return false;
+    bool unchanged = dltFile->getNumberOfFiles() == fullTextIndexes.size();
+    for(int num=0;unchanged && num<fullTextIndexes.size();num++)
+        unchanged = dltFile->getFileMsgNumber(num) == fullTextIndexes[num].size();
+    if(unchanged)
+    {
+        for(int num=0;num<fullTextIndexes.size();num++)
+            dltFile->setFullTextIndex(fullTextIndexes[num],num);
+    }
+    indexLock.unlock();
+
+    if(!unchanged)
+    {
+        qDebug() << "Create full text index: Files changed, index dropped";
+        return true;
+    }
+    for(int num=0;num<fullTextIndexes.size();num++)
+    {
+        qDebug() << "Created full text index with" << fullTextIndexes[num].wordCount() << "words for file" << dltFile->getFileName(num);
+        if(filterCacheEnabled)
+            saveFullTextCache(dltFile->getFileName(num),fullTextIndexes[num]);
+    }
+
+    qDebug() << "Create full text index: Finish";
+
+    return true;
+}
+
 bool DltFileIndexer::indexDefaultFilter()
 {
-    QSharedPointer<QDltMsg> msg;
+    QDltMsg msg;
+    QVector<QDltMsgQueue::Slot*> slots;
+    int filledSlots = 0;
 
     // start performance counter
     //QTime time;
@@ -570,18 +826,27 @@ bool DltFileIndexer::indexDefaultFilter()
     /* run through the whole open file */
     for(int ix = 0; ix < dltFile->size(); ix++)
     {
-        msg = QSharedPointer<QDltMsg>::create();
-        /* Fill message from file */
-        if(!dltFile->getMsg(ix, *msg))
+        if(useDefaultFilterThread)
         {
-            /* Skip broken messages */
-            continue;
+            /* Fill messages from file into free slots of the queue, full batches are passed to the thread */
+            if(slots.isEmpty())
+                defaultFilterThread.acquireSlots(slots);
+            QDltMsgQueue::Slot *slot = slots[filledSlots];
+            if(dltFile->getMsg(ix, slot->msg, true))
+            {
+                slot->index = ix;
+                if(++filledSlots == slots.size())
+                {
+                    defaultFilterThread.enqueueSlots(slots);
+                    slots.clear();
+                    filledSlots = 0;
+                }
+            }
         }
-
-        if(useDefaultFilterThread)
-            defaultFilterThread.enqueueMessage(msg, ix);
-        else
+        else if(dltFile->getMsg(ix, msg, true))
+        {
             defaultFilterThread.processMessage(msg, ix);
+        }
 
         /* Update progress */
         if(ix % modulo == 0)
@@ -595,6 +860,7 @@ bool DltFileIndexer::indexDefaultFilter()
         {
             if(useDefaultFilterThread)
             {
+                defaultFilterThread.releaseSlots(slots);
                 defaultFilterThread.requestStop();
                 defaultFilterThread.wait();
             }
@@ -605,6 +871,9 @@ bool DltFileIndexer::indexDefaultFilter()
 
     if(useDefaultFilterThread)
     {
+        /* pass the last filled slots and give back the unused ones */
+        defaultFilterThread.enqueueSlots(slots.mid(0, filledSlots));
+        defaultFilterThread.releaseSlots(slots.mid(filledSlots));
         defaultFilterThread.requestStop();
         defaultFilterThread.wait();
     }
@@ -682,16 +951,10 @@ void DltFileIndexer::run()
     // index
     if(mode == modeIndex || mode == modeIndexAndFilter)
     {
-        for(int num=0;num < dltFile->getNumberOfFiles();num++)
+        if(!index())
         {
-            if(!index(num))
-            {
-                qDebug() << "Error in indexer" << __FILE__ << __LINE__;
-                return;
-            }
-           // qDebug() << "setDLTIndex" << num << __FILE__ << __LINE__;
-            dltFile->setDltIndex(indexAllList,num);
-            currentRun++;
+            qDebug() << "Error in indexer" << __FILE__ << __LINE__;
+            return;
         }
         emit(finishIndex());
     }
@@ -717,6 +980,16 @@ void DltFileIndexer::run()
         emit(finishFilter());
     }
 
+    // the full text index is created behind, the file can be used and searched meanwhile
+    if(mode == modeIndexAndFilter && fullTextIndexEnabled && QThread::currentThread() == this)
+    {
+        scopedLock.unlock();
+        fullTextPass = true;
+        setPriority(QThread::IdlePriority);
+        indexFullText();
+        fullTextPass = false;
+    }
+
     // indexDefaultFilter
     if(mode == modeDefaultFilter)
     {
@@ -780,9 +1053,10 @@ void DltFileIndexer::stop()
 }
 
 // load/safe index from/to file
-bool DltFileIndexer::loadIndexCache(QString filename)
+bool DltFileIndexer::loadIndexCache(QString filename, QVector<qint64> &index, qint64 &indexedSize, qint64 &errors)
 {
     QString filenameCache;
+    QByteArray metadata;
 
     // check if caching is enabled
     if(!filterCacheEnabled)
@@ -790,6 +1064,8 @@ bool DltFileIndexer::loadIndexCache(QString filename)
 
     // get the filename for the cache file
     filenameCache = filenameIndexCache(filename);
+    if(filenameCache.isEmpty())
+        return false;
 
     // load the cache file in a subdirectory index
     QFileInfo info(filename);
@@ -797,18 +1073,37 @@ bool DltFileIndexer::loadIndexCache(QString filename)
     if (!dir.exists())
         dir.mkpath(".");
     qDebug() << "Index Cache filename" << info.dir().path() + "/index/" +filenameCache;
-    if(!loadIndex(info.dir().path() + "/index/" +filenameCache,indexAllList))
+    if(!loadIndex(info.dir().path() + "/index/" +filenameCache,index,&metadata))
     {
         // loading cache file failed
         return false;
     }
 
+    // metadata contains the indexed file size, the number of errors and the fingerprint of the last indexed bytes
+    if(metadata.size() != DLT_FILE_INDEXER_CACHE_METADATA_SIZE)
+    {
+        qDebug() << "Index cache" << filenameCache << "has no valid metadata";
+        index.clear();
+        return false;
+    }
+    indexedSize = qFromLittleEndian<qint64>(metadata.constData());
+    errors = qFromLittleEndian<qint64>(metadata.constData() + 8);
+
+    // the file must still contain the indexed data, otherwise it was truncated or rewritten
+    if(info.size() < indexedSize || fingerprintIndexCache(filename,qMax<qint64>(0,indexedSize-DLT_FILE_INDEXER_FINGERPRINT_SIZE),indexedSize) != metadata.mid(16))
+    {
+        qDebug() << "Index cache" << filenameCache << "does not match file content";
+        index.clear();
+        return false;
+    }
+
     return true;
 }
 
-bool DltFileIndexer::saveIndexCache(QString filename)
+bool DltFileIndexer::saveIndexCache(QString filename, const QVector<qint64> &index, qint64 indexedSize, qint64 errors)
 {
     QString filenameCache;
+    QByteArray metadata;
 
     // check if caching is enabled
     if(!filterCacheEnabled)
@@ -816,6 +1111,16 @@ bool DltFileIndexer::saveIndexCache(QString filename)
 
     // get the filename for the cache file
     filenameCache = filenameIndexCache(filename);
+    if(filenameCache.isEmpty())
+        return false;
+
+    // store the indexed file size, the number of errors and the fingerprint of the last indexed bytes
+    metadata.resize(16);
+    qToLittleEndian<qint64>(indexedSize, metadata.data());
+    qToLittleEndian<qint64>(errors, metadata.data() + 8);
+    metadata += fingerprintIndexCache(filename,qMax<qint64>(0,indexedSize-DLT_FILE_INDEXER_FINGERPRINT_SIZE),indexedSize);
+    if(metadata.size() != DLT_FILE_INDEXER_CACHE_METADATA_SIZE)
+        return false;
 
     // save the cache file in a sudirectory index
     QFileInfo info(filename);
@@ -823,7 +1128,7 @@ bool DltFileIndexer::saveIndexCache(QString filename)
     if (!dir.exists())
         dir.mkpath(".");
     qDebug() << "Index Cache filename" << info.dir().path() + "/index/" +filenameCache;
-    if(!saveIndex(info.dir().path() + "/index/" +filenameCache,indexAllList))
+    if(!saveIndex(info.dir().path() + "/index/" +filenameCache,index,metadata))
     {
         // saving cache file failed
         return false;
@@ -837,11 +1142,17 @@ QString DltFileIndexer::filenameIndexCache(QString filename)
     QString hashString;
     QByteArray hashByteArray;
     QByteArray md5;
+    QByteArray fingerprint;
     QString filenameCache;
 
+    // fingerprint of the leading bytes, which do not change when data is appended to the file
+    fingerprint = fingerprintIndexCache(filename,0,DLT_FILE_INDEXER_FINGERPRINT_SIZE);
+    if(fingerprint.isEmpty())
+        return QString();
+
     // create string to be hashed
     hashString = QFileInfo(filename).fileName();
-    hashString += "_" + QString("%1").arg(dltFile->fileSize());
+    hashString += "_" + QString(fingerprint.toHex());
 
     // create byte array from hash string
     hashByteArray = hashString.toLatin1();
@@ -857,6 +1168,166 @@ QString DltFileIndexer::filenameIndexCache(QString filename)
     return filenameCache;
 }
 
+QByteArray DltFileIndexer::fingerprintIndexCache(QString filename, qint64 start, qint64 end)
+{
+    QFile file(filename);
+
+    if(!file.open(QFile::ReadOnly) || !file.seek(start))
+        return QByteArray();
+
+    // MD5 of the bytes in the range, the range is shorter for small files
+    const QByteArray data = file.read(end - start);
+    file.close();
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Md5);
+}
+
+bool DltFileIndexer::loadMetadataCache(QString filename, QDltMetadataIndex &metadata)
+{
+    QString filenameCache;
+
+    // check if caching is enabled
+    if(!filterCacheEnabled)
+        return false;
+
+    // the metadata index is stored next to the index cache
+    filenameCache = filenameIndexCache(filename);
+    if(filenameCache.isEmpty())
+        return false;
+    filenameCache.replace(".dix",".dmi");
+
+    QFileInfo info(filename);
+    return metadata.load(info.dir().path() + "/index/" +filenameCache,keyMetadataCache(filename));
+}
+
+bool DltFileIndexer::saveMetadataCache(QString filename, const QDltMetadataIndex &metadata)
+{
+    QString filenameCache;
+
+    // check if caching is enabled
+    if(!filterCacheEnabled)
+        return false;
+
+    // the metadata index is stored next to the index cache
+    filenameCache = filenameIndexCache(filename);
+    if(filenameCache.isEmpty())
+        return false;
+    filenameCache.replace(".dix",".dmi");
+
+    QFileInfo info(filename);
+    QDir dir(info.dir().path()+"/index");
+    if (!dir.exists())
+        dir.mkpath(".");
+    qDebug() << "Metadata Index Cache filename" << info.dir().path() + "/index/" +filenameCache;
+
+    return metadata.save(info.dir().path() + "/index/" +filenameCache,keyMetadataCache(filename));
+}
+
+QByteArray DltFileIndexer::keyMetadataCache(QString filename)
+{
+    // the metadata index is valid for the file size and content it was created from
+    const qint64 size = QFileInfo(filename).size();
+
+    return QByteArray::number(size) + fingerprintIndexCache(filename,qMax<qint64>(0,size-DLT_FILE_INDEXER_FINGERPRINT_SIZE),size);
+}
+
+bool DltFileIndexer::loadTextBlockCache(QString filename, QDltTextBlockIndex &textBlocks)
+{
+    QString filenameCache;
+
+    // check if caching is enabled
+    if(!filterCacheEnabled)
+        return false;
+
+    // the text block index is stored next to the index cache
+    filenameCache = filenameIndexCache(filename);
+    if(filenameCache.isEmpty())
+        return false;
+    filenameCache.replace(".dix",".dtb");
+
+    QFileInfo info(filename);
+    return textBlocks.load(info.dir().path() + "/index/" +filenameCache,keyMetadataCache(filename));
+}
+
+bool DltFileIndexer::saveTextBlockCache(QString filename, const QDltTextBlockIndex &textBlocks)
+{
+    QString filenameCache;
+
+    // check if caching is enabled
+    if(!filterCacheEnabled)
+        return false;
+
+    // the text block index is stored next to the index cache
+    filenameCache = filenameIndexCache(filename);
+    if(filenameCache.isEmpty())
+        return false;
+    filenameCache.replace(".dix",".dtb");
+
+    QFileInfo info(filename);
+    QDir dir(info.dir().path()+"/index");
+    if (!dir.exists())
+        dir.mkpath(".");
+    qDebug() << "Text Block Index Cache filename" << info.dir().path() + "/index/" +filenameCache;
+
+    return textBlocks.save(info.dir().path() + "/index/" +filenameCache,keyMetadataCache(filename));
+}
+
+bool DltFileIndexer::loadFullTextCache(QString filename, QDltFullTextIndex &fullText)
+{
+    QString filenameCache;
+
+    // check if caching is enabled
+    if(!filterCacheEnabled)
+        return false;
+
+    // the full text index is stored next to the index cache
+    filenameCache = filenameIndexCache(filename);
+    if(filenameCache.isEmpty())
+        return false;
+    filenameCache.replace(".dix",".dft");
+
+    QFileInfo info(filename);
+    return fullText.load(info.dir().path() + "/index/" +filenameCache,keyMetadataCache(filename));
+}
+
+bool DltFileIndexer::saveFullTextCache(QString filename, const QDltFullTextIndex &fullText)
+{
+    QString filenameCache;
+
+    // check if caching is enabled
+    if(!filterCacheEnabled)
+        return false;
+
+    // the full text index is stored next to the index cache
+    filenameCache = filenameIndexCache(filename);
+    if(filenameCache.isEmpty())
+        return false;
+    filenameCache.replace(".dix",".dft");
+
+    QFileInfo info(filename);
+    QDir dir(info.dir().path()+"/index");
+    if (!dir.exists())
+        dir.mkpath(".");
+    qDebug() << "Full Text Index Cache filename" << info.dir().path() + "/index/" +filenameCache;
+
+    return fullText.save(info.dir().path() + "/index/" +filenameCache,keyMetadataCache(filename));
+}
+
+QByteArray DltFileIndexer::textRenderKey(bool pluginsEnabled, const QList<QDltPlugin*> &decoderPlugins)
+{
+    // the header text contains the local time and the formatted message id
+    QByteArray key = QTimeZone::systemTimeZoneId();
+
+    if(QDltSettingsManager::getInstance()->value("startup/showMsgId", true).toBool())
+        key += "_" + QDltSettingsManager::getInstance()->value("startup/msgIdFormat", "0x%x").toString().toUtf8();
+
+    // the payload text depends on the decoder plugins
+    if(pluginsEnabled)
+        key += "_" + md5DecoderPlugins(decoderPlugins).toHex();
+
+    return key;
+}
+
 // read/write index cache
 bool DltFileIndexer::loadFilterIndexCache(QDltFilterList &filterList, QVector<qint64> &index, QStringList filenames)
 {
@@ -914,15 +1385,20 @@ bool DltFileIndexer::saveFilterIndexCache(QDltFilterList &filterList, QVector<qi
 }
 
 QByteArray DltFileIndexer::md5ActiveDecoderPlugins()
+{
+    return md5DecoderPlugins(activeDecoderPlugins);
+}
+
+QByteArray DltFileIndexer::md5DecoderPlugins(const QList<QDltPlugin*> &decoderPlugins)
 {
     QByteArray md5;
     QString hashString = "Plugins";
     QByteArray hashByteArray;
 
     // walk through all active decoder plugins and generate String with all plugin names, version and loaded filename
-    for(int num=0;num<activeDecoderPlugins.size();num++)
+    for(int num=0;num<decoderPlugins.size();num++)
     {
-        QDltPlugin *plugin = activeDecoderPlugins[num];
+        QDltPlugin *plugin = decoderPlugins[num];
 
         hashString += plugin->name();
         hashString += plugin->pluginVersion();
@@ -982,48 +1458,17 @@ QString DltFileIndexer::filenameFilterIndexCache(QDltFilterList &filterList,QStr
     return filename;
 }
 
-bool DltFileIndexer::saveIndex(QString filename, const QVector<qint64> &index)
+bool DltFileIndexer::saveIndex(QString filename, const QVector<qint64> &index, const QByteArray &metadata)
 {
-    quint32 version = DLT_FILE_INDEXER_FILE_VERSION;
-    qint64 value;
-
-    QFile file(filename);
-
-    // open cache file
-    if(!file.open(QFile::WriteOnly))
-    {
-        // open file failed
-        return false;
-    }
-
-    // write version
-    file.write((char*)&version,sizeof(version));
-
-    // write complete index
-    for(int num=0;num<index.size();num++)
-    {
-        value = index[num];
-        file.write((char*)&value,sizeof(value));
-    }
-
-    // close cache file
-    file.close();
-
-    return true;
+    // write index in the compact block format
+    return QDltIndexFile::save(filename,index,metadata);
 }
 
-bool DltFileIndexer::loadIndex(QString filename, QVector<qint64> &index)
+bool DltFileIndexer::loadIndex(QString filename, QVector<qint64> &index, QByteArray *metadata)
 {
-    quint32 version;
-    qint64 value;
-    int length;
-    qint64 indexcount=0;
-
-    QFile file(filename);
     index.clear();
 
-    // open cache file
-    if(!file.open(QFile::ReadOnly))
+    if(!QFileInfo::exists(filename))
     {
         //qDebug() << "Loading index file " << filename << "failed !";
         return false;
@@ -1032,26 +1477,6 @@ bool DltFileIndexer::loadIndex(QString filename, QVector<qint64> &index)
     qDebug() << "### Load index file";
     qDebug() << "Load index file " << filename;// << __FILE__ << "LINE" << __LINE__;
 
-    index.reserve(static_cast<int>((file.size() - sizeof(version)) / sizeof(value))); // prevent memory issues through reallocation
-
-    // read version
-    length = file.read((char*)&version,sizeof(version));
-
-    // compare version if valid
-    if((length != sizeof(version)) || version != DLT_FILE_INDEXER_FILE_VERSION)
-    {
-        // wrong version number
-        qDebug() << "Loading index file " << filename << "failed !";
-        file.close();
-        return false;
-    }
-
-    int modvalue = file.size() / 100;
-    if (modvalue == 0) // avoid divison by zero
-    {
-         modvalue = 1;
-    }
-
    // read complete index
    if (false == QDltOptManager::getInstance()->issilentMode() )
      {
@@ -1063,43 +1488,25 @@ bool DltFileIndexer::loadIndex(QString filename, QVector<qint64> &index)
       qDebug().noquote() << "Load index: Start";
      }
 
-    unsigned int progressCounter = 1;
-    unsigned int percent = 0;
-    unsigned long fileSize = file.size();
     emit(progress(0));
-    do
-    {
-        length = file.read((char*)&value,sizeof(value));
-        if(length==sizeof(value))
-        {
-            index.append(value);
-        }
-
-        if(fileSize)
-            percent = (file.pos()*100)/fileSize;
 
-        if(percent>=progressCounter)
-        {
-            progressCounter += 1;
-            emit(progress(percent));
-            if((percent>0) && ((percent%10)==0))
-              qDebug() << "LI:" << percent << "%";
-        }
-        indexcount++;
+    // index files of version 2 and 3 are loaded, blocks are decoded in parallel
+    if(!QDltIndexFile::load(filename,index,metadata))
+    {
+        // wrong version number or corrupt file
+        qDebug() << "Loading index file " << filename << "failed !";
+        return false;
     }
-    while(length==sizeof(value));
 
     // now that it is doen we have to set the 100 %
     if (false == QDltOptManager::getInstance()->issilentMode() )
       {
-        emit(progress(fileSize));
+        emit(progress(100));
       }
     else
       {
        qDebug().noquote() << "Load index: Finish";
       }
-    // close cache file
-    file.close();
 
     return true;
 }
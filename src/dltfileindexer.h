@@ -8,13 +8,20 @@
 #include <QPair>
 #include <QMutex>
 
+#include <atomic>
+
 #include "qdltdefaultfilter.h"
 #include "qdltfile.h"
+#include "qdltindexfile.h"
 #include "qdltplugin.h"
 #include "qdltpluginmanager.h"
 
 #define DLT_FILE_INDEXER_SEG_SIZE (1024*1024)
-#define DLT_FILE_INDEXER_FILE_VERSION 2
+#define DLT_FILE_INDEXER_FILE_VERSION QDLT_INDEX_FILE_VERSION_BLOCKS
+#define DLT_FILE_INDEXER_FINGERPRINT_SIZE (64*1024)
+#define DLT_FILE_INDEXER_CACHE_METADATA_SIZE (16+16)
+#define DLT_FILE_INDEXER_FILTER_RANGE_SIZE (16*1024)
+#define DLT_FILE_INDEXER_QUEUE_BATCH_SIZE 64
 
 class DltFileIndexerKey
 {
@@ -68,35 +75,63 @@ public:
 
     typedef enum { modeNone, modeIndex, modeIndexAndFilter, modeFilter, modeDefaultFilter } IndexingMode;
 
-    // create main index
-    bool index(int num);
+    // create main index of all files, the files are indexed in parallel
+    bool index();
 
     qint64 getfileerrors(void);
 
     // create index based on filters and apply plugins
     bool indexFilter(QStringList filenames);
+    bool indexFilterMetadata(QDltFilterList &filterList, quint64 start, quint64 end, QStringList filenames);
+    bool indexFilterParallel(QDltFilterList &filterList, quint64 start, quint64 end, bool silentMode, bool lazyArguments);
     bool indexDefaultFilter();
 
+    // create the full text index of all files, run at low priority behind the filter index
+    bool indexFullText();
+
     // load/save filter index from/to file
     bool loadFilterIndexCache(QDltFilterList &filterList, QVector<qint64> &index, QStringList filenames);
     bool saveFilterIndexCache(QDltFilterList &filterList, QVector<qint64> index, QStringList filenames);
     QString filenameFilterIndexCache(QDltFilterList &filterList, QStringList filenames);
     QByteArray md5ActiveDecoderPlugins(); // generate hash value over all active decoder plugins
+    static QByteArray md5DecoderPlugins(const QList<QDltPlugin*> &decoderPlugins);
 
-    // load/save index from/to file
-    bool loadIndexCache(QString filename);
-    bool saveIndexCache(QString filename);
+    // load/save index from/to file, the cache is found by the leading bytes of the file
+    // and stays valid when data is appended, indexedSize is the file size covered by the index
+    bool loadIndexCache(QString filename, QVector<qint64> &index, qint64 &indexedSize, qint64 &errors);
+    bool saveIndexCache(QString filename, const QVector<qint64> &index, qint64 indexedSize, qint64 errors);
     QString filenameIndexCache(QString filename);
+    QByteArray fingerprintIndexCache(QString filename, qint64 start, qint64 end);
+
+    // load/save metadata index from/to file, stored next to the index cache
+    bool loadMetadataCache(QString filename, QDltMetadataIndex &metadata);
+    bool saveMetadataCache(QString filename, const QDltMetadataIndex &metadata);
+    QByteArray keyMetadataCache(QString filename);
+
+    // load/save text block index from/to file, stored next to the index cache
+    bool loadTextBlockCache(QString filename, QDltTextBlockIndex &textBlocks);
+    bool saveTextBlockCache(QString filename, const QDltTextBlockIndex &textBlocks);
+
+    // load/save full text index from/to file, stored next to the index cache
+    bool loadFullTextCache(QString filename, QDltFullTextIndex &fullText);
+    bool saveFullTextCache(QString filename, const QDltFullTextIndex &fullText);
+
+    // key of the header and payload text of the messages as rendered by the search
+    // depends on the time zone, the message id format and the decoder plugins
+    static QByteArray textRenderKey(bool pluginsEnabled, const QList<QDltPlugin*> &decoderPlugins);
 
     // load/save index from/to file
-    bool saveIndex(QString filename, const QVector<qint64> &index);
-    bool loadIndex(QString filename, QVector<qint64> &index);
+    bool saveIndex(QString filename, const QVector<qint64> &index, const QByteArray &metadata = QByteArray());
+    bool loadIndex(QString filename, QVector<qint64> &index, QByteArray *metadata = nullptr);
 
     // Accessors to mutex
     void lock();
     void unlock();
     bool tryLock();
 
+    // the thread is running and uses the index, the full text index is created without the lock
+    bool isIndexing() const { return isRunning() && !fullTextPass; }
+
     // set/get indexing mode
     void setMode(IndexingMode mode) { this->mode = mode; }
     IndexingMode getMode() { return mode; }
@@ -125,6 +160,14 @@ public:
     void setFilterCacheEnabled(bool enabled) { filterCacheEnabled = enabled; }
     bool getFilterCacheEnabled() { return filterCacheEnabled; }
 
+    // enable/disable creation of the text block index for the search
+    void setTextBlockIndexEnabled(bool enabled) { textBlockIndexEnabled = enabled; }
+    bool getTextBlockIndexEnabled() { return textBlockIndexEnabled; }
+
+    // enable/disable creation of the full text index for the search
+    void setFullTextIndexEnabled(bool enabled) { fullTextIndexEnabled = enabled; }
+    bool getFullTextIndexEnabled() { return fullTextIndexEnabled; }
+
     // get index of all messages
     QVector<qint64> getIndexAll() { return indexAllList; }
     QVector<qint64> getIndexFilters() { return indexFilterList; }
@@ -182,6 +225,15 @@ private:
     QVector<qint64> indexFilterList;
     QMap<DltFileIndexerKey,qint64> indexFilterListSorted;
 
+    // range of messages filtered by a worker thread, merged in the order of the ranges
+    typedef struct
+    {
+        quint64 start;
+        quint64 end;
+        QVector<qint64> indexFilterList;
+        QMap<DltFileIndexerKey,qint64> indexFilterListSorted;
+    } FilterRange;
+
     // getLogInfoList
     QList<int> getLogInfoList;
 
@@ -195,6 +247,15 @@ private:
     // filter cache enabled
     bool filterCacheEnabled;
 
+    // text block index enabled
+    bool textBlockIndexEnabled;
+
+    // full text index enabled
+    bool fullTextIndexEnabled;
+
+    // the full text index is created, the lock is released
+    std::atomic<bool> fullTextPass;
+
     // file errors
     qint64 errors_in_file;
 
@@ -15,9 +15,19 @@ DltFileIndexerDefaultFilterThread::DltFileIndexerDefaultFilterThread
 DltFileIndexerDefaultFilterThread::~DltFileIndexerDefaultFilterThread()
 {}
 
-void DltFileIndexerDefaultFilterThread::enqueueMessage(const QSharedPointer<QDltMsg> &msg, int index)
+int DltFileIndexerDefaultFilterThread::acquireSlots(QVector<QDltMsgQueue::Slot*> &slots)
 {
-    msgQueue.enqueueMsg(msg, index);
+    return msgQueue.acquire(slots, DLT_FILE_INDEXER_QUEUE_BATCH_SIZE);
+}
+
+void DltFileIndexerDefaultFilterThread::enqueueSlots(const QVector<QDltMsgQueue::Slot*> &slots)
+{
+    msgQueue.enqueue(slots);
+}
+
+void DltFileIndexerDefaultFilterThread::releaseSlots(const QVector<QDltMsgQueue::Slot*> &slots)
+{
+    msgQueue.release(slots);
 }
 
 void DltFileIndexerDefaultFilterThread::requestStop()
@@ -27,19 +37,23 @@ void DltFileIndexerDefaultFilterThread::requestStop()
 
 void DltFileIndexerDefaultFilterThread::run()
 {
-    QPair<QSharedPointer<QDltMsg>, int> msgPair;
-
-    while(msgQueue.dequeue(msgPair))
-        processMessage(msgPair.first, msgPair.second);
+    QVector<QDltMsgQueue::Slot*> slots;
+
+    while(msgQueue.dequeue(slots, DLT_FILE_INDEXER_QUEUE_BATCH_SIZE) > 0)
+    {
+        for(QDltMsgQueue::Slot *slot : slots)
+            processMessage(slot->msg, slot->index);
+        msgQueue.release(slots);
+    }
 }
 
-void DltFileIndexerDefaultFilterThread::processMessage(QSharedPointer<QDltMsg> &msg, int index)
+void DltFileIndexerDefaultFilterThread::processMessage(QDltMsg &msg, int index)
 {
     /* Process all decoderplugins */
-    pluginManager->decodeMsg(*msg, silentMode);
+    pluginManager->decodeMsg(msg, silentMode);
 
-    /* run through all default filter */
+    /* run through all default filter, messages with broken arguments are skipped */
     for(int num = 0; num < defaultFilter->defaultFilterList.size(); num++)
-        if(defaultFilter->defaultFilterList[num]->checkFilter(*msg)) // if filter matches message...
+        if(defaultFilter->defaultFilterList[num]->checkFilter(msg) && msg.hasValidArguments()) // if filter matches message...
             defaultFilter->defaultFilterIndex[num]->indexFilter.append(index); // ... add message to index cache
 }
@@ -2,7 +2,7 @@
 #define DLTFILEINDEXERDEFAULTFILTERTHREAD_H
 
 #include "dltfileindexer.h"
-#include "dltmsgqueue.h"
+#include "qdltmsgqueue.h"
 #include <QThread>
 
 class DltFileIndexerDefaultFilterThread :public QThread
@@ -11,8 +11,10 @@ class DltFileIndexerDefaultFilterThread :public QThread
 public:
     DltFileIndexerDefaultFilterThread(QDltDefaultFilter *defaultFilter, QDltPluginManager *pluginManager, bool silentMode);
     ~DltFileIndexerDefaultFilterThread();
-    void enqueueMessage(const QSharedPointer<QDltMsg> &msg, int index);
-    void processMessage(QSharedPointer<QDltMsg> &msg, int index);
+    int acquireSlots(QVector<QDltMsgQueue::Slot*> &slots);
+    void enqueueSlots(const QVector<QDltMsgQueue::Slot*> &slots);
+    void releaseSlots(const QVector<QDltMsgQueue::Slot*> &slots);
+    void processMessage(QDltMsg &msg, int index);
     void requestStop();
 
 protected:
@@ -23,7 +25,7 @@ private:
     QDltPluginManager *pluginManager;
     bool silentMode;
 
-    DltMsgQueue msgQueue;
+    QDltMsgQueue msgQueue;
 };
 
 #endif // DLTFILEINDEXERDEFAULTFILTERTHREAD_H
@@ -2,7 +2,7 @@
 #define DLTFILEINDEXERTHREAD_H
 
 #include "dltfileindexer.h"
-#include "dltmsgqueue.h"
+#include "qdltmsgqueue.h"
 #include <QThread>
 
 class DltFileIndexerThread :public QThread
@@ -11,8 +11,11 @@ class DltFileIndexerThread :public QThread
 public:
     DltFileIndexerThread(DltFileIndexer *indexer, QDltFilterList *filterList, bool sortByTimeEnabled, bool sortByTimestampEnabled, QVector<qint64> *indexFilterList, QMap<DltFileIndexerKey,qint64> *indexFilterListSorted, QDltPluginManager *pluginManager, QList<QDltPlugin*> *activeViewerPlugins, bool silentMode);
     ~DltFileIndexerThread();
-    void enqueueMessage(const QSharedPointer<QDltMsg> &msg, int index);
-    void processMessage(QSharedPointer<QDltMsg> &msg, int index);
+    int acquireSlots(QVector<QDltMsgQueue::Slot*> &slots);
+    void enqueueSlots(const QVector<QDltMsgQueue::Slot*> &slots);
+    void releaseSlots(const QVector<QDltMsgQueue::Slot*> &slots);
+    void processMessage(QDltMsg &msg, int index);
+    void setIndexFilterList(QVector<qint64> *indexFilterList, QMap<DltFileIndexerKey,qint64> *indexFilterListSorted);
     void requestStop();
 
 protected:
@@ -31,7 +34,7 @@ private:
     QList<QDltPlugin*> *activeViewerPlugins;
     bool silentMode;
 
-    DltMsgQueue msgQueue;
+    QDltMsgQueue msgQueue;
 };
 
 #endif // DLTFILEINDEXERTHREAD_H
@@ -0,0 +1,568 @@
+#include "dltingestthread.h"
+#include "project.h"
+
+#include <QDebug>
+#include <QHostAddress>
+#include <QNetworkInterface>
+#include <QRegularExpression>
+#include <QSocketNotifier>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUdpSocket>
+
+#include <ctime>
+
+/* Bytes buffered by the TCP socket, when the queue is full the ECU has to wait */
+#define DLT_INGEST_TCP_READ_BUFFER_SIZE (16*1024*1024)
+
+/* Bytes read from the TCP socket or serial port at once */
+#define DLT_INGEST_DEVICE_READ_SIZE (64*1024)
+
+/* Interval in ms in which the thread tries again to pass messages, when the queue was full */
+#define DLT_INGEST_RETRY_INTERVAL 1
+
+/* Maximum number of recvmmsg calls before the events of the thread are handled again */
+#define DLT_INGEST_UDP_RECEIVE_CALLS 16
+
+/* Maximum number of datagrams passed as one message of the queue, when they are read with QUdpSocket */
+#define DLT_INGEST_UDP_BATCH_DATAGRAMS 64
+
+namespace
+{
+
+QDltImporter::DltStorageHeaderTimestamp currentTimestamp()
+{
+    QDltImporter::DltStorageHeaderTimestamp timestamp = {0, 0};
+    struct timespec ts;
+    if (timespec_get(&ts, TIME_UTC))
+    {
+        timestamp.sec = static_cast<quint32>(ts.tv_sec);
+        timestamp.usec = static_cast<quint32>(ts.tv_nsec / 1000);
+    }
+    return timestamp;
+}
+
+int connectionState(QAbstractSocket::SocketState socketState)
+{
+    switch(socketState)
+    {
+    case QAbstractSocket::ConnectingState:
+        return QDltConnection::QDltConnectionConnecting;
+    case QAbstractSocket::ConnectedState:
+        return QDltConnection::QDltConnectionOnline;
+    default:
+        return QDltConnection::QDltConnectionOffline;
+    }
+}
+
+}
+
+DltIngestThread::DltIngestThread(EcuItem *ecuitem, bool supportDLTv2, QObject *parent)
+    : QThread(parent),
+      interfacetype(ecuitem->interfacetype),
+      supportDLTv2(supportDLTv2),
+      hostname(ecuitem->getHostname()),
+      ipport(ecuitem->getIpport()),
+      bindAddress(ecuitem->getEthIF()),
+      udpport(ecuitem->getUdpport()),
+      multicast(ecuitem->is_multicast),
+      ethIF(ecuitem->getEthIF()),
+      port(ecuitem->getPort()),
+      baudrate(ecuitem->getBaudrate()),
+      device(nullptr),
+      retryTimer(nullptr),
+#ifdef Q_OS_LINUX
+      udpNotifier(nullptr),
+#endif
+      queue(DLT_INGEST_QUEUE_SIZE),
+      notified(false),
+      open(false),
+      bytesRead(0),
+      bytesReceived(0),
+      bytesError(0),
+      syncFound(0),
+      datagramsDropped(0)
+{
+    if (bindAddress == "AnyIP")
+    {
+        bindAddress = "0.0.0.0"; // we need to translate AnyIP to 0.0.0.0 on Linux ...
+    }
+    multicastAddresses = ecuitem->getmcastIP().split(QRegularExpression("\\s+"));
+    multicastAddresses.removeAll(QString());
+
+    if (interfacetype == EcuItem::INTERFACETYPE_TCP)
+        syncSerialHeader = ecuitem->getSyncSerialHeaderIp();
+    else
+        syncSerialHeader = ecuitem->getSyncSerialHeaderSerial();
+    connection.setSyncSerialHeader(syncSerialHeader);
+}
+
+DltIngestThread::~DltIngestThread()
+{
+    requestStop();
+    wait();
+}
+
+void DltIngestThread::requestStop()
+{
+    /* the connection is closed when the event loop of the thread returns */
+    quit();
+}
+
+void DltIngestThread::send(const QByteArray &data)
+{
+    /* queued to the thread, as the device must only be used there */
+    emit sendRequested(data);
+}
+
+int DltIngestThread::takeMessages(QVector<Message> &messages, int maxCount)
+{
+    /* reset before taking, so messages added meanwhile are notified again */
+    notified = false;
+
+    messages.clear();
+    int count = 0;
+    Message message;
+    while (count < maxCount && queue.pop(message))
+    {
+        count += message.count();
+        messages.append(std::move(message));
+    }
+
+    return count;
+}
+
+void DltIngestThread::takeStatistics(unsigned long &bytesRead, unsigned long &bytesReceived, unsigned long &bytesError, unsigned long &syncFound, unsigned long &datagramsDropped)
+{
+    bytesRead = this->bytesRead.exchange(0);
+    bytesReceived = this->bytesReceived.exchange(0);
+    bytesError = this->bytesError.exchange(0);
+    syncFound = this->syncFound.exchange(0);
+    datagramsDropped = this->datagramsDropped.exchange(0);
+}
+
+void DltIngestThread::run()
+{
+    /* the device and the timer are created in the thread, so their events are handled here */
+    QTimer timer;
+    timer.setSingleShot(true);
+    timer.setInterval(DLT_INGEST_RETRY_INTERVAL);
+    retryTimer = &timer;
+    connect(&timer, &QTimer::timeout, &timer, [this]() { readData(); });
+
+#ifdef Q_OS_LINUX
+    if (interfacetype == EcuItem::INTERFACETYPE_UDP && QHostAddress(bindAddress).protocol() == QAbstractSocket::IPv4Protocol)
+    {
+        if (!openUdpReceiver())
+        {
+            retryTimer = nullptr;
+            return;
+        }
+
+        /* nothing is sent to an ECU connected by UDP */
+        QSocketNotifier notifier(udpReceiver.socketDescriptor(), QSocketNotifier::Read);
+        udpNotifier = &notifier;
+        connect(&notifier, &QSocketNotifier::activated, &notifier, [this]() { readData(); });
+
+        exec();
+
+        udpNotifier = nullptr;
+        udpReceiver.close();
+        open = false;
+        retryTimer = nullptr;
+        if (!pending.isEmpty())
+            qDebug() << "Messages not passed when the connection was closed:" << pending.size();
+        pending.clear();
+        return;
+    }
+#endif
+
+    device = openDevice();
+    if (!device)
+    {
+        retryTimer = nullptr;
+        return;
+    }
+
+    connect(this, &DltIngestThread::sendRequested, device, [this](const QByteArray &data) {
+        if (device->isOpen())
+            device->write(data);
+    });
+    connect(device, &QIODevice::readyRead, device, [this]() { readData(); });
+
+    exec();
+
+    /* close the connection */
+    disconnect(this, &DltIngestThread::sendRequested, nullptr, nullptr);
+    if (QAbstractSocket *socket = qobject_cast<QAbstractSocket*>(device))
+    {
+        socket->disconnectFromHost();
+        if (socket->state() != QAbstractSocket::UnconnectedState)
+            socket->abort();
+    }
+    device->close();
+    open = false;
+    delete device;
+    device = nullptr;
+    retryTimer = nullptr;
+
+    /* messages which could not be passed are lost */
+    if (!pending.isEmpty())
+        qDebug() << "Messages not passed when the connection was closed:" << pending.size();
+    pending.clear();
+}
+
+QIODevice *DltIngestThread::openDevice()
+{
+    if (interfacetype == EcuItem::INTERFACETYPE_TCP)
+    {
+        QTcpSocket *socket = new QTcpSocket();
+        socket->setReadBufferSize(DLT_INGEST_TCP_READ_BUFFER_SIZE);
+        connect(socket, &QAbstractSocket::connected, socket, [this]() {
+            emit connected();
+        });
+        /* the thread ends with the connection, a new thread is started to reconnect */
+        connect(socket, &QAbstractSocket::disconnected, socket, [this]() {
+            emit disconnected();
+            quit();
+        });
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+        connect(socket, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error), socket, [this, socket](QAbstractSocket::SocketError) {
+#else
+        connect(socket, &QAbstractSocket::errorOccurred, socket, [this, socket](QAbstractSocket::SocketError) {
+#endif
+            emit errorOccurred(socket->errorString());
+            quit();
+        });
+        connect(socket, &QAbstractSocket::stateChanged, socket, [this](QAbstractSocket::SocketState socketState) {
+            /* set before the state is passed, so control messages can be sent when the connection is online */
+            open = (socketState == QAbstractSocket::ConnectedState);
+            emit stateChanged(connectionState(socketState));
+        });
+        socket->connectToHost(hostname, ipport);
+        return socket;
+    }
+
+    if (interfacetype == EcuItem::INTERFACETYPE_UDP)
+    {
+        QUdpSocket *socket = new QUdpSocket();
+        connect(socket, &QAbstractSocket::stateChanged, socket, [this](QAbstractSocket::SocketState socketState) {
+            emit stateChanged(connectionState(socketState));
+        });
+        if (!socket->bind(QHostAddress(bindAddress), udpport, QUdpSocket::ShareAddress))
+        {
+            qDebug() << "Error - binding failed with" << socket->errorString();
+            emit errorOccurred("Binding failed");
+            delete socket;
+            return nullptr;
+        }
+        qDebug() << "Bound to " << ethIF << "on port" << udpport;
+        socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 26214400);
+        open = true;
+
+        if (multicast)
+        {
+            const QList<QNetworkInterface> interfaces = QNetworkInterface::allInterfaces();
+            bool interfaceFound = false;
+            for (const QNetworkInterface &networkInterface : interfaces)
+            {
+                if (networkInterface.humanReadableName() != ethIF)
+                    continue;
+                interfaceFound = true;
+                for (const QString &address : multicastAddresses)
+                {
+                    if (socket->joinMulticastGroup(QHostAddress(address), networkInterface))
+                    {
+                        qDebug() << "Successfully joined multicast group" << address << "on interface" << ethIF;
+                    }
+                    else
+                    {
+                        qDebug() << "Error joining multicast group" << address << "on interface" << ethIF << socket->errorString();
+                        emit errorOccurred("Error joining multicast group");
+                    }
+                }
+                break;
+            }
+            if (!interfaceFound)
+            {
+                qDebug() << "Error joining multicast group" << multicastAddresses << "on interface" << ethIF;
+                emit errorOccurred("Interface not found");
+            }
+        }
+        else
+        {
+            qDebug() << "UDP unicast configured to" << ethIF;
+        }
+        return socket;
+    }
+
+    /* Serial */
+    QSerialPort *serialport = new QSerialPort();
+    serialport->setBaudRate(baudrate, QSerialPort::AllDirections);
+    serialport->setPortName(port);
+    serialport->setDataBits(QSerialPort::Data8);
+    serialport->setParity(QSerialPort::NoParity);
+    serialport->setStopBits(QSerialPort::OneStop);
+    serialport->setFlowControl(QSerialPort::NoFlowControl);
+    connect(serialport, &QSerialPort::dataTerminalReadyChanged, serialport, [this](bool set) {
+        emit stateChanged(set ? QDltConnection::QDltConnectionOnline : QDltConnection::QDltConnectionOffline);
+    });
+    if (!serialport->open(QIODevice::ReadWrite))
+    {
+        qDebug() << "Error opening serial port" << port << serialport->errorString();
+        emit errorOccurred(serialport->errorString());
+        delete serialport;
+        return nullptr;
+    }
+    open = true;
+    emit connected();
+    return serialport;
+}
+
+void DltIngestThread::readData()
+{
+    /* messages which did not fit into the queue are passed first, the connection is not read until then */
+    if (!enqueuePending())
+    {
+        retryTimer->start();
+        return;
+    }
+
+#ifdef Q_OS_LINUX
+    if (udpNotifier)
+    {
+        /* the socket is read again, when all messages were passed */
+        udpNotifier->setEnabled(true);
+        readDatagrams();
+        notify();
+        if (!pending.isEmpty())
+        {
+            udpNotifier->setEnabled(false);
+            retryTimer->start();
+        }
+        return;
+    }
+#endif
+
+    if (interfacetype == EcuItem::INTERFACETYPE_UDP)
+    {
+        QUdpSocket *socket = static_cast<QUdpSocket*>(device);
+        QDltMsg msg;
+
+        while (pending.isEmpty() && socket->hasPendingDatagrams())
+        {
+            /* the messages of several datagrams are received directly into one buffer, all at the same time */
+            Message message{QByteArray(), QByteArray(), currentTimestamp(), false, {}};
+            for (int datagrams = 0; datagrams < DLT_INGEST_UDP_BATCH_DATAGRAMS && socket->hasPendingDatagrams(); datagrams++)
+            {
+                const int offset = message.payload.size();
+                const qint64 size = qMax<qint64>(0, socket->pendingDatagramSize());
+                message.payload.resize(offset + static_cast<int>(size));
+                const qint64 bytesRcvd = socket->readDatagram(message.payload.data() + offset, size);
+                if (bytesRcvd <= 0)
+                {
+                    message.payload.resize(offset);
+                    continue;
+                }
+                bytesRead += static_cast<unsigned long>(bytesRcvd);
+
+                /* one or more DLT messages in the datagram */
+                quint32 dataSize = static_cast<quint32>(bytesRcvd);
+                const char *dataPtr = message.payload.constData() + offset;
+                while (dataSize > 0)
+                {
+                    const quint32 sizeMsg = msg.checkMsgSize(dataPtr, dataSize, supportDLTv2);
+                    if (sizeMsg == 0 || sizeMsg > dataSize)
+                        break;
+                    bytesReceived += sizeMsg;
+                    message.sizes.append(sizeMsg);
+                    dataSize -= sizeMsg;
+                    dataPtr += sizeMsg;
+                }
+
+                /* the rest of the datagram is no complete message */
+                message.payload.resize(offset + static_cast<int>(bytesRcvd - dataSize));
+            }
+
+            if (!message.sizes.isEmpty())
+                enqueue(std::move(message));
+        }
+    }
+    else
+    {
+        /* received directly into the buffer of the connection, the data stays in the device while the queue is full */
+        while (pending.isEmpty())
+        {
+            const qint64 bytes = device->read(connection.reserve(DLT_INGEST_DEVICE_READ_SIZE), DLT_INGEST_DEVICE_READ_SIZE);
+            if (bytes <= 0)
+                break;
+            connection.commit(static_cast<int>(bytes));
+            bytesRead += static_cast<unsigned long>(bytes);
+            parseMessages();
+        }
+    }
+
+    notify();
+
+    if (!pending.isEmpty())
+        retryTimer->start();
+}
+
+#ifdef Q_OS_LINUX
+bool DltIngestThread::openUdpReceiver()
+{
+    if (!udpReceiver.open(QHostAddress(bindAddress), static_cast<quint16>(udpport)))
+    {
+        qDebug() << "Error - binding failed with" << udpReceiver.errorString();
+        emit errorOccurred("Binding failed");
+        return false;
+    }
+    qDebug() << "Bound to " << ethIF << "on port" << udpport << "receive buffer" << udpReceiver.receiveBufferSize();
+    emit stateChanged(QDltConnection::QDltConnectionOffline);
+    open = true;
+
+    if (multicast)
+    {
+        int interfaceIndex = 0;
+        const QList<QNetworkInterface> interfaces = QNetworkInterface::allInterfaces();
+        for (const QNetworkInterface &networkInterface : interfaces)
+        {
+            if (networkInterface.humanReadableName() == ethIF)
+            {
+                interfaceIndex = networkInterface.index();
+                break;
+            }
+        }
+        if (interfaceIndex == 0)
+        {
+            qDebug() << "Error joining multicast group" << multicastAddresses << "on interface" << ethIF;
+            emit errorOccurred("Interface not found");
+            return true;
+        }
+        for (const QString &address : std::as_const(multicastAddresses))
+        {
+            if (udpReceiver.joinMulticastGroup(QHostAddress(address), interfaceIndex))
+            {
+                qDebug() << "Successfully joined multicast group" << address << "on interface" << ethIF;
+            }
+            else
+            {
+                qDebug() << "Error joining multicast group" << address << "on interface" << ethIF << udpReceiver.errorString();
+                emit errorOccurred("Error joining multicast group");
+            }
+        }
+    }
+    else
+    {
+        qDebug() << "UDP unicast configured to" << ethIF;
+    }
+    return true;
+}
+
+void DltIngestThread::readDatagrams()
+{
+    QDltMsg msg;
+
+    for (int calls = 0; calls < DLT_INGEST_UDP_RECEIVE_CALLS && pending.isEmpty(); calls++)
+    {
+        const int count = udpReceiver.receive();
+        if (count < 0)
+            qDebug() << "Error receiving datagrams" << udpReceiver.errorString();
+        if (count <= 0)
+            break;
+
+        /* the messages of all datagrams are passed in one buffer, all received at the same time */
+        Message message{QByteArray(), QByteArray(), currentTimestamp(), false, {}};
+        int size = 0;
+        for (int num = 0; num < count; num++)
+            size += static_cast<int>(udpReceiver.datagramSize(num));
+        message.payload.reserve(size);
+
+        for (int num = 0; num < count; num++)
+        {
+            /* one or more DLT messages in the datagram */
+            quint32 dataSize = udpReceiver.datagramSize(num);
+            const char *dataPtr = udpReceiver.datagram(num);
+            bytesRead += dataSize;
+            while (dataSize > 0)
+            {
+                const quint32 sizeMsg = msg.checkMsgSize(dataPtr, dataSize, supportDLTv2);
+                if (sizeMsg == 0 || sizeMsg > dataSize)
+                    break;
+                bytesReceived += sizeMsg;
+                message.payload.append(dataPtr, static_cast<int>(sizeMsg));
+                message.sizes.append(sizeMsg);
+                dataSize -= sizeMsg;
+                dataPtr += sizeMsg;
+            }
+        }
+        datagramsDropped += udpReceiver.takeDropped();
+
+        if (!message.sizes.isEmpty())
+            enqueue(std::move(message));
+
+        /* the socket is empty */
+        if (count < DLT_UDP_RECEIVE_BATCH_SIZE)
+            break;
+    }
+}
+#endif
+
+void DltIngestThread::parseMessages()
+{
+    QDltMsg msg;
+    const QDltImporter::DltStorageHeaderTimestamp timestamp = currentTimestamp();
+
+    /* the remaining data stays in the buffer of the connection, while the queue is full */
+    while (pending.isEmpty() &&
+           ((interfacetype == EcuItem::INTERFACETYPE_SERIAL_ASCII) ? connection.parseAscii(msg) : connection.parseDlt(msg, supportDLTv2)))
+    {
+        const bool controlResponse = (msg.getType() == QDltMsg::DltTypeControl) && (msg.getSubtype() == QDltMsg::DltControlResponse);
+        enqueue(Message{msg.getHeader(), msg.getPayload(), timestamp, controlResponse, {}});
+    }
+
+    bytesReceived += connection.bytesReceived;
+    connection.bytesReceived = 0;
+    bytesError += connection.bytesError;
+    connection.bytesError = 0;
+    syncFound += connection.syncFound;
+    connection.syncFound = 0;
+}
+
+bool DltIngestThread::enqueue(Message &&message)
+{
+    if (pending.isEmpty() && queue.push(std::move(message)))
+        return true;
+
+    pending.append(std::move(message));
+    return false;
+}
+
+bool DltIngestThread::enqueuePending()
+{
+    int count = 0;
+    while (count < pending.size() && queue.push(std::move(pending[count])))
+        count++;
+    pending.remove(0, count);
+
+    if (count > 0)
+        notify();
+
+    if (!pending.isEmpty())
+        return false;
+
+    /* continue with the data already buffered by the connection */
+    if (interfacetype != EcuItem::INTERFACETYPE_UDP)
+    {
+        parseMessages();
+        notify();
+    }
+
+    return pending.isEmpty();
+}
+
+void DltIngestThread::notify()
+{
+    if (!queue.isEmpty() && !notified.exchange(true))
+        emit messagesAvailable();
+}
@@ -0,0 +1,143 @@
+#ifndef DLTINGESTTHREAD_H
+#define DLTINGESTTHREAD_H
+
+#include <QThread>
+#include <QByteArray>
+#include <QSerialPort>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <atomic>
+
+#include "qdltconnection.h"
+#include "qdltimporter.h"
+#include "qdltspscqueue.hpp"
+#include "dltudpreceiver.h"
+
+class EcuItem;
+class QIODevice;
+class QSocketNotifier;
+class QTimer;
+
+/* Number of received messages buffered for the main window, per connection */
+#define DLT_INGEST_QUEUE_SIZE 65536
+
+/* Number of messages the main window takes at once, before handling other events */
+#define DLT_INGEST_READ_BATCH_SIZE 10000
+
+/* Delay in ms before the main window reads the messages left again */
+#define DLT_INGEST_READ_DELAY 10
+
+/**
+ * @brief Receives the messages of one ECU connection in its own thread.
+ * The thread owns the TCP socket, UDP socket or serial port of the connection,
+ * reads the received data and splits it into DLT messages. The messages are
+ * passed to the main window through a lock-free single producer, single consumer
+ * queue, together with the time they were received. The main window is only
+ * notified once when the queue gets new messages, until it takes them.
+ * If the queue is full, the thread stops reading from the connection until the
+ * main window takes messages again.
+ * UDP datagrams are received in batches, on Linux with recvmmsg. All messages of
+ * a batch are passed as one item of the queue, without a copy per message.
+ */
+class DltIngestThread : public QThread
+{
+    Q_OBJECT
+public:
+    /* A received message, without storage header */
+    struct Message
+    {
+        QByteArray header;
+        QByteArray payload;
+        QDltImporter::DltStorageHeaderTimestamp timestamp;
+        bool controlResponse;
+        /* if not empty, the payload contains several complete messages with these sizes */
+        QVector<quint32> sizes;
+
+        int count() const { return sizes.isEmpty() ? 1 : sizes.size(); }
+    };
+
+    /* the configuration of the connection is taken from the ECU when the thread is created */
+    DltIngestThread(EcuItem *ecuitem, bool supportDLTv2, QObject *parent = nullptr);
+    ~DltIngestThread();
+
+    /* close the connection and stop the thread, received messages can still be taken */
+    void requestStop();
+
+    /* the connection is open, it can be used to send messages */
+    bool isOpen() const { return open; }
+
+    /* send data to the ECU, can be called from any thread */
+    void send(const QByteArray &data);
+
+    /* take received messages, only called by one thread, returns the number of messages taken
+       the items taken contain up to maxCount messages */
+    int takeMessages(QVector<Message> &messages, int maxCount);
+    bool hasMessages() const { return !queue.isEmpty(); }
+
+    /* take the statistics collected since the last call */
+    void takeStatistics(unsigned long &bytesRead, unsigned long &bytesReceived, unsigned long &bytesError, unsigned long &syncFound, unsigned long &datagramsDropped);
+
+signals:
+    /* new messages can be taken, emitted once until the messages are taken */
+    void messagesAvailable();
+    void connected();
+    void disconnected();
+    void errorOccurred(const QString &error);
+    void stateChanged(int state); /* QDltConnection::QDltConnectionState */
+
+    /* used internally to pass data to send to the thread */
+    void sendRequested(const QByteArray &data);
+
+protected:
+    void run();
+
+private:
+    QIODevice *openDevice();
+    void readData();
+#ifdef Q_OS_LINUX
+    bool openUdpReceiver();
+    void readDatagrams();
+#endif
+    void parseMessages();
+    bool enqueue(Message &&message);
+    bool enqueuePending();
+    void notify();
+
+    /* configuration */
+    int interfacetype;
+    bool supportDLTv2;
+    QString hostname;
+    unsigned int ipport;
+    QString bindAddress;
+    unsigned int udpport;
+    bool multicast;
+    QString ethIF;
+    QStringList multicastAddresses;
+    QString port;
+    QSerialPort::BaudRate baudrate;
+    bool syncSerialHeader;
+
+    /* only used by the thread */
+    QIODevice *device;
+    QTimer *retryTimer;
+    QDltConnection connection;
+    QVector<Message> pending;
+#ifdef Q_OS_LINUX
+    DltUdpReceiver udpReceiver;
+    QSocketNotifier *udpNotifier;
+#endif
+
+    QDltSpscQueue<Message> queue;
+    std::atomic<bool> notified;
+    std::atomic<bool> open;
+
+    std::atomic<unsigned long> bytesRead;
+    std::atomic<unsigned long> bytesReceived;
+    std::atomic<unsigned long> bytesError;
+    std::atomic<unsigned long> syncFound;
+    std::atomic<unsigned long> datagramsDropped;
+};
+
+#endif // DLTINGESTTHREAD_H
@@ -0,0 +1,172 @@
+#include "dltudpreceiver.h"
+
+#ifdef Q_OS_LINUX
+
+#include <QDebug>
+
+#include <netinet/in.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace
+{
+
+/* control data of a datagram, only the drop counter is requested */
+const size_t controlSize = CMSG_SPACE(sizeof(quint32));
+
+}
+
+DltUdpReceiver::DltUdpReceiver()
+    : fd(-1),
+      dropCount(0),
+      dropped(0)
+{
+}
+
+DltUdpReceiver::~DltUdpReceiver()
+{
+    close();
+}
+
+bool DltUdpReceiver::open(const QHostAddress &address, quint16 port)
+{
+    close();
+
+    fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        setError("socket");
+        return false;
+    }
+
+    /* the same as QUdpSocket::ShareAddress */
+    const int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(address.toIPv4Address());
+    if (bind(fd, reinterpret_cast<const struct sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        setError("bind");
+        close();
+        return false;
+    }
+
+    /* the forced size is not limited by net.core.rmem_max, but needs CAP_NET_ADMIN */
+    const int bufferSize = DLT_UDP_RECEIVE_BUFFER_SIZE;
+    if (setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &bufferSize, sizeof(bufferSize)) != 0)
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+
+    if (setsockopt(fd, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable)) != 0)
+        qDebug() << "Counting dropped datagrams not supported:" << strerror(errno);
+
+    arena.resize(static_cast<size_t>(DLT_UDP_RECEIVE_BATCH_SIZE) * DLT_UDP_DATAGRAM_SIZE);
+    control.resize(DLT_UDP_RECEIVE_BATCH_SIZE * controlSize);
+    iovecs.resize(DLT_UDP_RECEIVE_BATCH_SIZE);
+    messages.resize(DLT_UDP_RECEIVE_BATCH_SIZE);
+    for (size_t num = 0; num < messages.size(); num++)
+    {
+        iovecs[num].iov_base = arena.data() + num * DLT_UDP_DATAGRAM_SIZE;
+        iovecs[num].iov_len = DLT_UDP_DATAGRAM_SIZE;
+        memset(&messages[num], 0, sizeof(mmsghdr));
+        messages[num].msg_hdr.msg_iov = &iovecs[num];
+        messages[num].msg_hdr.msg_iovlen = 1;
+        messages[num].msg_hdr.msg_control = control.data() + num * controlSize;
+    }
+    dropCount = 0;
+    dropped = 0;
+
+    return true;
+}
+
+void DltUdpReceiver::close()
+{
+    if (fd >= 0)
+        ::close(fd);
+    fd = -1;
+}
+
+bool DltUdpReceiver::joinMulticastGroup(const QHostAddress &group, int interfaceIndex)
+{
+    struct ip_mreqn mreq;
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.imr_multiaddr.s_addr = htonl(group.toIPv4Address());
+    mreq.imr_ifindex = interfaceIndex;
+    if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0)
+    {
+        setError("IP_ADD_MEMBERSHIP");
+        return false;
+    }
+    return true;
+}
+
+int DltUdpReceiver::receiveBufferSize() const
+{
+    int size = 0;
+    socklen_t length = sizeof(size);
+    if (getsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, &length) != 0)
+        return -1;
+    return size;
+}
+
+int DltUdpReceiver::receive()
+{
+    /* the lengths are overwritten by the kernel */
+    for (mmsghdr &message : messages)
+    {
+        message.msg_hdr.msg_controllen = controlSize;
+        message.msg_hdr.msg_flags = 0;
+        message.msg_len = 0;
+    }
+
+    int count;
+    do
+    {
+        count = recvmmsg(fd, messages.data(), static_cast<unsigned int>(messages.size()), MSG_DONTWAIT, nullptr);
+    } while (count < 0 && errno == EINTR);
+
+    if (count < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return 0;
+        setError("recvmmsg");
+        return -1;
+    }
+
+    /* the counter of the socket is only reported, when datagrams were dropped before */
+    for (int num = 0; num < count; num++)
+    {
+        struct msghdr &header = messages[static_cast<size_t>(num)].msg_hdr;
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR(&header, cmsg))
+        {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL)
+            {
+                quint32 counter;
+                memcpy(&counter, CMSG_DATA(cmsg), sizeof(counter));
+                dropped += counter - dropCount;
+                dropCount = counter;
+            }
+        }
+    }
+
+    return count;
+}
+
+unsigned long DltUdpReceiver::takeDropped()
+{
+    const unsigned long count = dropped;
+    dropped = 0;
+    return count;
+}
+
+void DltUdpReceiver::setError(const char *function)
+{
+    error = QString("%1: %2").arg(function, strerror(errno));
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,74 @@
+#ifndef DLTUDPRECEIVER_H
+#define DLTUDPRECEIVER_H
+
+#include <QtGlobal>
+
+#ifdef Q_OS_LINUX
+
+#include <QHostAddress>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <vector>
+
+/* Maximum number of datagrams received with one system call */
+#define DLT_UDP_RECEIVE_BATCH_SIZE 64
+
+/* Maximum size of an UDP datagram */
+#define DLT_UDP_DATAGRAM_SIZE 65536
+
+/* Size of the receive buffer of the socket, the kernel drops datagrams when it is full */
+#define DLT_UDP_RECEIVE_BUFFER_SIZE (64*1024*1024)
+
+/**
+ * @brief Receives UDP datagrams in batches with recvmmsg, only available on Linux.
+ * The datagrams are received into an arena, which is allocated once when the
+ * socket is opened. They are valid until the next call of receive().
+ * The kernel reports the number of datagrams dropped, because the receive
+ * buffer of the socket was full, with each received datagram (SO_RXQ_OVFL).
+ */
+class DltUdpReceiver
+{
+public:
+    DltUdpReceiver();
+    ~DltUdpReceiver();
+
+    /* create the socket and bind it, the address can be shared with other sockets */
+    bool open(const QHostAddress &address, quint16 port);
+    void close();
+    bool isOpen() const { return fd >= 0; }
+    int socketDescriptor() const { return fd; }
+
+    /* join a multicast group on the interface with the given index */
+    bool joinMulticastGroup(const QHostAddress &group, int interfaceIndex);
+
+    /* size of the receive buffer granted by the kernel */
+    int receiveBufferSize() const;
+
+    /* receive the available datagrams without waiting, returns the number of datagrams or -1 on error */
+    int receive();
+    const char *datagram(int index) const { return arena.data() + static_cast<size_t>(index) * DLT_UDP_DATAGRAM_SIZE; }
+    unsigned int datagramSize(int index) const { return messages[static_cast<size_t>(index)].msg_len; }
+
+    /* take the number of datagrams dropped by the kernel since the last call */
+    unsigned long takeDropped();
+
+    QString errorString() const { return error; }
+
+private:
+    void setError(const char *function);
+
+    int fd;
+    std::vector<char> arena;
+    std::vector<char> control;
+    std::vector<iovec> iovecs;
+    std::vector<mmsghdr> messages;
+    quint32 dropCount;
+    unsigned long dropped;
+    QString error;
+};
+
+#endif // Q_OS_LINUX
+
+#endif // DLTUDPRECEIVER_H
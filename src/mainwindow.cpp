@@ -19,6 +19,7 @@
 
 #include "filtergrouplogs.h"
 #include <algorithm>
+#include <limits>
 #include <QMimeData>
 #include <QTreeView>
 #include <QFileDialog>
@@ -202,6 +203,8 @@ MainWindow::~MainWindow()
 {
     timer.stop(); // stop the receive timeout timer in case it is running
     dltIndexer->stop(); // in case a thread is running we want to stop it
+    outputWriter.setWrittenCallback(nullptr);
+    outputWriter.close(); // write the buffered messages
     /**
      * All plugin dockwidgets must be removed from the layout manually and
      * then deleted. This has to be done here, because they contain
@@ -235,6 +238,7 @@ MainWindow::~MainWindow()
         // rename old file
         qfile.close();
         outputfile.flush();
+        outputWriter.close();
         outputfile.close();
         bool result = outputfile.rename(info.absoluteFilePath(), infoNew.absoluteFilePath());
         if ( false == result )
@@ -450,6 +454,7 @@ void MainWindow::initView()
     totalBytesRcvd = 0;
     totalByteErrorsRcvd = 0;
     totalSyncFoundRcvd = 0;
+    totalDatagramsDropped = 0;
 
     /* filename string */
     statusFilename = new QLabel("No log file loaded");
@@ -477,6 +482,7 @@ void MainWindow::initView()
     statusBytesReceived = new QLabel("Recv: 0");
     statusByteErrorsReceived = new QLabel("Recv Errors: 0");
     statusSyncFoundReceived = new QLabel("Sync found: 0");
+    statusDatagramsDropped = new QLabel("UDP dropped: 0");
     statusProgressBar = new QProgressBar();
 
     statusBar()->addWidget(statusFilename,1);
@@ -485,6 +491,7 @@ void MainWindow::initView()
     statusBar()->addWidget(statusBytesReceived, 0);
     statusBar()->addWidget(statusByteErrorsReceived);
     statusBar()->addWidget(statusSyncFoundReceived);
+    statusBar()->addWidget(statusDatagramsDropped);
     statusBar()->addWidget(statusProgressBar);
 
     /* Create search text box */
@@ -555,6 +562,18 @@ void MainWindow::initSignalConnections()
     /* Connect Search dialog find to action History */
     connect(searchDlg,SIGNAL(addActionHistory()),this,SLOT(onAddActionToHistory()));
 
+    /* Update the index, when received messages were written to the file by the background thread */
+    outputWriter.setWrittenCallback([this]() {
+        if(!outputWrittenPending.exchange(true))
+            QMetaObject::invokeMethod(this, "outputWritten", Qt::QueuedConnection);
+    });
+    outputWriter.setKeepWrittenMessages(true);
+
+    /* Read the messages left by the connections, when reading was delayed or limited */
+    readTimer.setSingleShot(true);
+    readTimer.setInterval(DLT_INGEST_READ_DELAY);
+    connect(&readTimer, &QTimer::timeout, this, &MainWindow::readyRead);
+
     /* Insert search text box to search toolbar, before previous button */
 
     QAction *before = m_searchActions.at(ToolbarPosition::FindPrevious);
@@ -632,6 +651,7 @@ void MainWindow::initFileHandling()
 {
     /* Initialize dlt-file indexer  */
     dltIndexer = new DltFileIndexer(&qfile,&pluginManager,&defaultFilter, this);
+    searchDlg->indexer = dltIndexer;
 
     /* connect signals */
     connect(dltIndexer, SIGNAL(progressMax(int)), this, SLOT(reloadLogFileProgressMax(int)));
@@ -793,6 +813,7 @@ void MainWindow::initFileHandling()
                 else
                     // normally load log file mutithreaded
                     reloadLogFile();
+                outputWriter.close();
                 outputfile.close(); // open later again when writing
             }
             else
@@ -959,6 +980,7 @@ void MainWindow::deleteactualFile()
     {
         // Delete created temp file
         qfile.close();
+        outputWriter.close();
         outputfile.close();
         if(outputfile.exists() && !outputfile.remove())
         {
@@ -1060,6 +1082,7 @@ void MainWindow::onNewTriggered(QString fileName)
         }
         else
         {
+            outputWriter.close();
             outputfile.close();
         }
     }
@@ -1076,6 +1099,7 @@ void MainWindow::onNewTriggered(QString fileName)
         isDltFileReadOnly = false;
         //reloadLogFile(false,false); // avoid "CORRUPT MESSAGE" - non threading !
         reloadLogFile(); // avoid "CORRUPT MESSAGE" - non threading !
+        outputWriter.close();
         outputfile.close(); // open later again when writing
     }
     else
@@ -1231,6 +1255,7 @@ bool MainWindow::openDltFile(QStringList fileNames)
         }
         else
         {
+            outputWriter.close();
             outputfile.close();
         }
     }
@@ -1274,6 +1299,7 @@ bool MainWindow::openDltFile(QStringList fileNames)
         else
             // normally load log file mutithreaded
             reloadLogFile();
+        outputWriter.close();
         outputfile.close(); // open later again when writing
         ret = true;
     }
@@ -1290,6 +1316,7 @@ bool MainWindow::openDltFile(QStringList fileNames)
             else
                 // normally load log file mutithreaded
                 reloadLogFile();
+            outputWriter.close();
             outputfile.close(); // open later again when writing
             ret = true;
             //qDebug() << "Loading file" << fileNames.last() << outputfile.errorString();
@@ -1365,6 +1392,13 @@ void MainWindow::appendDltFile(const QString &fileName)
         qDebug() << "Failed opening WriteOnly" << outputfile.fileName();
         return;
     }
+    /* append behind the received messages still buffered by the writer */
+    if(!openOutputWriter())
+    {
+        qDebug() << "Failed opening output writer" << outputfile.fileName();
+        dlt_file_free(&importfile,0);
+        return;
+    }
     for(int pos = 0 ; pos<num ; pos++)
     {
         if ( 0 == (pos % 1000))
@@ -1376,15 +1410,16 @@ void MainWindow::appendDltFile(const QString &fileName)
         if (progress.wasCanceled())
         {
             dlt_file_free(&importfile,0);
-            reloadLogFile();
+            outputWriter.close();
             outputfile.close();
+            reloadLogFile();
             return;
         }
         dlt_file_message(&importfile,pos,0);
-        outputfile.write((char*)importfile.msg.headerbuffer,importfile.msg.headersize);
-        outputfile.write((char*)importfile.msg.databuffer,importfile.msg.datasize);
+        outputWriter.write((const char*)importfile.msg.headerbuffer,importfile.msg.headersize,
+                           (const char*)importfile.msg.databuffer,importfile.msg.datasize);
     }
-    outputfile.flush();
+    outputWriter.close();
     outputfile.close();
 
     dlt_file_free(&importfile,0);
@@ -1417,15 +1452,22 @@ void MainWindow::on_action_menuFile_Import_DLT_Stream_triggered()
         qDebug() << "Failed opening WriteOnly" << outputfile.fileName();
         return;
     }
+    /* append behind the received messages still buffered by the writer */
+    if(!openOutputWriter())
+    {
+        qDebug() << "Failed opening output writer" << outputfile.fileName();
+        dlt_file_free(&importfile,0);
+        return;
+    }
     int version = (dlt_file_check_version(&importfile,0)&0xe0) >>5;
     qDebug() << "DLT file version " << version;
     auto dltReadFunc = (version == 2)  ? dltv2_file_read_raw : dlt_file_read_raw;
 	while (dltReadFunc(&importfile,false,0)>=0)
 	        {   
-	            outputfile.write((char*)importfile.msg.headerbuffer,importfile.msg.headersize);
-	            outputfile.write((char*)importfile.msg.databuffer,importfile.msg.datasize);
+	            outputWriter.write((const char*)importfile.msg.headerbuffer,importfile.msg.headersize,
+	                               (const char*)importfile.msg.databuffer,importfile.msg.datasize);
 	        }
-    outputfile.flush();
+    outputWriter.close();
     outputfile.close();
 
     dlt_file_free(&importfile,0);
@@ -1463,12 +1505,19 @@ void MainWindow::on_action_menuFile_Import_DLT_Stream_with_Serial_Header_trigger
         qDebug() << "Failed opening WriteOnly" << outputfile.fileName();
         return;
     }
+    /* append behind the received messages still buffered by the writer */
+    if(!openOutputWriter())
+    {
+        qDebug() << "Failed opening output writer" << outputfile.fileName();
+        dlt_file_free(&importfile,0);
+        return;
+    }
     while (dlt_file_read_raw(&importfile,true,0)>=0)
     {
-        outputfile.write((char*)importfile.msg.headerbuffer,importfile.msg.headersize);
-        outputfile.write((char*)importfile.msg.databuffer,importfile.msg.datasize);
+        outputWriter.write((const char*)importfile.msg.headerbuffer,importfile.msg.headersize,
+                           (const char*)importfile.msg.databuffer,importfile.msg.datasize);
     }
-    outputfile.flush();
+    outputWriter.close();
     outputfile.close();
 
     dlt_file_free(&importfile,0);
@@ -1789,6 +1838,7 @@ void MainWindow::onSaveAsTriggered(QString fileName)
     workingDirectory.setDltDirectory(QFileInfo(fileName).absolutePath());
 
     qfile.close();
+    outputWriter.close();
     outputfile.close();
 
     QFile sourceFile( outputfile.fileName() );
@@ -1822,6 +1872,7 @@ void MainWindow::onSaveAsTriggered(QString fileName)
         openFileNames = QStringList(fileName);
         isDltFileReadOnly = false;
         reloadLogFile();
+        outputWriter.close();
         outputfile.close(); // open later again when writing
     }
     else
@@ -1867,6 +1918,7 @@ void MainWindow::on_action_menuFile_Clear_triggered()
         }
         else
         {
+            outputWriter.close();
             outputfile.close();
         }
     }
@@ -1875,6 +1927,7 @@ void MainWindow::on_action_menuFile_Clear_triggered()
     totalBytesRcvd = 0; // reset receive counter too
     totalSyncFoundRcvd = 0; // reset sync counter too
     totalByteErrorsRcvd = 0; // reset receive byte error too
+    totalDatagramsDropped = 0; // reset dropped datagrams too
     target_version_string.clear();
     autoloadPluginsVersionEcus.clear();
     autoloadPluginsVersionStrings.clear();
@@ -1885,6 +1938,7 @@ void MainWindow::on_action_menuFile_Clear_triggered()
         isDltFileReadOnly = false;
         statusFilename->setMinimumWidth(statusFilename->width()); // just works to show default tmp file + location in status line
         reloadLogFile(false,false);
+        outputWriter.close();
         outputfile.close(); // open later again when writing
     }
     else
@@ -2126,6 +2180,15 @@ void MainWindow::reloadLogFileFinishDefaultFilter()
 
 void MainWindow::reloadLogFile(bool update, bool multithreaded)
 {
+    /* the search threads read the index, reload when the search is finished */
+    if(true == isSearchOngoing)
+    {
+        reloadAfterSearchUpdate = reloadAfterSearch ? (reloadAfterSearchUpdate && update) : update;
+        reloadAfterSearchMultithreaded = multithreaded;
+        reloadAfterSearch = true;
+        return;
+    }
+
     qint64 fileerrors = 0;
     /* check if in logging only mode, then do not create index */
     tableModel->setLoggingOnlyMode(settings->loggingOnlyMode);
@@ -2248,6 +2311,8 @@ void MainWindow::reloadLogFile(bool update, bool multithreaded)
     dltIndexer->setSortByTimestampEnabled(QDltSettingsManager::getInstance()->value("startup/sortByTimestampEnabled", false).toBool());
     dltIndexer->setMultithreaded(multithreaded);
     dltIndexer->setFilterCacheEnabled(settings->filterCache);
+    dltIndexer->setTextBlockIndexEnabled(settings->textBlockIndex);
+    dltIndexer->setFullTextIndexEnabled(settings->fullTextIndex);
 
     // run through all viewer plugins
     // must be run in the UI thread, if some gui actions are performed
@@ -2337,9 +2402,13 @@ void MainWindow::applySettings()
         }
     }
 
-    // disable or enable filter cache
+    // disable or enable filter cache and text indexes
     if(dltIndexer)
+    {
         dltIndexer->setFilterCacheEnabled(settings->filterCache);
+        dltIndexer->setTextBlockIndexEnabled(settings->textBlockIndex);
+        dltIndexer->setFullTextIndexEnabled(settings->fullTextIndex);
+    }
 
     // set DLT message chache size
     qfile.setCacheSize(settings->msgCacheSize);
@@ -3510,19 +3579,15 @@ void MainWindow::disconnectECU(EcuItem *ecuitem)
         ecuitem->update();
         on_configWidget_itemSelectionChanged();
 
-        /* update conenction state */
-        if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP)
+        /* close the connection */
+        if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL_DLT || ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL_ASCII)
         {
-            /* TCP or UDP */
-            if (ecuitem->socket->state()!=QAbstractSocket::UnconnectedState)
-                ecuitem->socket->disconnectFromHost();
-        }
-        else
-        {
-            /* Serial */
             qDebug() << "Close serial port" << ecuitem->getPort();
-            ecuitem->m_serialport->close();
         }
+        stopIngest(ecuitem);
+
+        /* write all messages received until now to the file */
+        outputWriter.flush();
 
         ecuitem->InvalidAll();
     }
@@ -3576,175 +3641,38 @@ void MainWindow::connectECU(EcuItem* ecuitem,bool force)
         ecuitem->ipcon.clear();
         ecuitem->serialcon.clear();
 
-        /* start socket connection to host */
-        if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP)
+        /* TCP and UDP are only connected again, when the last connection was closed */
+        if(ecuitem->ingest && ecuitem->ingest->isRunning() && ecuitem->interfacetype != EcuItem::INTERFACETYPE_SERIAL_DLT && ecuitem->interfacetype != EcuItem::INTERFACETYPE_SERIAL_ASCII)
         {
-            /* TCP */
-            qDebug()<< "Try to connect to ECU" << GetConnectionType(ecuitem->interfacetype) << ecuitem->getHostname() << QDateTime::currentDateTime().toString("hh:mm:ss");
-            /* connect socket signals with window slots */
-            if (ecuitem->socket->state()==QAbstractSocket::UnconnectedState)
-            {
-                disconnect(ecuitem->socket,0,0,0);
-                connect(ecuitem->socket,SIGNAL(connected()),this,SLOT(connected()));
-                connect(ecuitem->socket,SIGNAL(disconnected()),this,SLOT(disconnected()));
-#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
-                connect(ecuitem->socket, SIGNAL(error(QAbstractSocket::SocketError)), this, SLOT(error(QAbstractSocket::SocketError)));
-#else
-                connect(ecuitem->socket, &QAbstractSocket::errorOccurred, this, &MainWindow::error);
-#endif
-                connect(ecuitem->socket,SIGNAL(readyRead()),this,SLOT(readyRead()));
-                connect(ecuitem->socket,SIGNAL(stateChanged(QAbstractSocket::SocketState)),this,SLOT(stateChangedIP(QAbstractSocket::SocketState)));
-                ecuitem->socket->connectToHost(ecuitem->getHostname(),ecuitem->getIpport());
-            }
+            checkConnectionState();
+            return;
         }
-        /* start socket connection to host */
-       else if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP)
-        {
-            /* UDP */
-            bool bindstate = false;
-            QString connectIPaddress = ecuitem->getEthIF();
+        stopIngest(ecuitem);
 
-            if ( ecuitem->getEthIF() == "AnyIP")
-            {
-                connectIPaddress = "0.0.0.0"; // we need to translate AnyIP to 0.0.0.0 on Linux ...
-            }
-
-           /* connect socket signals with window slots */
-            if (ecuitem->socket->state() == QAbstractSocket::UnconnectedState)
-            {
-               disconnect(ecuitem->socket,0,0,0);
-
-               if (  ecuitem->is_multicast == true )
-               {
-                 qDebug()<< "Try to connect (UDP/MC) on" << ecuitem->getEthIF() << GetConnectionType(ecuitem->interfacetype)  << "on port" << ecuitem->getUdpport() << "at" << QDateTime::currentDateTime().toString("hh:mm:ss");
-                 //bindstate = ecuitem->socket->bind(QHostAddress(ecuitem->getmcastIP()), ecuitem->getUdpport(),QUdpSocket::ShareAddress );
-                 bindstate = ecuitem->socket->bind(QHostAddress(connectIPaddress), ecuitem->getUdpport(),QUdpSocket::ShareAddress ) ;
-               }
-               else
-               {
+        switch(ecuitem->interfacetype)
+        {
+        case EcuItem::INTERFACETYPE_TCP:
+            qDebug()<< "Try to connect to ECU" << GetConnectionType(ecuitem->interfacetype) << ecuitem->getHostname() << QDateTime::currentDateTime().toString("hh:mm:ss");
+            break;
+        case EcuItem::INTERFACETYPE_UDP:
+            if (  ecuitem->is_multicast == true )
+                qDebug()<< "Try to connect (UDP/MC) on" << ecuitem->getEthIF() << GetConnectionType(ecuitem->interfacetype)  << "on port" << ecuitem->getUdpport() << "at" << QDateTime::currentDateTime().toString("hh:mm:ss");
+            else
                 qDebug()<< "Try to connect (UDP) to" << ecuitem->getEthIF() << GetConnectionType(ecuitem->interfacetype)  << "on port" << ecuitem->getUdpport() << "at" << QDateTime::currentDateTime().toString("hh:mm:ss");
-                bindstate = ecuitem->socket->bind(QHostAddress(connectIPaddress), ecuitem->getUdpport(),QUdpSocket::ShareAddress ) ;
-               }
-
-               if ( true == bindstate )//ecuitem->socket->bind(QHostAddress(ecuitem->getmcastIP()), ecuitem->getUdpport(),QUdpSocket::ShareAddress ))
-                { // green - success
-                 qDebug() << "Bound to " << ecuitem->getEthIF() << "on port" << ecuitem->getUdpport();
-                 ecuitem->udpsocket.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption,26214400);
-                 ecuitem->tryToConnect = true;
-                 if (  ecuitem->is_multicast == true )
-                 {
-                     QList<QNetworkInterface> 	interfaces  = QNetworkInterface::allInterfaces();
-                     int num;
-                     for(num=0;num<interfaces.length();num++)
-                     {
-                         if(interfaces[num].humanReadableName()==ecuitem->getEthIF())
-                         {
-                             QString multicastAddressArray = ecuitem->getmcastIP();
-                             QStringList multicastAddress = multicastAddressArray.split(QRegularExpression("\\s+"));
-                             for(int i = 0;i<multicastAddress.size();i++)
-                             {
-                                 if(!multicastAddress[i].isEmpty())
-                                 {
-                                     if ( true == ecuitem->udpsocket.joinMulticastGroup(QHostAddress(multicastAddress[i]), interfaces[num]) )
-                                     {
-                                        qDebug() << "Successfully joined multicast group" << multicastAddress[i] << "on interface" << ecuitem->getEthIF();
-                                     }
-                                     else // setting up multicast failed
-                                     {
-                                        ecuitem->connected = false; // unicast socket setup was ok
-                                        ecuitem->connectError.append("Error joining multicast group");
-                                        qDebug() << "Error joining multicast group" << multicastAddress[i] << "on interface" << ecuitem->getEthIF() << ecuitem->socket->errorString();
-                                     }
-                                 }
-                             }
-                             break;
-                         }
-                     }
-                     if(num==interfaces.length())
-                     {
-                         ecuitem->connected = false; // unicast socket setup was ok
-                         ecuitem->connectError.append("Interface not found");
-                         qDebug() << "Error joining multicast group" << ecuitem->getmcastIP() << "on interface" << ecuitem->getEthIF() << ecuitem->socket->errorString();
-                     }
-                 } // multicast
-                 else // unicast case
-                 {
-                     qDebug() <<  "UDP unicast configured to" << ecuitem->getEthIF();
-                 }
-
-                 connect(ecuitem->socket,SIGNAL(connected()),this,SLOT(connected()));
-                 connect(ecuitem->socket,SIGNAL(disconnected()),this,SLOT(disconnected()));
-#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
-                connect(ecuitem->socket, SIGNAL(error(QAbstractSocket::SocketError)), this, SLOT(error(QAbstractSocket::SocketError)));
-#else
-                connect(ecuitem->socket, &QAbstractSocket::errorOccurred, this, &MainWindow::error);
-#endif
-                 connect(ecuitem->socket,SIGNAL(readyRead()),this,SLOT(readyRead()));
-                 connect(ecuitem->socket,SIGNAL(stateChanged(QAbstractSocket::SocketState)),this,SLOT(stateChangedIP(QAbstractSocket::SocketState)));
-                 ecuitem->update();
-                }
-                else
-                {
-                  qDebug() << "Error - binding failed with" << ecuitem->socket->errorString();
-                  ecuitem->connectError.append("Binding failed");
-                  ecuitem->connected = false;
-                  ecuitem->update();
-                }
-            }
+            break;
+        default:
+            qDebug()<< "Try to connect to ECU on serial port" << ecuitem->getPort() << QDateTime::currentDateTime().toString("hh:mm:ss");
+            break;
         }
-        else
-        {
-            /* Serial */
-            if ( NULL == ecuitem->m_serialport )
-            {
-                qDebug()<< "Try to connect to ECU on serial port" << ecuitem->getPort() << QDateTime::currentDateTime().toString("hh:mm:ss");
-                ecuitem->m_serialport = new QSerialPort();
-                if ( NULL != ecuitem->m_serialport )
-                {
-                ecuitem->m_serialport->setBaudRate(ecuitem->getBaudrate(), QSerialPort::AllDirections);
-		ecuitem->m_serialport->setPortName(ecuitem->getPort());
-                ecuitem->m_serialport->setDataBits(QSerialPort::Data8);
-                ecuitem->m_serialport->setParity(QSerialPort::NoParity);
-                ecuitem->m_serialport->setStopBits(QSerialPort::OneStop);
-                ecuitem->m_serialport->setFlowControl(QSerialPort::NoFlowControl);
-                //ecuitem->m_serialport->waitForReadyRead(0); // this lead to immediate crash on Windows and Ubuntu
-                QThread::msleep(10);
-                connect(ecuitem->m_serialport,SIGNAL(readyRead()), this, SLOT(readyRead()));
-                connect(ecuitem->m_serialport,SIGNAL(dataTerminalReadyChanged(bool)),this,SLOT(stateChangedSerial(bool)));
-                //ecuitem->m_serialport->waitForReadyRead(10);
-                }
-             }
-            else // serial port object already exists
-            {
-                //to keep things consistent: delete old member, create new one
-                //alternatively we could just close the port, and set the new settings.
-                ecuitem->m_serialport->close();
-                ecuitem->m_serialport->setBaudRate(ecuitem->getBaudrate());
-                ecuitem->m_serialport->setPortName(ecuitem->getPort());
-            }
-
-            if(ecuitem->m_serialport->isOpen())
-            {
-                ecuitem->m_serialport->close();
-                ecuitem->m_serialport->setBaudRate(ecuitem->getBaudrate());
-            }
 
-            ecuitem->m_serialport->open(QIODevice::ReadWrite);
-
-            if( true == ecuitem->m_serialport->isOpen())
-            {
-                ecuitem->connected = true;
-                ecuitem->update();
-                on_configWidget_itemSelectionChanged();
-                qDebug() << "Open serial port" << ecuitem->getPort();
-                /* send new default log level to ECU, if selected in dlg */
-                if (ecuitem->updateDataIfOnline)
-                {
-                    sendUpdates(ecuitem);
-                }
-
-            }
-        }
+        /* the connection is opened and read by its own thread */
+        ecuitem->ingest = new DltIngestThread(ecuitem, settings->supportDLTv2Decoding);
+        connect(ecuitem->ingest, &DltIngestThread::connected, this, &MainWindow::connected);
+        connect(ecuitem->ingest, &DltIngestThread::disconnected, this, &MainWindow::disconnected);
+        connect(ecuitem->ingest, &DltIngestThread::errorOccurred, this, &MainWindow::error);
+        connect(ecuitem->ingest, &DltIngestThread::stateChanged, this, &MainWindow::stateChanged);
+        connect(ecuitem->ingest, &DltIngestThread::messagesAvailable, this, &MainWindow::readyRead);
+        ecuitem->ingest->start();
 
         if(  (settings->showCtId && settings->showCtIdDesc) || (settings->showApId && settings->showApIdDesc) )
         {
@@ -3762,7 +3690,7 @@ void MainWindow::connected()
     for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
     {
         EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-        if( ecuitem->socket == sender())
+        if( ecuitem->ingest && ecuitem->ingest == sender())
         {
             /* update connection state */
             ecuitem->connected = true;
@@ -3775,7 +3703,19 @@ void MainWindow::connected()
             ecuitem->totalBytesRcvdLastTimeout = 0;
             ecuitem->ipcon.clear();
             ecuitem->serialcon.clear();
-            qDebug()<<"Connected to" << ecuitem->getHostname() << "at" << QDateTime::currentDateTime().toString("hh:mm:ss") << GetConnectionType(ecuitem->interfacetype);
+            if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL_DLT || ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL_ASCII)
+            {
+                qDebug() << "Open serial port" << ecuitem->getPort();
+                /* send new default log level to ECU, if selected in dlg */
+                if (ecuitem->updateDataIfOnline)
+                {
+                    sendUpdates(ecuitem);
+                }
+            }
+            else
+            {
+                qDebug()<<"Connected to" << ecuitem->getHostname() << "at" << QDateTime::currentDateTime().toString("hh:mm:ss") << GetConnectionType(ecuitem->interfacetype);
+            }
         }
     }
 checkConnectionState();
@@ -3846,7 +3786,7 @@ void MainWindow::disconnected()
         EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
         if( ecuitem &&
             (ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP) &&
-            ecuitem->socket == sender())
+            ecuitem->ingest && ecuitem->ingest == sender())
         {
             switch (ecuitem->interfacetype)
             {
@@ -3866,9 +3806,6 @@ void MainWindow::disconnected()
             ecuitem->InvalidAll();
             ecuitem->update();
             on_configWidget_itemSelectionChanged();
-
-            /* disconnect socket signals from window slots */
-            disconnect(ecuitem->socket,0,0,0);
         }
     }
     checkConnectionState();
@@ -3924,7 +3861,7 @@ void MainWindow::timeout()
         checkConnectionState();
 }
 
-void MainWindow::error(QAbstractSocket::SocketError /* socketError */)
+void MainWindow::error(const QString &errorString)
 {
     /* signal emited when connection to host is not possible */
     //qDebug() << "Socket error" << __LINE__ << __FILE__;
@@ -3932,15 +3869,14 @@ void MainWindow::error(QAbstractSocket::SocketError /* socketError */)
     for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
     {
         EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-        if( ecuitem &&
-            (ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP) &&
-            ecuitem->socket == sender())
+        if( ecuitem && ecuitem->ingest && ecuitem->ingest == sender())
         {
-            /* save error */
-            ecuitem->connectError = ecuitem->socket->errorString();
-            qDebug() << "Socket connection error" << ecuitem->socket->errorString() << "for" << ecuitem->getHostname() << "on" << ecuitem->getIpport();// << __LINE__ << __FILE__;
-            /* disconnect socket */
-            ecuitem->socket->disconnectFromHost();
+            /* save error, the connection is closed by the thread */
+            ecuitem->connectError = errorString;
+            if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP)
+                qDebug() << "Socket connection error" << errorString << "for" << ecuitem->getHostname() << "on" << ecuitem->getIpport();// << __LINE__ << __FILE__;
+            else
+                qDebug() << "Serial connection error" << errorString << "on" << ecuitem->getPort();
 
             /* update connection state */
             ecuitem->connected = false;
@@ -3954,35 +3890,58 @@ void MainWindow::error(QAbstractSocket::SocketError /* socketError */)
 
 void MainWindow::readyRead()
 {
-    /* signal emited when socket received data */
+    /* signal emited when a connection received messages */
     //qDebug() << "readyRead" << __LINE__ << __FILE__;
     /* Delay reading, if indexer is working on the dlt file */
     if(true == dltIndexer->tryLock())
     {
-        /* find socket which emited signal */
+        /* read all connections with received messages */
         for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
         {
             EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-            if( ecuitem && (ecuitem->socket == sender() || ecuitem->m_serialport == sender() || dltIndexer == sender() ) && ( true == ecuitem->connected || (ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP ) ) )
+            if( ecuitem && ecuitem->ingest && ecuitem->ingest->hasMessages() )
             {
                 read(ecuitem);
             }
         }
         dltIndexer->unlock();
     }
-    /*
-    else
+
+    /* the connections only notify again after their messages were taken, so read the rest later */
+    for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
+    {
+        EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
+        if( ecuitem && ecuitem->ingest && ecuitem->ingest->hasMessages() )
+        {
+            readTimer.start();
+            break;
+        }
+    }
+}
+
+void MainWindow::stopIngest(EcuItem *ecuitem)
+{
+    if(!ecuitem->ingest)
+        return;
+
+    ecuitem->ingest->requestStop();
+    ecuitem->ingest->wait();
+
+    /* write the messages received until the connection was closed */
+    while(ecuitem->ingest->hasMessages())
     {
-      qDebug() << "Fail locking indexer in readyRead" << __LINE__ << __FILE__;
-      //tbd: have a look why this one is called in commandline / mode File open
+        read(ecuitem);
     }
-    */
 
+    disconnect(ecuitem->ingest, nullptr, this, nullptr);
+    delete ecuitem->ingest;
+    ecuitem->ingest = nullptr;
 }
 
 void MainWindow::writeDLTMessageToFile(const QByteArray& bufferHeader, std::string_view payload,
-                                       const EcuItem* ecuitem) {
-    DltStorageHeader str = QDltImporter::makeDltStorageHeader();
+                                       const EcuItem* ecuitem,
+                                       std::optional<QDltImporter::DltStorageHeaderTimestamp> timestamp) {
+    DltStorageHeader str = QDltImporter::makeDltStorageHeader(timestamp);
     if (ecuitem)
         dlt_set_id(str.ecu, ecuitem->id.toLatin1());
 
@@ -4001,226 +3960,156 @@ void MainWindow::writeDLTMessageToFile(const QByteArray& bufferHeader, std::stri
     if( settings->splitlogfile != 0) // only in case the file size limit checking is active ...
      {
      // check if files size limit reached ( see Settings->Project Other->Maximum File Size )
-     if( ( ((outputfile.size()+sizeof(DltStorageHeader)+bufferHeader.size()+ payload.size())) > settings->fmaxFileSizeMB *1000*1000) )
+     // the size of the writer contains the buffered messages, which are not in the file yet
+     if( ( ((outputWriter.size()+sizeof(DltStorageHeader)+bufferHeader.size()+ payload.size())) > settings->fmaxFileSizeMB *1000*1000) )
       {
         createsplitfile();
       }
     }
 
-    // write data into file
+    // the messages are written to the file in large blocks by the writer
+    if(!openOutputWriter())
+    {
+        return;
+    }
+
     if(!ecuitem || !ecuitem->getWriteDLTv2StorageHeader())
     {
         // write version 1 storage header
-        outputfile.write((char*)&str,sizeof(DltStorageHeader));
+        outputWriter.writeMessage(str, bufferHeader, payload);
     }
     else
     {
         // write version 2 storage header
-        outputfile.write((char*)"DLT",3);
-        quint8 version = 2;
-        outputfile.write((char*)&version,1);
-        quint32 nanoseconds = str.microseconds * 1000ul; // not in big endian format
-        outputfile.write((char*)&nanoseconds,4);
-        quint64 seconds = (quint64) str.seconds; // not in big endian format
-        outputfile.write(((char*)&seconds),5);
-        quint8 length;
-        length = ecuitem->id.length();
-        outputfile.write((char*)&length,1);
-        outputfile.write(ecuitem->id.toLatin1(),ecuitem->id.length());
-    }
-    outputfile.write(bufferHeader);
-    outputfile.write(payload.data(), payload.size());
-    outputfile.flush();
-    //outputfile.close();  // This slows down online tracing, keep open while online tracing
+        outputWriter.writeMessageV2(str, ecuitem->id.toLatin1(), bufferHeader, payload);
+    }
 }
 
-void MainWindow::read(EcuItem* ecuitem)
+bool MainWindow::openOutputWriter()
 {
-    int udpMessageCounter = 0;
-    long int bytesRcvd = 0;
-
-    if (nullptr == ecuitem)
+    if(outputWriter.isOpen() && outputWriter.getFileName() == outputfile.fileName())
     {
-       qDebug() << "Invalid ECU given in" << __FILE__ << "Line:" << __LINE__;
-       return;
+        return true;
     }
 
-    qmsg.clear();
-    data.clear();
+    return outputWriter.open(outputfile.fileName());
+}
 
-    switch (ecuitem->interfacetype)
-     {
-      case EcuItem::INTERFACETYPE_TCP:
-          /* TCP */
-          data = ecuitem->socket->readAll();
-          bytesRcvd = data.size();
-          //qDebug() << "bytes received" << bytesRcvd;
-          ecuitem->ipcon.add(data);
-          break;
-      case EcuItem::INTERFACETYPE_UDP:
-          while(ecuitem->udpsocket.hasPendingDatagrams() && udpMessageCounter<100)
-          {
-            data.resize(ecuitem->udpsocket.pendingDatagramSize());
-            bytesRcvd = ecuitem->udpsocket.readDatagram( data.data(), data.size() );
-            //qDebug() << "bytes received" << bytesRcvd;
-            unsigned int dataSize = data.size();
-            const char* dataPtr = data.data();
-            // Find one or more DLT messages in the UDP message
-            while(dataSize>0)
-            {
-                quint32 sizeMsg = qmsg.checkMsgSize(dataPtr,dataSize,settings->supportDLTv2Decoding);
-                if(sizeMsg>0)
-                {
-                    // DLT message found, write it with storage header
-                    QByteArray empty;
-                    if(settings->loggingOnlyFilteredMessages)
-                    {
-                        // write only messages which match filter
-                        bool silentMode = !QDltOptManager::getInstance()->issilentMode();
-                        QDltMsg qmsg;
-                        qmsg.setMsg(QByteArray(dataPtr,sizeMsg),false,settings->supportDLTv2Decoding);
-                        if ( true == pluginsEnabled ) // we check the general plugin enabled/disabled switch
-                        {
-                           pluginManager.decodeMsg(qmsg,silentMode);
-                        }
-                        if(qfile.checkFilter(qmsg))
-                        {
-                            writeDLTMessageToFile(empty,{dataPtr,sizeMsg}, ecuitem);
-                        }
-                    }
-                    else
-                    {
-                        // write all messages
-                        writeDLTMessageToFile(empty, {dataPtr,sizeMsg}, ecuitem);
-                    }
-                    totalBytesRcvd+=sizeMsg;
-                    if(sizeMsg<=dataSize)
-                    {
-                        dataSize -= sizeMsg;
-                        dataPtr += sizeMsg;
-                    }
-                    else
-                    {
-                        dataSize = 0;
-                    }
-                }
-                else
-                {
-                    dataSize = 0;
-                }
-            }
-            //ecuitem->ipcon.add(data);
-            ecuitem->connected= true;
-            ecuitem->tryToConnect = true;
-            ecuitem->update();
-            udpMessageCounter++;
+void MainWindow::outputWritten()
+{
+    outputWrittenPending = false;
 
-            /* analyse received message, check if DLT control message response */
-            /*if(qmsg.setMsg(data,false))
-            {
-                if ( (qmsg.getType()==QDltMsg::DltTypeControl) && (qmsg.getSubtype()==QDltMsg::DltControlResponse))
-                {
-                    controlMessage_ReceiveControlMessage(ecuitem,qmsg);
-                }
-            }*/
-          }
-          break;
-      case EcuItem::INTERFACETYPE_SERIAL_DLT:
-      case EcuItem::INTERFACETYPE_SERIAL_ASCII:
-          data = ecuitem->m_serialport->readAll();
-          bytesRcvd = data.size();
-          ecuitem->serialcon.add(data);
-          break;
-      default:
-         break;
-     }
+    /* read the written messages in DLT file parser and update DLT message list view */
+    /* Delay reading, if indexer is working on the dlt file */
+    bool updated = false;
+    if(true == dltIndexer->tryLock())
+    {
+        if(false == dltIndexer->isIndexing())
+        {
+            updateIndex();
+            updated = true;
+        }
+        dltIndexer->unlock();
+    }
 
+    /* The messages stay kept by the writer, the update is run again when the indexer or the search is finished */
+    outputWrittenDelayed = !updated;
+}
 
-    if (bytesRcvd <= 0 && ecuitem->connected == false)
+void MainWindow::read(EcuItem* ecuitem)
+{
+    if (nullptr == ecuitem || nullptr == ecuitem->ingest)
     {
-      qDebug() << "ERROR: bytesRcvd <= 0 in " << __LINE__ << __FILE__;
-      return;
+       qDebug() << "Invalid ECU given in" << __FILE__ << "Line:" << __LINE__;
+       return;
     }
 
-    /* reading data; new data is added to the current buffer */
-     ecuitem->totalBytesRcvd += bytesRcvd;
+    /* take a limited number of messages, so the user interface stays responsive */
+    ecuitem->ingest->takeMessages(ingestMessages, DLT_INGEST_READ_BATCH_SIZE);
+
+    unsigned long bytesRead, bytesReceived, bytesError, syncFound, datagramsDropped;
+    ecuitem->ingest->takeStatistics(bytesRead, bytesReceived, bytesError, syncFound, datagramsDropped);
 
-     while(((ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP) && ecuitem->ipcon.parseDlt(qmsg,settings->supportDLTv2Decoding)) ||
-            (ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL_DLT && ecuitem->serialcon.parseDlt(qmsg,settings->supportDLTv2Decoding)) ||
-            (ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL_ASCII && ecuitem->serialcon.parseAscii(qmsg)) )
+    for(const DltIngestThread::Message &message : std::as_const(ingestMessages))
+    {
+        if(message.sizes.isEmpty())
+        {
+            const std::string_view payload(message.payload.constData(), static_cast<std::string_view::size_type>(message.payload.size()));
+            readMessage(ecuitem, message.header, payload, message.controlResponse, message.timestamp);
+        }
+        else
         {
-            /* analyse received message, check if DLT control message response */
-            if ( (qmsg.getType()==QDltMsg::DltTypeControl) && (qmsg.getSubtype()==QDltMsg::DltControlResponse))
+            /* several messages received in one batch, each is written directly from the batch */
+            const char *data = message.payload.constData();
+            for(const quint32 size : message.sizes)
             {
-                controlMessage_ReceiveControlMessage(ecuitem,qmsg);
+                readMessage(ecuitem, QByteArray(), std::string_view(data, size), message.controlResponse, message.timestamp);
+                data += size;
             }
+        }
+    }
 
-            /* write message to file */
-            const QByteArray bufferHeader = qmsg.getHeader();
-            const QByteArray bufferPayload = qmsg.getPayload();
-            if(settings->loggingOnlyFilteredMessages)
-            {
-                // write only messages which match filter
-                bool silentMode = !QDltOptManager::getInstance()->issilentMode();
-                if ( true == pluginsEnabled ) // we check the general plugin enabled/disabled switch
-                {
-                   pluginManager.decodeMsg(qmsg,silentMode);
-                }
-                if(qfile.checkFilter(qmsg))
-                {
-                    writeDLTMessageToFile(
-                                bufferHeader,
-                                {bufferPayload.data(),
-                                 static_cast<std::string_view::size_type>(bufferPayload.size())},
-                                ecuitem);
-                }
-            }
-            else
-            {
-                // write all messages
-                writeDLTMessageToFile(
-                            bufferHeader,
-                            {bufferPayload.data(),
-                             static_cast<std::string_view::size_type>(bufferPayload.size())},
-                            ecuitem);
-            }
+    /* UDP has no connection, it is online when messages are received */
+    if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP && !ingestMessages.isEmpty() && ecuitem->tryToConnect)
+    {
+        if(false == ecuitem->connected)
+        {
+            ecuitem->connected = true;
+            ecuitem->update();
+        }
+    }
+    ingestMessages.clear();
 
-        } //end while
+    ecuitem->totalBytesRcvd += bytesRead;
+    totalBytesRcvd += bytesReceived;
+    totalByteErrorsRcvd += bytesError;
+    totalSyncFoundRcvd += syncFound;
+    totalDatagramsDropped += datagramsDropped;
 
-     if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP)
-        {
-            /* TCP or UDP */
-            totalByteErrorsRcvd+=ecuitem->ipcon.bytesError;
-            ecuitem->ipcon.bytesError = 0;
-            totalBytesRcvd+=ecuitem->ipcon.bytesReceived;
-            //qDebug() << "totalBytesRcvd" << totalBytesRcvd;
-            ecuitem->ipcon.bytesReceived = 0;
-            totalSyncFoundRcvd+=ecuitem->ipcon.syncFound;
-            ecuitem->ipcon.syncFound = 0;
-         }
-       else if(ecuitem->m_serialport)
-         {
-            /* serial */
-            totalByteErrorsRcvd+=ecuitem->serialcon.bytesError;
-            ecuitem->serialcon.bytesError = 0;
-            totalBytesRcvd+=ecuitem->serialcon.bytesReceived;
-            ecuitem->serialcon.bytesReceived = 0;
-            totalSyncFoundRcvd+=ecuitem->serialcon.syncFound;
-            ecuitem->serialcon.syncFound = 0;
-         }
+    /* the index is updated, when the writer has written the messages to the file */
+}
 
-     //if(outputfile.isOpen()) //&& ( settings->loggingOnlyMode == 0 )  )
-     //   {
-            if(false == dltIndexer->isRunning())
-            {
-                updateIndex();
-            }
-     //   }
+void MainWindow::readMessage(EcuItem* ecuitem, const QByteArray &header, std::string_view payload, bool controlResponse, const QDltImporter::DltStorageHeaderTimestamp &timestamp)
+{
+    /* analyse received message, check if DLT control message response */
+    if(controlResponse || settings->loggingOnlyFilteredMessages)
+    {
+        QByteArray buffer(header);
+        buffer.append(payload.data(), static_cast<int>(payload.size()));
+        qmsg.setMsg(buffer, false, settings->supportDLTv2Decoding);
+    }
+    if(controlResponse)
+    {
+        controlMessage_ReceiveControlMessage(ecuitem,qmsg);
+    }
+
+    /* write message to file */
+    if(settings->loggingOnlyFilteredMessages)
+    {
+        // write only messages which match filter
+        bool silentMode = !QDltOptManager::getInstance()->issilentMode();
+        if ( true == pluginsEnabled ) // we check the general plugin enabled/disabled switch
+        {
+           pluginManager.decodeMsg(qmsg,silentMode);
+        }
+        if(qfile.checkFilter(qmsg))
+        {
+            writeDLTMessageToFile(header, payload, ecuitem, timestamp);
+        }
+    }
+    else
+    {
+        // write all messages
+        writeDLTMessageToFile(header, payload, ecuitem, timestamp);
+    }
 }
 
 
 void MainWindow::createsplitfile()
 {
+    // write all messages of the old file, before it is copied
+    outputWriter.flush();
+
     // get new filename
     dltIndexer->stop();
     QFileInfo info(outputfile.fileName());
@@ -4249,6 +4138,7 @@ void MainWindow::SplitTriggered(QString fileName)
     workingDirectory.setDltDirectory(QFileInfo(fileName).absolutePath());
 
     // close existing file
+    outputWriter.close();
     if(outputfile.isOpen())
     {
         //qDebug() << "isOpen" << fileName << __FILE__ << __LINE__;
@@ -4258,6 +4148,7 @@ void MainWindow::SplitTriggered(QString fileName)
         }
         else
         {
+            outputWriter.close();
             outputfile.close();
         }
     }
@@ -4274,6 +4165,7 @@ void MainWindow::SplitTriggered(QString fileName)
         openFileNames = QStringList(fileName);
         isDltFileReadOnly = false;
         reloadLogFile(false,true);
+        outputWriter.close();
         outputfile.close(); // open later again when writing
      }
     else
@@ -4304,14 +4196,51 @@ void MainWindow::updateIndex()
     activeViewerPlugins = pluginManager.getViewerPlugins();
     pluginsEnabled = dltIndexer->getPluginsEnabled();
 
-    /* read received messages in DLT file parser and update DLT message list view */
-    /* update indexes  and table view */
+    /* take the received messages written to the output file since the last update */
+    outputWriter.takeWrittenMessages(writtenData, writtenMessages);
+
     int oldsize = qfile.size();
-    qfile.updateIndex();
+    const int numberOfFiles = qfile.getNumberOfFiles();
+    const bool liveOutput = numberOfFiles > 0 && outputWriter.isOpen() &&
+                            qfile.getFileName(numberOfFiles - 1) == outputWriter.getFileName();
+
+    /* the written messages can be appended to the index, if they directly follow the last indexed message */
+    bool inSync = liveOutput && liveIndexEnd >= 0 && liveIndexSize == oldsize && !writtenMessages.empty();
+    qint64 end = liveIndexEnd;
+    for(size_t num = 0; inSync && num < writtenMessages.size(); num++)
+    {
+        inSync = writtenMessages[num].pos == end;
+        end += writtenMessages[num].size;
+    }
+    /* the writer drops the kept messages, if the file was written otherwise, check it was not truncated or replaced */
+    if(inSync && QFileInfo(qfile.getFileName(numberOfFiles - 1)).size() < end)
+    {
+        inSync = false;
+    }
+
+    size_t live = 0;
+    size_t offset = 0;
+    if(!inSync)
+    {
+        /* read received messages in DLT file parser and update DLT message list view */
+        /* update indexes  and table view */
+        qfile.updateIndex();
+
+        /* the written messages are already in the file, continue behind the last one found */
+        liveIndexEnd = -1;
+        const qint64 lastPos = liveOutput ? qfile.getLastIndexPos() : std::numeric_limits<qint64>::max();
+        for(; live < writtenMessages.size() && writtenMessages[live].pos <= lastPos; live++)
+        {
+            if(writtenMessages[live].pos == lastPos)
+                liveIndexEnd = lastPos + writtenMessages[live].size;
+            offset += static_cast<size_t>(writtenMessages[live].size);
+        }
+    }
+    const int scannedSize = qfile.size();
 
     bool silentMode = !QDltOptManager::getInstance()->issilentMode();
 
-    if(oldsize!=qfile.size())
+    if(oldsize != scannedSize || (live < writtenMessages.size() && writtenMessages[live].pos == liveIndexEnd))
     {
         // only run through viewer plugins, if new messages are added
         for(int i = 0; i < activeViewerPlugins.size(); i++)
@@ -4321,39 +4250,39 @@ void MainWindow::updateIndex()
         }
     }
 
-    for(int num=oldsize;num<qfile.size();num++)
+    for(int num=oldsize;num<scannedSize;num++)
     {
-     qmsg.setMsg(qfile.getMsg(num),true,settings->supportDLTv2Decoding);
-     qmsg.setIndex(num);
+        qmsg.setMsg(qfile.getMsg(num),true,settings->supportDLTv2Decoding);
+        updateIndexMsg(num, qmsg, activeViewerPlugins, silentMode);
+    }
 
-     if ( true == pluginsEnabled ) // we check the general plugin enabled/disabled switch
-     {
-     for(int i = 0; i < activeViewerPlugins.size(); i++)
-      {
-            item = activeViewerPlugins.at(i);
-            item->updateMsg(num,qmsg);
-      }
-     }
+    /* parse the written messages from memory and append them to the index */
+    for(; live < writtenMessages.size(); live++)
+    {
+        const QDltFileWriter::WrittenMessage &message = writtenMessages[live];
+        if(message.pos != liveIndexEnd)
+        {
+            /* a gap, the messages are found by reading the file with the next update */
+            liveIndexEnd = -1;
+            break;
+        }
 
-     if ( true == pluginsEnabled ) // we check the general plugin enabled/disabled switch
-      {
-        pluginManager.decodeMsg(qmsg,silentMode);
-      }
+        const bool valid = qmsg.setMsg(QByteArray::fromRawData(writtenData.data() + offset, message.size),true,settings->supportDLTv2Decoding);
+        offset += static_cast<size_t>(message.size);
 
-     if(qfile.checkFilter(qmsg))
-      {
-            qfile.addFilterIndex(num);
-      }
+        if(!qfile.appendIndex(message.pos, valid ? &qmsg : nullptr))
+        {
+            /* the index was updated otherwise, read the file with the next update */
+            liveIndexEnd = -1;
+            break;
+        }
+        liveIndexEnd = message.pos + message.size;
 
-     if ( true == pluginsEnabled ) // we check the general plugin enabled/disabled switch
-     {
-     for(int i = 0; i < activeViewerPlugins.size(); i++)
-      {
-            item = activeViewerPlugins[i];
-            item->updateMsgDecoded(num,qmsg);
-      }
-     }
+        updateIndexMsg(qfile.size() - 1, qmsg, activeViewerPlugins, silentMode);
     }
+    liveIndexSize = qfile.size();
+    writtenData.clear();
+    writtenMessages.clear();
 
     if(oldsize!=qfile.size())
     {
@@ -4366,11 +4295,47 @@ void MainWindow::updateIndex()
     }
 }
 
+void MainWindow::updateIndexMsg(int num, QDltMsg &qmsg, const QList<QDltPlugin*> &activeViewerPlugins, bool silentMode)
+{
+    QDltPlugin *item = 0;
+
+    qmsg.setIndex(num);
+
+    if ( true == pluginsEnabled ) // we check the general plugin enabled/disabled switch
+    {
+        for(int i = 0; i < activeViewerPlugins.size(); i++)
+        {
+            item = activeViewerPlugins.at(i);
+            item->updateMsg(num,qmsg);
+        }
+    }
+
+    if ( true == pluginsEnabled ) // we check the general plugin enabled/disabled switch
+    {
+        pluginManager.decodeMsg(qmsg,silentMode);
+    }
+
+    if(qfile.checkFilter(qmsg))
+    {
+        qfile.addFilterIndex(num);
+    }
+
+    if ( true == pluginsEnabled ) // we check the general plugin enabled/disabled switch
+    {
+        for(int i = 0; i < activeViewerPlugins.size(); i++)
+        {
+            item = activeViewerPlugins[i];
+            item->updateMsgDecoded(num,qmsg);
+        }
+    }
+}
+
 void MainWindow::drawUpdatedView()
 {
     statusByteErrorsReceived->setText(QString("Recv Errors: %L1").arg(totalByteErrorsRcvd));
     statusBytesReceived->setText(QString("Recv: %L1").arg(totalBytesRcvd));
     statusSyncFoundReceived->setText(QString("Sync found: %L1").arg(totalSyncFoundRcvd));
+    statusDatagramsDropped->setText(QString("UDP dropped: %L1").arg(totalDatagramsDropped));
 
     tableModel->modelChanged();
 
@@ -4586,8 +4551,9 @@ void MainWindow::controlMessage_SendControlMessage(EcuItem* ecuitem,DltMessage &
     msg.headersize = sizeof(DltStorageHeader) + sizeof(DltStandardHeader) + sizeof(DltExtendedHeader) + DLT_STANDARD_HEADER_EXTRA_SIZE(msg.standardheader->htyp);
     msg.standardheader->len = DLT_HTOBE_16(msg.headersize - sizeof(DltStorageHeader) + msg.datasize);
 
-    /* send message to daemon */
-    if ((ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP) && ecuitem->socket->isOpen())
+    /* send message to daemon, the data is written by the thread of the connection */
+    const bool connectionOpen = ecuitem->ingest && ecuitem->ingest->isOpen();
+    if ((ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP) && connectionOpen)
     {
         QByteArray tmpBuf;
 
@@ -4599,24 +4565,29 @@ void MainWindow::controlMessage_SendControlMessage(EcuItem* ecuitem,DltMessage &
         tmpBuf.append((const char*)msg.headerbuffer+sizeof(DltStorageHeader),msg.headersize-sizeof(DltStorageHeader));
         tmpBuf.append((const char*)msg.databuffer,msg.datasize);
 
-        ecuitem->socket->write(tmpBuf);
+        ecuitem->ingest->send(tmpBuf);
     }
-    else if (ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL_DLT && ecuitem->m_serialport && ecuitem->m_serialport->isOpen())
+    else if (ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL_DLT && connectionOpen)
     {
+        QByteArray tmpBuf;
+
         /* Optional: Send serial header, if requested */
         if (ecuitem->getSendSerialHeaderSerial())
-            ecuitem->m_serialport->write((const char*)dltSerialHeader,sizeof(dltSerialHeader));
+            tmpBuf.append((const char*)dltSerialHeader,sizeof(dltSerialHeader));
 
         /* Send data */
-        ecuitem->m_serialport->write((const char*)msg.headerbuffer+sizeof(DltStorageHeader),msg.headersize-sizeof(DltStorageHeader));
-        ecuitem->m_serialport->write((const char*)msg.databuffer,msg.datasize);
+        tmpBuf.append((const char*)msg.headerbuffer+sizeof(DltStorageHeader),msg.headersize-sizeof(DltStorageHeader));
+        tmpBuf.append((const char*)msg.databuffer,msg.datasize);
+
+        ecuitem->ingest->send(tmpBuf);
     }
-    else if (ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL_ASCII && ecuitem->m_serialport && ecuitem->m_serialport->isOpen())
+    else if (ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL_ASCII && connectionOpen)
     {
         /* In SERIAL_ASCII mode we send only user input */
         if (appid == "SER" && contid == "CON") {
-            ecuitem->m_serialport->write((const char*)(msg.databuffer+8),(msg.datasize-8));
-            ecuitem->m_serialport->write("\r\n");
+            QByteArray tmpBuf((const char*)(msg.databuffer+8),(msg.datasize-8));
+            tmpBuf.append("\r\n");
+            ecuitem->ingest->send(tmpBuf);
         }
         else
         {
@@ -4638,14 +4609,18 @@ void MainWindow::controlMessage_SendControlMessage(EcuItem* ecuitem,DltMessage &
     }
     if(dltIndexer->tryLock())
     {
-        /* store ctrl message in log file */
-        outputfile.write((const char*)msg.headerbuffer,msg.headersize);
-        outputfile.write((const char*)msg.databuffer,msg.datasize);
-        outputfile.flush();
+        /* store ctrl message in log file, after the messages already buffered */
+        if(openOutputWriter())
+        {
+            outputWriter.writeMessage(*(DltStorageHeader*)msg.headerbuffer,
+                                      QByteArray::fromRawData((const char*)msg.headerbuffer + sizeof(DltStorageHeader), msg.headersize - sizeof(DltStorageHeader)),
+                                      std::string_view((const char*)msg.databuffer, msg.datasize));
+            outputWriter.flush();
+        }
 
         /* read received messages in DLT file parser and update DLT message list view */
         /* update indexes  and table view */
-        if(!dltIndexer->isRunning())
+        if(!dltIndexer->isIndexing())
             updateIndex();
 
         dltIndexer->unlock();
@@ -4713,16 +4688,18 @@ void MainWindow::controlMessage_WriteControlMessage(DltMessage &msg, QString app
     }
     if(dltIndexer->tryLock())
     {
-        /* store ctrl message in log file */
-        // https://bugreports.qt-project.org/browse/QTBUG-26069
-        outputfile.seek(outputfile.size());
-        outputfile.write((const char*)msg.headerbuffer,msg.headersize);
-        outputfile.write((const char*)msg.databuffer,msg.datasize);
-        outputfile.flush();
+        /* store ctrl message in log file, after the messages already buffered */
+        if(openOutputWriter())
+        {
+            outputWriter.writeMessage(*(DltStorageHeader*)msg.headerbuffer,
+                                      QByteArray::fromRawData((const char*)msg.headerbuffer + sizeof(DltStorageHeader), msg.headersize - sizeof(DltStorageHeader)),
+                                      std::string_view((const char*)msg.databuffer, msg.datasize));
+            outputWriter.flush();
+        }
 
         /* read received messages in DLT file parser and update DLT message list view */
         /* update indexes  and table view */
-        if(!dltIndexer->isRunning())
+        if(!dltIndexer->isIndexing())
             updateIndex();
 
         dltIndexer->unlock();
@@ -5768,54 +5745,20 @@ void MainWindow::sendUpdates(EcuItem* ecuitem)
 
 }
 
-void MainWindow::stateChangedSerial(bool dsrChanged){
-    /* signal emited when connection state changed */
-
-    /* find socket which emited signal */
-    for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
-    {
-        EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-        if( ecuitem->m_serialport == sender())
-        {
-            /* update ECU item */
-            ecuitem->update();
-
-            if(dsrChanged)
-            {
-                /* send new default log level to ECU, if selected in dlg */
-                if (ecuitem->updateDataIfOnline)
-                {
-                    sendUpdates(ecuitem);
-                }
-            }
-
-            if(dsrChanged)
-            {
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionOnline,ecuitem->getHostname());
-            }
-            else
-            {
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionOffline,ecuitem->getHostname());
-            }
-
-        }
-    }
-}
-
-void MainWindow::stateChangedIP(QAbstractSocket::SocketState socketState)
+void MainWindow::stateChanged(int state)
 {
     /* signal emited when connection state changed */
-    //qDebug() << "stateChangedIP" << socketState << __LINE__ << __FILE__;
-    /* find socket which emited signal */
+    //qDebug() << "stateChanged" << state << __LINE__ << __FILE__;
+    /* find connection which emited signal */
     for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
     {
         EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-        if( ecuitem && ecuitem->socket == sender())
+        if( ecuitem && ecuitem->ingest && ecuitem->ingest == sender())
         {
             /* update ECU item */
             ecuitem->update();
 
-            if (socketState==QAbstractSocket::ConnectedState)
+            if (state == QDltConnection::QDltConnectionOnline)
             {
                 /* send new default log level to ECU, if selected in dlg */
                 if (ecuitem->updateDataIfOnline)
@@ -5824,23 +5767,7 @@ void MainWindow::stateChangedIP(QAbstractSocket::SocketState socketState)
                 }
             }
 
-            switch(socketState){
-            case QAbstractSocket::UnconnectedState:
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionOffline,ecuitem->getHostname());
-                break;
-            case QAbstractSocket::ConnectingState:
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionConnecting,ecuitem->getHostname());
-                break;
-            case QAbstractSocket::ConnectedState:
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionOnline,ecuitem->getHostname());
-                break;
-            case QAbstractSocket::ClosingState:
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionOffline,ecuitem->getHostname());
-                break;
-            default:
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionOffline,ecuitem->getHostname());
-                break;
-            }
+            pluginManager.stateChanged(num,(QDltConnection::QDltConnectionState)state,ecuitem->getHostname());
         }
     }
 }
@@ -7104,6 +7031,13 @@ void MainWindow::dropEvent(QDropEvent *event)
     QString filename;
     QStringList filenames;
 
+    /* the search threads read the file, it cannot be replaced now */
+    if(true == isSearchOngoing)
+    {
+        event->ignore();
+        return;
+    }
+
     if (event->mimeData()->hasUrls())
     {
         QStringList importFilenames;
@@ -7712,7 +7646,6 @@ void MainWindow::searchTableRenewed()
         ui->dockWidgetSearchIndex->show();
         ui->dockWidgetSearchIndex->setWindowTitle(hits);
     }
-    m_searchtableModel->modelChanged();
 }
 
 
@@ -7875,6 +7808,17 @@ void MainWindow::onSearchProgressChanged(bool isInProgress)
     searchInput->setState(isInProgress ? SearchForm::State::PROGRESS : SearchForm::State::INPUT);
 
     ui->dockWidgetProject->setEnabled(!isInProgress);
+
+    /* run what was delayed, while the search threads read the file */
+    if(!isInProgress && reloadAfterSearch)
+    {
+        reloadAfterSearch = false;
+        reloadLogFile(reloadAfterSearchUpdate, reloadAfterSearchMultithreaded);
+    }
+    else if(!isInProgress && outputWrittenDelayed)
+    {
+        QMetaObject::invokeMethod(this, "outputWritten", Qt::QueuedConnection);
+    }
 }
 
 QString MainWindow::GetConnectionType(int iTypeNumber)
@@ -7907,6 +7851,12 @@ void MainWindow::indexDone()
 {
     qint64 fileerrors = dltIndexer->getfileerrors();
     statusFileError->setText(QString("FileErr: %L1").arg(fileerrors));
+
+    /* add the messages written while the indexer was running */
+    if(outputWrittenDelayed && !isSearchOngoing)
+    {
+        QMetaObject::invokeMethod(this, "outputWritten", Qt::QueuedConnection);
+    }
 }
 
 void MainWindow::indexStart()
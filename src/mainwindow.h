@@ -49,6 +49,10 @@
 #include "searchtablemodel.h"
 #include "ui_mainwindow.h"
 #include "searchform.h"
+#include "dltingestthread.h"
+#include "qdltfilewriter.h"
+
+#include <atomic>
 
 /**
  * @brief Namespace to contain the toolbar positions.
@@ -123,8 +127,20 @@ private:
     /* Timer for draw Event */
     QTimer drawTimer;
 
+    /* Timer for reading messages left by the connections */
+    QTimer readTimer;
+
     QDltControl qcontrol;
     QFile outputfile;
+    QDltFileWriter outputWriter;
+    std::atomic<bool> outputWrittenPending{false};
+    /* Received messages written to the output file, appended to the index without reading the file again */
+    std::vector<char> writtenData;
+    std::vector<QDltFileWriter::WrittenMessage> writtenMessages;
+    /* End of the last written message in the index, -1 if the index must be updated by reading the file */
+    qint64 liveIndexEnd{-1};
+    /* Number of messages in the index, when liveIndexEnd was set */
+    int liveIndexSize{0};
     bool outputfileIsTemporary;
     bool outputfileIsFromCLI;
     TableModel *tableModel;
@@ -139,11 +155,13 @@ private:
     QLabel *statusBytesReceived;
     QLabel *statusByteErrorsReceived;
     QLabel *statusSyncFoundReceived;
+    QLabel *statusDatagramsDropped;
     QProgressBar *statusProgressBar;
 
     unsigned long totalBytesRcvd;
     unsigned long totalByteErrorsRcvd;
     unsigned long totalSyncFoundRcvd;
+    unsigned long totalDatagramsDropped;
 
     /* Search */
     SearchDialog *searchDlg;
@@ -214,7 +232,7 @@ private:
     quint16 senderPort; // in readdatagramm
 
     /* used in ::read() */
-    QByteArray data;
+    QVector<DltIngestThread::Message> ingestMessages;
     QDltMsg qmsg;
 
     /* dlt-file Indexer with cancel cabability */
@@ -224,6 +242,12 @@ private:
     QColor pulseButtonColor;
 
     bool isSearchOngoing;
+    /* Reload requested while the search threads read the file, done when the search is finished */
+    bool reloadAfterSearch{false};
+    bool reloadAfterSearchUpdate{false};
+    bool reloadAfterSearchMultithreaded{false};
+    /* Update of the index delayed, because the file was locked */
+    bool outputWrittenDelayed{false};
 
     /* DLT File opened only Read only */
     bool isDltFileReadOnly;
@@ -291,7 +315,11 @@ private:
     void disconnectECU(EcuItem *ecuitem);
     void checkConnectionState();
     void read(EcuItem *ecuitem);
+    void readMessage(EcuItem *ecuitem, const QByteArray &header, std::string_view payload, bool controlResponse, const QDltImporter::DltStorageHeaderTimestamp &timestamp);
+    void stopIngest(EcuItem *ecuitem);
+    bool openOutputWriter();
     void updateIndex();
+    void updateIndexMsg(int num, QDltMsg &qmsg, const QList<QDltPlugin*> &activeViewerPlugins, bool silentMode);
     void drawUpdatedView();
 
     void syncCheckBoxesAndMenu();
@@ -367,7 +395,8 @@ private:
     void resetDefaultFilter();
 
     void writeDLTMessageToFile(const QByteArray& bufferHeader, std::string_view payload,
-                               const EcuItem* ecuitem);
+                               const EcuItem* ecuitem,
+                               std::optional<QDltImporter::DltStorageHeaderTimestamp> timestamp = std::nullopt);
 
 
 protected:
@@ -527,8 +556,9 @@ private slots:
     void filterAddTable();
     void connected();
     void disconnected();
-    void error(QAbstractSocket::SocketError);
+    void error(const QString &errorString);
     void readyRead();
+    void outputWritten();
     void timeout();
     void connectAll();
     void disconnectAll();
@@ -538,8 +568,7 @@ private slots:
     void openRecentProject();
     void openRecentFilters();
     void applyConfigEnabled(bool enabled);
-    void stateChangedIP(QAbstractSocket::SocketState socketState);
-    void stateChangedSerial(bool dsrChanged);
+    void stateChanged(int state);
     void sectionInTableDoubleClicked(int logicalIndex);
     void on_actionJump_To_triggered();
     void on_actionAutoScroll_triggered(bool checked);
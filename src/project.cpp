@@ -24,6 +24,7 @@
 #include <QHeaderView>
 
 #include "project.h"
+#include "dltingestthread.h"
 #include "dltuiutils.h"
 #include "dlt_user.h"
 #include "qdltoptmanager.h"
@@ -34,7 +35,7 @@ const char *traceinfo[] = {"default","off","on"};
 
 EcuItem::EcuItem(QTreeWidgetItem *parent)
 : QTreeWidgetItem(parent,ecu_type)
-, socket(0)
+, ingest(0)
 {
     /* initialise receive buffer and message*/
     id = default_id;
@@ -68,12 +69,6 @@ EcuItem::EcuItem(QTreeWidgetItem *parent)
 
     status = EcuItem::unknown;
 
-    m_serialport = 0;
-
-    /* Limit size of socket receiption buffer to limit application buffer size */
-    /* qt sets buffer normally to unlimited */
-    //socket.setReadBufferSize(64000);
-
     autoReconnectTimestamp = QDateTime::currentDateTime();
 
     writeDLTv2StorageHeader = false;
@@ -81,7 +76,8 @@ EcuItem::EcuItem(QTreeWidgetItem *parent)
 
 EcuItem::~EcuItem()
 {
-
+    /* closes the connection */
+    delete ingest;
 }
 
 void EcuItem::update()
@@ -133,7 +129,6 @@ void EcuItem::update()
         case EcuItem::INTERFACETYPE_TCP:
 
             setData(1,Qt::DisplayRole,QString("%1 [TCP %2:%3]").arg(description).arg(hostname).arg(ipport));
-            socket = & tcpsocket;
             break;
         case EcuItem::INTERFACETYPE_UDP:
             if ( true == is_multicast)
@@ -144,12 +139,10 @@ void EcuItem::update()
             {
             setData(1,Qt::DisplayRole,QString("%1 [UDP %2:%3]").arg(description).arg(ethIF).arg(udpport));
             }
-            socket = & udpsocket;
             break;
         case EcuItem::INTERFACETYPE_SERIAL_DLT:
         case EcuItem::INTERFACETYPE_SERIAL_ASCII:
             setData(1,Qt::DisplayRole,QString("%1 [%2]").arg(description).arg(port));
-            socket = 0;
             break;
     }
 
@@ -43,6 +43,7 @@
 enum dlt_item_type { ecu_type = QTreeWidgetItem::UserType, application_type, context_type, filter_type, plugin_type };
 
 class ApplicationItem;
+class DltIngestThread;
 
 class EcuItem  : public QTreeWidgetItem
 {
@@ -77,12 +78,8 @@ public:
     bool updateDataIfOnline;
     void update();
 
-    /* connection */
-    QTcpSocket tcpsocket;
-    QUdpSocket udpsocket;
-    QAbstractSocket * socket;
-
-    QSerialPort *m_serialport;
+    /* connection, received in its own thread */
+    DltIngestThread *ingest;
 
     /* connection status */
     bool tryToConnect;
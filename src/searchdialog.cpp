@@ -21,8 +21,10 @@
 #include "ui_searchdialog.h"
 #include "qdltoptmanager.h"
 #include "tablemodel.h"
+#include "dltfileindexer.h"
 
 #include <dltmessagematcher.h>
+#include <dltsearchengine.h>
 
 #include <QMessageBox>
 #include <QProgressBar>
@@ -30,6 +32,7 @@
 #include <QSignalBlocker>
 #include <QColorDialog>
 #include <QAction>
+#include <QBitArray>
 
 SearchDialog::SearchDialog(QWidget *parent) :
     QDialog(parent),
@@ -47,6 +50,7 @@ SearchDialog::SearchDialog(QWidget *parent) :
     // at start we want to know if single step search or "fill search table mode" is active !
     bool checked = QDltSettingsManager::getInstance()->value("other/search/checkBoxSearchIndex", bool(true)).toBool();
     ui->checkBoxFindAll->setChecked(checked);
+    ui->checkBoxWithinResults->setEnabled(checked);
 
     checked = QDltSettingsManager::getInstance()->value("other/search/checkBoxHeader", bool(true)).toBool();
     ui->checkBoxHeader->setChecked(checked);
@@ -166,6 +170,11 @@ bool SearchDialog::searchtoIndex()
 }
 
 
+bool SearchDialog::searchWithinResults()
+{
+    return searchtoIndex() && ui->checkBoxWithinResults->isChecked();
+}
+
 bool SearchDialog::getSearchFromBeginning()
 {
     return (ui->radioButtonPosBeginning->isChecked());
@@ -224,12 +233,17 @@ void SearchDialog::focusRow(long int searchLine)
 
 int SearchDialog::find()
 {
+    // events are processed while searching, a second search must not start then
+    if (isSearchRunning)
+    {
+        return -1;
+    }
+
     isSearchCancelled = false;
 
     emit addActionHistory();
     QRegularExpression searchTextRegExpression;
     is_TimeStampSearchSelected = false;
-    long int searchBorder;
     long int lStartLine;
 
     emit searchProgressChanged(true);
@@ -286,20 +300,6 @@ int SearchDialog::find()
          qDebug() << "Search starting at line" << startLine;
     }
 
-    searchBorder = startLine;
-    if(searchBorder < 0 || searchtoIndex())
-    {
-        if(getNextClicked() || searchtoIndex())
-        {
-            searchBorder = file->sizeFilter()==0?0:file->sizeFilter()-1;
-        }
-        else
-        {
-            searchBorder = 0;
-        }
-
-    }
-
     if(getRegExp() == true)
     {
         searchTextRegExpression.setPattern(getText());
@@ -317,6 +317,7 @@ int SearchDialog::find()
         if (!getCaseSensitive())
             options |= QRegularExpression::CaseInsensitiveOption;
         searchTextRegExpression.setPatternOptions(static_cast<QRegularExpression::PatternOption>(options));
+        searchTextRegExpression.optimize();
     }
 
     //check timestamp search pattern
@@ -367,12 +368,15 @@ int SearchDialog::find()
      fIs_APID_CTID_requested = false;
     }
 
-    findMessages(startLine,searchBorder,searchTextRegExpression);
+    isSearchRunning = true;
+    findMessages(startLine,searchTextRegExpression);
+    isSearchRunning = false;
 
     emit searchProgressChanged(false);
 
     if (searchtoIndex() == true )
     {
+        m_searchtablemodel->flush_SearchResults();
         cacheSearchHistory();
         emit refreshedSearchIndex();
         //if at least one element has been found -> successful search
@@ -405,14 +409,24 @@ private:
     std::chrono::high_resolution_clock::time_point m_start;
 };
 
-void SearchDialog::findMessages(long int searchLine, long int searchBorder, QRegularExpression &searchTextRegExp)
+void SearchDialog::findMessages(long int searchLine, QRegularExpression &searchTextRegExp)
 {
-
-    QDltMsg msg;
-    QByteArray buf;
-    int ctr = 0;
     Qt::CaseSensitivity is_Case_Sensitive = Qt::CaseInsensitive;
 
+    // the worker threads read the index of the file, it must not be changed while they run
+    // live updates of the index take the same lock, they are delayed until the search is finished
+    if (!indexer->tryLock()) {
+        qDebug() << "Search not possible, the indexer is working on the file";
+        if (false == fSilentMode) {
+            QMessageBox::warning(0, QString("Search"), QString("The file is being indexed, search again when it is finished."));
+        }
+        return;
+    }
+    struct IndexerLock {
+        DltFileIndexer *indexer;
+        ~IndexerLock() { indexer->unlock(); }
+    } indexerLock{indexer};
+
     ScopedTimer timer{};
 
     if(getCaseSensitive() == true)
@@ -420,6 +434,19 @@ void SearchDialog::findMessages(long int searchLine, long int searchBorder, QReg
         is_Case_Sensitive = Qt::CaseSensitive;
     }
 
+    // a refinement only checks the messages found by the previous search
+    QBitArray previousResults;
+    const SearchResultList &results = m_searchtablemodel->get_SearchResults();
+    if (searchWithinResults() && !results.isEmpty()) {
+        previousResults.resize(file->size());
+        for (int position = 0; position < results.size(); position++) {
+            const unsigned long msgIndex = results.at(position);
+            if (msgIndex < static_cast<unsigned long>(previousResults.size())) {
+                previousResults.setBit(static_cast<int>(msgIndex));
+            }
+        }
+    }
+
     m_searchtablemodel->clear_SearchResults();
 
     bool msgIdEnabled=QDltSettingsManager::getInstance()->value("startup/showMsgId", true).toBool();
@@ -443,63 +470,82 @@ void SearchDialog::findMessages(long int searchLine, long int searchBorder, QReg
     }
     matcher.setHeaderSearchEnabled(getHeader());
     matcher.setPayloadSearchEnabled(getPayload());
+    if (getRegExp()) {
+        matcher.setRegexPrefilter(searchTextRegExp);
+    }
 
-    do
-    {
-        ctr++; // for file progress indication
+    // the literals which are contained in every matching text
+    const bool pluginsEnabled = QDltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool();
+    const QByteArray renderKey = DltFileIndexer::textRenderKey(pluginsEnabled, pluginManager->getDecoderPlugins());
+    QStringList literals;
+    if (getRegExp()) {
+        QDltRegexPrefilter prefilter;
+        prefilter.setRegularExpression(searchTextRegExp);
+        literals = prefilter.getLiterals();
+    } else {
+        literals.append(getText());
+    }
 
-        if(getNextClicked() || searchtoIndex())
-        {
-            searchLine++;
-            if(searchLine >= file->sizeFilter())
-            {
-                searchLine = 0;
-            }
-        }
-        else // go back
-        {
-            searchLine--;
-            if(searchLine <= -1)
-            {
-                searchLine = file->sizeFilter()-1;
-            }
-        }
+    // find all only checks the candidates of the full text index, without literals all messages are checked
+    QBitArray fullTextCandidates;
+    if (searchtoIndex() && file->hasFullTextIndex(renderKey)) {
+        file->findFullText(literals, fullTextCandidates);
+    }
 
-        // Update progress every 0.5%
-        if(searchLine%1000 == 0)
-        {
-            QApplication::processEvents();
-            if (isSearchCancelled) {
-                break;
-            }
-            emit searchProgressValueChanged(static_cast<int>(ctr * 100.0 / file->sizeFilter()));
-        }
+    // skip blocks of messages, which do not contain the literals of the search text
+    QDltTextBlockIndex::Query textBlockQuery;
+    if (fullTextCandidates.isEmpty() && file->hasTextBlockIndex(renderKey)) {
+        textBlockQuery = QDltTextBlockIndex::query(literals);
+    }
 
-        /* get the message with the selected item id */
-        buf = file->getMsgFilter(searchLine);
-        msg.setMsg(buf);
-        msg.setIndex(file->getMsgFilterPos(searchLine));
+    DltSearchEngine engine(*file, matcher, getRegExp() ? DltMessageMatcher::Pattern(searchTextRegExp) : DltMessageMatcher::Pattern(getText()));
+    if (pluginsEnabled) {
+        engine.setPluginManager(pluginManager, fSilentMode);
+    }
+    if (!previousResults.isEmpty() || !fullTextCandidates.isEmpty() || !textBlockQuery.isEmpty()) {
+        engine.setCandidateFunction([&](int msgIndex) {
+            if (!previousResults.isEmpty() && (msgIndex < 0 || msgIndex >= previousResults.size() || !previousResults.testBit(msgIndex)))
+                return false;
+            if (!fullTextCandidates.isEmpty() && msgIndex >= 0 && msgIndex < fullTextCandidates.size() && !fullTextCandidates.testBit(msgIndex))
+                return false;
+            return textBlockQuery.isEmpty() || file->mayContainText(msgIndex, textBlockQuery);
+        });
+    }
 
-        /* decode the message if desired - could this call be avoided as the message is already decoded elsewhere ? */
-        if(QDltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool())
-        {
-            //qDebug() << "Decode" << __LINE__;
-            pluginManager->decodeMsg(msg, fSilentMode);
+    // the search runs in worker threads, the UI stays responsive while waiting for them
+    const int rowCount = file->sizeFilter();
+    auto progress = [&](int checkedRows) {
+        emit searchProgressValueChanged(static_cast<int>(checkedRows * 100.0 / rowCount));
+        QApplication::processEvents();
+        if (isSearchCancelled) {
+            engine.cancel();
         }
+    };
 
-        const bool matchFound = getRegExp() ? matcher.match(msg, searchTextRegExp) : matcher.match(msg, getText());
-        if (!matchFound)
-        {
-            match = false;
-            continue;
+    match = false;
+    if (searchtoIndex()) {
+        // find all searches from the row after the start line to the end
+        const int begin = (searchLine + 1 < rowCount) ? static_cast<int>(qMax(0L, searchLine + 1)) : 0;
+        engine.findAll(begin, rowCount, [&](const QVector<int>& rows) {
+            for (int row : rows) {
+                foundLine(row);
+            }
+            // the search results window shows the number of results, the rows are inserted by the model
+            emit refreshedSearchIndex();
+        }, progress);
+    } else {
+        const int row = engine.findNearest(static_cast<int>(searchLine), getNextClicked(), progress);
+        if (row >= 0) {
+            foundLine(row);
         }
+    }
 
-        if (foundLine(searchLine))
-            break;
-        else
-            continue;
+    if (getRegExp()) {
+        qDebug() << "Messages rejected by regular expression literals:" << engine.getRegexPrefilterRejectedCount();
+    }
+    if (!previousResults.isEmpty() || !fullTextCandidates.isEmpty() || !textBlockQuery.isEmpty()) {
+        qDebug() << "Messages skipped by previous results and text indexes:" << engine.getSkippedCount();
     }
-    while( searchBorder != searchLine );
 }
 
 bool SearchDialog::foundLine(long int searchLine)
@@ -509,7 +555,6 @@ bool SearchDialog::foundLine(long int searchLine)
     if (searchtoIndex() == true)
     {
         addToSearchIndex(searchLine);
-        emit refreshedSearchIndex();
     }
     else
     {
@@ -615,18 +660,10 @@ void SearchDialog::loadSearchHistory()
         text = action->text();
     }
 
-    // creating a local list to store the indexes related to the key retrieved from the cache.
-    QList <unsigned long> tmp ;
+    // replacing the previous search list by the cached search obtained, the chunks of the results are shared.
     if(cachedHistoryKey.size() > 0)
     {
-        tmp = cachedHistoryKey[text];
-
-        //deleting the previous search list and adding the cached search obtained to the model.
-        m_searchtablemodel->clear_SearchResults();
-        for (int i = 0;i < tmp.size();i++)
-        {
-            m_searchtablemodel->add_SearchResultEntry(tmp.at(i));
-        }
+        m_searchtablemodel->set_SearchResults(cachedHistoryKey.value(text));
     }
     emit refreshedSearchIndex();
 }
@@ -635,7 +672,7 @@ void SearchDialog::cacheSearchHistory()
 {
     // if it is a new search then add all the indexes of the search to a list(m_searchHistory).
     QString searchBoxText = getText();  
-    m_searchHistory.append(m_searchtablemodel->m_searchResultList);
+    m_searchHistory.append(m_searchtablemodel->get_SearchResults());
     cachedHistoryKey.insert(searchBoxText,m_searchHistory.last());    
 }
 
@@ -679,6 +716,7 @@ void SearchDialog::on_checkBoxFindAll_toggled(bool checked)
 {
     QDltSettingsManager::getInstance()->setValue("other/search/checkBoxSearchIndex", checked);
     setStartLine(-1);
+    ui->checkBoxWithinResults->setEnabled(checked);
 }
 
 void SearchDialog::on_checkBoxCaseSensitive_toggled(bool checked)
@@ -30,6 +30,8 @@ namespace Ui {
 class SearchDialog;
 }
 
+class DltFileIndexer;
+
 class SearchDialog : public QDialog {
     Q_OBJECT
 
@@ -55,6 +57,7 @@ public:
      */
 
     QDltFile *file;
+    DltFileIndexer *indexer;
     QTableView *table;
     QDltPluginManager *pluginManager;
     QCheckBox *regexpCheckBox;
@@ -66,6 +69,7 @@ private:
     SearchTableModel *m_searchtablemodel;
 
     bool isSearchCancelled{false};
+    bool isSearchRunning{false};
 
     long int startLine;
     bool nextClicked;
@@ -86,11 +90,11 @@ private:
 
     QColor highlightColor;
 
-    QHash<QString, QList <unsigned long>> cachedHistoryKey;
+    QHash<QString, SearchResultList> cachedHistoryKey;
 
     void setRegExp(bool regExp);
     void addToSearchIndex(long int searchLine);
-    void findMessages(long int searchLine, long int searchBorder, QRegularExpression &searchTextRegExp);
+    void findMessages(long int searchLine, QRegularExpression &searchTextRegExp);
     void updateColorbutton();
     void setSearchColour(QLineEdit *lineEdit,int result);
     void setHeader(bool header);
@@ -108,6 +112,7 @@ private:
     bool getNextClicked();
     bool getClicked();
     bool searchtoIndex();
+    bool searchWithinResults();
     bool foundLine(long int searchLine);
     QString getApIDText();
     QString getCtIDText();
@@ -115,7 +120,7 @@ private:
     QString getTimeStampEnd();
     QString getPayLoadStampStart();
     QString getPayLoadStampEnd();
-    QList < QList <unsigned long>> m_searchHistory;
+    QList <SearchResultList> m_searchHistory;
     QList<QLineEdit*> lineEdits;
 
 private slots:
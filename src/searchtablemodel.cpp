@@ -23,6 +23,23 @@
 #include "dlt_protocol.h"
 #include "qdltoptmanager.h"
 
+/* interval in which added search results are inserted into the views */
+#define DLT_VIEWER_SEARCH_UPDATE_INTERVAL 100
+
+void SearchResultList::append(unsigned long entry)
+{
+    if ((m_size & (ChunkSize - 1)) == 0)
+        m_chunks.append(QVector<quint32>());
+    /* message indexes of a file fit into 32 bit */
+    m_chunks.last().append(static_cast<quint32>(entry));
+    m_size++;
+}
+
+void SearchResultList::clear()
+{
+    m_chunks.clear();
+    m_size = 0;
+}
 
 
 SearchTableModel::SearchTableModel(const QString &,QObject *parent) :
@@ -31,6 +48,10 @@ SearchTableModel::SearchTableModel(const QString &,QObject *parent) :
     qfile = NULL;
     project = NULL;
     pluginManager = NULL;
+
+    m_updateTimer.setSingleShot(true);
+    m_updateTimer.setInterval(DLT_VIEWER_SEARCH_UPDATE_INTERVAL);
+    connect(&m_updateTimer, &QTimer::timeout, this, &SearchTableModel::flush_SearchResults);
 }
 
 SearchTableModel::~SearchTableModel()
@@ -46,17 +67,17 @@ QVariant SearchTableModel::data(const QModelIndex &index, int role) const
     if (!index.isValid())
         return QVariant();
 
-    if (index.row() >= m_searchResultList.size() && index.row()<0)
+    if (index.row() >= m_shownCount || index.row() < 0)
         return QVariant();
 
     if (role == Qt::DisplayRole)
     {
         /* get the message with the selected item id */
-        if(!qfile->getMsg(m_searchResultList.at(index.row()), msg))
+        if(!qfile->getMsg(m_searchResults.at(index.row()), msg))
         {
             if(index.column() == FieldNames::Index)
             {
-                return QString("%1").arg((m_searchResultList.at(index.row())));
+                return QString("%1").arg((m_searchResults.at(index.row())));
             }
             else if(index.column() == FieldNames::Payload)
             {
@@ -73,7 +94,7 @@ QVariant SearchTableModel::data(const QModelIndex &index, int role) const
         {
         case FieldNames::Index:
             /* display index */            
-            return QString("%L1").arg((m_searchResultList.at(index.row())));
+            return QString("%L1").arg((m_searchResults.at(index.row())));
         case FieldNames::Time:
             if( project->settings->automaticTimeSettings == 0 )
                return QString("%1.%2").arg(msg.getGmTimeWithOffsetString(project->settings->utcOffset,project->settings->dst)).arg(msg.getMicroseconds(),6,10,QLatin1Char('0'));
@@ -195,7 +216,7 @@ QVariant SearchTableModel::data(const QModelIndex &index, int role) const
 
     if ( role == Qt::ForegroundRole )
     {
-        if(qfile->getMsg(m_searchResultList.at(index.row()), msg))
+        if(qfile->getMsg(m_searchResults.at(index.row()), msg))
         {
             /* Valid message found, calculate background color and find optimal forground color */
             return QVariant(QBrush(DltUiUtils::optimalTextColor(getMsgBackgroundColor(msg))));
@@ -213,7 +234,7 @@ QVariant SearchTableModel::data(const QModelIndex &index, int role) const
 
     if ( role == Qt::BackgroundRole )
     {
-        if(qfile->getMsg(m_searchResultList.at(index.row()), msg))
+        if(qfile->getMsg(m_searchResults.at(index.row()), msg))
         {
             /* Valid message found, calculate background color */
             return QVariant(QBrush(getMsgBackgroundColor(msg)));
@@ -273,14 +294,14 @@ QVariant SearchTableModel::headerData(int section, Qt::Orientation orientation,
 
 int SearchTableModel::rowCount(const QModelIndex & /*parent*/) const
 {
-    return get_SearchResultListSize();
+    return m_shownCount;
 }
 
 void SearchTableModel::modelChanged()
 {    
     index(0, 1);
-    index(m_searchResultList.size()-1, 0);
-    index(m_searchResultList.size()-1, columnCount() - 1);
+    index(m_shownCount-1, 0);
+    index(m_shownCount-1, columnCount() - 1);
     emit(layoutChanged());
 }
 
@@ -291,31 +312,55 @@ int SearchTableModel::columnCount(const QModelIndex & /*parent*/) const
 
 void SearchTableModel::clear_SearchResults()
 {
-    m_searchResultList.clear();
-    modelChanged();
+    set_SearchResults(SearchResultList());
+}
+
+void SearchTableModel::set_SearchResults(const SearchResultList &results)
+{
+    beginResetModel();
+    m_updateTimer.stop();
+    m_searchResults = results;
+    m_shownCount = m_searchResults.size();
+    endResetModel();
 }
 
 void SearchTableModel::add_SearchResultEntry(unsigned long entry)
 {
-    m_searchResultList.append(entry);
+    m_searchResults.append(entry);
+
+    /* the views are not updated for each entry, many entries are inserted at once */
+    if (!m_updateTimer.isActive())
+        m_updateTimer.start();
+}
+
+void SearchTableModel::flush_SearchResults()
+{
+    m_updateTimer.stop();
+
+    if (m_shownCount >= m_searchResults.size())
+        return;
+
+    beginInsertRows(QModelIndex(), m_shownCount, m_searchResults.size() - 1);
+    m_shownCount = m_searchResults.size();
+    endInsertRows();
 }
 
 
-bool SearchTableModel::get_SearchResultEntry(int position, unsigned long &entry)
+bool SearchTableModel::get_SearchResultEntry(int position, unsigned long &entry) const
 {
-    if (position > m_searchResultList.size() || 0 > position )
+    if (position >= m_searchResults.size() || 0 > position )
     {
         return false;
     }
 
-    entry = m_searchResultList.at(position);
+    entry = m_searchResults.at(position);
     return true;
 }
 
 
 int SearchTableModel::get_SearchResultListSize() const
 {
-    return m_searchResultList.size();
+    return m_searchResults.size();
 }
 
 QColor SearchTableModel::getMsgBackgroundColor(QDltMsg &msg) const
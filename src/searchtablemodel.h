@@ -21,12 +21,35 @@
 #define SEARCHTABLEMODEL_H
 
 #include <QAbstractTableModel>
+#include <QTimer>
+#include <QVector>
 
 #include "project.h"
 #include "qdltpluginmanager.h"
 
 #define DLT_VIEWER_SEARCHCOLUMN_COUNT FieldNames::Arg0
 
+/* Message indexes of search results, stored in chunks which are only appended.
+ * Copies share the chunks, so the search history keeps results without copying them.
+ */
+class SearchResultList
+{
+public:
+    void append(unsigned long entry);
+    void clear();
+
+    int size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+    unsigned long at(int position) const { return m_chunks.at(position >> ChunkBits).at(position & (ChunkSize - 1)); }
+
+private:
+    static const int ChunkBits = 16;
+    static const int ChunkSize = 1 << ChunkBits;
+
+    QVector<QVector<quint32>> m_chunks;
+    int m_size{0};
+};
+
 class SearchTableModel : public QAbstractTableModel
 {
     Q_OBJECT
@@ -46,10 +69,14 @@ public:
 
     void clear_SearchResults();
     void add_SearchResultEntry(unsigned long entry);
+    void set_SearchResults(const SearchResultList &results);
 
+    /* show the added entries now instead of waiting for the update timer */
+    void flush_SearchResults();
 
     int get_SearchResultListSize() const;
-    bool get_SearchResultEntry(int position, unsigned long &entry);
+    bool get_SearchResultEntry(int position, unsigned long &entry) const;
+    const SearchResultList &get_SearchResults() const { return m_searchResults; }
 
     QColor getMsgBackgroundColor(QDltMsg &msg) const;
 
@@ -63,9 +90,12 @@ signals:
 public slots:
 
 
-public:
-    QList <unsigned long> m_searchResultList;
-    
+private:
+    SearchResultList m_searchResults;
+
+    /* number of entries the views know of, added entries are inserted in batches by the update timer */
+    int m_shownCount{0};
+    QTimer m_updateTimer;
 };
 
 #endif // SEARCHTABLEMODEL_H
@@ -237,6 +237,8 @@ void SettingsDialog::writeDlg()
     ui->checkBoxPluginsAutoload->setCheckState(settings->pluginsAutoloadPath?Qt::Checked:Qt::Unchecked);
     ui->lineEditPluginsAutoload->setText(settings->pluginsAutoloadPathName);
     ui->checkBoxFilterCache->setCheckState(settings->filterCache?Qt::Checked:Qt::Unchecked);
+    ui->checkBoxTextBlockIndex->setCheckState(settings->textBlockIndex?Qt::Checked:Qt::Unchecked);
+    ui->checkBoxFullTextIndex->setCheckState(settings->fullTextIndex?Qt::Checked:Qt::Unchecked);
     ui->checkBoxAutoConnect->setCheckState(settings->autoConnect?Qt::Checked:Qt::Unchecked);
     ui->checkBoxSupportDLTV2Decoding->setCheckState(settings->supportDLTv2Decoding?Qt::Checked:Qt::Unchecked);
     ui->checkBoxAutoScroll->setCheckState(settings->autoScroll?Qt::Checked:Qt::Unchecked);
@@ -413,6 +415,8 @@ void SettingsDialog::readDlg()
     settings->pluginsAutoloadPath = (ui->checkBoxPluginsAutoload->checkState() == Qt::Checked);
     settings->pluginsAutoloadPathName = ui->lineEditPluginsAutoload->text();
     settings->filterCache = (ui->checkBoxFilterCache->checkState() == Qt::Checked);
+    settings->textBlockIndex = (ui->checkBoxTextBlockIndex->checkState() == Qt::Checked);
+    settings->fullTextIndex = (ui->checkBoxFullTextIndex->checkState() == Qt::Checked);
     settings->autoConnect = (ui->checkBoxAutoConnect->checkState() == Qt::Checked);
     settings->supportDLTv2Decoding = (ui->checkBoxSupportDLTV2Decoding->checkState() == Qt::Checked);
     settings->autoScroll = (ui->checkBoxAutoScroll->checkState() == Qt::Checked);
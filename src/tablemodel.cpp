@@ -335,6 +335,9 @@ QVariant TableModel::headerData(int section, Qt::Orientation orientation,
      /* last search index must be deleted because model changed */
      lastSearchIndex = -1;
 
+     /* rows may show other messages now */
+     m_cache.clear();
+
      emit(layoutChanged());
  }
 
@@ -70,8 +70,9 @@ private:
     bool loggingOnlyMode;
 
     // cache is used in data()-method to avoid decoding of the same message multiple times
-    // key is a message index in the qdltfile; message can fail to decode, in that case value is empty optional
-    mutable QDltLruCache<int, std::optional<QDltMsg>> m_cache{1};
+    // key is a row of the table; message can fail to decode, in that case value is empty optional
+    // it keeps the rows of some screens, so scrolling back does not decode them again; cleared when the model changes
+    mutable QDltLruCache<int, std::optional<QDltMsg>> m_cache{256};
 
     long int searchhit;
     QColor searchBackgroundColor() const;